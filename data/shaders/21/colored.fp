@@ -0,0 +1,8 @@
+#version 120
+
+varying vec4 vertexColor;
+
+void main(void)
+{
+  gl_FragColor = vertexColor;
+}
@@ -13,16 +13,17 @@ void main(void)
     vec2 off = 1.0 / texSize;
     vec2 tc = UV.st;
 
-    vec4 c = texture2D(tex, tc);
-    vec4 n = texture2D(tex, vec2(tc.x, tc.y - off.y));
-    vec4 e = texture2D(tex, vec2(tc.x + off.x, tc.y));
-    vec4 s = texture2D(tex, vec2(tc.x, tc.y + off.y));
-    vec4 w = texture2D(tex, vec2(tc.x - off.x, tc.y));
+    // glyph coverage is stored in the red channel
+    float c = texture2D(tex, tc).r;
+    float n = texture2D(tex, vec2(tc.x, tc.y - off.y)).r;
+    float e = texture2D(tex, vec2(tc.x + off.x, tc.y)).r;
+    float s = texture2D(tex, vec2(tc.x, tc.y + off.y)).r;
+    float w = texture2D(tex, vec2(tc.x - off.x, tc.y)).r;
 
-    vec4 origColor = vec4(color.rgb, c.a);
+    vec4 origColor = vec4(color.rgb, c);
 
     float ua = 0.0;
-    if (c.a == 0.0 && ( n.a > 0.0 || e.a>0.0 || s.a>0.0 || w.a>0.0))
+    if (c == 0.0 && ( n > 0.0 || e > 0.0 || s > 0.0 || w > 0.0))
     {
         origColor = outlineColor;
     }
@@ -0,0 +1,10 @@
+#version 120
+
+uniform sampler2D tex;
+varying vec2 UV;
+
+void main(void)
+{
+  // cached layers hold premultiplied colors, fade is already applied
+  gl_FragColor = texture2D(tex, UV);
+}
@@ -1,7 +1,13 @@
 #version 150
+
+layout(std140) uniform FrameConstants
+{
+  mat4 MVP;
+  vec4 fade;
+};
+
 uniform sampler2D tex;
-uniform vec4 fade;
-uniform int cnt[6];
+uniform sampler2D palette;
 uniform int global_light;
 uniform int trans;
 uniform int outline;
@@ -10,53 +16,33 @@ uniform float texHeight;
 in vec2 UV;
 out vec4 fragColor;
 
-void main(void)
+// Texels of indexed textures are palette indexes, the palette texture is 256x1
+vec4 paletteColor(float index)
 {
+    return texture(palette, vec2(index * 255.0 / 256.0 + 0.5 / 256.0, 0.5));
+}
 
-    vec3 monitorsPalette[5];
-        monitorsPalette[0] = vec3(0.42, 0.42, 0.43);
-        monitorsPalette[1] = vec3(0.38, 0.40, 0.49);
-        monitorsPalette[2] = vec3(0.34, 0.42, 0.56);
-        monitorsPalette[3] = vec3(0.00, 0.57, 0.63);
-        monitorsPalette[4] = vec3(0.42, 0.73, 1.00);
-
-
-    vec3 slimePalette[4];
-        slimePalette[0] = vec3(0.00, 0.42, 0.00);
-        slimePalette[1] = vec3(0.04, 0.45, 0.02);
-        slimePalette[2] = vec3(0.10, 0.48, 0.05);
-        slimePalette[3] = vec3(0.16, 0.51, 0.10);
-
-
-    vec3 shorePalette[6];
-        shorePalette[0] = vec3(0.32, 0.24, 0.16);
-        shorePalette[1] = vec3(0.29, 0.23, 0.16);
-        shorePalette[2] = vec3(0.26, 0.21, 0.15);
-        shorePalette[3] = vec3(0.24, 0.20, 0.15);
-        shorePalette[4] = vec3(0.21, 0.18, 0.14);
-        shorePalette[5] = vec3(0.20, 0.16, 0.14);
-
-
-    vec3 fireSlowPalette[5];
-        fireSlowPalette[0] = vec3(1.0, 0.0, 0.0);
-        fireSlowPalette[1] = vec3(0.84, 0.0, 0.0);
-        fireSlowPalette[2] = vec3(0.57, 0.16, 0.04);
-        fireSlowPalette[3] = vec3(1.0, 0.46, 0.0);
-        fireSlowPalette[4] = vec3(1.0, 0.23, 0.0);
-
+// Indexes 229-254 are cycled by the animated palette
+bool animatedIndex(float index)
+{
+    int i = int(index * 255.0 + 0.5);
+    return i >= 229 && i <= 254;
+}
 
-    vec3 fireFastPalette[5];
-        fireFastPalette[0] = vec3(0.27, 0.0, 0.0);
-        fireFastPalette[1] = vec3(0.48, 0.0, 0.0);
-        fireFastPalette[2] = vec3(0.70, 0.0, 0.0);
-        fireFastPalette[3] = vec3(0.48, 0.0, 0.0);
-        fireFastPalette[4] = vec3(0.27, 0.0, 0.0);
+// Opacity of a texel, index 0 is transparent
+float coverage(vec2 uv)
+{
+    return texture(tex, uv).r;
+}
 
-    vec4 origColor = texture(tex, UV);
+void main(void)
+{
+    float index = texture(tex, UV).r;
+    vec4 origColor = paletteColor(index);
+    bool animated = animatedIndex(index);
 
     if (outline == 0)
     {
-
         if (trans == 3) // glass
         {
             //origColor.r=0.0;
@@ -70,7 +56,6 @@ void main(void)
         }
         else if (trans == 4) // steam
         {
-
             if (origColor.a>0)
             {
                 float gray = dot(origColor.rgb, vec3( 0.21, 0.72, 0.07 ));
@@ -101,73 +86,24 @@ void main(void)
             }
             origColor.rgb = origColor.rgb/100*global_light;
         }
-        else
+        else if (!animated)
         {
-
-            if (origColor.a == 0.2 && origColor.r == 0.6)
-            {
-                int index = int(round(origColor.b * 255.0)) / 51;
-
-                if (index<0) index = 0;
-
-                if (origColor.g == 0.0)
-                {
-                    if (index>3) index = 3;
-                    int newIndex = (index + cnt[0]) % 4;
-                    origColor.rgb = slimePalette[newIndex];
-                }
-                else if (origColor.g == 0.2)
-                {
-                    if (index>4) index = 4;
-                    int newIndex = (index + cnt[1]) % 5;
-                    origColor.rgb = monitorsPalette[newIndex];
-                }
-                else if (origColor.g == 0.4)
-                {
-                    if (index>4) index = 4;
-                    int newIndex = (index + cnt[2]) % 5;
-                    origColor.rgb = fireSlowPalette[newIndex];
-                }
-                else if (origColor.g == 0.6)
-                {
-                    if (index>4) index = 4;
-                    int newIndex = (index + cnt[3]) % 5;
-                    origColor.rgb = fireFastPalette[newIndex];
-                }
-                else if (origColor.g == 0.8)
-                {
-                    if (index>5) index = 5;
-                    int newIndex = (index + cnt[4]) % 6;
-                    origColor.rgb = shorePalette[newIndex];
-                }
-                else if (origColor.g == 1.0)
-                {
-                    origColor.rgb = vec3((cnt[5]*4)/255.0,0,0);
-                }
-
-                origColor.a = 1.0;
-            }
-            else
-            {
-                // add light
-                origColor.rgb = origColor.rgb/100*global_light;
-            }
+            // add light, animated palette colors glow in the dark
+            origColor.rgb = origColor.rgb/100*global_light;
         }
-
     }
     else
     {
-        ivec2 texSize = textureSize(tex,0);
         vec4 outlineColor = vec4(0.0,0.0,0.0,0.0);
         if (outline == 1) // red, animated
         {
+            // fast fire colors (243-247) are already cycled by the palette
             float texPos = UV.y - texStart;
             float prop = (texHeight)/5;
             int idx = int(texPos / prop);
             if (idx>4) idx = 4;
-            int newIdx = (idx + cnt[3]) % 5;
 
-            outlineColor = vec4(fireFastPalette[newIdx],1.0);
+            outlineColor = vec4(paletteColor((243.0 + float(idx)) / 255.0).rgb, 1.0);
         }
         else if (outline == 2) // yellow
         {
@@ -178,17 +114,18 @@ void main(void)
             outlineColor = vec4(0.0,1.0,0.0,1.0);
         }
 
+        ivec2 texSize = textureSize(tex,0);
+
         vec2 off = 1.0 / texSize;
         vec2 tc = UV.st;
 
-        vec4 c = texture(tex, tc);
-        vec4 n = texture(tex, vec2(tc.x, tc.y - off.y));
-        vec4 e = texture(tex, vec2(tc.x + off.x, tc.y));
-        vec4 s = texture(tex, vec2(tc.x, tc.y + off.y));
-        vec4 w = texture(tex, vec2(tc.x - off.x, tc.y));
+        float c = coverage(tc);
+        float n = coverage(vec2(tc.x, tc.y - off.y));
+        float e = coverage(vec2(tc.x + off.x, tc.y));
+        float s = coverage(vec2(tc.x, tc.y + off.y));
+        float w = coverage(vec2(tc.x - off.x, tc.y));
 
-        float ua = 0.0;
-        if (c.a == 0.0 && ( n.a != 0.0 || e.a!=0.0 || s.a!=0.0 || w.a!=0.0))
+        if (c == 0.0 && ( n != 0.0 || e != 0.0 || s != 0.0 || w != 0.0))
         {
             origColor = outlineColor;
         }
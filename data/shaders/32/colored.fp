@@ -0,0 +1,9 @@
+#version 150
+
+in vec4 vertexColor;
+out vec4 fragColor;
+
+void main(void)
+{
+  fragColor = vertexColor;
+}
@@ -1,9 +1,14 @@
 #version 150
 
+layout(std140) uniform FrameConstants
+{
+  mat4 MVP;
+  vec4 fade;
+};
+
 uniform sampler2D tex;
 uniform vec4 outlineColor;
 uniform vec4 color;
-uniform vec4 fade;
 in vec2 UV;
 out vec4 fragColor;
 
@@ -14,16 +19,17 @@ void main(void)
     vec2 off = 1.0 / texSize;
     vec2 tc = UV.st;
 
-    vec4 c = texture(tex, tc);
-    vec4 n = texture(tex, vec2(tc.x, tc.y - off.y));
-    vec4 e = texture(tex, vec2(tc.x + off.x, tc.y));
-    vec4 s = texture(tex, vec2(tc.x, tc.y + off.y));
-    vec4 w = texture(tex, vec2(tc.x - off.x, tc.y));
+    // glyph coverage is stored in the red channel
+    float c = texture(tex, tc).r;
+    float n = texture(tex, vec2(tc.x, tc.y - off.y)).r;
+    float e = texture(tex, vec2(tc.x + off.x, tc.y)).r;
+    float s = texture(tex, vec2(tc.x, tc.y + off.y)).r;
+    float w = texture(tex, vec2(tc.x - off.x, tc.y)).r;
 
-    vec4 origColor = vec4(color.rgb, c.a);
+    vec4 origColor = vec4(color.rgb, c);
 
     float ua = 0.0;
-    if (c.a == 0.0 && ( n.a > 0.0 || e.a>0.0 || s.a>0.0 || w.a>0.0))
+    if (c == 0.0 && ( n > 0.0 || e > 0.0 || s > 0.0 || w > 0.0))
     {
         origColor = outlineColor;
     }
@@ -0,0 +1,11 @@
+#version 150
+
+uniform sampler2D tex;
+in vec2 UV;
+out vec4 fragColor;
+
+void main(void)
+{
+  // cached layers hold premultiplied colors, fade is already applied
+  fragColor = texture(tex, UV);
+}
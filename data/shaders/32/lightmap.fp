@@ -1,6 +1,11 @@
 #version 150
 
-uniform vec4 fade;
+layout(std140) uniform FrameConstants
+{
+  mat4 MVP;
+  vec4 fade;
+};
+
 in float fLight;
 out vec4 fragColor;
 
@@ -1,9 +1,15 @@
 #version 150
 
+layout(std140) uniform FrameConstants
+{
+  mat4 MVP;
+  vec4 fade;
+};
+
 uniform sampler2D tex;
 uniform sampler2D eggTex;
-uniform vec4 fade;
-uniform int cnt[6];
+uniform sampler2D palette;
+uniform bool indexed;
 uniform int global_light;
 uniform int trans;
 uniform bool doegg;
@@ -12,54 +18,40 @@ uniform int outline;
 in vec2 UV;
 out vec4 fragColor;
 
-void main(void)
+// Texels of indexed textures are palette indexes, the palette texture is 256x1
+vec4 paletteColor(float index)
 {
+    return texture(palette, vec2(index * 255.0 / 256.0 + 0.5 / 256.0, 0.5));
+}
 
-    const vec3 monitorsPalette[5] = vec3[](
-            vec3(0.42, 0.42, 0.43),
-            vec3(0.38, 0.40, 0.49),
-            vec3(0.34, 0.42, 0.56),
-            vec3(0.00, 0.57, 0.63),
-            vec3(0.42, 0.73, 1.00)
-        );
-
-
-        const vec3 slimePalette[4] = vec3[] (
-            vec3(0.00, 0.42, 0.00),
-            vec3(0.04, 0.45, 0.02),
-            vec3(0.10, 0.48, 0.05),
-            vec3(0.16, 0.51, 0.10)
-        );
-
-
-        const vec3 shorePalette[6] = vec3[] (
-            vec3(0.32, 0.24, 0.16),
-            vec3(0.29, 0.23, 0.16),
-            vec3(0.26, 0.21, 0.15),
-            vec3(0.24, 0.20, 0.15),
-            vec3(0.21, 0.18, 0.14),
-            vec3(0.20, 0.16, 0.14)
-        );
-
-
-        const vec3 fireSlowPalette[5] = vec3[] (
-            vec3(1.00, 0.00, 0.00),
-            vec3(0.84, 0.00, 0.00),
-            vec3(0.57, 0.16, 0.04),
-            vec3(1.00, 0.46, 0.00),
-            vec3(1.00, 0.23, 0.00)
-        );
-
+// Indexes 229-254 are cycled by the animated palette
+bool animatedIndex(float index)
+{
+    int i = int(index * 255.0 + 0.5);
+    return i >= 229 && i <= 254;
+}
 
-        const vec3 fireFastPalette[5] = vec3[] (
-            vec3(0.27, 0.0, 0.0),
-            vec3(0.48, 0.0, 0.0),
-            vec3(0.70, 0.0, 0.0),
-            vec3(0.48, 0.0, 0.0),
-            vec3(0.27, 0.0, 0.0)
-        );
+// Opacity of a texel, index 0 is transparent
+float coverage(vec2 uv)
+{
+    vec4 texel = texture(tex, uv);
+    return indexed ? texel.r : texel.a;
+}
 
-    vec4 origColor = texture(tex, UV);
+void main(void)
+{
+    vec4 origColor;
+    bool animated = false;
+    if (indexed)
+    {
+        float index = texture(tex, UV).r;
+        origColor = paletteColor(index);
+        animated = animatedIndex(index);
+    }
+    else
+    {
+        origColor = texture(tex, UV);
+    }
 
     if (outline == 0)
     {
@@ -106,57 +98,10 @@ void main(void)
             }
             origColor.rgb = origColor.rgb/100*global_light;
         }
-        else
+        else if (!animated)
         {
-
-            if (origColor.a == 0.2 && origColor.r == 0.6)
-            {
-                int index = int(round(origColor.b * 255.0)) / 51;
-
-                if (index<0) index = 0;
-
-                if (origColor.g == 0.0)
-                {
-                    if (index>3) index = 3;
-                    int newIndex = (index + cnt[0]) % 4;
-                    origColor.rgb = slimePalette[newIndex];
-                }
-                else if (origColor.g == 0.2)
-                {
-                    if (index>4) index = 4;
-                    int newIndex = (index + cnt[1]) % 5;
-                    origColor.rgb = monitorsPalette[newIndex];
-                }
-                else if (origColor.g == 0.4)
-                {
-                    if (index>4) index = 4;
-                    int newIndex = (index + cnt[2]) % 5;
-                    origColor.rgb = fireSlowPalette[newIndex];
-                }
-                else if (origColor.g == 0.6)
-                {
-                    if (index>4) index = 4;
-                    int newIndex = (index + cnt[3]) % 5;
-                    origColor.rgb = fireFastPalette[newIndex];
-                }
-                else if (origColor.g == 0.8)
-                {
-                    if (index>5) index = 5;
-                    int newIndex = (index + cnt[4]) % 6;
-                    origColor.rgb = shorePalette[newIndex];
-                }
-                else if (origColor.g == 1.0)
-                {
-                    origColor.rgb = vec3((cnt[5]*4)/255.0,0,0);
-                }
-
-                origColor.a = 1.0;
-            }
-            else
-            {
-                // add light
-                origColor.rgb = origColor.rgb/100*global_light;
-            }
+            // add light, animated palette colors glow in the dark
+            origColor.rgb = origColor.rgb/100*global_light;
         }
     }
     else
@@ -180,14 +125,13 @@ void main(void)
         vec2 off = 1.0 / texSize;
         vec2 tc = UV.st;
 
-        vec4 c = texture(tex, tc);
-        vec4 n = texture(tex, vec2(tc.x, tc.y - off.y));
-        vec4 e = texture(tex, vec2(tc.x + off.x, tc.y));
-        vec4 s = texture(tex, vec2(tc.x, tc.y + off.y));
-        vec4 w = texture(tex, vec2(tc.x - off.x, tc.y));
+        float c = coverage(tc);
+        float n = coverage(vec2(tc.x, tc.y - off.y));
+        float e = coverage(vec2(tc.x + off.x, tc.y));
+        float s = coverage(vec2(tc.x, tc.y + off.y));
+        float w = coverage(vec2(tc.x - off.x, tc.y));
 
-        float ua = 0.0;
-        if (c.a == 0.0 && ( n.a != 0.0 || e.a!=0.0 || s.a!=0.0 || w.a!=0.0))
+        if (c == 0.0 && ( n != 0.0 || e != 0.0 || s != 0.0 || w != 0.0))
         {
             origColor = outlineColor;
         }
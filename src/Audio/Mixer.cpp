@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <chrono>
 #include <string>
 #include <SDL.h>
 #include "../Audio/Mixer.h"
@@ -14,6 +16,10 @@ namespace Falltergeist
 {
     namespace Audio
     {
+        const size_t Mixer::STREAM_BUFFER_SIZE;
+        const size_t Mixer::STREAM_CHUNK_SIZE;
+        const unsigned int Mixer::STREAM_INTERVAL;
+
         Mixer::Mixer()
         {
             _init();
@@ -21,16 +27,40 @@ namespace Falltergeist
 
         Mixer::~Mixer()
         {
+            if (!_enabled)
+            {
+                return;
+            }
             for (auto& x: _sfx)
             {
                 Mix_FreeChunk(x.second);
             }
             Mix_HookMusic(NULL,NULL);
+            {
+                std::lock_guard<std::mutex> lock(_streamMutex);
+                _stopStreaming = true;
+            }
+            _streamCondition.notify_one();
+            if (_streamThread.joinable())
+            {
+                _streamThread.join();
+            }
+            if (_stream.underruns() || _stream.overruns())
+            {
+                Logger::debug("AUDIO") << "stream underruns: " << _stream.underruns() << ", overruns: " << _stream.overruns() << std::endl;
+            }
             Mix_CloseAudio();
         }
 
         void Mixer::_init()
         {
+            auto settings = Game::getInstance()->settings();
+            if (!settings->audioEnabled() || settings->headless())
+            {
+                Logger::info() << "[AUDIO] - disabled, using null audio" << std::endl;
+                return;
+            }
+
             std::string message = "[AUDIO] - SDL_Init - ";
             if (SDL_InitSubSystem(SDL_INIT_AUDIO) < 0)
             {
@@ -48,109 +78,205 @@ namespace Falltergeist
             Logger::info() << message + "[OK]" << std::endl;
             int frequency, channels;
             Mix_QuerySpec(&frequency, &_format, &channels);
+            _enabled = true;
+
+            _mixBuffer.resize(Game::getInstance()->settings()->audioBufferSize() * 2);
+            _streamDecoded.resize(STREAM_CHUNK_SIZE);
+            _streamStereo.resize(STREAM_CHUNK_SIZE * 2);
+            _streamThread = std::thread(&Mixer::_streamLoop, this);
         }
 
         void Mixer::stopMusic()
         {
+            if (!_enabled) return;
             Mix_HookMusic(nullptr, nullptr);
+            _stopStream();
         }
 
-        std::function<void(void*, uint8_t*, uint32_t)> musicCallback;
+        void Mixer::_startStream(Format::Acm::File* acm, bool mono, bool loop)
+        {
+            // callback is not running once unhooked, and the streaming thread waits for the lock,
+            // so nobody touches the buffer while it's reset
+            Mix_HookMusic(NULL, NULL);
+            {
+                std::lock_guard<std::mutex> lock(_streamMutex);
+                _streamSource = acm;
+                _streamMono = mono;
+                _loop = loop;
+                _streamFinished = false;
+                _stream.reset();
+                acm->rewind();
+                // first samples are ready before playback starts
+                _fillStream();
+            }
+            _streamCondition.notify_one();
+        }
 
-        void myMusicPlayer(void *udata, uint8_t *stream, int len)
+        void Mixer::_stopStream()
         {
-            musicCallback(udata, stream, len);
+            std::lock_guard<std::mutex> lock(_streamMutex);
+            _streamSource = nullptr;
+            _stream.reset();
         }
 
-        void Mixer::_musicCallback(void *udata, uint8_t *stream, uint32_t len)
+        // streaming thread
+        void Mixer::_streamLoop()
         {
-            if (_paused) return;
+            std::unique_lock<std::mutex> lock(_streamMutex);
+            while (!_stopStreaming)
+            {
+                _fillStream();
+                _streamCondition.wait_for(lock, std::chrono::milliseconds(STREAM_INTERVAL));
+            }
+        }
 
-            auto pacm = (Format::Acm::File*)(udata);
-            if (pacm->samplesLeft() <= 0)
+        // caller must hold _streamMutex
+        void Mixer::_fillStream()
+        {
+            if (!_streamSource || _streamFinished)
+            {
+                return;
+            }
+
+            // the callback may read more meanwhile, so actual free space is never less than this
+            size_t free = _stream.capacity() - _stream.size();
+            while (free >= STREAM_CHUNK_SIZE * 2)
             {
-                if (_loop)
+                if (_streamSource->samplesLeft() <= 0)
                 {
-                    pacm->rewind();
+                    if (!_loop)
+                    {
+                        _streamFinished = true;
+                        return;
+                    }
+                    _streamSource->rewind();
+                }
+
+                size_t samples;
+                if (_streamMono)
+                {
+                    // speech is mono, buffer is always stereo
+                    size_t read = _streamSource->readSamples(_streamDecoded.data(), STREAM_CHUNK_SIZE);
+                    for (size_t i = 0; i != read; ++i)
+                    {
+                        _streamStereo[i * 2] = _streamDecoded[i];
+                        _streamStereo[i * 2 + 1] = _streamDecoded[i];
+                    }
+                    samples = read * 2;
                 }
                 else
                 {
-                    Mix_HookMusic(NULL,NULL);
+                    samples = _streamSource->readSamples(_streamStereo.data(), STREAM_CHUNK_SIZE * 2);
+                }
+
+                if (samples == 0)
+                {
+                    _streamFinished = true;
                     return;
                 }
+                free -= _stream.write(_streamStereo.data(), samples);
             }
+        }
+
+        std::function<void(void*, uint8_t*, uint32_t)> musicCallback;
+
+        void myMusicPlayer(void *udata, uint8_t *stream, int len)
+        {
+            musicCallback(udata, stream, len);
+        }
+
+        void Mixer::_musicCallback(void *udata, uint8_t *stream, uint32_t len)
+        {
+            if (_paused) return;
 
-            // music is stereo. just fetch
-            Base::Buffer<uint16_t> tmp(len / 2);
-            pacm->readSamples(tmp.data(), len / 2);
             SDL_memset(stream, 0, len);
-            SDL_MixAudioFormat(stream, (uint8_t*)tmp.data(), _format, len, static_cast<int>(SDL_MIX_MAXVOLUME * _musicVolume));
+            size_t samples = len / 2;
+            size_t done = 0;
+            while (done < samples)
+            {
+                size_t read = _stream.read(_mixBuffer.data(), std::min(samples - done, _mixBuffer.size()));
+                if (read == 0)
+                {
+                    break;
+                }
+                SDL_MixAudioFormat(stream + done * 2, (uint8_t*)_mixBuffer.data(), _format, static_cast<uint32_t>(read * 2),
+                                   static_cast<int>(SDL_MIX_MAXVOLUME * _musicVolume));
+                done += read;
+            }
+
+            if (done < samples && _streamFinished)
+            {
+                Mix_HookMusic(NULL,NULL);
+            }
         }
 
         void Mixer::playACMMusic(const std::string& filename, bool loop)
         {
+            if (!_enabled) return;
             Mix_HookMusic(NULL, NULL);
             auto acm = ResourceManager::getInstance()->acmFileType(Game::getInstance()->settings()->musicPath()+filename);
             if (!acm) return;
             _lastMusic = filename;
-            _loop = loop;
+            _startStream(acm, false, loop);
             musicCallback = std::bind(&Mixer::_musicCallback, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
-            acm->rewind();
-            Mix_HookMusic(myMusicPlayer, (void *)acm);
+            Mix_HookMusic(myMusicPlayer, nullptr);
         }
 
         void Mixer::_speechCallback(void *udata, uint8_t *stream, uint32_t len)
         {
             if (_paused) return;
 
-            auto pacm = (Format::Acm::File*)(udata);
-            if (pacm->samplesLeft() <= 0)
-            {
-                Mix_HookMusic(NULL,NULL);
-                return;
-            }
-
-            Base::Buffer<uint16_t> tmp(len / 2);
-            uint16_t* sstr = (uint16_t*)stream;
-            pacm->readSamples(tmp.data(), len / 4);
-            for (size_t i = 0; i < len / 4; i++)
+            // already converted to stereo by the streaming thread
+            size_t samples = len / 2;
+            size_t read = _stream.read((uint16_t*)stream, samples);
+            if (read < samples)
             {
-                sstr[i*2] = tmp[i];
-                sstr[i*2 + 1] = tmp[i];
+                SDL_memset(stream + read * 2, 0, (samples - read) * 2);
+                if (_streamFinished)
+                {
+                    Mix_HookMusic(NULL,NULL);
+                }
             }
         }
 
         void Mixer::playACMSpeech(const std::string& filename)
         {
+            if (!_enabled) return;
             Mix_HookMusic(NULL, NULL);
             auto acm = ResourceManager::getInstance()->acmFileType("sound/speech/"+filename);
             if (!acm) return;
+            _startStream(acm, true, false);
             musicCallback = std::bind(&Mixer::_speechCallback, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
-            acm->rewind();
-            Mix_HookMusic(myMusicPlayer, (void *)acm);
+            Mix_HookMusic(myMusicPlayer, nullptr);
         }
 
         void Mixer::_movieCallback(void *udata, uint8_t *stream, uint32_t len)
         {
             auto pmve = (UI::MvePlayer*)(udata);
-            if (pmve->samplesLeft() <= 0)
+            uint32_t samples = pmve->getAudio(stream, len);
+            if (samples < len / 2)
             {
-                Logger::debug("AUDIO") << "buffer underrun?" << std::endl;
-                Mix_HookMusic(NULL, NULL);
-                return;
+                // decoder is late (or playback hasn't started yet): play silence instead of dropping the movie sound
+                SDL_memset(stream + samples * 2, 0, len - samples * 2);
+                if (pmve->audioFinished() && pmve->samplesLeft() == 0)
+                {
+                    Mix_HookMusic(NULL, NULL);
+                }
             }
-
-            pmve->getAudio(stream, len);
         }
 
         void Mixer::playMovieMusic(UI::MvePlayer* mve)
         {
+            if (!_enabled) return;
+            Mix_HookMusic(NULL, NULL);
+            _stopStream();
             musicCallback = std::bind(&Mixer::_movieCallback,this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
             Mix_HookMusic(myMusicPlayer, reinterpret_cast<void *>(mve));
         }
 
         void Mixer::playACMSound(const std::string& filename)
         {
+            if (!_enabled) return;
             auto acm = ResourceManager::getInstance()->acmFileType(filename);
             if (!acm) return;
             Logger::debug("Mixer") << "playing: " << acm->filename() << std::endl;
@@ -192,6 +318,7 @@ namespace Falltergeist
 
         void Mixer::stopSounds()
         {
+            if (!_enabled) return;
             Mix_HaltChannel(-1);
         }
 
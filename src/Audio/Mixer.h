@@ -1,18 +1,36 @@
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
 #include <cstdint>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 #include <SDL_mixer.h>
+#include "../Audio/RingBuffer.h"
 
 namespace Falltergeist
 {
+    namespace Format
+    {
+        namespace Acm
+        {
+            class File;
+        }
+    }
     namespace UI
     {
         class MvePlayer;
     }
     namespace Audio
     {
+        /**
+         * Streamed sources (music, speech and movie sound) are decoded outside of the audio thread into lock-free
+         * ring buffers: music and speech on a streaming thread of the mixer, movie sound on the movie decoder thread.
+         * Audio callbacks only copy samples out, so they never decode, allocate or wait for a lock.
+         */
         class Mixer
         {
             public:
@@ -38,13 +56,42 @@ namespace Falltergeist
                 void setMusicVolume(double volume);
 
             private:
+                // streamed samples, one second of stereo
+                static const size_t STREAM_BUFFER_SIZE = 22050 * 2;
+                // samples decoded at once by the streaming thread
+                static const size_t STREAM_CHUNK_SIZE = 4096;
+                // how often the streaming thread tops up the buffer, in milliseconds
+                static const unsigned int STREAM_INTERVAL = 20;
+
                 void _init();
+                void _startStream(Format::Acm::File* acm, bool mono, bool loop);
+                void _stopStream();
+                void _streamLoop();
+                void _fillStream();
                 void _musicCallback(void* udata, uint8_t* stream, uint32_t len);
                 void _speechCallback(void* udata, uint8_t* stream, uint32_t len);
                 void _movieCallback(void* udata, uint8_t* stream, uint32_t len);
                 std::unordered_map<std::string, Mix_Chunk*> _sfx;
-                bool _paused = false;
+                // false when audio is disabled in settings or the game runs headless
+                bool _enabled = false;
+                std::atomic<bool> _paused{false};
+
+                RingBuffer<uint16_t> _stream{STREAM_BUFFER_SIZE};
+                std::thread _streamThread;
+                // guards the source fields below, held by the streaming thread while it decodes
+                std::mutex _streamMutex;
+                std::condition_variable _streamCondition;
+                Format::Acm::File* _streamSource = nullptr;
+                bool _streamMono = false;
                 bool _loop = false;
+                bool _stopStreaming = false;
+                // source has no more samples, callback stops once the buffer is drained
+                std::atomic<bool> _streamFinished{false};
+                // streaming thread only
+                std::vector<uint16_t> _streamDecoded;
+                std::vector<uint16_t> _streamStereo;
+                // audio thread only
+                std::vector<uint16_t> _mixBuffer;
 
                 double _musicVolume = 1.0;
                 SDL_AudioFormat _format;
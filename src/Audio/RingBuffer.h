@@ -0,0 +1,115 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace Falltergeist
+{
+    namespace Audio
+    {
+        /**
+         * Lock-free single-producer/single-consumer ring buffer for streamed audio samples.
+         * One thread writes (decoder), another one reads (audio callback); neither ever blocks or allocates.
+         * Reads and writes are at most two memcpy calls. Writes which don't fit drop the samples that don't fit,
+         * reads which can't be satisfied return what is there; both cases are counted.
+         */
+        template <typename T>
+        class RingBuffer final
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "RingBuffer supports trivially copyable types only");
+
+            public:
+                explicit RingBuffer(size_t capacity) : _data(std::max<size_t>(capacity, 1))
+                {
+                }
+
+                RingBuffer(const RingBuffer&) = delete;
+                RingBuffer& operator=(const RingBuffer&) = delete;
+
+                size_t capacity() const
+                {
+                    return _data.size();
+                }
+
+                // Number of items ready to be read. Exact for the consumer, a lower bound for the producer.
+                size_t size() const
+                {
+                    return _writePosition.load(std::memory_order_acquire) - _readPosition.load(std::memory_order_acquire);
+                }
+
+                // Producer only. Returns number of items written.
+                size_t write(const T* data, size_t count)
+                {
+                    size_t writePosition = _writePosition.load(std::memory_order_relaxed);
+                    size_t free = capacity() - (writePosition - _readPosition.load(std::memory_order_acquire));
+                    if (count > free)
+                    {
+                        _overruns.fetch_add(1, std::memory_order_relaxed);
+                        count = free;
+                    }
+
+                    size_t offset = writePosition % capacity();
+                    size_t first = std::min(count, capacity() - offset);
+                    std::memcpy(_data.data() + offset, data, first * sizeof(T));
+                    std::memcpy(_data.data(), data + first, (count - first) * sizeof(T));
+
+                    _writePosition.store(writePosition + count, std::memory_order_release);
+                    return count;
+                }
+
+                // Consumer only. Returns number of items read.
+                size_t read(T* data, size_t count)
+                {
+                    size_t readPosition = _readPosition.load(std::memory_order_relaxed);
+                    size_t available = _writePosition.load(std::memory_order_acquire) - readPosition;
+                    if (count > available)
+                    {
+                        _underruns.fetch_add(1, std::memory_order_relaxed);
+                        count = available;
+                    }
+
+                    size_t offset = readPosition % capacity();
+                    size_t first = std::min(count, capacity() - offset);
+                    std::memcpy(data, _data.data() + offset, first * sizeof(T));
+                    std::memcpy(data + first, _data.data(), (count - first) * sizeof(T));
+
+                    _readPosition.store(readPosition + count, std::memory_order_release);
+                    return count;
+                }
+
+                // Drops all items. Neither producer nor consumer may be running at the same time.
+                void reset()
+                {
+                    _readPosition.store(0, std::memory_order_relaxed);
+                    _writePosition.store(0, std::memory_order_relaxed);
+                }
+
+                // Reads which got less than requested
+                uint32_t underruns() const
+                {
+                    return _underruns.load(std::memory_order_relaxed);
+                }
+
+                // Writes which didn't fit
+                uint32_t overruns() const
+                {
+                    return _overruns.load(std::memory_order_relaxed);
+                }
+
+            private:
+                std::vector<T> _data;
+                // positions only grow, index into the buffer is position % capacity
+                // padding keeps producer and consumer positions on separate cache lines
+                std::atomic<size_t> _readPosition{0};
+                char _padding[64];
+                std::atomic<size_t> _writePosition{0};
+                std::atomic<uint32_t> _underruns{0};
+                std::atomic<uint32_t> _overruns{0};
+        };
+    }
+}
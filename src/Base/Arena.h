@@ -0,0 +1,165 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../Logger.h"
+
+namespace Falltergeist
+{
+    namespace Base
+    {
+        // Monotonic allocator for data which lives as long as a location: its tiles and game objects.
+        // Allocating bumps a pointer inside a big chunk, so data loaded together lies together in memory.
+        // Deallocating does nothing; all chunks are released at once when the arena is destroyed.
+        // Owner of the arena must destroy everything placed in it first. If anything acquired is still alive
+        // when the arena is destroyed, the chunks are leaked instead of freed, so the survivors stay valid.
+        class Arena
+        {
+            public:
+                explicit Arena(size_t chunkSize = 64 * 1024) : _chunkSize(chunkSize)
+                {
+                }
+
+                ~Arena()
+                {
+                    if (_live != 0)
+                    {
+                        Logger::error("ARENA") << "Arena destroyed while " << _live << " objects allocated in it are still alive, "
+                                               << _chunks.size() << " chunks are leaked" << std::endl;
+                        for (auto& chunk : _chunks)
+                        {
+                            chunk.release();
+                        }
+                    }
+                }
+
+                Arena(const Arena&) = delete;
+                Arena& operator= (const Arena&) = delete;
+
+                // Returns uninitialized memory aligned to a given power of two.
+                void* allocate(size_t size, size_t alignment)
+                {
+                    void* result = _current;
+                    if (!result || !std::align(alignment, size, result, _left))
+                    {
+                        // allocations which don't fit a chunk get a chunk of their own
+                        size_t chunkSize = std::max(_chunkSize, size + alignment);
+                        _chunks.emplace_back(new char[chunkSize]);
+                        result = _chunks.back().get();
+                        _left = chunkSize;
+                        std::align(alignment, size, result, _left);
+                    }
+                    _current = static_cast<char*>(result) + size;
+                    _left -= size;
+                    _allocated += size;
+                    return result;
+                }
+
+                // Constructs an object in the arena. Its destructor is never called, so only trivially destructible types are allowed.
+                template <typename T, typename... Args>
+                T* create(Args&&... args)
+                {
+                    static_assert(std::is_trivially_destructible<T>::value, "Arena::create() - type must be trivially destructible");
+                    return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+                }
+
+                // Allocation which is given back with release(), counted to catch objects that outlive the arena.
+                void* acquire(size_t size, size_t alignment)
+                {
+                    ++_live;
+                    return allocate(size, alignment);
+                }
+
+                // Memory itself is reused only after the whole arena is released.
+                void release()
+                {
+                    assert(_live != 0);
+                    --_live;
+                }
+
+                size_t allocated() const
+                {
+                    return _allocated;
+                }
+
+                // Allocations acquired and not released yet
+                size_t live() const
+                {
+                    return _live;
+                }
+
+                size_t chunks() const
+                {
+                    return _chunks.size();
+                }
+
+            private:
+                size_t _chunkSize;
+                std::vector<std::unique_ptr<char[]>> _chunks;
+                void* _current = nullptr;
+                size_t _left = 0;
+                size_t _allocated = 0;
+                size_t _live = 0;
+        };
+
+        // Standard allocator over an Arena, meant for std::allocate_shared.
+        // It doesn't own the arena: whatever is allocated with it must be destroyed before the arena is.
+        template <typename T>
+        class ArenaAllocator
+        {
+            public:
+                using value_type = T;
+
+                template <typename U>
+                struct rebind
+                {
+                    using other = ArenaAllocator<U>;
+                };
+
+                ArenaAllocator(Arena* arena) : _arena(arena)
+                {
+                }
+
+                template <typename U>
+                ArenaAllocator(const ArenaAllocator<U>& other) : _arena(other.arena())
+                {
+                }
+
+                T* allocate(size_t count)
+                {
+                    return static_cast<T*>(_arena->acquire(sizeof(T) * count, alignof(T)));
+                }
+
+                void deallocate(T*, size_t)
+                {
+                    _arena->release();
+                }
+
+                Arena* arena() const
+                {
+                    return _arena;
+                }
+
+                template <typename U>
+                bool operator== (const ArenaAllocator<U>& other) const
+                {
+                    return _arena == other.arena();
+                }
+
+                template <typename U>
+                bool operator!= (const ArenaAllocator<U>& other) const
+                {
+                    return _arena != other.arena();
+                }
+
+            private:
+                Arena* _arena;
+        };
+    }
+}
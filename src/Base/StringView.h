@@ -0,0 +1,163 @@
+#pragma once
+
+#include <cctype>
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <string>
+
+namespace Falltergeist
+{
+    namespace Base
+    {
+        // Non-owning reference to a range of characters, a minimal stand-in for C++17 std::string_view.
+        // Viewed characters must outlive the view.
+        class StringView
+        {
+            public:
+                static const size_t npos = static_cast<size_t>(-1);
+
+                StringView() : _data(""), _size(0)
+                {
+                }
+
+                StringView(const char* data, size_t size) : _data(data), _size(size)
+                {
+                }
+
+                StringView(const char* str) : _data(str), _size(std::strlen(str))
+                {
+                }
+
+                StringView(const std::string& str) : _data(str.data()), _size(str.size())
+                {
+                }
+
+                const char* data() const
+                {
+                    return _data;
+                }
+
+                size_t size() const
+                {
+                    return _size;
+                }
+
+                bool empty() const
+                {
+                    return _size == 0;
+                }
+
+                const char* begin() const
+                {
+                    return _data;
+                }
+
+                const char* end() const
+                {
+                    return _data + _size;
+                }
+
+                // No bounds checking is performed.
+                char operator[] (size_t index) const
+                {
+                    return _data[index];
+                }
+
+                char front() const
+                {
+                    return _data[0];
+                }
+
+                char back() const
+                {
+                    return _data[_size - 1];
+                }
+
+                // Characters [position, position + count), clamped to the end of the view
+                StringView substr(size_t position, size_t count = npos) const
+                {
+                    if (position > _size)
+                    {
+                        position = _size;
+                    }
+                    if (count > _size - position)
+                    {
+                        count = _size - position;
+                    }
+                    return StringView(_data + position, count);
+                }
+
+                size_t find(char chr, size_t position = 0) const
+                {
+                    if (position >= _size)
+                    {
+                        return npos;
+                    }
+                    auto found = static_cast<const char*>(std::memchr(_data + position, chr, _size - position));
+                    return found ? static_cast<size_t>(found - _data) : npos;
+                }
+
+                size_t findFirstOf(const char* chars, size_t position = 0) const
+                {
+                    for (size_t i = position; i < _size; ++i)
+                    {
+                        if (std::strchr(chars, _data[i]))
+                        {
+                            return i;
+                        }
+                    }
+                    return npos;
+                }
+
+                StringView ltrimmed() const
+                {
+                    size_t start = 0;
+                    while (start != _size && std::isspace(static_cast<unsigned char>(_data[start])))
+                    {
+                        ++start;
+                    }
+                    return StringView(_data + start, _size - start);
+                }
+
+                StringView rtrimmed() const
+                {
+                    size_t size = _size;
+                    while (size != 0 && std::isspace(static_cast<unsigned char>(_data[size - 1])))
+                    {
+                        --size;
+                    }
+                    return StringView(_data, size);
+                }
+
+                StringView trimmed() const
+                {
+                    return ltrimmed().rtrimmed();
+                }
+
+                std::string str() const
+                {
+                    return std::string(_data, _size);
+                }
+
+                bool operator== (StringView other) const
+                {
+                    return _size == other._size && std::memcmp(_data, other._data, _size) == 0;
+                }
+
+                bool operator!= (StringView other) const
+                {
+                    return !(*this == other);
+                }
+
+            private:
+                const char* _data;
+                size_t _size;
+        };
+
+        inline std::ostream& operator <<(std::ostream& stream, StringView value)
+        {
+            return stream.write(value.data(), static_cast<std::streamsize>(value.size()));
+        }
+    }
+}
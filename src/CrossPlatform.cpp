@@ -364,6 +364,35 @@ namespace Falltergeist
         return false;
     }
 
+    bool CrossPlatform::fileInfo(const std::string& file, uint64_t& size, int64_t& modified)
+    {
+    #if defined(__unix__) || defined(__APPLE__) // Linux, OS X, BSD
+        struct stat st;
+
+        if (stat(file.c_str(), &st) != 0)
+        {
+            return false;
+        }
+        size = static_cast<uint64_t>(st.st_size);
+        modified = static_cast<int64_t>(st.st_mtime);
+        return true;
+    #elif defined(_WIN32) || defined(WIN32) // Windows
+        WIN32_FILE_ATTRIBUTE_DATA attrs;
+
+        if (!GetFileAttributesEx(file.c_str(), GetFileExInfoStandard, &attrs))
+        {
+            return false;
+        }
+        size = (static_cast<uint64_t>(attrs.nFileSizeHigh) << 32) | attrs.nFileSizeLow;
+        // FILETIME counts 100 ns intervals since 1601
+        uint64_t time = (static_cast<uint64_t>(attrs.ftLastWriteTime.dwHighDateTime) << 32) | attrs.ftLastWriteTime.dwLowDateTime;
+        modified = static_cast<int64_t>(time / 10000000ULL) - 11644473600LL;
+        return true;
+    #else
+        #error Platform not supported: CrossPlatform::fileInfo not implemented
+    #endif
+    }
+
     std::string CrossPlatform::getConfigPath()
     {
     #if defined(__unix__)
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <list>
 #include <string>
 #include <vector>
@@ -25,6 +26,9 @@ namespace Falltergeist
 
             static bool fileExists(std::string file);
 
+            // Size and last modification time (seconds since epoch) of a file, returns false if it can't be queried
+            static bool fileInfo(const std::string& file, uint64_t& size, int64_t& modified);
+
         protected:
             CrossPlatform() = default;
             ~CrossPlatform() = default;
@@ -1,4 +1,4 @@
-#include "../../Format/Dat/Stream.h"
+#include "../../Format/Dat/BinaryReader.h"
 #include "../../Format/Aaf/File.h"
 
 namespace Falltergeist
@@ -9,20 +9,20 @@ namespace Falltergeist
         {
             File::File(Dat::Stream&& stream)
             {
-                stream.setPosition(0);
+                Dat::BigEndianReader reader(stream.data(), stream.size());
 
-                _signature     = stream.uint32(); // should be "AAFF"
-                _maximumHeight = stream.uint16();
-                _horizontalGap = stream.uint16();
-                _spaceWidth    = stream.uint16();
-                _verticalGap   = stream.uint16();
+                _signature     = reader.uint32(); // should be "AAFF"
+                _maximumHeight = reader.uint16();
+                _horizontalGap = reader.uint16();
+                _spaceWidth    = reader.uint16();
+                _verticalGap   = reader.uint16();
 
                 // Glyphs info
                 for (unsigned i = 0; i != 256; ++i)
                 {
-                    uint16_t width  = stream.uint16();
-                    uint16_t height = stream.uint16();
-                    uint32_t offset = stream.uint32();
+                    uint16_t width  = reader.uint16();
+                    uint16_t height = reader.uint16();
+                    uint32_t offset = reader.uint32();
 
                     if (width > _maximumWidth)
                     {
@@ -33,14 +33,13 @@ namespace Falltergeist
                     _glyphs.back().setDataOffset(offset);
                 }
 
-                _loadRgba(stream);
+                _loadAlpha(reader);
             }
 
-            void File::_loadRgba(Dat::Stream& stream)
+            void File::_loadAlpha(Dat::BigEndianReader& reader)
             {
-                //_rgba = new uint32_t[_maximumWidth * _maximumHeight * 256]();
                 // leave 1 px around glyph
-                _rgba.resize((_maximumWidth + 2) * 16 * (_maximumHeight + 2) * 16);
+                _alpha.resize((_maximumWidth + 2) * 16 * (_maximumHeight + 2) * 16);
 
                 for (unsigned i = 0; i != 256; ++i)
                 {
@@ -50,13 +49,13 @@ namespace Falltergeist
                     // Move glyph to bottom
                     glyphY += _maximumHeight - _glyphs.at(i).height();
 
-                    stream.setPosition(0x080C + _glyphs.at(i).dataOffset());
+                    reader.setPosition(0x080C + _glyphs.at(i).dataOffset());
 
                     for (uint16_t y = 0; y != _glyphs.at(i).height(); ++y)
                     {
                         for (uint16_t x = 0; x != _glyphs.at(i).width(); ++x)
                         {
-                            uint8_t byte = stream.uint8();
+                            uint8_t byte = reader.uint8();
                             if (byte != 0)
                             {
                                 uint8_t alpha = 0;
@@ -86,16 +85,16 @@ namespace Falltergeist
                                         break;
                                 }
 
-                                _rgba[(glyphY + y)*((_maximumWidth+2)*16)  + glyphX + x] = 0xFFFFFF00 | alpha;
+                                _alpha[(glyphY + y)*((_maximumWidth+2)*16)  + glyphX + x] = alpha;
                             }
                         }
                     }
                 }
             }
 
-            uint32_t* File::rgba()
+            uint8_t* File::alpha()
             {
-                return _rgba.data();
+                return _alpha.data();
             }
 
             const std::vector<Glyph>& File::glyphs() const
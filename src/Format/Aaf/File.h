@@ -5,6 +5,7 @@
 #include <memory>
 #include <vector>
 #include "../../Format/Aaf/Glyph.h"
+#include "../../Format/Dat/BinaryReader.h"
 #include "../../Format/Dat/Item.h"
 
 namespace Falltergeist
@@ -23,7 +24,8 @@ namespace Falltergeist
                 public:
                     File(Dat::Stream&& stream);
 
-                    uint32_t* rgba();
+                    // Glyph atlas coverage, 8 bits per pixel
+                    uint8_t* alpha();
 
                     const std::vector<Glyph>& glyphs() const;
 
@@ -41,9 +43,9 @@ namespace Falltergeist
                     uint16_t _horizontalGap = 0;
                     uint16_t _spaceWidth = 0;
                     uint16_t _verticalGap = 0;
-                    std::vector<uint32_t> _rgba;
+                    std::vector<uint8_t> _alpha;
 
-                    void _loadRgba(Dat::Stream& stream);
+                    void _loadAlpha(Dat::BigEndianReader& reader);
             };
         }
     }
@@ -7,6 +7,7 @@
 #include "../Acm/Decoder.h"
 #include "../Acm/General.h"
 #include "../Acm/Unpacker.h"
+#include "../Dat/BinaryReader.h"
 #include "../../Exception.h"
 
 namespace Falltergeist
@@ -19,18 +20,20 @@ namespace Falltergeist
 
             File::File(Dat::Stream&& stream) : _stream(std::move(stream))
             {
-                _stream.setPosition(0);
-                _stream.setEndianness(ENDIANNESS::LITTLE);
                 _samplesReady = 0;
 
+                Dat::LittleEndianReader reader(_stream.data(), _stream.size());
+
                 Header hdr;
-                _stream >> hdr.signature;
-                _stream >> hdr.samples;
-                _stream >> hdr.channels;
-                _stream >> hdr.rate;
+                reader >> hdr.signature;
+                reader >> hdr.samples;
+                reader >> hdr.channels;
+                reader >> hdr.rate;
+
+                int16_t tmpword = reader.int16();
 
-                int16_t tmpword;
-                _stream.readBytes((uint8_t*)&tmpword, 2);
+                // the rest of the file is a bit stream consumed by the unpacker
+                _stream.setPosition(HEADER_SIZE);
                 _subblocks = (int32_t) (tmpword >> 4);
                 _levels = (int32_t) (tmpword&15);
 
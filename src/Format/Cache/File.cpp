@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include "../../CrossPlatform.h"
+#include "../../Exception.h"
+#include "../../Format/Cache/File.h"
+#include "../../Format/Cache/Writer.h"
+#include "../../Logger.h"
+#include "zlib.h"
+
+namespace Falltergeist
+{
+    namespace Format
+    {
+        namespace Cache
+        {
+            const char File::MAGIC[4] = {'F', 'G', 'T', 'C'};
+            // bump whenever layout of any cached structure changes
+            const uint32_t File::VERSION = 2;
+
+            File::File(const std::string& path, const Key& key) : _path(path), _key(key)
+            {
+            }
+
+            bool File::load()
+            {
+                std::ifstream stream(_path, std::ios_base::in | std::ios_base::binary | std::ios_base::ate);
+                if (!stream.is_open())
+                {
+                    return false;
+                }
+                auto size = static_cast<size_t>(stream.tellg());
+                stream.seekg(0, std::ios::beg);
+                _data.resize(size);
+                if (!stream.read(reinterpret_cast<char*>(_data.data()), size))
+                {
+                    return false;
+                }
+
+                try
+                {
+                    Reader header(_data.data(), _data.size());
+                    char magic[sizeof(MAGIC)];
+                    header.readBytes(reinterpret_cast<uint8_t*>(magic), sizeof(magic));
+                    if (std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || header.uint32() != VERSION)
+                    {
+                        return false;
+                    }
+                    if (header.string() != _key.source
+                        || header.uint32() != _key.offset
+                        || header.uint32() != _key.size
+                        || header.uint32() != static_cast<uint32_t>(_key.sourceSize)
+                        || header.uint32() != static_cast<uint32_t>(_key.sourceSize >> 32)
+                        || header.uint32() != static_cast<uint32_t>(_key.sourceModified)
+                        || header.uint32() != static_cast<uint32_t>(static_cast<uint64_t>(_key.sourceModified) >> 32))
+                    {
+                        Logger::info("CACHE") << _key.filename << ": source data changed, rebuilding cache" << std::endl;
+                        return false;
+                    }
+                    size_t payloadSize = header.uint32();
+                    uint32_t payloadCrc = header.uint32();
+                    if (payloadSize != header.bytesRemains() || crc32(_data.data() + header.position(), payloadSize) != payloadCrc)
+                    {
+                        Logger::warning("CACHE") << _key.filename << ": cache file is damaged: " << _path << std::endl;
+                        return false;
+                    }
+                    _payloadOffset = header.position();
+                }
+                catch (const Exception&)
+                {
+                    Logger::warning("CACHE") << _key.filename << ": cache file is truncated: " << _path << std::endl;
+                    return false;
+                }
+                return true;
+            }
+
+            Reader File::reader() const
+            {
+                return Reader(_data.data() + _payloadOffset, _data.size() - _payloadOffset);
+            }
+
+            void File::save(const Writer& payload)
+            {
+                Writer header;
+                header.writeBytes(reinterpret_cast<const uint8_t*>(MAGIC), sizeof(MAGIC));
+                header.writeUint32(VERSION);
+                header.writeString(_key.source);
+                header.writeUint32(_key.offset);
+                header.writeUint32(_key.size);
+                // 64-bit values as low and high halves
+                header.writeUint32(static_cast<uint32_t>(_key.sourceSize));
+                header.writeUint32(static_cast<uint32_t>(_key.sourceSize >> 32));
+                header.writeUint32(static_cast<uint32_t>(_key.sourceModified));
+                header.writeUint32(static_cast<uint32_t>(static_cast<uint64_t>(_key.sourceModified) >> 32));
+                header.writeCount(payload.data().size());
+                header.writeUint32(crc32(payload.data().data(), payload.data().size()));
+
+                try
+                {
+                    CrossPlatform::createDirectory(_path.substr(0, _path.find_last_of('/')));
+                }
+                catch (const std::runtime_error& e)
+                {
+                    Logger::warning("CACHE") << "Can't create cache directory: " << e.what() << std::endl;
+                    return;
+                }
+
+                std::ofstream stream(_path, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+                stream.write(reinterpret_cast<const char*>(header.data().data()), header.data().size());
+                stream.write(reinterpret_cast<const char*>(payload.data().data()), payload.data().size());
+                if (!stream)
+                {
+                    Logger::warning("CACHE") << "Can't write cache file: " << _path << std::endl;
+                }
+            }
+
+            uint32_t File::crc32(const uint8_t* data, size_t size)
+            {
+                uLong crc = ::crc32(0L, Z_NULL, 0);
+                // zlib takes uInt lengths
+                while (size > 0)
+                {
+                    uInt chunk = static_cast<uInt>(std::min<size_t>(size, 1u << 30));
+                    crc = ::crc32(crc, data, chunk);
+                    data += chunk;
+                    size -= chunk;
+                }
+                return static_cast<uint32_t>(crc);
+            }
+        }
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../../Format/Cache/Reader.h"
+
+namespace Falltergeist
+{
+    namespace Format
+    {
+        namespace Cache
+        {
+            class Writer;
+
+            /**
+             * Identifies source data a cache file was built from.
+             * Location (DAT file or data directory, offset of the entry and its packed size) and size and modification time
+             * of the DAT or loose file all have to match, so a cache becomes stale by itself as soon as the source changes.
+             * Nothing of it requires reading the entry, a cache hit never unpacks the source data.
+             */
+            struct Key
+            {
+                std::string filename;
+                std::string source;
+                uint32_t offset = 0;
+                uint32_t size = 0;
+                uint64_t sourceSize = 0;
+                int64_t sourceModified = 0;
+            };
+
+            /**
+             * @brief Binary cache of one fully parsed resource file.
+             * Layout: header ("FGTC", version, key, payload size, payload CRC-32) followed by the payload written by the resource itself.
+             * The whole file is read with one call and validated before the payload is handed out.
+             */
+            class File
+            {
+                public:
+                    static const char MAGIC[4];
+                    static const uint32_t VERSION;
+
+                    File(const std::string& path, const Key& key);
+
+                    /**
+                     * Reads cache file. Returns false if it doesn't exist, is damaged or was built from different source data.
+                     */
+                    bool load();
+
+                    /**
+                     * Reader over the payload of a loaded cache file, valid while the File lives.
+                     */
+                    Reader reader() const;
+
+                    /**
+                     * Writes payload with a fresh header. Failures are logged, the cache is an optimization only.
+                     */
+                    void save(const Writer& payload);
+
+                    static uint32_t crc32(const uint8_t* data, size_t size);
+
+                private:
+                    std::string _path;
+                    Key _key;
+                    std::vector<uint8_t> _data;
+                    size_t _payloadOffset = 0;
+            };
+        }
+    }
+}
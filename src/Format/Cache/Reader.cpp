@@ -0,0 +1,42 @@
+#include "../../Exception.h"
+#include "../../Format/Cache/Reader.h"
+
+namespace Falltergeist
+{
+    namespace Format
+    {
+        namespace Cache
+        {
+            Reader::Reader(const uint8_t* data, size_t size) : Dat::LittleEndianReader(data, size)
+            {
+            }
+
+            bool Reader::boolean()
+            {
+                return uint8() != 0;
+            }
+
+            size_t Reader::count()
+            {
+                size_t value = uint32();
+                // every element takes at least one byte
+                if (value > bytesRemains())
+                {
+                    throw Exception("Cache::Reader::count() - count is out of range: " + std::to_string(value));
+                }
+                return value;
+            }
+
+            std::string Reader::string()
+            {
+                size_t size = count();
+                std::string value(size, '\0');
+                if (size != 0)
+                {
+                    readBytes(reinterpret_cast<uint8_t*>(&value[0]), size);
+                }
+                return value;
+            }
+        }
+    }
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "../../Format/Dat/BinaryReader.h"
+
+namespace Falltergeist
+{
+    namespace Format
+    {
+        namespace Cache
+        {
+            /**
+             * Reads structures written by Cache::Writer. All reads are bounds checked and throw Exception on truncated data,
+             * so a damaged cache file is rejected instead of producing garbage.
+             */
+            class Reader : public Dat::LittleEndianReader
+            {
+                public:
+                    Reader(const uint8_t* data, size_t size);
+
+                    bool boolean();
+                    // Number of elements of a following container, checked against the remaining data
+                    size_t count();
+                    std::string string();
+            };
+        }
+    }
+}
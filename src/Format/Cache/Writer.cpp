@@ -0,0 +1,60 @@
+#include "../../Format/Cache/Writer.h"
+
+namespace Falltergeist
+{
+    namespace Format
+    {
+        namespace Cache
+        {
+            Writer& Writer::writeUint8(uint8_t value)
+            {
+                _data.push_back(value);
+                return *this;
+            }
+
+            Writer& Writer::writeUint16(uint16_t value)
+            {
+                writeUint8(static_cast<uint8_t>(value & 0xFF));
+                return writeUint8(static_cast<uint8_t>(value >> 8));
+            }
+
+            Writer& Writer::writeUint32(uint32_t value)
+            {
+                writeUint16(static_cast<uint16_t>(value & 0xFFFF));
+                return writeUint16(static_cast<uint16_t>(value >> 16));
+            }
+
+            Writer& Writer::writeInt32(int32_t value)
+            {
+                return writeUint32(static_cast<uint32_t>(value));
+            }
+
+            Writer& Writer::writeBool(bool value)
+            {
+                return writeUint8(value ? 1 : 0);
+            }
+
+            Writer& Writer::writeCount(size_t value)
+            {
+                return writeUint32(static_cast<uint32_t>(value));
+            }
+
+            Writer& Writer::writeString(const std::string& value)
+            {
+                writeCount(value.size());
+                return writeBytes(reinterpret_cast<const uint8_t*>(value.data()), value.size());
+            }
+
+            Writer& Writer::writeBytes(const uint8_t* data, size_t size)
+            {
+                _data.insert(_data.end(), data, data + size);
+                return *this;
+            }
+
+            const std::vector<uint8_t>& Writer::data() const
+            {
+                return _data;
+            }
+        }
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Falltergeist
+{
+    namespace Format
+    {
+        namespace Cache
+        {
+            /**
+             * Serializes parsed resource structures into a flat little-endian byte buffer, read back by Cache::Reader.
+             */
+            class Writer
+            {
+                public:
+                    Writer& writeUint8(uint8_t value);
+                    Writer& writeUint16(uint16_t value);
+                    Writer& writeUint32(uint32_t value);
+                    Writer& writeInt32(int32_t value);
+                    Writer& writeBool(bool value);
+                    // Number of elements of a following container
+                    Writer& writeCount(size_t value);
+                    // Length followed by characters, no terminating zero
+                    Writer& writeString(const std::string& value);
+                    Writer& writeBytes(const uint8_t* data, size_t size);
+
+                    const std::vector<uint8_t>& data() const;
+
+                private:
+                    std::vector<uint8_t> _data;
+            };
+        }
+    }
+}
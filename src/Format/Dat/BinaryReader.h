@@ -0,0 +1,177 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "../../Exception.h"
+#include "../../Format/Dat/Stream.h"
+#include "../../Format/Enums.h"
+
+namespace Falltergeist
+{
+    namespace Format
+    {
+        namespace Dat
+        {
+            // Non-virtual read cursor over a contiguous byte span (usually the buffer of a Dat::Stream).
+            // Byte order is a template parameter, so every read compiles down to a load plus an optional byte swap.
+            // The span must outlive the reader.
+            template <ENDIANNESS E>
+            class BinaryReader
+            {
+                public:
+                    BinaryReader(const uint8_t* data, size_t size) : _begin(data), _cursor(data), _end(data + size)
+                    {
+                    }
+
+                    // Starts reading at the current position of the stream
+                    explicit BinaryReader(const Stream& stream) : BinaryReader(stream.data(), stream.size())
+                    {
+                        _cursor = _begin + stream.position();
+                    }
+
+                    size_t position() const
+                    {
+                        return static_cast<size_t>(_cursor - _begin);
+                    }
+
+                    BinaryReader& setPosition(size_t position)
+                    {
+                        if (position > size()) {
+                            throw Exception("BinaryReader::setPosition() - position is out of range: " + std::to_string(position));
+                        }
+                        _cursor = _begin + position;
+                        return *this;
+                    }
+
+                    size_t size() const
+                    {
+                        return static_cast<size_t>(_end - _begin);
+                    }
+
+                    size_t bytesRemains() const
+                    {
+                        return static_cast<size_t>(_end - _cursor);
+                    }
+
+                    BinaryReader& skipBytes(size_t numberOfBytes)
+                    {
+                        _require(numberOfBytes);
+                        _cursor += numberOfBytes;
+                        return *this;
+                    }
+
+                    BinaryReader& readBytes(uint8_t* destination, size_t size)
+                    {
+                        _require(size);
+                        std::memcpy(destination, _cursor, size);
+                        _cursor += size;
+                        return *this;
+                    }
+
+                    uint32_t uint32() { return _read<uint32_t>(); }
+                    int32_t int32() { return static_cast<int32_t>(_read<uint32_t>()); }
+                    uint16_t uint16() { return _read<uint16_t>(); }
+                    int16_t int16() { return static_cast<int16_t>(_read<uint16_t>()); }
+                    uint8_t uint8() { return _read<uint8_t>(); }
+                    int8_t int8() { return static_cast<int8_t>(_read<uint8_t>()); }
+
+                    template <typename T>
+                    BinaryReader& operator>>(T& value)
+                    {
+                        value = _read<T>();
+                        return *this;
+                    }
+
+                    // Reads count integers at once: one bounds check, one memcpy and a swap loop the compiler vectorizes
+                    template <typename T>
+                    BinaryReader& readArray(T* destination, size_t count)
+                    {
+                        static_assert(std::is_integral<T>::value, "BinaryReader::readArray() supports integral types only");
+                        _require(count * sizeof(T));
+                        std::memcpy(destination, _cursor, count * sizeof(T));
+                        _cursor += count * sizeof(T);
+                        if (_needsSwap() && sizeof(T) > 1) {
+                            typedef typename std::make_unsigned<T>::type U;
+                            U* values = reinterpret_cast<U*>(destination);
+                            for (size_t i = 0; i != count; ++i) {
+                                values[i] = _swap(values[i]);
+                            }
+                        }
+                        return *this;
+                    }
+
+                    template <typename T>
+                    std::vector<T> readArray(size_t count)
+                    {
+                        std::vector<T> values(count);
+                        readArray(values.data(), count);
+                        return values;
+                    }
+
+                private:
+                    const uint8_t* _begin;
+                    const uint8_t* _cursor;
+                    const uint8_t* _end;
+
+                    static constexpr bool _needsSwap()
+                    {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+                        return E == ENDIANNESS::LITTLE;
+#else
+                        return E == ENDIANNESS::BIG;
+#endif
+                    }
+
+                    static uint8_t _swap(uint8_t value)
+                    {
+                        return value;
+                    }
+
+                    static uint16_t _swap(uint16_t value)
+                    {
+                        return static_cast<uint16_t>((value >> 8) | (value << 8));
+                    }
+
+                    static uint32_t _swap(uint32_t value)
+                    {
+                        return (value >> 24) | ((value >> 8) & 0x0000FF00) | ((value << 8) & 0x00FF0000) | (value << 24);
+                    }
+
+                    static uint64_t _swap(uint64_t value)
+                    {
+                        return (static_cast<uint64_t>(_swap(static_cast<uint32_t>(value))) << 32)
+                            | _swap(static_cast<uint32_t>(value >> 32));
+                    }
+
+                    void _require(size_t numberOfBytes) const
+                    {
+                        if (numberOfBytes > bytesRemains()) {
+                            throw Exception("BinaryReader - unexpected end of data at position " + std::to_string(position()));
+                        }
+                    }
+
+                    template <typename T>
+                    T _read()
+                    {
+                        static_assert(std::is_integral<T>::value, "BinaryReader supports integral types only");
+                        typedef typename std::make_unsigned<T>::type U;
+                        _require(sizeof(U));
+                        U value;
+                        std::memcpy(&value, _cursor, sizeof(U));
+                        _cursor += sizeof(U);
+                        if (_needsSwap()) {
+                            value = _swap(value);
+                        }
+                        return static_cast<T>(value);
+                    }
+            };
+
+            using BigEndianReader = BinaryReader<ENDIANNESS::BIG>;
+            using LittleEndianReader = BinaryReader<ENDIANNESS::LITTLE>;
+        }
+    }
+}
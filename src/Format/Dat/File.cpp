@@ -110,6 +110,16 @@ namespace Falltergeist
                 return nullptr;
             }
 
+            std::vector<std::string> File::filenames() const
+            {
+                std::vector<std::string> result;
+                result.reserve(_entries.size());
+                for (auto& entry : _entries) {
+                    result.push_back(entry.first);
+                }
+                return result;
+            }
+
             File& File::operator>>(int32_t &value)
             {
                 readBytes(reinterpret_cast<char *>(&value), sizeof(value));
@@ -5,6 +5,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include "Entry.h"
 
 namespace Falltergeist
@@ -24,6 +25,8 @@ namespace Falltergeist
 
                     // an pointer to an entry with given name or nullptr if no such entry exists
                     Entry* entry(const std::string& filename);
+                    // names of all entries, in no particular order
+                    std::vector<std::string> filenames() const;
 
                     File* readBytes(char* destination, unsigned int numberOfBytes);
                     File* skipBytes(unsigned int numberOfBytes);
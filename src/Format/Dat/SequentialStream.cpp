@@ -0,0 +1,107 @@
+#include <algorithm>
+#include "../../Exception.h"
+#include "../../Format/Dat/Entry.h"
+#include "../../Format/Dat/File.h"
+#include "../../Format/Dat/SequentialStream.h"
+
+namespace Falltergeist
+{
+    namespace Format
+    {
+        namespace Dat
+        {
+            SequentialStream::SequentialStream(const std::string& path)
+            {
+                _stream.open(path, std::ios_base::binary);
+                if (_stream.is_open()) {
+                    _stream.seekg(0, std::ios::end);
+                    _remaining = static_cast<size_t>(_stream.tellg());
+                    _stream.seekg(0, std::ios::beg);
+                }
+            }
+
+            SequentialStream::SequentialStream(Entry& datFileEntry)
+            {
+                _stream.open(datFileEntry.datFile()->filename(), std::ios_base::binary);
+                if (!_stream.is_open()) {
+                    return;
+                }
+                _stream.seekg(datFileEntry.dataOffset(), std::ios::beg);
+                _compressed = datFileEntry.compressed();
+
+                if (!_compressed) {
+                    _remaining = datFileEntry.unpackedSize();
+                    return;
+                }
+
+                _remaining = datFileEntry.packedSize();
+                _input.resize(INPUT_BUFFER_SIZE);
+                _zStream.next_in = Z_NULL;
+                _zStream.avail_in = 0;
+                _zStream.zalloc = Z_NULL;
+                _zStream.zfree = Z_NULL;
+                _zStream.opaque = Z_NULL;
+                if (inflateInit(&_zStream) != Z_OK) {
+                    throw Exception("SequentialStream - can't initialize zlib for " + datFileEntry.filename());
+                }
+            }
+
+            SequentialStream::~SequentialStream()
+            {
+                if (_compressed) {
+                    inflateEnd(&_zStream);
+                }
+            }
+
+            bool SequentialStream::isOpen() const
+            {
+                return _stream.is_open();
+            }
+
+            size_t SequentialStream::read(uint8_t* destination, size_t size)
+            {
+                if (!_compressed) {
+                    size = std::min(size, _remaining);
+                    _stream.read(reinterpret_cast<char*>(destination), size);
+                    size_t bytesRead = static_cast<size_t>(_stream.gcount());
+                    _remaining -= bytesRead;
+                    return bytesRead;
+                }
+
+                _zStream.next_out = destination;
+                _zStream.avail_out = static_cast<uInt>(size);
+                while (_zStream.avail_out > 0 && !_inflateEnd) {
+                    if (_zStream.avail_in == 0 && _remaining > 0) {
+                        size_t chunk = std::min(_remaining, _input.size());
+                        _stream.read(reinterpret_cast<char*>(_input.data()), chunk);
+                        chunk = static_cast<size_t>(_stream.gcount());
+                        _remaining = chunk > 0 ? _remaining - chunk : 0;
+                        _zStream.next_in = _input.data();
+                        _zStream.avail_in = static_cast<uInt>(chunk);
+                    }
+                    // zlib may still hold output from previous input, so inflate even when there is no new input
+                    int result = inflate(&_zStream, Z_NO_FLUSH);
+                    if (result == Z_STREAM_END) {
+                        _inflateEnd = true;
+                    } else if (result == Z_BUF_ERROR) {
+                        if (_zStream.avail_in == 0 && _remaining == 0) {
+                            // truncated entry
+                            break;
+                        }
+                    } else if (result != Z_OK) {
+                        throw Exception("SequentialStream - corrupted compressed data");
+                    }
+                }
+                return size - _zStream.avail_out;
+            }
+
+            bool SequentialStream::eof() const
+            {
+                if (_compressed) {
+                    return _inflateEnd;
+                }
+                return _remaining == 0;
+            }
+        }
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include "../../Base/Buffer.h"
+#include "zlib.h"
+
+namespace Falltergeist
+{
+    namespace Format
+    {
+        namespace Dat
+        {
+            class Entry;
+
+            // Forward-only stream over a file on disk or a Dat file entry. Unlike Dat::Stream it never holds
+            // the whole file in memory: compressed entries are inflated on the fly through a small fixed buffer.
+            // Opens its own file handle, so it can be read from any thread.
+            class SequentialStream
+            {
+                public:
+                    SequentialStream(const std::string& path);
+                    SequentialStream(Dat::Entry& datFileEntry);
+                    ~SequentialStream();
+
+                    SequentialStream(const SequentialStream&) = delete;
+                    SequentialStream& operator= (const SequentialStream&) = delete;
+
+                    bool isOpen() const;
+
+                    // reads up to size bytes, returns number of bytes actually read
+                    size_t read(uint8_t* destination, size_t size);
+
+                    bool eof() const;
+
+                private:
+                    static const size_t INPUT_BUFFER_SIZE = 64 * 1024;
+
+                    std::ifstream _stream;
+                    // bytes left to read from the file (packed bytes for compressed entries)
+                    size_t _remaining = 0;
+                    bool _compressed = false;
+                    bool _inflateEnd = false;
+                    z_stream _zStream;
+                    Base::Buffer<uint8_t> _input;
+            };
+        }
+    }
+}
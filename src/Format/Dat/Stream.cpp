@@ -80,6 +80,11 @@ namespace Falltergeist
                 return _buffer.size();
             }
 
+            const uint8_t* Stream::data() const
+            {
+                return reinterpret_cast<const uint8_t*>(_buffer.data());
+            }
+
             std::streambuf::int_type Stream::underflow()
             {
                 if (gptr() == egptr())
@@ -33,6 +33,8 @@ namespace Falltergeist
                     Stream& setPosition(size_t position);
                     size_t position() const;
                     size_t size() const;
+                    // Whole underlying buffer, regardless of the current position
+                    const uint8_t* data() const;
 
                     size_t bytesRemains();
 
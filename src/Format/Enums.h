@@ -99,6 +99,34 @@ enum class PROCEDURE_FLAG
     INLINE      = 0x40
 };
 
+// Procedures which the engine calls by itself when something happens to script owner
+enum class STANDARD_PROCEDURE
+{
+    START = 0,
+    SPATIAL,
+    DESCRIPTION,
+    PICKUP,
+    DROP,
+    USE,
+    USE_OBJ_ON,
+    USE_SKILL_ON,
+    TALK,
+    CRITTER,
+    COMBAT,
+    DAMAGE,
+    MAP_ENTER,
+    MAP_EXIT,
+    CREATE,
+    DESTROY,
+    LOOK_AT,
+    TIMED_EVENT,
+    MAP_UPDATE,
+    PUSH,
+    IS_DROPPING,
+    COMBAT_IS_STARTING,
+    COMBAT_IS_OVER
+};
+
 enum class OBJECT_TYPE
 {
     ITEM = 0,
@@ -1,5 +1,5 @@
 #include "../Fon/File.h"
-#include "../Dat/Stream.h"
+#include "../Dat/BinaryReader.h"
 
 namespace Falltergeist
 {
@@ -9,18 +9,18 @@ namespace Falltergeist
         {
             File::File(Dat::Stream&& stream)
             {
-                stream.setPosition(0);
+                Dat::BigEndianReader reader(stream.data(), stream.size());
 
-                _numchars = stream.uint32();
-                _maximumHeight = stream.uint32();
-                _horizontalGap = stream.uint32();
+                _numchars = reader.uint32();
+                _maximumHeight = reader.uint32();
+                _horizontalGap = reader.uint32();
                 _verticalGap = _horizontalGap; // i hope
-                stream.skipBytes(8);
+                reader.skipBytes(8);
 
                 for (unsigned int i = 0; i < _numchars; ++i)
                 {
-                    uint32_t width = stream.uint32();
-                    uint32_t offset = stream.uint32();
+                    uint32_t width = reader.uint32();
+                    uint32_t offset = reader.uint32();
 
                     if (width > _maximumWidth)
                     {
@@ -32,12 +32,12 @@ namespace Falltergeist
 
                 _spaceWidth = _glyphs.at(0x20).width();
 
-                _loadRgba(stream);
+                _loadAlpha(reader);
             }
 
-            void File::_loadRgba(Dat::Stream& stream)
+            void File::_loadAlpha(Dat::BigEndianReader& reader)
             {
-                _rgba.resize((_maximumWidth + 2) * 16 * (_maximumHeight + 2) * 16);
+                _alpha.resize((_maximumWidth + 2) * 16 * (_maximumHeight + 2) * 16);
 
                 for (unsigned int i=0; i < _numchars; i++)
                 {
@@ -56,16 +56,16 @@ namespace Falltergeist
                             for (unsigned int x = 0; x < _glyphs.at(i).width(); x++)
                             {
                                 // [offset + y * bytesPerLine + (x / 8)]
-                                stream.setPosition(0x0414+offset + y * bytesPerLine + (x / 8));
-                                uint8_t b = stream.uint8();
+                                reader.setPosition(0x0414+offset + y * bytesPerLine + (x / 8));
+                                uint8_t b = reader.uint8();
 
                                 if (b & (1 << (7 - (x % 8))))
                                 {
-                                    _rgba[(glyphY + y)*(_maximumWidth+2)*16  + glyphX + x] = 0xFFFFFFFF;
+                                    _alpha[(glyphY + y)*(_maximumWidth+2)*16  + glyphX + x] = 255;
                                 }
                                 else
                                 {
-                                    _rgba[(glyphY + y)*(_maximumWidth+2)*16  + glyphX + x] = 0x00000000;
+                                    _alpha[(glyphY + y)*(_maximumWidth+2)*16  + glyphX + x] = 0;
                                 }
                             }
                         }
@@ -74,9 +74,9 @@ namespace Falltergeist
                 }
             }
 
-            uint32_t* File::rgba()
+            uint8_t* File::alpha()
             {
-                return _rgba.data();
+                return _alpha.data();
             }
 
             const std::vector<Glyph>& File::glyphs() const
@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include <vector>
+#include "../Dat/BinaryReader.h"
 #include "../Dat/Item.h"
 #include "../Fon/Glyph.h"
 
@@ -19,7 +20,8 @@ namespace Falltergeist
             {
                 public:
                     File(Dat::Stream&& stream);
-                    uint32_t* rgba();
+                    // Glyph atlas coverage, 8 bits per pixel
+                    uint8_t* alpha();
 
                     const std::vector<Glyph>& glyphs() const;
 
@@ -36,10 +38,10 @@ namespace Falltergeist
                     uint32_t _horizontalGap = 0;
                     uint32_t _spaceWidth = 0;
                     uint32_t _verticalGap = 0;
-                    std::vector<uint32_t> _rgba;
+                    std::vector<uint8_t> _alpha;
                     uint32_t _numchars;
 
-                    void _loadRgba(Dat::Stream& stream);
+                    void _loadAlpha(Dat::BigEndianReader& reader);
             };
         }
     }
@@ -1,6 +1,6 @@
 ﻿#include <algorithm>
 #include "../Enums.h"
-#include "../Dat/Stream.h"
+#include "../Dat/BinaryReader.h"
 #include "../Frm/File.h"
 #include "../Pal/File.h"
 
@@ -12,21 +12,21 @@ namespace Falltergeist
         {
             File::File(Dat::Stream&& stream)
             {
-                stream.setPosition(0);
+                Dat::BigEndianReader reader(stream.data(), stream.size());
 
-                _version = stream.uint32();
-                _framesPerSecond = stream.uint16();
-                _actionFrame = stream.uint16();
-                _framesPerDirection = stream.uint16();
+                _version = reader.uint32();
+                _framesPerSecond = reader.uint16();
+                _actionFrame = reader.uint16();
+                _framesPerDirection = reader.uint16();
 
                 uint16_t shiftX[6];
                 uint16_t shiftY[6];
                 uint32_t dataOffset[6];
-                for (unsigned int i = 0; i != 6; ++i) shiftX[i] = stream.uint16();
-                for (unsigned int i = 0; i != 6; ++i) shiftY[i] = stream.uint16();
+                reader.readArray(shiftX, 6);
+                reader.readArray(shiftY, 6);
+                reader.readArray(dataOffset, 6);
                 for (unsigned int i = 0; i != 6; ++i)
                 {
-                    dataOffset[i] = stream.uint32();
                     if (i > 0 && dataOffset[i-1] == dataOffset[i])
                     {
                         continue;
@@ -43,26 +43,26 @@ namespace Falltergeist
                 for (auto& direction : _directions)
                 {
                     // jump to frames data at frames area
-                    stream.setPosition(direction.dataOffset() + 62);
+                    reader.setPosition(direction.dataOffset() + 62);
 
                     // read all frames
                     for (unsigned i = 0; i != _framesPerDirection; ++i)
                     {
-                        uint16_t width = stream.uint16();
-                        uint16_t height = stream.uint16();
+                        uint16_t width = reader.uint16();
+                        uint16_t height = reader.uint16();
 
                         direction.frames().emplace_back(width, height);
                         auto& frame = direction.frames().back();
 
                         // Number of pixels for this frame
                         // We don't need this, because we already have width*height
-                        stream.uint32();
+                        reader.uint32();
 
-                        frame.setOffsetX(stream.int16());
-                        frame.setOffsetY(stream.int16());
+                        frame.setOffsetX(reader.int16());
+                        frame.setOffsetY(reader.int16());
 
                         // Pixels data
-                        stream.readBytes(frame.data(), frame.width() * frame.height());
+                        reader.readBytes(frame.data(), frame.width() * frame.height());
                     }
                 }
             }
@@ -110,65 +110,45 @@ namespace Falltergeist
                 return height;
             }
 
-            uint32_t* File::rgba(Pal::File* palFile)
+            const uint8_t* File::indexes()
             {
-                // TODO: this looks like a getter, which in fact creates _rgba.
-                // Moreover, the content of _rgba depends on the specific palFile that was provided the first time
-                // This is clearly bad semantics
-                if (!_rgba.empty()) return _rgba.data();
-
-                _rgba.resize(width()*height());
+                if (!_indexes.empty()) return _indexes.data();
 
                 uint16_t w = width();
 
+                // index 0 is transparent
+                _indexes.resize(w*height(), 0);
+
                 size_t positionY = 1;
                 for (auto& direction : _directions)
                 {
                     size_t positionX = 1;
                     for (auto& frame : direction.frames())
                     {
-                        // TODO: more efficient way to generate texture?
                         for (uint16_t y = 0; y != frame.height(); ++y)
                         {
-                            for (uint16_t x = 0; x != frame.width(); ++x)
-                            {
-                                _rgba[((y + positionY)*w) + x + positionX] = *palFile->color(frame.index(x, y));
-                            }
+                            const uint8_t* row = frame.data() + y * frame.width();
+                            std::copy(row, row + frame.width(), _indexes.begin() + (y + positionY)*w + positionX);
                         }
                         positionX += frame.width() + 2;
                     }
                     positionY += direction.height();
                 }
-                return _rgba.data();
+                return _indexes.data();
             }
 
-            std::vector<bool>& File::mask(Pal::File* palFile)
+            std::shared_ptr<const Mask> File::mask(Pal::File* palFile)
             {
-                if (!_mask.empty()) return _mask;
-
-                uint16_t w = width();
-                uint16_t h = height();
+                if (_mask) return _mask;
 
-                _mask.resize(w*h, true);
-
-                unsigned positionY = 1;
-                for (auto& direction : _directions)
+                bool opaqueIndexes[256];
+                for (unsigned i = 0; i != 256; ++i)
                 {
-                    unsigned positionX = 1;
-                    for (auto& frame : direction.frames())
-                    {
-                        // TODO: optimize
-                        for (unsigned y = 0; y != frame.height(); ++y)
-                        {
-                            for (unsigned x = 0; x != frame.width(); ++x)
-                            {
-                                _mask[((y + positionY)*w) + x + positionX] = (palFile->color(frame.index(x, y))->alpha() > 0);
-                            }
-                        }
-                        positionX += frame.width() + 2;
-                    }
-                    positionY += direction.height();
+                    opaqueIndexes[i] = palFile->color(i)->alpha() > 0;
                 }
+
+                // gaps between frames hold index 0, so they come out transparent
+                _mask = std::make_shared<const Mask>(width(), height(), indexes(), opaqueIndexes);
                 return _mask;
             }
 
@@ -1,9 +1,11 @@
 ﻿#pragma once
 
 #include <map>
+#include <memory>
 #include <vector>
 #include "../Dat/Item.h"
 #include "../Frm/Direction.h"
+#include "../Frm/Mask.h"
 #include "../Enums.h"
 
 namespace Falltergeist
@@ -39,13 +41,15 @@ namespace Falltergeist
                     int16_t offsetX(unsigned int direction = 0, unsigned int frame = 0) const;
                     int16_t offsetY(unsigned int direction = 0, unsigned int frame = 0) const;
 
-                    uint32_t* rgba(Pal::File* palFile);
-                    std::vector<bool>& mask(Pal::File* palFile);
+                    // All frames laid out on one image, one palette index per pixel, with 1px transparent gaps
+                    const uint8_t* indexes();
+                    // Opacity of indexes() pixels, built on first call and shared by everyone holding the image
+                    std::shared_ptr<const Mask> mask(Pal::File* palFile);
 
                     const std::vector<Direction>& directions() const;
 
                 protected:
-                    std::vector<uint32_t> _rgba;
+                    std::vector<uint8_t> _indexes;
                     uint32_t _version = 0;
                     uint16_t _framesPerSecond = 0;
                     uint16_t _framesPerDirection = 0;
@@ -53,7 +57,7 @@ namespace Falltergeist
                     bool _animatedPalette = false;
 
                     std::vector<Direction> _directions;
-                    std::vector<bool> _mask;
+                    std::shared_ptr<const Mask> _mask;
             };
         }
     }
@@ -53,6 +53,11 @@ namespace Falltergeist
             {
                 return _indexes.data();
             }
+
+            const uint8_t* Frame::data() const
+            {
+                return _indexes.data();
+            }
         }
     }
 }
@@ -32,6 +32,7 @@ namespace Falltergeist
                     uint8_t index(uint16_t x, uint16_t y) const;
 
                     uint8_t* data();
+                    const uint8_t* data() const;
 
                 protected:
                     uint16_t _width = 0;
@@ -0,0 +1,87 @@
+﻿#include "../Frm/Mask.h"
+
+namespace Falltergeist
+{
+    namespace Format
+    {
+        namespace Frm
+        {
+            Mask::Mask(unsigned int width, unsigned int height, const uint8_t* indexes, const bool* opaqueIndexes)
+                : _width(width), _height(height), _wordsPerRow((width + 63) / 64)
+            {
+                _bits.resize(_wordsPerRow * height, 0);
+                _spans.resize(height, Span{0, 0});
+
+                // 0/1 lookup, so the inner loops are plain shifts and ors without branches
+                uint64_t table[256];
+                for (unsigned int i = 0; i != 256; ++i)
+                {
+                    table[i] = opaqueIndexes[i] ? 1 : 0;
+                }
+
+                for (unsigned int y = 0; y != height; ++y)
+                {
+                    const uint8_t* row = indexes + static_cast<size_t>(y) * width;
+                    uint64_t* bits = _bits.data() + y * _wordsPerRow;
+
+                    unsigned int x = 0;
+                    for (size_t word = 0; x + 64 <= width; ++word, x += 64)
+                    {
+                        uint64_t value = 0;
+                        for (unsigned int bit = 0; bit != 64; ++bit)
+                        {
+                            value |= table[row[x + bit]] << bit;
+                        }
+                        bits[word] = value;
+                    }
+                    for (unsigned int bit = 0; x + bit < width; ++bit)
+                    {
+                        bits[x / 64] |= table[row[x + bit]] << bit;
+                    }
+
+                    // opaque span of the row
+                    unsigned int begin = 0;
+                    while (begin < width && !table[row[begin]])
+                    {
+                        ++begin;
+                    }
+                    unsigned int end = width;
+                    while (end > begin && !table[row[end - 1]])
+                    {
+                        --end;
+                    }
+                    _spans[y] = Span{static_cast<uint16_t>(begin), static_cast<uint16_t>(end)};
+                }
+            }
+
+            unsigned int Mask::width() const
+            {
+                return _width;
+            }
+
+            unsigned int Mask::height() const
+            {
+                return _height;
+            }
+
+            bool Mask::opaque(int x, int y) const
+            {
+                if (x < 0 || y < 0 || static_cast<unsigned int>(y) >= _height)
+                {
+                    return false;
+                }
+                const Span& span = _spans[y];
+                if (x < span.begin || x >= span.end)
+                {
+                    return false;
+                }
+                return (_bits[y * _wordsPerRow + x / 64] >> (x % 64)) & 1;
+            }
+
+            size_t Mask::size() const
+            {
+                return _bits.size() * sizeof(uint64_t) + _spans.size() * sizeof(Span);
+            }
+        }
+    }
+}
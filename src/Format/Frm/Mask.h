@@ -0,0 +1,46 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Falltergeist
+{
+    namespace Format
+    {
+        namespace Frm
+        {
+            // Immutable 1 bit per pixel opacity mask used for hit testing.
+            // Rows are padded to whole 64-bit words; every row also keeps the span of its opaque pixels
+            // so most misses are rejected without touching the bits.
+            class Mask
+            {
+                public:
+                    // opaqueIndexes tells which of 256 palette indexes are opaque
+                    Mask(unsigned int width, unsigned int height, const uint8_t* indexes, const bool* opaqueIndexes);
+
+                    unsigned int width() const;
+                    unsigned int height() const;
+
+                    // Pixels outside of the mask are transparent
+                    bool opaque(int x, int y) const;
+
+                    // Memory taken by the bits and spans, in bytes
+                    size_t size() const;
+
+                private:
+                    struct Span
+                    {
+                        uint16_t begin;
+                        uint16_t end;
+                    };
+
+                    unsigned int _width;
+                    unsigned int _height;
+                    size_t _wordsPerRow;
+                    std::vector<uint64_t> _bits;
+                    std::vector<Span> _spans;
+            };
+        }
+    }
+}
@@ -2,6 +2,8 @@
 #include <algorithm>
 #include <cctype>
 #include "../../Exception.h"
+#include "../../Format/Cache/Reader.h"
+#include "../../Format/Cache/Writer.h"
 #include "../../Format/Dat/Stream.h"
 #include "../../Format/Gam/File.h"
 
@@ -40,6 +42,31 @@ namespace Falltergeist
                 }
             }
 
+            File::File(Cache::Reader& reader)
+            {
+                for (auto vars : {&_GVARS, &_MVARS})
+                {
+                    for (size_t i = 0, count = reader.count(); i != count; ++i)
+                    {
+                        auto name = reader.string();
+                        (*vars)[name] = reader.int32();
+                    }
+                }
+            }
+
+            void File::save(Cache::Writer& writer) const
+            {
+                for (auto vars : {&_GVARS, &_MVARS})
+                {
+                    writer.writeCount(vars->size());
+                    for (auto& var : *vars)
+                    {
+                        writer.writeString(var.first);
+                        writer.writeInt32(var.second);
+                    }
+                }
+            }
+
             void File::_parseLine(std::string line)
             {
                 // cut everything after comment
@@ -8,6 +8,12 @@ namespace Falltergeist
 {
     namespace Format
     {
+        namespace Cache
+        {
+            class Reader;
+            class Writer;
+        }
+
         namespace Dat
         {
             class Stream;
@@ -19,6 +25,10 @@ namespace Falltergeist
             {
                 public:
                     File(Dat::Stream&& stream);
+                    // Restores parsed file from the binary cache
+                    File(Cache::Reader& reader);
+
+                    void save(Cache::Writer& writer) const;
                     std::map<std::string, int>* GVARS();
                     std::map<std::string, int>* MVARS();
                     int GVAR(std::string name);
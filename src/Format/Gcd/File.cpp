@@ -1,5 +1,5 @@
 #include "../../Exception.h"
-#include "../../Format/Dat/Stream.h"
+#include "../../Format/Dat/BinaryReader.h"
 #include "../../Format/Gcd/File.h"
 
 namespace Falltergeist
@@ -10,102 +10,102 @@ namespace Falltergeist
         {
             File::File(Dat::Stream&& stream)
             {
-                stream.setPosition(0);
+                Dat::BigEndianReader reader(stream.data(), stream.size());
 
-                stream.uint32(); // unknown 1
+                reader.uint32(); // unknown 1
 
                 // primary stats
                 for (unsigned i = (unsigned)STAT::STRENGTH; i <= (unsigned)STAT::LUCK; i++)
                 {
-                    setStat((STAT)i, stream.uint32());
+                    setStat((STAT)i, reader.uint32());
                 }
 
                 // secondary stats
-                _hitPoints = stream.uint32();
-                _actionPoints = stream.uint32();
-                _armorClass = stream.uint32();
+                _hitPoints = reader.uint32();
+                _actionPoints = reader.uint32();
+                _armorClass = reader.uint32();
 
-                stream.uint32(); // unknown 2
+                reader.uint32(); // unknown 2
 
-                _meleeDamage = stream.uint32();
-                _carryWeight = stream.uint32();
-                _sequence    = stream.uint32();
-                _healingRate = stream.uint32();
-                _criticalChance      = stream.uint32();
-                _criticalHitModifier = stream.uint32();
+                _meleeDamage = reader.uint32();
+                _carryWeight = reader.uint32();
+                _sequence    = reader.uint32();
+                _healingRate = reader.uint32();
+                _criticalChance      = reader.uint32();
+                _criticalHitModifier = reader.uint32();
 
                 for (unsigned i = (unsigned)DAMAGE::NORMAL; i <= (unsigned)DAMAGE::EXPLOSIVE; i++)
                 {
-                    setDamage((DAMAGE)i, stream.uint32());
+                    setDamage((DAMAGE)i, reader.uint32());
                 }
                 for (unsigned i = (unsigned)DAMAGE::NORMAL; i <= (unsigned)DAMAGE::EXPLOSIVE; i++)
                 {
-                    setResistance((DAMAGE)i, stream.uint32());
+                    setResistance((DAMAGE)i, reader.uint32());
                 }
 
-                _radiationResistance = stream.uint32();
-                _poisonResistance    = stream.uint32();
-                _age    = stream.uint32();
-                _gender = (GENDER)stream.uint32();
+                _radiationResistance = reader.uint32();
+                _poisonResistance    = reader.uint32();
+                _age    = reader.uint32();
+                _gender = (GENDER)reader.uint32();
 
                 // bonuses to primary stats
                 for (unsigned i = (unsigned)STAT::STRENGTH; i <= (unsigned)STAT::LUCK; i++)
                 {
-                    setStatBonus((STAT)i, stream.uint32());
+                    setStatBonus((STAT)i, reader.uint32());
                 }
 
                 // bonuses to secondary stats
-                _hitPointsBonus    = stream.uint32();
-                _actionPointsBonus = stream.uint32();
-                _armorClassBonus   = stream.uint32();
+                _hitPointsBonus    = reader.uint32();
+                _actionPointsBonus = reader.uint32();
+                _armorClassBonus   = reader.uint32();
 
-                stream.uint32(); // unknown 3
+                reader.uint32(); // unknown 3
 
-                _meleeDamageBonus = stream.uint32();
-                _carryWeightBonus = stream.uint32();
-                _sequenceBonus    = stream.uint32();
-                _healingRateBonus = stream.uint32();
-                _criticalChanceBonus      = stream.uint32();
-                _criticalHitModifierBonus = stream.uint32();
+                _meleeDamageBonus = reader.uint32();
+                _carryWeightBonus = reader.uint32();
+                _sequenceBonus    = reader.uint32();
+                _healingRateBonus = reader.uint32();
+                _criticalChanceBonus      = reader.uint32();
+                _criticalHitModifierBonus = reader.uint32();
 
                 for (unsigned i = (unsigned)DAMAGE::NORMAL; i <= (unsigned)DAMAGE::EXPLOSIVE; i++)
                 {
-                    setDamageBonus((DAMAGE)i, stream.uint32());
+                    setDamageBonus((DAMAGE)i, reader.uint32());
                 }
                 for (unsigned i = (unsigned)DAMAGE::NORMAL; i <= (unsigned)DAMAGE::EXPLOSIVE; i++)
                 {
-                    setResistanceBonus((DAMAGE)i, stream.uint32());
+                    setResistanceBonus((DAMAGE)i, reader.uint32());
                 }
 
-                _radiationResistanceBonus = stream.uint32();
-                _poisonResistanceBonus    = stream.uint32();
-                _ageBonus    = stream.uint32();
-                _genderBonus = stream.uint32();
+                _radiationResistanceBonus = reader.uint32();
+                _poisonResistanceBonus    = reader.uint32();
+                _ageBonus    = reader.uint32();
+                _genderBonus = reader.uint32();
 
                 //skills
                 for (unsigned i = (unsigned)SKILL::SMALL_GUNS; i <= (unsigned)SKILL::OUTDOORSMAN; i++)
                 {
-                    setSkill((SKILL)i, stream.uint32());
+                    setSkill((SKILL)i, reader.uint32());
                 }
 
                 // unknown
-                stream.uint32(); // unknown 4
-                stream.uint32(); // unknown 5
-                stream.uint32(); // unknown 6
-                stream.uint32(); // unknown 7
+                reader.uint32(); // unknown 4
+                reader.uint32(); // unknown 5
+                reader.uint32(); // unknown 6
+                reader.uint32(); // unknown 7
 
                 // name
                 uint8_t name[32];
-                stream.readBytes(name, 32);
+                reader.readBytes(name, 32);
                 setName((char*)name);
 
-                _firstTaggedSkill  = (SKILL)stream.int32();
-                _secondTaggedSkill = (SKILL)stream.int32();
-                _thirdTaggedSkill  = (SKILL)stream.int32();
-                _fourthTaggedSkill = (SKILL)stream.int32();
-                _firstTrait  = (TRAIT)stream.int32();
-                _secondTrait = (TRAIT)stream.int32();
-                _characterPoints = stream.uint32();
+                _firstTaggedSkill  = (SKILL)reader.int32();
+                _secondTaggedSkill = (SKILL)reader.int32();
+                _thirdTaggedSkill  = (SKILL)reader.int32();
+                _fourthTaggedSkill = (SKILL)reader.int32();
+                _firstTrait  = (TRAIT)reader.int32();
+                _secondTrait = (TRAIT)reader.int32();
+                _characterPoints = reader.uint32();
             }
 
             uint32_t File::stat(STAT number) const
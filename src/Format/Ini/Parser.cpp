@@ -1,5 +1,3 @@
-#include <algorithm>
-#include <sstream>
 #include "../Ini/File.h"
 #include "../Ini/Parser.h"
 
@@ -9,7 +7,7 @@ namespace Falltergeist
     {
         namespace Ini
         {
-            Parser::Parser(std::istream &stream) : _stream(stream), _section("")
+            Parser::Parser(const Dat::Stream& stream) : _tokenizer(stream), _section("")
             {
             }
 
@@ -20,81 +18,74 @@ namespace Falltergeist
             Array Parser::parseArray(const std::string& str)
             {
                 Array ret;
-                for (std::string& value : Parser::split(',', str))
+                size_t start = 0;
+                Base::StringView source(str);
+                while (start <= source.size())
                 {
-                    std::string key = "";
-                    Parser::trim(value);
+                    size_t end = source.find(',', start);
+                    if (end == Base::StringView::npos)
+                    {
+                        end = source.size();
+                    }
+                    auto value = source.substr(start, end - start).trimmed();
+                    start = end + 1;
+
                     // skip empty values
-                    if (value.size() == 0)
+                    if (value.empty())
                     {
                         continue;
                     }
                     // check for associative
+                    Base::StringView key;
                     size_t colon = value.find(':');
-                    if (colon != std::string::npos)
+                    if (colon != Base::StringView::npos)
                     {
-                        key = value.substr(0, colon);
-                        Parser::rtrim(key);
-                        value = value.substr(colon + 1);
-                        Parser::ltrim(value);
+                        key = value.substr(0, colon).rtrimmed();
+                        value = value.substr(colon + 1).ltrimmed();
                     }
-                    if (value.size() > 0)
+                    if (!value.empty())
                     {
-                        ret.push_back(std::make_pair(key, value));
+                        ret.emplace_back(key.str(), Value());
+                        ret.back().second.assign(value);
                     }
                 }
                 return ret;
             }
 
-            void Parser::_stripComments(std::string& line)
-            {
-                auto pos = line.find(";");
-                if (pos != std::string::npos)
-                {
-                    line.erase(pos);
-                }
-            }
-
             std::unique_ptr<File> Parser::parse()
             {
                 auto ini = std::unique_ptr<File>(new File());
-                std::string line;
+                Base::StringView line;
 
-                while (std::getline(_stream, line))
+                while (_tokenizer.nextLine(line))
                 {
                     // Lines starting with "#" or ";" are treated as comments and ignored
-                    if (line[0] == '#' || line[0] == ';') continue;
+                    if (!line.empty() && (line.front() == '#' || line.front() == ';')) continue;
 
-                    // Prepare line
-                    _stripComments(line);
-                    trim(line);
+                    // Prepare line: strip comments and trim
+                    line = line.substr(0, line.find(';')).trimmed();
 
                     // Skip empty lines
-                    if (line.length() == 0) continue;
+                    if (line.empty()) continue;
 
                     // Found section
-                    if (*line.begin() == '[' && *line.rbegin() == ']')
+                    if (line.front() == '[' && line.back() == ']')
                     {
-                        _section = line.substr(1, line.length() - 2);
-
+                        _section.assign(line.data() + 1, line.size() - 2);
                         continue;
                     }
 
                     auto eqPos = line.find('=');
-                    if (eqPos == std::string::npos)
+                    if (eqPos == Base::StringView::npos)
                     {
                         continue;
                     }
 
-                    auto name  = line.substr(0, eqPos);
-                    auto value = line.substr(eqPos + 1);
-                    rtrim(name);
-                    ltrim(value);
-
                     // Property names are case-insensitive
-                    toLower(name);
+                    auto& name = _names.lowercase(line.substr(0, eqPos).rtrimmed());
+                    auto value = line.substr(eqPos + 1).ltrimmed();
 
-                    ini->section(_section).setProperty(name, value);
+                    ini->section(_section)[name].assign(value);
                 }
 
                 return ini;
@@ -5,11 +5,18 @@
 #include <vector>
 #include "../../Format/Ini/Value.h"
 #include "../../Format/Txt/Parser.h"
+#include "../../Format/Txt/StringPool.h"
+#include "../../Format/Txt/Tokenizer.h"
 
 namespace Falltergeist
 {
     namespace Format
     {
+        namespace Dat
+        {
+            class Stream;
+        }
+
         namespace Ini
         {
             class File;
@@ -18,11 +25,12 @@ namespace Falltergeist
             /**
              * @brief Parser of INI files.
              * Parses INI-like TXT files, such as MAPS.TXT, CITY.TXT, etc.
+             * Lines are tokenized in place over the stream buffer, only section names and values which are kept get copied.
              */
             class Parser : public Txt::Parser
             {
                 public:
-                    Parser(std::istream &stream);
+                    Parser(const Dat::Stream& stream);
                     ~Parser();
 
                     std::unique_ptr<File> parse();
@@ -30,11 +38,9 @@ namespace Falltergeist
                     static Array parseArray(const std::string& value);
 
                 private:
-                    std::istream &_stream; // stream to parse
+                    Txt::Tokenizer _tokenizer;
                     std::string  _section; // current section
-
-                protected:
-                    void _stripComments(std::string& line);
+                    Txt::StringPool _names; // property names, repeated in every section
             };
         }
     }
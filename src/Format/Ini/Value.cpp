@@ -16,6 +16,11 @@ namespace Falltergeist
                 _value = value;
             }
 
+            void Value::assign(Base::StringView value)
+            {
+                _value.assign(value.data(), value.size());
+            }
+
             Value::operator std::string() const
             {
                 return _value;
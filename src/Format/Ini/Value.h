@@ -2,6 +2,8 @@
 
 #include <ostream>
 #include <string>
+#include <vector>
+#include "../../Base/StringView.h"
 
 namespace Falltergeist
 {
@@ -24,6 +26,11 @@ namespace Falltergeist
 
                     void operator =(const std::string&);
 
+                    /**
+                     * Replaces value with a copy of given characters, reusing already allocated storage.
+                     */
+                    void assign(Base::StringView value);
+
                     /*template <class T>
                     explicit operator T() const;*/
 
@@ -1,5 +1,4 @@
-﻿#include "../../Format/Dat/Stream.h"
-#include "../../Format/Int/File.h"
+﻿#include "../../Format/Int/File.h"
 #include "../../Exception.h"
 
 namespace Falltergeist
@@ -8,15 +7,13 @@ namespace Falltergeist
     {
         namespace Int
         {
-            File::File(Dat::Stream&& stream) : _stream(std::move(stream))
+            File::File(Dat::Stream&& stream) : _stream(std::move(stream)), _reader(_stream.data(), _stream.size())
             {
-                _stream.setPosition(0);
-
                 // Initialization code goes here
-                _stream.setPosition(42);
+                _reader.setPosition(42);
 
                 // Procedures table
-                uint32_t proceduresCount = _stream.uint32();
+                uint32_t proceduresCount = _reader.uint32();
 
                 std::vector<uint32_t> procedureNameOffsets;
 
@@ -25,55 +22,60 @@ namespace Falltergeist
                     _procedures.emplace_back();
                     auto& procedure = _procedures.back();
 
-                    procedureNameOffsets.push_back(_stream.uint32());
-                    procedure.setFlags(_stream.uint32());
-                    procedure.setDelay(_stream.uint32());
-                    procedure.setConditionOffset(_stream.uint32());
-                    procedure.setBodyOffset(_stream.uint32());
-                    procedure.setArgumentsCounter(_stream.uint32());
+                    procedureNameOffsets.push_back(_reader.uint32());
+                    procedure.setFlags(_reader.uint32());
+                    procedure.setDelay(_reader.uint32());
+                    procedure.setConditionOffset(_reader.uint32());
+                    procedure.setBodyOffset(_reader.uint32());
+                    procedure.setArgumentsCounter(_reader.uint32());
                 }
 
                 // Identifiers table
-                uint32_t tableSize = _stream.uint32();
+                uint32_t tableSize = _reader.uint32();
                 unsigned j = 0;
                 while (j < tableSize)
                 {
-                    uint16_t nameLength = _stream.uint16();
+                    uint16_t nameLength = _reader.uint16();
                     j += 2;
 
                     uint32_t nameOffset = j + 4;
                     std::string name;
                     for (unsigned i = 0; i != nameLength; ++i, ++j)
                     {
-                        uint8_t ch = _stream.uint8();
+                        uint8_t ch = _reader.uint8();
                         if (ch != 0) name.push_back(ch);
                     }
 
                     _identifiers.insert(std::make_pair(nameOffset, name)); // names of functions and variables
                 }
 
-                _stream.skipBytes(4); // signature 0xFFFFFFFF
+                _reader.skipBytes(4); // signature 0xFFFFFFFF
 
                 for (unsigned i = 0; i != procedureNameOffsets.size(); ++i)
                 {
                     _procedures.at(i).setName(_identifiers.at(procedureNameOffsets.at(i)));
                 }
 
+                for (size_t i = 0; i != STANDARD_PROCEDURES; ++i)
+                {
+                    _standardProcedures[i] = procedure(procedureName(static_cast<STANDARD_PROCEDURE>(i)));
+                }
+
                 // STRINGS TABLE
-                uint32_t stringsTable = _stream.uint32();
+                uint32_t stringsTable = _reader.uint32();
 
                 if (stringsTable != 0xFFFFFFFF)
                 {
                     uint32_t j = 0;
                     while (j < stringsTable)
                     {
-                        uint16_t length = _stream.uint16();
+                        uint16_t length = _reader.uint16();
                         j += 2;
                         uint32_t nameOffset = j + 4;
                         std::string name;
                         for (unsigned i = 0; i != length; ++i, ++j)
                         {
-                            uint8_t ch = _stream.uint8();
+                            uint8_t ch = _reader.uint8();
                             if (ch != 0) name.push_back(ch);
                         }
                         _strings.insert(std::make_pair(nameOffset, name));
@@ -93,12 +95,12 @@ namespace Falltergeist
 
             size_t File::position() const
             {
-                return _stream.position();
+                return _reader.position();
             }
 
             void File::setPosition(size_t pos)
             {
-                _stream.setPosition(pos);
+                _reader.setPosition(pos);
             }
 
             size_t File::size() const
@@ -108,12 +110,12 @@ namespace Falltergeist
 
             uint16_t File::readOpcode()
             {
-                return _stream.uint16();
+                return _reader.uint16();
             }
 
             uint32_t File::readValue()
             {
-                return _stream.uint32();
+                return _reader.uint32();
             }
 
             const std::vector<Procedure>& File::procedures() const
@@ -132,6 +134,41 @@ namespace Falltergeist
                 }
                 return nullptr;
             }
+
+            const Procedure* File::procedure(STANDARD_PROCEDURE procedure) const
+            {
+                return _standardProcedures.at(static_cast<size_t>(procedure));
+            }
+
+            const std::string& File::procedureName(STANDARD_PROCEDURE procedure)
+            {
+                static const std::array<std::string, STANDARD_PROCEDURES> names = {{
+                    "start",
+                    "spatial_p_proc",
+                    "description_p_proc",
+                    "pickup_p_proc",
+                    "drop_p_proc",
+                    "use_p_proc",
+                    "use_obj_on_p_proc",
+                    "use_skill_on_p_proc",
+                    "talk_p_proc",
+                    "critter_p_proc",
+                    "combat_p_proc",
+                    "damage_p_proc",
+                    "map_enter_p_proc",
+                    "map_exit_p_proc",
+                    "create_p_proc",
+                    "destroy_p_proc",
+                    "look_at_p_proc",
+                    "timed_event_p_proc",
+                    "map_update_p_proc",
+                    "push_p_proc",
+                    "is_dropping_p_proc",
+                    "combat_is_starting_p_proc",
+                    "combat_is_over_p_proc"
+                }};
+                return names.at(static_cast<size_t>(procedure));
+            }
         }
     }
 }
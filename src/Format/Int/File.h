@@ -1,8 +1,10 @@
 ﻿#pragma once
 
+#include <array>
 #include <map>
 #include <string>
 #include <vector>
+#include "../../Format/Dat/BinaryReader.h"
 #include "../../Format/Dat/Item.h"
 #include "../../Format/Dat/Stream.h"
 #include "../../Format/Int/Procedure.h"
@@ -17,12 +19,24 @@ namespace Falltergeist
             {
                 public:
                     File(Dat::Stream&& stream);
+                    // _reader points into _stream's buffer, so neither may be copied or moved on their own
+                    File(const File&) = delete;
+                    File(File&&) = delete;
+                    File& operator=(const File&) = delete;
+                    File& operator=(File&&) = delete;
 
                     const std::vector<Procedure>& procedures() const;
 
+                    static const size_t STANDARD_PROCEDURES = static_cast<size_t>(STANDARD_PROCEDURE::COMBAT_IS_OVER) + 1;
+
                     // returns procedure with a given name or nullptr if none found
                     const Procedure* procedure(const std::string& name) const;
 
+                    // returns standard procedure or nullptr if script doesn't implement it, without looking it up by name
+                    const Procedure* procedure(STANDARD_PROCEDURE procedure) const;
+
+                    static const std::string& procedureName(STANDARD_PROCEDURE procedure);
+
                     const std::map<unsigned int, std::string>& identifiers() const;
                     const std::map<unsigned int, std::string>& strings() const;
 
@@ -43,8 +57,11 @@ namespace Falltergeist
 
                 protected:
                     Dat::Stream _stream;
+                    Dat::BigEndianReader _reader;
 
                     std::vector<Procedure> _procedures;
+                    // point into _procedures, which doesn't change after loading
+                    std::array<const Procedure*, STANDARD_PROCEDURES> _standardProcedures{};
 
                     std::map<unsigned int, std::string> _functions;
                     std::vector<unsigned int> _functionsOffsets;
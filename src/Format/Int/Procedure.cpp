@@ -95,7 +95,7 @@ namespace Falltergeist
                 return flags() & (unsigned)PROCEDURE_FLAG::INLINE;
             }
 
-            std::string Procedure::name() const
+            const std::string& Procedure::name() const
             {
                 return _name;
             }
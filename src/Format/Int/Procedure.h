@@ -30,7 +30,7 @@ namespace Falltergeist
                     uint32_t argumentsCounter();
                     void setArgumentsCounter(uint32_t value);
 
-                    std::string name() const;
+                    const std::string& name() const;
                     void setName(const std::string& name);
 
                     bool isTimed();
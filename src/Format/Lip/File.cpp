@@ -1,5 +1,5 @@
 #include "../../Exception.h"
-#include "../../Format/Dat/Stream.h"
+#include "../../Format/Dat/BinaryReader.h"
 #include "../../Format/Lip/File.h"
 
 namespace Falltergeist
@@ -10,30 +10,25 @@ namespace Falltergeist
         {
             File::File(Dat::Stream&& stream)
             {
-                stream.setPosition(0);
-                stream >> _version;
+                Dat::BigEndianReader reader(stream.data(), stream.size());
+                reader >> _version;
                 if (_version != 2)
                 {
                     throw Exception("Invalid LIP file.");
                 }
-                stream >> _unknown1 >> _unknown2 >> _unknown3;
-                stream >> _acmSize >> _phonemesCount;
-                stream >> _unknown4;
-                stream >> _markersCount;
-                stream.readBytes(_acmName, 8);
-                stream.readBytes(_unknown5, 4);
+                reader >> _unknown1 >> _unknown2 >> _unknown3;
+                reader >> _acmSize >> _phonemesCount;
+                reader >> _unknown4;
+                reader >> _markersCount;
+                reader.readBytes(_acmName, 8);
+                reader.readBytes(_unknown5, 4);
 
-                for (uint32_t i=0; i < _phonemesCount; i++)
-                {
-                    uint8_t phoneme;
-                    stream >> phoneme;
-                    _phonemes.push_back(phoneme);
-                }
+                _phonemes = reader.readArray<uint8_t>(_phonemesCount);
 
                 for (uint32_t i=0; i < _markersCount; i++)
                 {
                     uint32_t stype, smarker;
-                    stream >> stype >> smarker;
+                    reader >> stype >> smarker;
                     _markerSamples.push_back(smarker);
                     _markerTimestamps.push_back(smarker*1000 / 22050 /2); //ms
                 }
@@ -1,8 +1,7 @@
-#include <algorithm>
-#include <functional>
 #include <cctype>
 #include "../Dat/Stream.h"
 #include "../Lst/File.h"
+#include "../Txt/Tokenizer.h"
 
 namespace Falltergeist
 {
@@ -12,48 +11,37 @@ namespace Falltergeist
         {
             File::File(Dat::Stream&& stream)
             {
-                stream.setPosition(0);
-
-                std::string line;
-                unsigned char ch;
-                for (unsigned int i = 0; i != stream.size(); ++i)
-                {
-                    stream >> ch;
-                    if (ch == 0x0D) // \r
-                    {
-                        // do nothing
-                    }
-                    else if (ch == 0x0A) // \n
-                    {
-                        _addString(line);
-                        line.clear();
-                    }
-                    else
-                    {
-                        line += ch;
-                    }
-                }
-                if (line.size() != 0)
+                Txt::Tokenizer tokenizer(stream);
+                Base::StringView line;
+                while (tokenizer.nextLine(line))
                 {
                     _addString(line);
                 }
             }
 
-            void File::_addString(std::string line)
+            void File::_addString(Base::StringView line)
             {
-                // strip comments
-                if (auto pos = line.find(";")) line = line.substr(0, pos);
-
-                // rtrim
-                line.erase(std::find_if(line.rbegin(), line.rend(), std::not1(std::ptr_fun<int, int>(std::isspace))).base(), line.end());
-
-                // replace slashes
-                std::replace(line.begin(),line.end(),'\\','/');
+                // strip comments, a ';' in the very first column has never counted as one
+                size_t pos = line.find(';');
+                if (pos != 0)
+                {
+                    line = line.substr(0, pos);
+                }
 
-                // to lower
-                std::transform(line.begin(),line.end(),line.begin(), ::tolower);
+                line = line.rtrimmed();
 
-                _strings.push_back(line);
+                // the only copy of the line: drop stray '\r', replace slashes and lowercase at once
+                std::string value;
+                value.reserve(line.size());
+                for (char chr : line)
+                {
+                    if (chr == '\r')
+                    {
+                        continue;
+                    }
+                    value += (chr == '\\') ? '/' : static_cast<char>(std::tolower(static_cast<unsigned char>(chr)));
+                }
+                _strings.push_back(std::move(value));
             }
 
             std::vector<std::string>* File::strings()
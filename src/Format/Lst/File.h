@@ -2,6 +2,7 @@
 
 #include <string>
 #include <vector>
+#include "../../Base/StringView.h"
 #include "../Dat/Item.h"
 
 namespace Falltergeist
@@ -25,7 +26,7 @@ namespace Falltergeist
 
                 protected:
                     std::vector<std::string> _strings;
-                    void _addString(std::string line);
+                    void _addString(Base::StringView line);
             };
         }
     }
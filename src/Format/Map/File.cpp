@@ -20,64 +20,61 @@ namespace Falltergeist
                 }
                 _initialized = true;
 
-                auto& stream = _stream;
-                stream.setPosition(0);
+                Dat::BigEndianReader reader(_stream.data(), _stream.size());
 
-                _version = stream.uint32();
+                _version = reader.uint32();
 
                 uint8_t name[16];
-                stream.readBytes(name, 16);
+                reader.readBytes(name, 16);
                 _name = (char*)name;
                 std::transform(_name.begin(), _name.end(), _name.begin(), ::tolower);
 
-                _defaultPosition   = stream.uint32();
-                _defaultElevation  = stream.uint32();
-                _defaultOrientaion = stream.uint32();
-                _LVARsize          = stream.uint32();
-                _scriptId          = stream.int32();
-                _elevationFlags    = stream.uint32();
+                _defaultPosition   = reader.uint32();
+                _defaultElevation  = reader.uint32();
+                _defaultOrientaion = reader.uint32();
+                _LVARsize          = reader.uint32();
+                _scriptId          = reader.int32();
+                _elevationFlags    = reader.uint32();
 
                 unsigned elevations = 0;
                 if ((_elevationFlags & 2) == 0) elevations++;
                 if ((_elevationFlags & 4) == 0) elevations++;
                 if ((_elevationFlags & 8) == 0) elevations++;
 
-                _unknown1       = stream.int32();
-                _MVARsize       = stream.uint32();
-                _mapId          = stream.uint32();
-                _timeSinceEpoch = stream.uint32();
+                _unknown1       = reader.int32();
+                _MVARsize       = reader.uint32();
+                _mapId          = reader.uint32();
+                _timeSinceEpoch = reader.uint32();
 
-                stream.skipBytes(4*44); // unkonwn
+                reader.skipBytes(4*44); // unkonwn
 
                 // MVAR AND SVAR SECTION
-                _MVARS.reserve(_MVARsize);
-                for (unsigned int i = 0; i != _MVARsize; ++i)
-                {
-                    _MVARS.push_back(stream.int32());
-                }
-
-                _LVARS.reserve(_LVARsize);
-                for (unsigned int i = 0; i != _LVARsize; ++i)
-                {
-                    _LVARS.push_back(stream.int32());
-                }
+                _MVARS = reader.readArray<int32_t>(_MVARsize);
+                _LVARS = reader.readArray<int32_t>(_LVARsize);
 
                 // TILES SECTION
+                // roof and floor tile numbers are interleaved, so read the whole elevation at once and split it
+                std::vector<uint16_t> tiles(10000 * 2);
                 for (unsigned int i = 0; i < elevations; i++)
                 {
                     _elevations.emplace_back();
+                    auto& roofTiles = _elevations.back().roofTiles();
+                    auto& floorTiles = _elevations.back().floorTiles();
+                    roofTiles.resize(10000);
+                    floorTiles.resize(10000);
 
-                    for (unsigned i = 0; i < 10000; i++)
+                    reader.readArray(tiles.data(), tiles.size());
+                    for (unsigned j = 0; j < 10000; j++)
                     {
-                        _elevations.back().roofTiles().push_back(stream.uint16());
-                        _elevations.back().floorTiles().push_back(stream.uint16());
+                        roofTiles[j] = tiles[j * 2];
+                        floorTiles[j] = tiles[j * 2 + 1];
                     }
                 }
 
                 // SCRIPTS SECTION
                 for (unsigned i = 0; i < 5; i++)
                 {
-                    uint32_t count = stream.uint32();
+                    uint32_t count = reader.uint32();
                     if (count > 0)
                     {
                         uint32_t loop = count;
@@ -90,9 +87,9 @@ namespace Falltergeist
                         for (unsigned j = 0; j < loop; j++)
                         {
                             Script script;
-                            script.setPID(stream.int32());
+                            script.setPID(reader.int32());
 
-                            stream.uint32(); // next script. unused
+                            reader.uint32(); // next script. unused
 
                             switch ((script.PID() & 0xFF000000) >> 24)
                             {
@@ -101,12 +98,12 @@ namespace Falltergeist
                                     break;
                                 case 1:
                                     script.setType(Script::Type::SPATIAL);
-                                    script.setSpatialTile(stream.uint32());
-                                    script.setSpatialRadius(stream.uint32());
+                                    script.setSpatialTile(reader.uint32());
+                                    script.setSpatialRadius(reader.uint32());
                                     break;
                                 case 2:
                                     script.setType(Script::Type::TIMER);
-                                    script.setTimerTime(stream.uint32());
+                                    script.setTimerTime(reader.uint32());
                                     break;
                                 case 3:
                                     script.setType(Script::Type::ITEM);
@@ -117,20 +114,20 @@ namespace Falltergeist
                                 default:
                                     break;
                             }
-                            stream.uint32(); //flags
-                            script.setScriptId(stream.int32());
-                            stream.uint32(); //unknown 5
-                            stream.uint32(); //oid == object->OID
-                            stream.uint32(); //local var offset
-                            stream.uint32(); //loal var cnt
-                            stream.uint32(); //unknown 9
-                            stream.uint32(); //unknown 10
-                            stream.uint32(); //unknown 11
-                            stream.uint32(); //unknown 12
-                            stream.uint32(); //unknown 13
-                            stream.uint32(); //unknown 14
-                            stream.uint32(); //unknown 15
-                            stream.uint32(); //unknown 16
+                            reader.uint32(); //flags
+                            script.setScriptId(reader.int32());
+                            reader.uint32(); //unknown 5
+                            reader.uint32(); //oid == object->OID
+                            reader.uint32(); //local var offset
+                            reader.uint32(); //loal var cnt
+                            reader.uint32(); //unknown 9
+                            reader.uint32(); //unknown 10
+                            reader.uint32(); //unknown 11
+                            reader.uint32(); //unknown 12
+                            reader.uint32(); //unknown 13
+                            reader.uint32(); //unknown 14
+                            reader.uint32(); //unknown 15
+                            reader.uint32(); //unknown 16
 
                             if (j < count)
                             {
@@ -139,8 +136,8 @@ namespace Falltergeist
 
                             if ((j % 16) == 15)
                             {
-                                check += stream.uint32();
-                                stream.uint32();
+                                check += reader.uint32();
+                                reader.uint32();
                             }
                         }
                         if (check != count)
@@ -151,19 +148,19 @@ namespace Falltergeist
                 }
 
                 //OBJECTS SECTION
-                stream.uint32(); // objects total
+                reader.uint32(); // objects total
                 for (auto& elev : _elevations)
                 {
-                    auto objectsOnElevation = stream.uint32();
+                    auto objectsOnElevation = reader.uint32();
                     for (size_t j = 0; j != objectsOnElevation; ++j)
                     {
-                        auto object = _readObject(stream, callback);
+                        auto object = _readObject(reader, callback);
                         if (object->inventorySize() > 0)
                         {
                             for (size_t i = 0; i < object->inventorySize(); ++i)
                             {
-                                uint32_t amount = stream.uint32();
-                                auto subobject = _readObject(stream, callback);
+                                uint32_t amount = reader.uint32();
+                                auto subobject = _readObject(reader, callback);
                                 subobject->setAmmount(amount);
                                 object->children().emplace_back(std::move(subobject));
                             }
@@ -173,31 +170,31 @@ namespace Falltergeist
                 }
             }
 
-            std::unique_ptr<Object> File::_readObject(Dat::Stream& stream, ProFileTypeLoaderCallback callback)
+            std::unique_ptr<Object> File::_readObject(Dat::BigEndianReader& reader, ProFileTypeLoaderCallback callback)
             {
                 auto object = std::make_unique<Object>();
-                object->setOID(stream.uint32());
-                object->setHexPosition(stream.int32());
-                object->setX(stream.uint32());
-                object->setY(stream.uint32());
-                object->setSx(stream.uint32());
-                object->setSy(stream.uint32());
-                object->setFrameNumber(stream.uint32());
-                object->setOrientation(stream.uint32());
-                uint32_t FID = stream.uint32();
+                object->setOID(reader.uint32());
+                object->setHexPosition(reader.int32());
+                object->setX(reader.uint32());
+                object->setY(reader.uint32());
+                object->setSx(reader.uint32());
+                object->setSy(reader.uint32());
+                object->setFrameNumber(reader.uint32());
+                object->setOrientation(reader.uint32());
+                uint32_t FID = reader.uint32();
                 object->setFrmTypeId(FID >> 24);
                 object->setFrmId(0x00FFFFFF & FID);
-                object->setFlags(stream.uint32());
-                object->setElevation(stream.uint32());
-                uint32_t PID = stream.uint32();
+                object->setFlags(reader.uint32());
+                object->setElevation(reader.uint32());
+                uint32_t PID = reader.uint32();
                 object->setObjectTypeId(PID >> 24);
                 object->setObjectId(0x00FFFFFF & PID);
-                object->setCombatId(stream.uint32());
-                object->setLightRadius(stream.uint32());
-                object->setLightIntensity(stream.uint32());
-                object->setOutline(stream.uint32());
+                object->setCombatId(reader.uint32());
+                object->setLightRadius(reader.uint32());
+                object->setLightIntensity(reader.uint32());
+                object->setOutline(reader.uint32());
 
-                int32_t SID = stream.int32();
+                int32_t SID = reader.int32();
                 if (SID != -1)
                 {
                     for (auto& script : _scripts)
@@ -210,16 +207,16 @@ namespace Falltergeist
                     }
                 }
 
-                SID = stream.int32();
+                SID = reader.int32();
                 if (SID != -1)
                 {
                     object->setScriptId(SID);
                 }
 
-                object->setInventorySize(stream.uint32());
-                object->setMaxInventorySize(stream.uint32());
-                object->setUnknown12(stream.uint32());
-                object->setUnknown13(stream.uint32());
+                object->setInventorySize(reader.uint32());
+                object->setMaxInventorySize(reader.uint32());
+                object->setUnknown12(reader.uint32());
+                object->setUnknown13(reader.uint32());
 
                 switch ((OBJECT_TYPE)object->objectTypeId())
                 {
@@ -228,17 +225,17 @@ namespace Falltergeist
                         switch((ITEM_TYPE)object->objectSubtypeId())
                         {
                             case ITEM_TYPE::AMMO:
-                                object->setAmmo(stream.uint32()); // bullets
+                                object->setAmmo(reader.uint32()); // bullets
                                 break;
                             case ITEM_TYPE::KEY:
-                                stream.uint32(); // keycode = -1 in all maps. saves only? ignore for now
+                                reader.uint32(); // keycode = -1 in all maps. saves only? ignore for now
                                 break;
                             case ITEM_TYPE::MISC:
-                                object->setAmmo(stream.uint32()); //charges - have strangely high values, or negative.
+                                object->setAmmo(reader.uint32()); //charges - have strangely high values, or negative.
                                 break;
                             case ITEM_TYPE::WEAPON:
-                                object->setAmmo(stream.uint32()); // ammo
-                                object->setAmmoPID(stream.uint32()); // ammo pid
+                                object->setAmmo(reader.uint32()); // ammo
+                                object->setAmmoPID(reader.uint32()); // ammo pid
                                 break;
                             case ITEM_TYPE::ARMOR:
                                 break;
@@ -251,16 +248,16 @@ namespace Falltergeist
                         }
                         break;
                     case OBJECT_TYPE::CRITTER:
-                        stream.uint32(); //reaction to player - saves only
-                        stream.uint32(); //current mp - saves only
-                        stream.uint32(); //combat results - saves only
-                        stream.uint32(); //damage last turn - saves only
-                        object->setAIPacket(stream.uint32()); // AI packet - is it different from .pro? well, it can be
-                        stream.uint32(); // team - always 1? saves only?
-                        stream.uint32(); // who hit me - saves only
-                        stream.uint32(); // hit points - saves only, otherwise = value from .pro
-                        stream.uint32(); // rad - always 0 - saves only
-                        stream.uint32(); // poison - always 0 - saves only
+                        reader.uint32(); //reaction to player - saves only
+                        reader.uint32(); //current mp - saves only
+                        reader.uint32(); //combat results - saves only
+                        reader.uint32(); //damage last turn - saves only
+                        object->setAIPacket(reader.uint32()); // AI packet - is it different from .pro? well, it can be
+                        reader.uint32(); // team - always 1? saves only?
+                        reader.uint32(); // who hit me - saves only
+                        reader.uint32(); // hit points - saves only, otherwise = value from .pro
+                        reader.uint32(); // rad - always 0 - saves only
+                        reader.uint32(); // poison - always 0 - saves only
                         object->setFrmId(FID & 0x00000FFF);
                         object->setObjectID1((FID & 0x0000F000) >> 12);
                         object->setObjectID2((FID & 0x00FF0000) >> 16);
@@ -277,19 +274,19 @@ namespace Falltergeist
                             case SCENERY_TYPE::LADDER_TOP:
                             case SCENERY_TYPE::LADDER_BOTTOM:
                             case SCENERY_TYPE::STAIRS:
-                                elevhex = stream.uint32();  // elev+hex
+                                elevhex = reader.uint32();  // elev+hex
                                 hex = elevhex & 0xFFFF;
                                 elev = ((elevhex >> 28) & 0xf) >> 1;
-                                object->setExitMap(stream.int32()); // map id
+                                object->setExitMap(reader.int32()); // map id
                                 object->setExitPosition(hex);
                                 object->setExitElevation(elev);
                                 break;
                             case SCENERY_TYPE::ELEVATOR:
-                                object->setElevatorType(stream.uint32()); // elevator type - sometimes -1
-                                object->setElevatorLevel(stream.uint32()); // current level - sometimes -1
+                                object->setElevatorType(reader.uint32()); // elevator type - sometimes -1
+                                object->setElevatorLevel(reader.uint32()); // current level - sometimes -1
                                 break;
                             case SCENERY_TYPE::DOOR:
-                                object->setOpened(stream.uint32() != 0);// is opened;
+                                object->setOpened(reader.uint32() != 0);// is opened;
                                 break;
                             case SCENERY_TYPE::GENERIC:
                                 break;
@@ -315,16 +312,16 @@ namespace Falltergeist
                             case 21:
                             case 22:
                             case 23:
-                                object->setExitMap(stream.int32());
-                                object->setExitPosition(stream.int32());
-                                object->setExitElevation(stream.int32());
-                                object->setExitOrientation(stream.int32());
+                                object->setExitMap(reader.int32());
+                                object->setExitPosition(reader.int32());
+                                object->setExitElevation(reader.int32());
+                                object->setExitOrientation(reader.int32());
                                 break;
                             default:
-                                stream.uint32();
-                                stream.uint32();
-                                stream.uint32();
-                                stream.uint32();
+                                reader.uint32();
+                                reader.uint32();
+                                reader.uint32();
+                                reader.uint32();
                                 break;
                         }
                         break;
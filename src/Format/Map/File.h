@@ -2,6 +2,7 @@
 
 #include <string>
 #include <vector>
+#include "../Dat/BinaryReader.h"
 #include "../Dat/Item.h"
 #include "../Dat/Stream.h"
 #include "../Map/Elevation.h"
@@ -78,7 +79,7 @@ namespace Falltergeist
 
                     std::string _name;
 
-                    std::unique_ptr<Object> _readObject(Dat::Stream& stream, ProFileTypeLoaderCallback callback);
+                    std::unique_ptr<Object> _readObject(Dat::BigEndianReader& reader, ProFileTypeLoaderCallback callback);
             };
         }
     }
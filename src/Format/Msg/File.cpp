@@ -2,6 +2,7 @@
 #include "../../Exception.h"
 #include "../../Format/Msg/File.h"
 #include "../../Format/Dat/Stream.h"
+#include "../../Format/Txt/Tokenizer.h"
 
 namespace Falltergeist
 {
@@ -11,72 +12,43 @@ namespace Falltergeist
         {
             File::File(Dat::Stream&& stream)
             {
-                stream.setPosition(0);
+                Txt::Tokenizer tokenizer(stream);
 
                 /*
                  * Because of bug in CMBATAI2.MSG in messages #1382 and #32020 we need to explode each line with '{' symbol
                  * Any extra '}' symbols must be trimed from exploded parts
                  */
 
-                while (stream.position() < stream.size())
+                while (tokenizer.skipPast('{'))
                 {
-                    uint8_t chr = stream.uint8();
-                    if (chr == '{')
+                    Base::StringView number;
+                    Base::StringView sound;
+                    if (!tokenizer.nextUntil('{', number) || !tokenizer.nextUntil('{', sound))
                     {
-                        std::string number;
-                        std::string sound;
-                        std::string text;
-                        chr = 0;
-                        // number
-                        while (chr != '{')
-                        {
-                            chr = stream.uint8();
-                            if (chr != '{' && chr != '}')
-                            {
-                                number += chr;
-                            }
-                        }
-
-                        // sound
-                        chr = 0;
-                        while (chr != '{')
-                        {
-                            chr = stream.uint8();
-                            if (chr != '{' && chr != '}')
-                            {
-                                sound += chr;
-                            }
-                        }
+                        throw Exception("File::File() - unexpected end of message");
+                    }
+                    number = number.substr(0, number.find('}'));
+                    sound = sound.substr(0, sound.find('}'));
 
-                        chr = 0;
-                        // text
-                        while (chr != '}' && chr != '{' && stream.position() < stream.size())
-                        {
-                            chr = stream.uint8();
-                            if (chr != '{' && chr != '}')
-                            {
-                                text += chr;
-                            }
-                        }
+                    // text ends at the closing brace or at the opening one of the next message, which is left unread
+                    auto text = tokenizer.nextUntilAny("{}");
 
-                        // "put back" last character
-                        stream.setPosition(stream.position() - 1);
+                    _messages.emplace_back();
+                    Message& message = _messages.back();
+                    message.setNumber(Txt::Tokenizer::toInt(number));
+                    message.setSound(sound.str());
 
-                        while (text.find("\n") != std::string::npos)
-                        {
-                            text.replace(text.find("\n"), 1, "");
-                        }
-                        while (text.find("\r") != std::string::npos)
+                    // line breaks are removed while copying, the only allocation per message
+                    std::string messageText;
+                    messageText.reserve(text.size());
+                    for (char chr : text)
+                    {
+                        if (chr != '\n' && chr != '\r')
                         {
-                            text.replace(text.find("\r"), 1, "");
+                            messageText += chr;
                         }
-
-                        Message message;
-                        message.setNumber(std::stoi(number));
-                        message.setSound(sound);
-                        message.setText(text);
-                        _messages.push_back(message);
                     }
+                    message.setText(std::move(messageText));
                 }
             }
 
@@ -1,3 +1,4 @@
+#include <utility>
 #include "../../Format/Msg/Message.h"
 
 namespace Falltergeist
@@ -26,7 +27,7 @@ namespace Falltergeist
 
             void Message::setSound(std::string sound)
             {
-                _sound = sound;
+                _sound = std::move(sound);
             }
 
             std::string Message::sound()
@@ -36,7 +37,7 @@ namespace Falltergeist
 
             void Message::setText(std::string text)
             {
-                _text = text;
+                _text = std::move(text);
             }
 
             std::string Message::text()
@@ -35,6 +35,11 @@ namespace Falltergeist
             {
                 return _opcodes;
             }
+
+            std::vector<uint8_t>& Chunk::data()
+            {
+                return _data;
+            }
         }
     }
 }
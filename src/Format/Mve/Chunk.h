@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include "../Mve/Opcode.h"
@@ -22,10 +23,14 @@ namespace Falltergeist
                     std::vector<Opcode>& opcodes();
                     const std::vector<Opcode>& opcodes() const;
 
+                    // raw chunk payload, opcodes point into it. Capacity is kept when a chunk object is reused.
+                    std::vector<uint8_t>& data();
+
                 protected:
-                    uint16_t _length;
-                    uint16_t _type;
+                    uint16_t _length = 0;
+                    uint16_t _type = 0;
                     std::vector<Opcode> _opcodes;
+                    std::vector<uint8_t> _data;
             };
         }
     }
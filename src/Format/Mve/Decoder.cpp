@@ -0,0 +1,585 @@
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include "../Mve/Decoder.h"
+#include "../Mve/Opcode.h"
+#include "../../Exception.h"
+
+namespace Falltergeist
+{
+    namespace Format
+    {
+        namespace Mve
+        {
+            namespace
+            {
+                const uint8_t OPCODE_INIT_VIDEO_BUFFER = 0x05;
+                const uint8_t OPCODE_SET_PALETTE = 0x0C;
+                const uint8_t OPCODE_SET_DECODING_MAP = 0x0F;
+                const uint8_t OPCODE_VIDEO_DATA = 0x11;
+
+                uint16_t readUint16(const uint8_t* data)
+                {
+                    return static_cast<uint16_t>(data[0] | (data[1] << 8));
+                }
+
+                // Byte selectors of 2-color patterns: byte k of an entry is 0xFF if pixel k takes the second color.
+                // Entries are built byte by byte, so they work the same on any byte order.
+                struct PatternMasks
+                {
+                    // one bit per pixel, 8 pixels
+                    uint64_t row[256];
+                    // one bit per 2 pixels, 8 pixels
+                    uint64_t doubledRow[16];
+                    // one bit per pixel, 4 pixels
+                    uint32_t halfRow[16];
+
+                    PatternMasks()
+                    {
+                        for (unsigned int mask = 0; mask != 256; ++mask)
+                        {
+                            uint8_t bytes[8];
+                            for (unsigned int k = 0; k != 8; ++k)
+                            {
+                                bytes[k] = (mask >> k) & 1 ? 0xFF : 0x00;
+                            }
+                            std::memcpy(&row[mask], bytes, 8);
+                        }
+                        for (unsigned int mask = 0; mask != 16; ++mask)
+                        {
+                            uint8_t bytes[8];
+                            for (unsigned int k = 0; k != 8; ++k)
+                            {
+                                bytes[k] = (mask >> (k / 2)) & 1 ? 0xFF : 0x00;
+                            }
+                            std::memcpy(&doubledRow[mask], bytes, 8);
+                            for (unsigned int k = 0; k != 4; ++k)
+                            {
+                                bytes[k] = (mask >> k) & 1 ? 0xFF : 0x00;
+                            }
+                            std::memcpy(&halfRow[mask], bytes, 4);
+                        }
+                    }
+                };
+
+                const PatternMasks& patternMasks()
+                {
+                    static const PatternMasks masks;
+                    return masks;
+                }
+
+                inline uint64_t broadcast8(uint8_t color)
+                {
+                    return UINT64_C(0x0101010101010101) * color;
+                }
+
+                inline uint32_t broadcast4(uint8_t color)
+                {
+                    return UINT32_C(0x01010101) * color;
+                }
+
+                // 8 pixels of c1, with c2 where selector bytes are set
+                inline void fillRow(uint8_t* dst, uint8_t c1, uint8_t c2, uint64_t selector)
+                {
+                    uint64_t value = broadcast8(c1) ^ ((broadcast8(c1) ^ broadcast8(c2)) & selector);
+                    std::memcpy(dst, &value, 8);
+                }
+
+                inline void fillHalfRow(uint8_t* dst, uint8_t c1, uint8_t c2, uint32_t selector)
+                {
+                    uint32_t value = broadcast4(c1) ^ ((broadcast4(c1) ^ broadcast4(c2)) & selector);
+                    std::memcpy(dst, &value, 4);
+                }
+
+                // 4x4 block of 2 colors, each mask byte covers 2 rows
+                inline void fillQuadrant(uint8_t* dst, unsigned int stride, uint8_t c1, uint8_t c2, uint8_t mask1, uint8_t mask2)
+                {
+                    auto& masks = patternMasks();
+                    fillHalfRow(dst,              c1, c2, masks.halfRow[mask1 & 0x0F]);
+                    fillHalfRow(dst + stride,     c1, c2, masks.halfRow[mask1 >> 4]);
+                    fillHalfRow(dst + stride * 2, c1, c2, masks.halfRow[mask2 & 0x0F]);
+                    fillHalfRow(dst + stride * 3, c1, c2, masks.halfRow[mask2 >> 4]);
+                }
+
+                // 4 pixels of 4 colors, 2 bits of mask per pixel
+                inline void fillHalfRow4(uint8_t* dst, const uint8_t* colors, uint8_t mask)
+                {
+                    dst[0] = colors[mask & 3];
+                    dst[1] = colors[(mask >> 2) & 3];
+                    dst[2] = colors[(mask >> 4) & 3];
+                    dst[3] = colors[mask >> 6];
+                }
+
+                // same as above, but each pixel is 2 pixels wide
+                inline void fillRow4Doubled(uint8_t* dst, const uint8_t* colors, uint8_t mask)
+                {
+                    for (unsigned int k = 0; k != 4; ++k)
+                    {
+                        dst[k * 2] = dst[k * 2 + 1] = colors[(mask >> (k * 2)) & 3];
+                    }
+                }
+
+                // 4x4 block of 4 colors, one mask byte per row
+                inline void fillQuadrant4(uint8_t* dst, unsigned int stride, const uint8_t* colors, const uint8_t* masks)
+                {
+                    for (unsigned int row = 0; row != 4; ++row)
+                    {
+                        fillHalfRow4(dst + stride * row, colors, masks[row]);
+                    }
+                }
+            }
+
+            Decoder::Decoder()
+            {
+                _palette.fill(0x000000FF);
+            }
+
+            bool Decoder::decode(Opcode& opcode)
+            {
+                switch (opcode.type())
+                {
+                    case OPCODE_INIT_VIDEO_BUFFER:
+                        if (opcode.length() < 4)
+                        {
+                            throw Exception("Decoder::decode() - video buffer opcode is too short");
+                        }
+                        // can be sent several times (intro and tanker)
+                        initBuffers(readUint16(opcode.data()), readUint16(opcode.data() + 2));
+                        return false;
+                    case OPCODE_SET_PALETTE:
+                        setPalette(opcode.data(), opcode.length());
+                        return false;
+                    case OPCODE_SET_DECODING_MAP:
+                        setDecodingMap(opcode.data(), opcode.length());
+                        return false;
+                    case OPCODE_VIDEO_DATA:
+                        decodeVideo(opcode.data(), opcode.length());
+                        return true;
+                    default:
+                        return false;
+                }
+            }
+
+            void Decoder::initBuffers(uint16_t blocksWide, uint16_t blocksHigh)
+            {
+                // repeated with the same size, buffers keep the previous frame which next one may copy blocks from
+                if (!_current.empty() && blocksWide == _blocksWide && blocksHigh == _blocksHigh)
+                {
+                    return;
+                }
+                _blocksWide = blocksWide;
+                _blocksHigh = blocksHigh;
+                _width = blocksWide * 8;
+                _height = blocksHigh * 8;
+                _current.assign(_width * _height, 0);
+                _back.assign(_width * _height, 0);
+                _decodingMap.assign(_blocksWide * _blocksHigh, 0);
+            }
+
+            void Decoder::setPalette(const uint8_t* data, uint32_t length)
+            {
+                if (length < 4)
+                {
+                    throw Exception("Decoder::setPalette() - palette opcode is too short");
+                }
+                unsigned int start = readUint16(data);
+                unsigned int count = readUint16(data + 2);
+                if (length < 4 + count * 3)
+                {
+                    throw Exception("Decoder::setPalette() - palette is truncated");
+                }
+
+                const uint8_t* color = data + 4;
+                unsigned int end = std::min(start + count, 256u);
+                for (unsigned int i = start; i < end; ++i, color += 3)
+                {
+                    // 6 bits per channel
+                    uint32_t r = (color[0] & 0x3F) << 2;
+                    uint32_t g = (color[1] & 0x3F) << 2;
+                    uint32_t b = (color[2] & 0x3F) << 2;
+                    _palette[i] = (r << 24) | (g << 16) | (b << 8) | 0xFF;
+                }
+            }
+
+            void Decoder::setDecodingMap(const uint8_t* data, uint32_t length)
+            {
+                // 4 bits per block, with odd number of blocks the high nibble of the last byte is unused
+                const size_t blocks = _decodingMap.size();
+                if (length < (blocks + 1) / 2)
+                {
+                    throw Exception("Decoder::setDecodingMap() - decoding map is truncated");
+                }
+                for (size_t i = 0; i != blocks / 2; ++i)
+                {
+                    _decodingMap[i * 2] = data[i] & 0x0F;
+                    _decodingMap[i * 2 + 1] = data[i] >> 4;
+                }
+                if (blocks % 2)
+                {
+                    _decodingMap[blocks - 1] = data[blocks / 2] & 0x0F;
+                }
+            }
+
+            void Decoder::decodeVideo(const uint8_t* data, uint32_t length)
+            {
+                if (_current.empty())
+                {
+                    throw Exception("Decoder::decodeVideo() - video buffers are not initialized");
+                }
+                if (length < 14)
+                {
+                    throw Exception("Decoder::decodeVideo() - video opcode is too short");
+                }
+
+                // header: hot and cold frame, x and y offset, x and y size, flags
+                uint16_t flags = readUint16(data + 12);
+                if (flags & 1)
+                {
+                    std::swap(_current, _back);
+                }
+                _decodeBlocks(data + 14, length - 14);
+            }
+
+            unsigned int Decoder::width() const
+            {
+                return _width;
+            }
+
+            unsigned int Decoder::height() const
+            {
+                return _height;
+            }
+
+            const uint8_t* Decoder::pixels() const
+            {
+                return _current.data();
+            }
+
+            const std::array<uint32_t, 256>& Decoder::palette() const
+            {
+                return _palette;
+            }
+
+            void Decoder::_copyBlock(const uint8_t* source, int sourceX, int sourceY, unsigned int x, unsigned int y)
+            {
+                int dstX = static_cast<int>(x);
+                int dstY = static_cast<int>(y);
+                int width = 8;
+                int height = 8;
+
+                // parts of the source outside of the frame are not copied
+                if (sourceX < 0)
+                {
+                    dstX -= sourceX;
+                    width += sourceX;
+                    sourceX = 0;
+                }
+                if (sourceY < 0)
+                {
+                    dstY -= sourceY;
+                    height += sourceY;
+                    sourceY = 0;
+                }
+                width = std::min(width, static_cast<int>(_width) - sourceX);
+                height = std::min(height, static_cast<int>(_height) - sourceY);
+                if (width <= 0 || height <= 0)
+                {
+                    return;
+                }
+
+                const uint8_t* src = source + sourceY * _width + sourceX;
+                uint8_t* dst = _current.data() + dstY * _width + dstX;
+                if (source == _current.data() && dst > src)
+                {
+                    // block overlaps its source in the same buffer: go bottom up, so rows are read before they're overwritten
+                    for (int row = height - 1; row >= 0; --row)
+                    {
+                        std::memmove(dst + row * _width, src + row * _width, width);
+                    }
+                    return;
+                }
+                for (int row = 0; row != height; ++row)
+                {
+                    std::memmove(dst + row * _width, src + row * _width, width);
+                }
+            }
+
+            void Decoder::_decodeBlocks(const uint8_t* data, uint32_t length)
+            {
+                const uint8_t* end = data + length;
+                auto require = [&data, end](size_t bytes)
+                {
+                    if (static_cast<size_t>(end - data) < bytes)
+                    {
+                        throw Exception("Decoder::decodeVideo() - video data is truncated");
+                    }
+                };
+
+                auto& masks = patternMasks();
+                const unsigned int stride = _width;
+                const uint8_t* back = _back.data();
+                const size_t blocks = _decodingMap.size();
+
+                for (size_t block = 0; block < blocks; ++block)
+                {
+                    unsigned int x = static_cast<unsigned int>(block % _blocksWide) * 8;
+                    unsigned int y = static_cast<unsigned int>(block / _blocksWide) * 8;
+                    uint8_t* dst = _current.data() + y * stride + x;
+
+                    switch (_decodingMap[block])
+                    {
+                        case 0x0:
+                            // same block of the previous frame
+                            _copyBlock(back, x, y, x, y);
+                            break;
+                        case 0x1:
+                            // unchanged
+                            break;
+                        case 0x2:
+                        case 0x3:
+                        {
+                            // block of the current frame, below/right (0x2) or above/left (0x3) of this one
+                            require(1);
+                            int b = *data++;
+                            int dx, dy;
+                            if (b < 56)
+                            {
+                                dx = 8 + (b % 7);
+                                dy = b / 7;
+                            }
+                            else
+                            {
+                                dx = -14 + ((b - 56) % 29);
+                                dy = 8 + ((b - 56) / 29);
+                            }
+                            int sign = _decodingMap[block] == 0x2 ? 1 : -1;
+                            _copyBlock(_current.data(), x + sign * dx, y + sign * dy, x, y);
+                            break;
+                        }
+                        case 0x4:
+                        {
+                            // block of the previous frame, up to 8 pixels away
+                            require(1);
+                            uint8_t b = *data++;
+                            _copyBlock(back, x + (b & 0x0F) - 8, y + (b >> 4) - 8, x, y);
+                            break;
+                        }
+                        case 0x5:
+                            require(2);
+                            _copyBlock(back, x + static_cast<int8_t>(data[0]), y + static_cast<int8_t>(data[1]), x, y);
+                            data += 2;
+                            break;
+                        case 0x6:
+                            // skip next 2 blocks
+                            block += 2;
+                            break;
+                        case 0x7:
+                            // 2 colors
+                            require(2);
+                            if (data[0] <= data[1])
+                            {
+                                // 1 bit per pixel
+                                require(10);
+                                for (unsigned int row = 0; row != 8; ++row)
+                                {
+                                    fillRow(dst + stride * row, data[0], data[1], masks.row[data[2 + row]]);
+                                }
+                                data += 10;
+                            }
+                            else
+                            {
+                                // 1 bit per 2x2 pixels
+                                require(4);
+                                for (unsigned int row = 0; row != 8; ++row)
+                                {
+                                    uint8_t mask = data[2 + row / 4] >> (((row / 2) & 1) * 4);
+                                    fillRow(dst + stride * row, data[0], data[1], masks.doubledRow[mask & 0x0F]);
+                                }
+                                data += 4;
+                            }
+                            break;
+                        case 0x8:
+                            // 2 colors per half or quadrant
+                            require(2);
+                            if (data[0] <= data[1])
+                            {
+                                // quadrants
+                                // 0 | 2
+                                // -----
+                                // 1 | 3
+                                require(16);
+                                fillQuadrant(dst,                  stride, data[0],  data[1],  data[2],  data[3] );
+                                fillQuadrant(dst + stride * 4,     stride, data[4],  data[5],  data[6],  data[7] );
+                                fillQuadrant(dst + 4,              stride, data[8],  data[9],  data[10], data[11]);
+                                fillQuadrant(dst + stride * 4 + 4, stride, data[12], data[13], data[14], data[15]);
+                                data += 16;
+                            }
+                            else
+                            {
+                                require(12);
+                                if (data[6] <= data[7])
+                                {
+                                    // left | right
+                                    fillQuadrant(dst,                  stride, data[0], data[1], data[2],  data[3] );
+                                    fillQuadrant(dst + stride * 4,     stride, data[0], data[1], data[4],  data[5] );
+                                    fillQuadrant(dst + 4,              stride, data[6], data[7], data[8],  data[9] );
+                                    fillQuadrant(dst + stride * 4 + 4, stride, data[6], data[7], data[10], data[11]);
+                                }
+                                else
+                                {
+                                    // top / bottom
+                                    for (unsigned int row = 0; row != 4; ++row)
+                                    {
+                                        fillRow(dst + stride * row,       data[0], data[1], masks.row[data[2 + row]]);
+                                        fillRow(dst + stride * (row + 4), data[6], data[7], masks.row[data[8 + row]]);
+                                    }
+                                }
+                                data += 12;
+                            }
+                            break;
+                        case 0x9:
+                            // 4 colors, 2 bits per pixel
+                            require(4);
+                            if (data[0] <= data[1] && data[2] <= data[3])
+                            {
+                                require(20);
+                                for (unsigned int row = 0; row != 8; ++row)
+                                {
+                                    fillHalfRow4(dst + stride * row,     data, data[4 + row * 2]);
+                                    fillHalfRow4(dst + stride * row + 4, data, data[5 + row * 2]);
+                                }
+                                data += 20;
+                            }
+                            else if (data[0] <= data[1])
+                            {
+                                // 2x2 pixels
+                                require(8);
+                                for (unsigned int row = 0; row != 8; row += 2)
+                                {
+                                    fillRow4Doubled(dst + stride * row, data, data[4 + row / 2]);
+                                    std::memcpy(dst + stride * (row + 1), dst + stride * row, 8);
+                                }
+                                data += 8;
+                            }
+                            else if (data[2] <= data[3])
+                            {
+                                // 2x1 pixels
+                                require(12);
+                                for (unsigned int row = 0; row != 8; ++row)
+                                {
+                                    fillRow4Doubled(dst + stride * row, data, data[4 + row]);
+                                }
+                                data += 12;
+                            }
+                            else
+                            {
+                                // 1x2 pixels
+                                require(12);
+                                for (unsigned int row = 0; row != 8; row += 2)
+                                {
+                                    fillHalfRow4(dst + stride * row,     data, data[4 + row]);
+                                    fillHalfRow4(dst + stride * row + 4, data, data[5 + row]);
+                                    std::memcpy(dst + stride * (row + 1), dst + stride * row, 8);
+                                }
+                                data += 12;
+                            }
+                            break;
+                        case 0xA:
+                            // 4 colors per half or quadrant
+                            require(2);
+                            if (data[0] <= data[1])
+                            {
+                                // quadrants
+                                // 0 | 2
+                                // -----
+                                // 1 | 3
+                                require(32);
+                                fillQuadrant4(dst,                  stride, data,      data + 4 );
+                                fillQuadrant4(dst + stride * 4,     stride, data + 8,  data + 12);
+                                fillQuadrant4(dst + 4,              stride, data + 16, data + 20);
+                                fillQuadrant4(dst + stride * 4 + 4, stride, data + 24, data + 28);
+                                data += 32;
+                            }
+                            else
+                            {
+                                require(24);
+                                if (data[12] <= data[13])
+                                {
+                                    // left | right
+                                    fillQuadrant4(dst,                  stride, data,      data + 4 );
+                                    fillQuadrant4(dst + stride * 4,     stride, data,      data + 8 );
+                                    fillQuadrant4(dst + 4,              stride, data + 12, data + 16);
+                                    fillQuadrant4(dst + stride * 4 + 4, stride, data + 12, data + 20);
+                                }
+                                else
+                                {
+                                    // top / bottom
+                                    for (unsigned int row = 0; row != 4; ++row)
+                                    {
+                                        fillHalfRow4(dst + stride * row,           data,      data[4 + row * 2] );
+                                        fillHalfRow4(dst + stride * row + 4,       data,      data[5 + row * 2] );
+                                        fillHalfRow4(dst + stride * (row + 4),     data + 12, data[16 + row * 2]);
+                                        fillHalfRow4(dst + stride * (row + 4) + 4, data + 12, data[17 + row * 2]);
+                                    }
+                                }
+                                data += 24;
+                            }
+                            break;
+                        case 0xB:
+                            // raw pixels
+                            require(64);
+                            for (unsigned int row = 0; row != 8; ++row)
+                            {
+                                std::memcpy(dst + stride * row, data + row * 8, 8);
+                            }
+                            data += 64;
+                            break;
+                        case 0xC:
+                            // raw 2x2 pixels
+                            require(16);
+                            for (unsigned int row = 0; row != 8; row += 2)
+                            {
+                                for (unsigned int column = 0; column != 4; ++column)
+                                {
+                                    dst[stride * row + column * 2] = dst[stride * row + column * 2 + 1] = data[(row / 2) * 4 + column];
+                                }
+                                std::memcpy(dst + stride * (row + 1), dst + stride * row, 8);
+                            }
+                            data += 16;
+                            break;
+                        case 0xD:
+                            // raw 4x4 pixels
+                            require(4);
+                            for (unsigned int row = 0; row != 8; ++row)
+                            {
+                                std::memset(dst + stride * row,     data[(row / 4) * 2],     4);
+                                std::memset(dst + stride * row + 4, data[(row / 4) * 2 + 1], 4);
+                            }
+                            data += 4;
+                            break;
+                        case 0xE:
+                            // solid color
+                            require(1);
+                            for (unsigned int row = 0; row != 8; ++row)
+                            {
+                                std::memset(dst + stride * row, data[0], 8);
+                            }
+                            data++;
+                            break;
+                        case 0xF:
+                            // checkerboard
+                            require(2);
+                            for (unsigned int row = 0; row != 8; ++row)
+                            {
+                                uint8_t first = data[row & 1];
+                                uint8_t second = data[(row & 1) ^ 1];
+                                fillRow(dst + stride * row, first, second, masks.row[0xAA]);
+                            }
+                            data += 2;
+                            break;
+                    }
+                }
+            }
+        }
+    }
+}
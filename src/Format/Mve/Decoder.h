@@ -0,0 +1,60 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace Falltergeist
+{
+    namespace Format
+    {
+        namespace Mve
+        {
+            class Opcode;
+
+            /**
+             * Interplay MVE video decoder (8 bits per pixel). Works on two raw index buffers without any SDL surfaces:
+             * block copies are memcpy/memmove of 8-byte rows and pattern blocks are filled from precomputed bit masks.
+             * Decoded frame is a plain array of palette indexes, so it can be uploaded to the GPU as is.
+             */
+            class Decoder
+            {
+                public:
+                    Decoder();
+
+                    /**
+                     * Feeds video opcodes (buffer init, palette, decoding map and frame data), other opcodes are ignored.
+                     * @return true if opcode decoded a new frame
+                     */
+                    bool decode(Opcode& opcode);
+
+                    // Allocates frame buffers. Size is in 8x8 blocks, buffers are allocated again only if it changes.
+                    void initBuffers(uint16_t blocksWide, uint16_t blocksHigh);
+                    void setPalette(const uint8_t* data, uint32_t length);
+                    void setDecodingMap(const uint8_t* data, uint32_t length);
+                    void decodeVideo(const uint8_t* data, uint32_t length);
+
+                    unsigned int width() const;
+                    unsigned int height() const;
+                    // Palette indexes of the last decoded frame, width() * height() bytes
+                    const uint8_t* pixels() const;
+                    // RGBA colors, same layout as Texture::loadFromRGBA() expects
+                    const std::array<uint32_t, 256>& palette() const;
+
+                private:
+                    unsigned int _blocksWide = 0;
+                    unsigned int _blocksHigh = 0;
+                    unsigned int _width = 0;
+                    unsigned int _height = 0;
+                    std::vector<uint8_t> _current;
+                    std::vector<uint8_t> _back;
+                    // block opcodes, one per 8x8 block
+                    std::vector<uint8_t> _decodingMap;
+                    std::array<uint32_t, 256> _palette;
+
+                    void _decodeBlocks(const uint8_t* data, uint32_t length);
+                    void _copyBlock(const uint8_t* source, int sourceX, int sourceY, unsigned int x, unsigned int y);
+            };
+        }
+    }
+}
@@ -1,5 +1,4 @@
 #include <cstring>
-#include "../Dat/Stream.h"
 #include "../Mve/Chunk.h"
 #include "../Mve/File.h"
 #include "../../Exception.h"
@@ -10,55 +9,66 @@ namespace Falltergeist
     {
         namespace Mve
         {
-            File::File(Dat::Stream&& stream) : _stream(std::move(stream))
+            namespace
+            {
+                uint16_t readUint16(const uint8_t* data)
+                {
+                    return static_cast<uint16_t>(data[0] | (data[1] << 8));
+                }
+            }
+
+            File::File(std::unique_ptr<Dat::SequentialStream> stream) : _stream(std::move(stream))
             {
-                _stream.setPosition(0);
-                _stream.setEndianness(ENDIANNESS::LITTLE);
                 // header
                 const char  MVE_HEADER[]  = "Interplay MVE File\x1A";
                 const int16_t MVE_HDRCONST1 = 0x001A;
                 const int16_t MVE_HDRCONST2 = 0x0100;
                 const int16_t MVE_HDRCONST3 = 0x1133;
-                int16_t check1, check2, check3;
-
-                char head[20];
-                _stream.readBytes((uint8_t*)head,20);
 
-                if (strncmp(head,MVE_HEADER,20)!=0)
+                uint8_t head[26];
+                if (_stream->read(head, sizeof(head)) != sizeof(head) || strncmp((char*)head, MVE_HEADER, 20) != 0)
                 {
                     throw Exception("Invalid MVE file.!");
                 }
-                _stream >> check1 >> check2 >> check3;
-                if  (!(check1 == MVE_HDRCONST1 && check2 == MVE_HDRCONST2 && check3 == MVE_HDRCONST3))
+                if (!(readUint16(head + 20) == MVE_HDRCONST1 && readUint16(head + 22) == MVE_HDRCONST2 && readUint16(head + 24) == MVE_HDRCONST3))
                 {
                     throw Exception("Invalid MVE file.");
                 }
             }
 
-            std::unique_ptr<Chunk> File::getNextChunk()
+            bool File::readChunk(Chunk& chunk)
             {
-                if (_stream.position() < _stream.size())
+                uint8_t header[4];
+                if (_stream->read(header, sizeof(header)) != sizeof(header))
                 {
-                    auto chunk = std::make_unique<Chunk>();
-                    chunk->setLength(_stream.uint16());
-                    chunk->setType(_stream.uint16());
-                    for (size_t i = 0; i < chunk->length();)
+                    return false;
+                }
+                chunk.setLength(readUint16(header));
+                chunk.setType(readUint16(header + 2));
+
+                auto& data = chunk.data();
+                data.resize(chunk.length());
+                if (_stream->read(data.data(), data.size()) != data.size())
+                {
+                    return false;
+                }
+
+                auto& opcodes = chunk.opcodes();
+                opcodes.clear();
+                for (size_t i = 0; i + 4 <= data.size();)
+                {
+                    uint16_t length = readUint16(&data[i]);
+                    if (i + 4 + length > data.size())
                     {
-                        chunk->opcodes().emplace_back(_stream.uint16());
-                        auto& opcode = chunk->opcodes().back();
-                        opcode.setType(_stream.uint8());
-                        opcode.setVersion(_stream.uint8());
-                        _stream.readBytes(opcode.data(), opcode.length());
-                        i += opcode.length() + 4;
+                        throw Exception("Invalid MVE file: opcode is out of chunk bounds");
                     }
-                    return chunk;
+                    opcodes.emplace_back(length, data.data() + i + 4);
+                    auto& opcode = opcodes.back();
+                    opcode.setType(data[i + 2]);
+                    opcode.setVersion(data[i + 3]);
+                    i += length + 4;
                 }
-                return nullptr;
-            }
-
-            void File::setPosition(unsigned int position)
-            {
-                _stream.setPosition(position);
+                return true;
             }
         }
     }
@@ -1,9 +1,7 @@
 #pragma once
 
-#include <vector>
-#include "../Dat/Item.h"
-#include "../Dat/Stream.h"
-#include "../Enums.h"
+#include <memory>
+#include "../Dat/SequentialStream.h"
 
 namespace Falltergeist
 {
@@ -13,17 +11,20 @@ namespace Falltergeist
         {
             class Chunk;
 
-            class File : public Dat::Item
+            // Movie is read chunk by chunk from a sequential stream and is never loaded into memory as a whole
+            class File
             {
                 public:
-                    File(Dat::Stream&& stream);
-                    std::unique_ptr<Chunk> getNextChunk();
+                    File(std::unique_ptr<Dat::SequentialStream> stream);
 
-                    // set the position of underlying stream
-                    void setPosition(unsigned int position);
+                    /**
+                     * Reads next chunk into given object, reusing its buffers.
+                     * @return false at the end of file
+                     */
+                    bool readChunk(Chunk& chunk);
 
                 protected:
-                    Dat::Stream _stream;
+                    std::unique_ptr<Dat::SequentialStream> _stream;
             };
         }
     }
@@ -6,13 +6,13 @@ namespace Falltergeist
     {
         namespace Mve
         {
-            Opcode::Opcode(uint16_t length) : _data(length)
+            Opcode::Opcode(uint16_t length, uint8_t* data) : _length(length), _data(data)
             {
             }
 
             uint16_t Opcode::length() const
             {
-                return static_cast<uint16_t>(_data.size());
+                return _length;
             }
 
             uint8_t Opcode::type() const
@@ -37,7 +37,7 @@ namespace Falltergeist
 
             uint8_t* Opcode::data()
             {
-                return _data.data();
+                return _data;
             }
         }
     }
@@ -1,7 +1,6 @@
 #pragma once
 
 #include <cstdint>
-#include "../../Base/Buffer.h"
 
 namespace Falltergeist
 {
@@ -9,10 +8,11 @@ namespace Falltergeist
     {
         namespace Mve
         {
+            // Opcode payload is not copied, it points into the data of the Chunk it belongs to
             class Opcode
             {
                 public:
-                    Opcode(uint16_t length);
+                    Opcode(uint16_t length, uint8_t* data);
 
                     uint16_t length() const;
 
@@ -28,7 +28,7 @@ namespace Falltergeist
                     uint16_t _length = 0;
                     uint8_t _type = 0;
                     uint8_t _version = 0;
-                    Base::Buffer<uint8_t> _data;
+                    uint8_t* _data = nullptr;
             };
         }
     }
@@ -1,4 +1,4 @@
-﻿#include "../Dat/Stream.h"
+﻿#include "../Dat/BinaryReader.h"
 #include "../Pal/Color.h"
 #include "../Pal/File.h"
 
@@ -10,15 +10,16 @@ namespace Falltergeist
         {
             File::File(Dat::Stream&& stream)
             {
-                stream.setPosition(3);
+                Dat::BigEndianReader reader(stream.data(), stream.size());
+                reader.setPosition(3);
 
                 _colors.emplace_back(0, 0, 0, 0); // zero color (transparent)
 
                 for (unsigned i = 1; i != 256; ++i)
                 {
-                    uint8_t r = stream.uint8();
-                    uint8_t g = stream.uint8();
-                    uint8_t b = stream.uint8();
+                    uint8_t r = reader.uint8();
+                    uint8_t g = reader.uint8();
+                    uint8_t b = reader.uint8();
                     _colors.emplace_back(r, g, b);
                 }
 
@@ -1,4 +1,4 @@
-#include "../Dat/Stream.h"
+#include "../Dat/BinaryReader.h"
 #include "../Pro/File.h"
 
 namespace Falltergeist
@@ -9,14 +9,14 @@ namespace Falltergeist
         {
             File::File(Dat::Stream&& stream)
             {
-                stream.setPosition(0);
+                Dat::BigEndianReader reader(stream.data(), stream.size());
 
-                _PID            = stream.int32();
-                _messageId      = stream.uint32();
-                _FID            = stream.int32();
-                _lightDistance  = stream.uint32();
-                _lightIntencity = stream.uint32();
-                _flags          = stream.uint32();
+                _PID            = reader.int32();
+                _messageId      = reader.uint32();
+                _FID            = reader.int32();
+                _lightDistance  = reader.uint32();
+                _lightIntencity = reader.uint32();
+                _flags          = reader.uint32();
 
                 switch ((OBJECT_TYPE)typeId())
                 {
@@ -24,7 +24,7 @@ namespace Falltergeist
                     case OBJECT_TYPE::MISC:
                         break;
                     default:
-                        _flagsExt = stream.uint32();
+                        _flagsExt = reader.uint32();
                         break;
                 }
 
@@ -34,7 +34,7 @@ namespace Falltergeist
                     case OBJECT_TYPE::CRITTER:
                     case OBJECT_TYPE::SCENERY:
                     case OBJECT_TYPE::WALL:
-                        _SID = stream.int32();
+                        _SID = reader.int32();
                         break;
                     case OBJECT_TYPE::TILE:
                     case OBJECT_TYPE::MISC:
@@ -45,81 +45,81 @@ namespace Falltergeist
                 {
                     case OBJECT_TYPE::ITEM:
                     {
-                        _subtypeId     = stream.uint32();
-                        _materialId    = stream.uint32();
-                        _containerSize = stream.uint32();
-                        _weight        = stream.uint32();
-                        _basePrice     = stream.uint32();
-                        _inventoryFID  = stream.int32();
-                        _soundId       = stream.uint8();
+                        _subtypeId     = reader.uint32();
+                        _materialId    = reader.uint32();
+                        _containerSize = reader.uint32();
+                        _weight        = reader.uint32();
+                        _basePrice     = reader.uint32();
+                        _inventoryFID  = reader.int32();
+                        _soundId       = reader.uint8();
 
                         switch ((ITEM_TYPE)subtypeId())
                         {
                             case ITEM_TYPE::ARMOR:
                             {
-                                _armorClass = stream.uint32();
+                                _armorClass = reader.uint32();
                                 // Damage resist
                                 for (unsigned int i = 0; i != 7; ++i)
                                 {
-                                    _damageResist.at(i) = stream.uint32();
+                                    _damageResist.at(i) = reader.uint32();
                                 }
                                 // Damage threshold
                                 for (unsigned int i = 0; i != 7; ++i)
                                 {
-                                    _damageThreshold.at(i) = stream.uint32();
+                                    _damageThreshold.at(i) = reader.uint32();
                                 }
-                                _perk           = stream.int32();
-                                _armorMaleFID   = stream.int32();
-                                _armorFemaleFID = stream.int32();
+                                _perk           = reader.int32();
+                                _armorMaleFID   = reader.int32();
+                                _armorFemaleFID = reader.int32();
                                 break;
                             }
                             case ITEM_TYPE::CONTAINER:
                             {
-                                stream.uint32(); // max size
-                                stream.uint32(); // containter flags
+                                reader.uint32(); // max size
+                                reader.uint32(); // containter flags
                                 break;
                             }
                             case ITEM_TYPE::DRUG:
                             {
-                                stream.uint32(); // Stat0
-                                stream.uint32(); // Stat1
-                                stream.uint32(); // Stat2
-                                stream.uint32(); // Stat0 ammount
-                                stream.uint32(); // Stat1 ammount
-                                stream.uint32(); // Stat2 ammount
+                                reader.uint32(); // Stat0
+                                reader.uint32(); // Stat1
+                                reader.uint32(); // Stat2
+                                reader.uint32(); // Stat0 ammount
+                                reader.uint32(); // Stat1 ammount
+                                reader.uint32(); // Stat2 ammount
                                 // first delayed effect
-                                stream.uint32(); // delay in game minutes
-                                stream.uint32(); // Stat0 ammount
-                                stream.uint32(); // Stat1 ammount
-                                stream.uint32(); // Stat2 ammount
+                                reader.uint32(); // delay in game minutes
+                                reader.uint32(); // Stat0 ammount
+                                reader.uint32(); // Stat1 ammount
+                                reader.uint32(); // Stat2 ammount
                                 // second delayed effect
-                                stream.uint32(); // delay in game minutes
-                                stream.uint32(); // Stat0 ammount
-                                stream.uint32(); // Stat1 ammount
-                                stream.uint32(); // Stat2 ammount
-                                stream.uint32(); // addiction chance
-                                stream.uint32(); // addiction perk
-                                stream.uint32(); // addiction delay
+                                reader.uint32(); // delay in game minutes
+                                reader.uint32(); // Stat0 ammount
+                                reader.uint32(); // Stat1 ammount
+                                reader.uint32(); // Stat2 ammount
+                                reader.uint32(); // addiction chance
+                                reader.uint32(); // addiction perk
+                                reader.uint32(); // addiction delay
                                 break;
                             }
                             case ITEM_TYPE::WEAPON:
-                                _weaponAnimationCode  = stream.uint32();
-                                _weaponDamageMin      = stream.uint32();
-                                _weaponDamageMax      = stream.uint32();
-                                _weaponDamageType     = stream.uint32();
-                                _weaponRangePrimary   = stream.uint32();
-                                _weaponRangeSecondary = stream.uint32();
-                                stream.uint32(); // Proj PID
-                                _weaponMinimumStrenght     = stream.uint32();
-                                _weaponActionCostPrimary   = stream.uint32();
-                                _weaponActionCostSecondary = stream.uint32();
-                                stream.uint32(); // Crit Fail
-                                _perk = stream.int32();
-                                _weaponBurstRounds  = stream.uint32();
-                                _weaponAmmoType     = stream.uint32();
-                                _weaponAmmoPID      = stream.uint32();
-                                _weaponAmmoCapacity = stream.uint32();
-                                _soundId = stream.uint8();
+                                _weaponAnimationCode  = reader.uint32();
+                                _weaponDamageMin      = reader.uint32();
+                                _weaponDamageMax      = reader.uint32();
+                                _weaponDamageType     = reader.uint32();
+                                _weaponRangePrimary   = reader.uint32();
+                                _weaponRangeSecondary = reader.uint32();
+                                reader.uint32(); // Proj PID
+                                _weaponMinimumStrenght     = reader.uint32();
+                                _weaponActionCostPrimary   = reader.uint32();
+                                _weaponActionCostSecondary = reader.uint32();
+                                reader.uint32(); // Crit Fail
+                                _perk = reader.int32();
+                                _weaponBurstRounds  = reader.uint32();
+                                _weaponAmmoType     = reader.uint32();
+                                _weaponAmmoPID      = reader.uint32();
+                                _weaponAmmoCapacity = reader.uint32();
+                                _soundId = reader.uint8();
                                 break;
                             case ITEM_TYPE::AMMO:
                                 break;
@@ -132,124 +132,124 @@ namespace Falltergeist
                     }
                     case OBJECT_TYPE::CRITTER:
                     {
-                        _critterHeadFID = stream.int32();
+                        _critterHeadFID = reader.int32();
 
-                        stream.uint32(); // ai packet number
-                        stream.uint32(); // team number
-                        _critterFlags = stream.uint32();
+                        reader.uint32(); // ai packet number
+                        reader.uint32(); // team number
+                        _critterFlags = reader.uint32();
 
                         for (unsigned int i = 0; i != 7; ++i)
                         {
-                            _critterStats.at(i) = stream.uint32();
+                            _critterStats.at(i) = reader.uint32();
                         }
-                        _critterHitPointsMax = stream.uint32();
-                        _critterActionPoints = stream.uint32();
-                        _critterArmorClass   = stream.uint32();
-                        stream.uint32(); // Unused
-                        _critterMeleeDamage    = stream.uint32();
-                        _critterCarryWeightMax = stream.uint32();
-                        _critterSequence       = stream.uint32();
-                        _critterHealingRate    = stream.uint32();
-                        _critterCriticalChance = stream.uint32();
-                        stream.uint32(); // Better criticals
+                        _critterHitPointsMax = reader.uint32();
+                        _critterActionPoints = reader.uint32();
+                        _critterArmorClass   = reader.uint32();
+                        reader.uint32(); // Unused
+                        _critterMeleeDamage    = reader.uint32();
+                        _critterCarryWeightMax = reader.uint32();
+                        _critterSequence       = reader.uint32();
+                        _critterHealingRate    = reader.uint32();
+                        _critterCriticalChance = reader.uint32();
+                        reader.uint32(); // Better criticals
 
                         // Damage threshold
                         for (unsigned int i = 0; i != 7; ++i)
                         {
-                            _damageThreshold.at(i) = stream.uint32();
+                            _damageThreshold.at(i) = reader.uint32();
                         }
                         // Damage resist
                         for (unsigned int i = 0; i != 9; ++i)
                         {
-                            _damageResist.at(i) = stream.uint32();
+                            _damageResist.at(i) = reader.uint32();
                         }
 
-                        _critterAge = stream.uint32(); // age
-                        _critterGender = stream.uint32(); // sex
+                        _critterAge = reader.uint32(); // age
+                        _critterGender = reader.uint32(); // sex
 
                         for (unsigned int i = 0; i != 7; ++i)
                         {
-                            _critterStatsBonus.at(i) = stream.uint32();
+                            _critterStatsBonus.at(i) = reader.uint32();
                         }
 
-                        stream.uint32(); // Bonus Health points
-                        stream.uint32(); // Bonus Action points
-                        stream.uint32(); // Bonus Armor class
-                        stream.uint32(); // Bonus Unused
-                        stream.uint32(); // Bonus Melee damage
-                        stream.uint32(); // Bonus Carry weight
-                        stream.uint32(); // Bonus Sequence
-                        stream.uint32(); // Bonus Healing rate
-                        stream.uint32(); // Bonus Critical chance
-                        stream.uint32(); // Bonus Better criticals
+                        reader.uint32(); // Bonus Health points
+                        reader.uint32(); // Bonus Action points
+                        reader.uint32(); // Bonus Armor class
+                        reader.uint32(); // Bonus Unused
+                        reader.uint32(); // Bonus Melee damage
+                        reader.uint32(); // Bonus Carry weight
+                        reader.uint32(); // Bonus Sequence
+                        reader.uint32(); // Bonus Healing rate
+                        reader.uint32(); // Bonus Critical chance
+                        reader.uint32(); // Bonus Better criticals
 
                         // Bonus Damage threshold
-                        stream.uint32();
-                        stream.uint32();
-                        stream.uint32();
-                        stream.uint32();
-                        stream.uint32();
-                        stream.uint32();
-                        stream.uint32();
-                        stream.uint32();
+                        reader.uint32();
+                        reader.uint32();
+                        reader.uint32();
+                        reader.uint32();
+                        reader.uint32();
+                        reader.uint32();
+                        reader.uint32();
+                        reader.uint32();
 
                         // Bonus Damage resistance
-                        stream.uint32();
-                        stream.uint32();
-                        stream.uint32();
-                        stream.uint32();
-                        stream.uint32();
-                        stream.uint32();
-                        stream.uint32();
-                        stream.uint32();
-
-                        stream.uint32(); // Bonus age
-                        stream.uint32(); // Bonus sex
+                        reader.uint32();
+                        reader.uint32();
+                        reader.uint32();
+                        reader.uint32();
+                        reader.uint32();
+                        reader.uint32();
+                        reader.uint32();
+                        reader.uint32();
+
+                        reader.uint32(); // Bonus age
+                        reader.uint32(); // Bonus sex
 
                         for (unsigned int i = 0; i != 18; ++i) {
-                            _critterSkills.at(i) = stream.uint32();
+                            _critterSkills.at(i) = reader.uint32();
                         }
 
-                        stream.uint32(); // body type
-                        stream.uint32(); // experience for kill
-                        stream.uint32(); // kill type
-                        stream.uint32(); // damage type
+                        reader.uint32(); // body type
+                        reader.uint32(); // experience for kill
+                        reader.uint32(); // kill type
+                        reader.uint32(); // damage type
                         break;
                     }
                     case OBJECT_TYPE::SCENERY:
                     {
-                        _subtypeId  = stream.uint32();
-                        _materialId = stream.uint32();
-                        _soundId    = stream.uint8();
+                        _subtypeId  = reader.uint32();
+                        _materialId = reader.uint32();
+                        _soundId    = reader.uint8();
                         switch((SCENERY_TYPE)subtypeId())
                         {
                             case SCENERY_TYPE::DOOR:
                             {
-                                stream.uint32(); // walk thru flag
-                                stream.uint32(); // unknown
+                                reader.uint32(); // walk thru flag
+                                reader.uint32(); // unknown
                                 break;
                             }
                             case SCENERY_TYPE::STAIRS:
                             {
-                                stream.uint32(); // DestTile && DestElevation
-                                stream.uint32(); // DestElevation
+                                reader.uint32(); // DestTile && DestElevation
+                                reader.uint32(); // DestElevation
                                 break;
                             }
                             case SCENERY_TYPE::ELEVATOR:
                             {
-                                stream.uint32(); // Elevator type
-                                stream.uint32(); // Elevator level
+                                reader.uint32(); // Elevator type
+                                reader.uint32(); // Elevator level
                                 break;
                             }
                             case SCENERY_TYPE::LADDER_BOTTOM:
                             case SCENERY_TYPE::LADDER_TOP:
                             {
-                                stream.uint32(); // DestTile && DestElevation
+                                reader.uint32(); // DestTile && DestElevation
                                 break;
                             }
                             case SCENERY_TYPE::GENERIC:
                             {
-                                stream.uint32(); // unknown
+                                reader.uint32(); // unknown
                                 break;
                             }
                         }
@@ -258,17 +258,17 @@ namespace Falltergeist
                     }
                     case OBJECT_TYPE::WALL:
                     {
-                        _materialId = stream.uint32();
+                        _materialId = reader.uint32();
                         break;
                     }
                     case OBJECT_TYPE::TILE:
                     {
-                        _materialId = stream.uint32();
+                        _materialId = reader.uint32();
                         break;
                     }
                     case OBJECT_TYPE::MISC:
                     {
-                        stream.uint32(); // unknown
+                        reader.uint32(); // unknown
                         break;
                     }
                 }
@@ -1,4 +1,4 @@
-﻿#include "../Dat/Stream.h"
+﻿#include "../Dat/BinaryReader.h"
 #include "../Rix/File.h"
 
 namespace Falltergeist
@@ -9,36 +9,38 @@ namespace Falltergeist
         {
             File::File(Dat::Stream&& stream)
             {
-                stream.setPosition(0);
+                // Dimensions are the only little-endian fields in the file
+                Dat::LittleEndianReader reader(stream.data(), stream.size());
 
                 // Signature
-                stream.uint32();
+                reader.uint32();
 
-                stream.setEndianness(ENDIANNESS::LITTLE);
-                _width = stream.uint16();
-                _height = stream.uint16();
-                stream.setEndianness(ENDIANNESS::BIG);
+                _width = reader.uint16();
+                _height = reader.uint16();
 
                 // Unknown 1
-                stream.uint16();
+                reader.uint16();
 
                 uint32_t palette[256];
 
                 // Palette
+                uint8_t rgb[256 * 3];
+                reader.readBytes(rgb, sizeof(rgb));
                 for (unsigned i = 0; i != 256; ++i)
                 {
-                    uint8_t r = stream.uint8();
-                    uint8_t g = stream.uint8();
-                    uint8_t b = stream.uint8();
+                    uint8_t r = rgb[i * 3];
+                    uint8_t g = rgb[i * 3 + 1];
+                    uint8_t b = rgb[i * 3 + 2];
                     palette[i] = (r << 26 | g << 18 | b << 10 | 0x000000FF);  // RGBA
                 }
 
                 _rgba.resize(_width * _height);
 
                 // Data
+                auto indexes = reader.readArray<uint8_t>((size_t)_width * _height);
                 for (unsigned i = 0; i != (unsigned)_width * _height; ++i)
                 {
-                    _rgba[i] = palette[stream.uint8()];
+                    _rgba[i] = palette[indexes[i]];
                 }
             }
 
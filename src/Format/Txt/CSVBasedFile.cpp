@@ -11,8 +11,7 @@ namespace Falltergeist
             template <typename ItemType>
             CSVBasedFile<ItemType>::CSVBasedFile(Dat::Stream&& stream)
             {
-                std::istream istr(&stream);
-                _parseText(istr);
+                _parseText(stream);
             }
 
             template <typename ItemType>
@@ -22,9 +21,9 @@ namespace Falltergeist
             }
 
             template <typename ItemType>
-            void CSVBasedFile<ItemType>::_parseText(std::istream& istr)
+            void CSVBasedFile<ItemType>::_parseText(const Dat::Stream& stream)
             {
-                CSVParser parser(istr);
+                CSVParser parser(stream);
                 auto csv = parser.parse();
                 for (auto& row : *csv)
                 {
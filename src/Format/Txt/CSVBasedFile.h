@@ -181,7 +181,7 @@ namespace Falltergeist
                     const std::list<ItemType>& items() const;
 
                 protected:
-                    void _parseText(std::istream& istr);
+                    void _parseText(const Dat::Stream& stream);
 
                     /**
                      * Parses next item
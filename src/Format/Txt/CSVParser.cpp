@@ -1,6 +1,4 @@
-#include <algorithm>
-#include <sstream>
-#include "CSVParser.h"
+#include "../Txt/CSVParser.h"
 
 namespace Falltergeist
 {
@@ -8,7 +6,7 @@ namespace Falltergeist
     {
         namespace Txt
         {
-            CSVParser::CSVParser(std::istream &stream) : _stream(stream)
+            CSVParser::CSVParser(const Dat::Stream& stream) : _tokenizer(stream)
             {
             }
 
@@ -16,52 +14,30 @@ namespace Falltergeist
             {
             }
 
-
-            void CSVParser::_stripComments(std::string& line)
-            {
-                size_t pos = line.find(";"), pos2 = line.find("#");
-                if (pos != std::string::npos)
-                {
-                    if (pos2 != std::string::npos)
-                    {
-                        line.erase(std::min(pos, pos2));
-                    }
-                    else
-                    {
-                        line.erase(pos);
-                    }
-                }
-                else if (pos2 != std::string::npos)
-                {
-                    line.erase(pos2);
-                }
-            }
-
             std::unique_ptr<CSVFile> CSVParser::parse()
             {
                 auto csv = std::unique_ptr<CSVFile>(new CSVFile());
-                std::string line;
+                Base::StringView line;
+                std::vector<Base::StringView> fields;
 
-                while (std::getline(_stream, line))
+                while (_tokenizer.nextLine(line))
                 {
                     // Lines starting with "#" or ";" are treated as comments and ignored
-                    if (line[0] == '#' || line[0] == ';') continue;
+                    if (!line.empty() && (line.front() == '#' || line.front() == ';')) continue;
 
-                    // Prepare line
-                    _stripComments(line);
-                    trim(line);
+                    // Prepare line: strip comments and trim
+                    line = line.substr(0, line.findFirstOf(";#")).trimmed();
 
                     // Skip empty lines
-                    if (line.length() == 0) continue;
+                    if (line.empty()) continue;
 
-                    std::vector<Ini::Value> values;
-                    auto splitLine = split(',', line);
+                    Tokenizer::split(line, ',', fields);
 
                     // trim and copy values
-                    for (auto& val : splitLine)
+                    std::vector<Ini::Value> values(fields.size());
+                    for (size_t i = 0; i != fields.size(); ++i)
                     {
-                        trim(val);
-                        values.push_back(val);
+                        values[i].assign(fields[i].trimmed());
                     }
 
                     csv->push_back(std::move(values));
@@ -6,31 +6,35 @@
 #include <vector>
 #include "../Ini/Value.h"
 #include "../Txt/Parser.h"
+#include "../Txt/Tokenizer.h"
 
 namespace Falltergeist
 {
     namespace Format
     {
+        namespace Dat
+        {
+            class Stream;
+        }
+
         namespace Txt
         {
             typedef std::list<std::vector<Ini::Value>> CSVFile;
 
             /**
              * @brief Parser of CSV files.
+             * Lines and fields are tokenized in place over the stream buffer, only field values get copied.
              */
             class CSVParser : public Parser
             {
                 public:
-                    CSVParser(std::istream &stream);
+                    CSVParser(const Dat::Stream& stream);
                     ~CSVParser();
 
                     std::unique_ptr<CSVFile> parse();
 
                 private:
-                    std::istream &_stream; // stream to parse
-
-                protected:
-                    void _stripComments(std::string& line);
+                    Txt::Tokenizer _tokenizer;
             };
         }
     }
@@ -1,3 +1,5 @@
+#include "../../Format/Cache/Reader.h"
+#include "../../Format/Cache/Writer.h"
 #include "../../Format/Dat/Stream.h"
 #include "../../Format/Ini/File.h"
 #include "../../Format/Txt/CityFile.h"
@@ -10,8 +12,59 @@ namespace Falltergeist
         {
             CityFile::CityFile(Dat::Stream&& stream)
             {
-                std::istream istr(&stream);
-                _parseText(istr);
+                _parseText(stream);
+            }
+
+            CityFile::CityFile(Cache::Reader& reader)
+            {
+                _cities.resize(reader.count());
+                for (auto& city : _cities)
+                {
+                    city.name = reader.string();
+                    city.worldX = reader.int32();
+                    city.worldY = reader.int32();
+                    city.startState = reader.boolean();
+                    city.size = static_cast<City::Size>(reader.uint8());
+                    city.townMapArtIdx = reader.int32();
+                    city.townMapLabelArtIdx = reader.int32();
+                    city.entrances.resize(reader.count());
+                    for (auto& entrance : city.entrances)
+                    {
+                        entrance.startState = reader.boolean();
+                        entrance.townMapX = reader.int32();
+                        entrance.townMapY = reader.int32();
+                        entrance.mapName = reader.string();
+                        entrance.elevation = reader.int32();
+                        entrance.tileNum = reader.int32();
+                        entrance.orientation = reader.int32();
+                    }
+                }
+            }
+
+            void CityFile::save(Cache::Writer& writer) const
+            {
+                writer.writeCount(_cities.size());
+                for (auto& city : _cities)
+                {
+                    writer.writeString(city.name);
+                    writer.writeInt32(city.worldX);
+                    writer.writeInt32(city.worldY);
+                    writer.writeBool(city.startState);
+                    writer.writeUint8(static_cast<uint8_t>(city.size));
+                    writer.writeInt32(city.townMapArtIdx);
+                    writer.writeInt32(city.townMapLabelArtIdx);
+                    writer.writeCount(city.entrances.size());
+                    for (auto& entrance : city.entrances)
+                    {
+                        writer.writeBool(entrance.startState);
+                        writer.writeInt32(entrance.townMapX);
+                        writer.writeInt32(entrance.townMapY);
+                        writer.writeString(entrance.mapName);
+                        writer.writeInt32(entrance.elevation);
+                        writer.writeInt32(entrance.tileNum);
+                        writer.writeInt32(entrance.orientation);
+                    }
+                }
             }
 
             const std::vector<City>& CityFile::cities() const
@@ -37,7 +90,7 @@ namespace Falltergeist
             }
 
 
-            void CityFile::_parseText(std::istream& stream)
+            void CityFile::_parseText(const Dat::Stream& stream)
             {
                 Ini::Parser parser(stream);
                 auto file = parser.parse();
@@ -7,6 +7,12 @@ namespace Falltergeist
 {
     namespace Format
     {
+        namespace Cache
+        {
+            class Reader;
+            class Writer;
+        }
+
         namespace Dat
         {
             class Stream;
@@ -78,6 +84,10 @@ namespace Falltergeist
             {
                 public:
                     CityFile(Dat::Stream&& stream);
+                    // Restores parsed file from the binary cache
+                    CityFile(Cache::Reader& reader);
+
+                    void save(Cache::Writer& writer) const;
 
                     const std::vector<City>& cities() const;
 
@@ -85,7 +95,7 @@ namespace Falltergeist
                     std::vector<City> _cities;
 
 
-                    void _parseText(std::istream& istr);
+                    void _parseText(const Dat::Stream& stream);
 
                     City::Size _sizeByName(std::string name) const;
             };
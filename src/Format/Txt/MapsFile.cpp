@@ -1,3 +1,5 @@
+#include "../Cache/Reader.h"
+#include "../Cache/Writer.h"
 #include "../Dat/Stream.h"
 #include "../Ini/File.h"
 #include "../Txt/MapsFile.h"
@@ -10,8 +12,64 @@ namespace Falltergeist
         {
             MapsFile::MapsFile(Dat::Stream&& stream)
             {
-                std::istream istr(&stream);
-                _parseText(istr);
+                _parseText(stream);
+            }
+
+            MapsFile::MapsFile(Cache::Reader& reader)
+            {
+                _maps.resize(reader.count());
+                for (auto& map : _maps)
+                {
+                    map.name = reader.string();
+                    map.lookupName = reader.string();
+                    map.music = reader.string();
+                    for (size_t i = 0, count = reader.count(); i != count; ++i)
+                    {
+                        auto name = reader.string();
+                        map.ambientSfx[name] = reader.uint8();
+                    }
+                    map.deadBodiesAge = reader.boolean();
+                    for (auto& canRest : map.canRestHere)
+                    {
+                        canRest = reader.boolean();
+                    }
+                    map.saved = reader.boolean();
+                    map.randomStartPoints.resize(reader.count());
+                    for (auto& point : map.randomStartPoints)
+                    {
+                        point.elevation = reader.int32();
+                        point.tileNum = reader.int32();
+                    }
+                }
+            }
+
+            void MapsFile::save(Cache::Writer& writer) const
+            {
+                writer.writeCount(_maps.size());
+                for (auto& map : _maps)
+                {
+                    writer.writeString(map.name);
+                    writer.writeString(map.lookupName);
+                    writer.writeString(map.music);
+                    writer.writeCount(map.ambientSfx.size());
+                    for (auto& sfx : map.ambientSfx)
+                    {
+                        writer.writeString(sfx.first);
+                        writer.writeUint8(sfx.second);
+                    }
+                    writer.writeBool(map.deadBodiesAge);
+                    for (auto canRest : map.canRestHere)
+                    {
+                        writer.writeBool(canRest);
+                    }
+                    writer.writeBool(map.saved);
+                    writer.writeCount(map.randomStartPoints.size());
+                    for (auto& point : map.randomStartPoints)
+                    {
+                        writer.writeInt32(point.elevation);
+                        writer.writeInt32(point.tileNum);
+                    }
+                }
             }
 
             const std::vector<Map>& MapsFile::maps() const
@@ -19,7 +77,7 @@ namespace Falltergeist
                 return _maps;
             }
 
-            void MapsFile::_parseText(std::istream& stream)
+            void MapsFile::_parseText(const Dat::Stream& stream)
             {
                 Ini::Parser parser(stream);
                 auto file = parser.parse();
@@ -8,6 +8,12 @@ namespace Falltergeist
 {
     namespace Format
     {
+        namespace Cache
+        {
+            class Reader;
+            class Writer;
+        }
+
         namespace Dat
         {
             class Stream;
@@ -35,7 +41,7 @@ namespace Falltergeist
                  * Keys are sfx names, value - probability in %. Probabilities *should* sum up to 100.
                  */
                 std::map<std::string, unsigned char> ambientSfx;
-                bool deadBodiesAge;
+                bool deadBodiesAge = false;
                 /**
                  * Flag for each elevation.
                  */
@@ -52,13 +58,17 @@ namespace Falltergeist
             {
                 public:
                     MapsFile(Dat::Stream&& stream);
+                    // Restores parsed file from the binary cache
+                    MapsFile(Cache::Reader& reader);
+
+                    void save(Cache::Writer& writer) const;
 
                     const std::vector<Map>& maps() const;
 
                 protected:
                     std::vector<Map> _maps;
 
-                    void _parseText(std::istream& istr);
+                    void _parseText(const Dat::Stream& stream);
             };
         }
     }
@@ -0,0 +1,61 @@
+#include <cctype>
+#include "../Txt/StringPool.h"
+
+namespace Falltergeist
+{
+    namespace Format
+    {
+        namespace Txt
+        {
+            const std::string& StringPool::lowercase(Base::StringView name)
+            {
+                auto it = _strings.find(name);
+                if (it != _strings.end())
+                {
+                    return *it->second;
+                }
+
+                std::unique_ptr<std::string> value(new std::string(name.size(), '\0'));
+                for (size_t i = 0; i != name.size(); ++i)
+                {
+                    (*value)[i] = static_cast<char>(std::tolower(static_cast<unsigned char>(name[i])));
+                }
+                Base::StringView key(*value);
+                return *_strings.emplace(key, std::move(value)).first->second;
+            }
+
+            size_t StringPool::size() const
+            {
+                return _strings.size();
+            }
+
+            size_t StringPool::CaseInsensitiveHash::operator()(Base::StringView value) const
+            {
+                // FNV-1a
+                size_t hash = 2166136261u;
+                for (char chr : value)
+                {
+                    hash ^= static_cast<size_t>(std::tolower(static_cast<unsigned char>(chr)));
+                    hash *= 16777619u;
+                }
+                return hash;
+            }
+
+            bool StringPool::CaseInsensitiveEqual::operator()(Base::StringView left, Base::StringView right) const
+            {
+                if (left.size() != right.size())
+                {
+                    return false;
+                }
+                for (size_t i = 0; i != left.size(); ++i)
+                {
+                    if (std::tolower(static_cast<unsigned char>(left[i])) != std::tolower(static_cast<unsigned char>(right[i])))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+        }
+    }
+}
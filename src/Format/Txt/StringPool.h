@@ -0,0 +1,45 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include "../../Base/StringView.h"
+
+namespace Falltergeist
+{
+    namespace Format
+    {
+        namespace Txt
+        {
+            /**
+             * @brief Interns names which repeat many times in a text file, like property names of MAPS.TXT or WORLDMAP.TXT sections.
+             * Each distinct name is stored once, lowercased; looking up one which is already there doesn't allocate.
+             */
+            class StringPool
+            {
+                public:
+                    /**
+                     * Returns pooled lowercase copy of given name. Names differing only by case share the same string.
+                     * Returned reference is valid while the pool lives.
+                     */
+                    const std::string& lowercase(Base::StringView name);
+
+                    size_t size() const;
+
+                private:
+                    struct CaseInsensitiveHash
+                    {
+                        size_t operator()(Base::StringView value) const;
+                    };
+
+                    struct CaseInsensitiveEqual
+                    {
+                        bool operator()(Base::StringView left, Base::StringView right) const;
+                    };
+
+                    // keys view the pooled strings
+                    std::unordered_map<Base::StringView, std::unique_ptr<std::string>, CaseInsensitiveHash, CaseInsensitiveEqual> _strings;
+            };
+        }
+    }
+}
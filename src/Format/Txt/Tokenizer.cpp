@@ -0,0 +1,130 @@
+#include <limits>
+#include "../../Exception.h"
+#include "../Dat/Stream.h"
+#include "../Txt/Tokenizer.h"
+
+namespace Falltergeist
+{
+    namespace Format
+    {
+        namespace Txt
+        {
+            Tokenizer::Tokenizer(const Dat::Stream& stream)
+                : _text(reinterpret_cast<const char*>(stream.data()), stream.size())
+            {
+            }
+
+            Tokenizer::Tokenizer(Base::StringView text) : _text(text)
+            {
+            }
+
+            bool Tokenizer::atEnd() const
+            {
+                return _position >= _text.size();
+            }
+
+            bool Tokenizer::nextLine(Base::StringView& line)
+            {
+                if (atEnd())
+                {
+                    return false;
+                }
+
+                size_t end = _text.find('\n', _position);
+                bool lastLine = (end == Base::StringView::npos);
+                if (lastLine)
+                {
+                    end = _text.size();
+                }
+
+                line = _text.substr(_position, end - _position);
+                _position = lastLine ? end : end + 1;
+
+                if (!line.empty() && line.back() == '\r')
+                {
+                    line = line.substr(0, line.size() - 1);
+                }
+                return !(lastLine && line.empty());
+            }
+
+            bool Tokenizer::nextUntil(char delimiter, Base::StringView& token)
+            {
+                size_t end = _text.find(delimiter, _position);
+                if (end == Base::StringView::npos)
+                {
+                    return false;
+                }
+                token = _text.substr(_position, end - _position);
+                _position = end + 1;
+                return true;
+            }
+
+            Base::StringView Tokenizer::nextUntilAny(const char* delimiters)
+            {
+                size_t end = _text.findFirstOf(delimiters, _position);
+                if (end == Base::StringView::npos)
+                {
+                    end = _text.size();
+                }
+                auto token = _text.substr(_position, end - _position);
+                _position = end;
+                return token;
+            }
+
+            bool Tokenizer::skipPast(char delimiter)
+            {
+                size_t found = _text.find(delimiter, _position);
+                if (found == Base::StringView::npos)
+                {
+                    _position = _text.size();
+                    return false;
+                }
+                _position = found + 1;
+                return true;
+            }
+
+            void Tokenizer::split(Base::StringView value, char delimiter, std::vector<Base::StringView>& tokens)
+            {
+                tokens.clear();
+                size_t start = 0, end = 0;
+                while ((end = value.find(delimiter, start)) != Base::StringView::npos)
+                {
+                    tokens.push_back(value.substr(start, end - start));
+                    start = end + 1;
+                }
+                tokens.push_back(value.substr(start));
+            }
+
+            int Tokenizer::toInt(Base::StringView value)
+            {
+                auto trimmed = value.ltrimmed();
+                size_t position = 0;
+                bool negative = false;
+                if (position != trimmed.size() && (trimmed[position] == '-' || trimmed[position] == '+'))
+                {
+                    negative = (trimmed[position] == '-');
+                    ++position;
+                }
+
+                size_t digitsStart = position;
+                // magnitude of INT_MIN is one more than INT_MAX
+                const long long limit = static_cast<long long>(std::numeric_limits<int>::max()) + (negative ? 1 : 0);
+                long long result = 0;
+                while (position != trimmed.size() && trimmed[position] >= '0' && trimmed[position] <= '9')
+                {
+                    result = result * 10 + (trimmed[position] - '0');
+                    if (result > limit)
+                    {
+                        throw Exception("Tokenizer::toInt() - number is out of range: " + value.str());
+                    }
+                    ++position;
+                }
+                if (position == digitsStart)
+                {
+                    throw Exception("Tokenizer::toInt() - not a number: " + value.str());
+                }
+                return static_cast<int>(negative ? -result : result);
+            }
+        }
+    }
+}
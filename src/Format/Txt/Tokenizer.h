@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "../../Base/StringView.h"
+
+namespace Falltergeist
+{
+    namespace Format
+    {
+        namespace Dat
+        {
+            class Stream;
+        }
+
+        namespace Txt
+        {
+            /**
+             * @brief Splits text of a resource file into lines and tokens in a single pass, without copying it.
+             * Works directly over the decompressed entry buffer: returned views point into it and stay valid while the stream lives.
+             */
+            class Tokenizer
+            {
+                public:
+                    Tokenizer(const Dat::Stream& stream);
+                    Tokenizer(Base::StringView text);
+
+                    bool atEnd() const;
+
+                    /**
+                     * Returns next line without the line break ("\n" or "\r\n").
+                     * Text after the last line break is returned only if it is not empty.
+                     * @return false if there are no lines left
+                     */
+                    bool nextLine(Base::StringView& line);
+
+                    /**
+                     * Returns text up to the next given delimiter and moves past it.
+                     * @return false if there is no such delimiter left, position is not changed then
+                     */
+                    bool nextUntil(char delimiter, Base::StringView& token);
+
+                    /**
+                     * Returns text up to the next of given delimiters, which is left unread, or up to the end of text.
+                     */
+                    Base::StringView nextUntilAny(const char* delimiters);
+
+                    /**
+                     * Moves past the next given delimiter.
+                     * @return false if there is no such delimiter left
+                     */
+                    bool skipPast(char delimiter);
+
+                    /**
+                     * Splits value by delimiter into given vector, which is cleared first.
+                     * The vector is meant to be reused, so splitting lines doesn't allocate once it has grown.
+                     */
+                    static void split(Base::StringView value, char delimiter, std::vector<Base::StringView>& tokens);
+
+                    /**
+                     * Parses integer the way std::stoi does: leading spaces, optional sign and digits up to the first other character.
+                     * @throws Exception if there are no digits
+                     */
+                    static int toInt(Base::StringView value);
+
+                private:
+                    Base::StringView _text;
+                    size_t _position = 0;
+            };
+        }
+    }
+}
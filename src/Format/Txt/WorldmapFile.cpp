@@ -1,4 +1,6 @@
 #include <sstream>
+#include "../Cache/Reader.h"
+#include "../Cache/Writer.h"
 #include "../Dat/Stream.h"
 #include "../Ini/File.h"
 #include "../Txt/Lexer.h"
@@ -16,7 +18,272 @@ namespace Falltergeist
             const char* NumericExpression::GLOBAL      = "Global";         // game global variable value
             const char* NumericExpression::RAND        = "Rand";           // a random value between 0 and 99
 
-            void WorldmapFile::_parseText(std::istream& stream)
+            namespace
+            {
+                void write(Cache::Writer& writer, const NumericExpression& exp)
+                {
+                    writer.writeString(exp.func);
+                    writer.writeString(exp.arg.str());
+                }
+
+                void read(Cache::Reader& reader, NumericExpression& exp)
+                {
+                    exp.func = reader.string();
+                    exp.arg = reader.string();
+                }
+
+                void write(Cache::Writer& writer, const Condition& condition)
+                {
+                    writer.writeCount(condition.size());
+                    for (auto& exp : condition)
+                    {
+                        writer.writeUint8(static_cast<uint8_t>(exp._operator));
+                        write(writer, exp._leftOperand);
+                        write(writer, exp._rightOperand);
+                    }
+                }
+
+                void read(Cache::Reader& reader, Condition& condition)
+                {
+                    condition.resize(reader.count());
+                    for (auto& exp : condition)
+                    {
+                        exp._operator = static_cast<LogicalExpression::Operator>(reader.uint8());
+                        read(reader, exp._leftOperand);
+                        read(reader, exp._rightOperand);
+                    }
+                }
+
+                void write(Cache::Writer& writer, const std::vector<EncounterGroup>& team)
+                {
+                    writer.writeCount(team.size());
+                    for (auto& group : team)
+                    {
+                        writer.writeString(group.encounterType);
+                        writer.writeUint32(group.minCount);
+                        writer.writeUint32(group.maxCount);
+                    }
+                }
+
+                void read(Cache::Reader& reader, std::vector<EncounterGroup>& team)
+                {
+                    team.resize(reader.count());
+                    for (auto& group : team)
+                    {
+                        group.encounterType = reader.string();
+                        group.minCount = reader.uint32();
+                        group.maxCount = reader.uint32();
+                    }
+                }
+
+                void write(Cache::Writer& writer, const std::vector<std::string>& strings)
+                {
+                    writer.writeCount(strings.size());
+                    for (auto& value : strings)
+                    {
+                        writer.writeString(value);
+                    }
+                }
+
+                void read(Cache::Reader& reader, std::vector<std::string>& strings)
+                {
+                    strings.resize(reader.count());
+                    for (auto& value : strings)
+                    {
+                        value = reader.string();
+                    }
+                }
+
+                void write(Cache::Writer& writer, const Encounter& enc)
+                {
+                    writer.writeString(enc.position);
+                    writer.writeInt32(enc.spacing);
+                    write(writer, enc.distance);
+                    writer.writeCount(enc.objects.size());
+                    for (auto& obj : enc.objects)
+                    {
+                        writer.writeInt32(obj.pid);
+                        writer.writeInt32(obj.ratio);
+                        writer.writeInt32(obj.script);
+                        writer.writeInt32(obj.distance);
+                        writer.writeBool(obj.dead);
+                        writer.writeCount(obj.items.size());
+                        for (auto& item : obj.items)
+                        {
+                            writer.writeUint32(item.pid);
+                            writer.writeBool(item.wielded);
+                            writer.writeUint32(item.minCount);
+                            writer.writeUint32(item.maxCount);
+                        }
+                        write(writer, obj.condition);
+                    }
+                }
+
+                void read(Cache::Reader& reader, Encounter& enc)
+                {
+                    enc.position = reader.string();
+                    enc.spacing = reader.int32();
+                    read(reader, enc.distance);
+                    enc.objects.resize(reader.count());
+                    for (auto& obj : enc.objects)
+                    {
+                        obj.pid = reader.int32();
+                        obj.ratio = reader.int32();
+                        obj.script = reader.int32();
+                        obj.distance = reader.int32();
+                        obj.dead = reader.boolean();
+                        obj.items.resize(reader.count());
+                        for (auto& item : obj.items)
+                        {
+                            item.pid = reader.uint32();
+                            item.wielded = reader.boolean();
+                            item.minCount = reader.uint32();
+                            item.maxCount = reader.uint32();
+                        }
+                        read(reader, obj.condition);
+                    }
+                }
+
+                void write(Cache::Writer& writer, const EncounterTable& table)
+                {
+                    writer.writeString(table.lookupName);
+                    write(writer, table.maps);
+                    writer.writeCount(table.encounters.size());
+                    for (auto& entry : table.encounters)
+                    {
+                        writer.writeUint8(static_cast<uint8_t>(entry.action));
+                        writer.writeBool(entry.isSpecial);
+                        writer.writeString(entry.map);
+                        writer.writeUint8(entry.chance);
+                        writer.writeInt32(entry.counter);
+                        write(writer, entry.condition);
+                        write(writer, entry.team1);
+                        write(writer, entry.team2);
+                    }
+                }
+
+                void read(Cache::Reader& reader, EncounterTable& table)
+                {
+                    table.lookupName = reader.string();
+                    read(reader, table.maps);
+                    table.encounters.resize(reader.count());
+                    for (auto& entry : table.encounters)
+                    {
+                        entry.action = static_cast<EncounterTableEntry::Action>(reader.uint8());
+                        entry.isSpecial = reader.boolean();
+                        entry.map = reader.string();
+                        entry.chance = reader.uint8();
+                        entry.counter = reader.int32();
+                        read(reader, entry.condition);
+                        read(reader, entry.team1);
+                        read(reader, entry.team2);
+                    }
+                }
+
+                void write(Cache::Writer& writer, const WorldmapTile& tile)
+                {
+                    writer.writeInt32(tile.artIdx);
+                    writer.writeInt32(tile.encounterDifficulty);
+                    writer.writeString(tile.walkMaskName);
+                    for (auto& column : tile.subtiles)
+                    {
+                        for (auto& subtile : column)
+                        {
+                            writer.writeString(subtile.terrain);
+                            writer.writeUint8(static_cast<uint8_t>(subtile.fill));
+                            writer.writeUint8(subtile.morningChance);
+                            writer.writeUint8(subtile.afternoonChance);
+                            writer.writeUint8(subtile.nightChance);
+                            writer.writeString(subtile.encounterTable);
+                        }
+                    }
+                }
+
+                void read(Cache::Reader& reader, WorldmapTile& tile)
+                {
+                    tile.artIdx = reader.int32();
+                    tile.encounterDifficulty = reader.int32();
+                    tile.walkMaskName = reader.string();
+                    for (auto& column : tile.subtiles)
+                    {
+                        for (auto& subtile : column)
+                        {
+                            subtile.terrain = reader.string();
+                            subtile.fill = static_cast<WorldmapSubtile::Fill>(reader.uint8());
+                            subtile.morningChance = reader.uint8();
+                            subtile.afternoonChance = reader.uint8();
+                            subtile.nightChance = reader.uint8();
+                            subtile.encounterTable = reader.string();
+                        }
+                    }
+                }
+            }
+
+            WorldmapFile::WorldmapFile(Cache::Reader& reader)
+            {
+                numHorizontalTiles = reader.int32();
+                for (size_t i = 0, count = reader.count(); i != count; ++i)
+                {
+                    auto name = reader.string();
+                    chanceNames[name] = reader.uint8();
+                }
+                for (size_t i = 0, count = reader.count(); i != count; ++i)
+                {
+                    auto& terrain = terrainTypes[reader.string()];
+                    terrain.travelDelay = reader.int32();
+                    read(reader, terrain.randomMaps);
+                }
+                for (size_t i = 0, count = reader.count(); i != count; ++i)
+                {
+                    read(reader, encounterTypes[reader.string()]);
+                }
+                for (size_t i = 0, count = reader.count(); i != count; ++i)
+                {
+                    read(reader, encounterTables[reader.string()]);
+                }
+                tiles.resize(reader.count());
+                for (auto& tile : tiles)
+                {
+                    read(reader, tile);
+                }
+            }
+
+            void WorldmapFile::save(Cache::Writer& writer) const
+            {
+                writer.writeInt32(numHorizontalTiles);
+                writer.writeCount(chanceNames.size());
+                for (auto& chance : chanceNames)
+                {
+                    writer.writeString(chance.first);
+                    writer.writeUint8(chance.second);
+                }
+                writer.writeCount(terrainTypes.size());
+                for (auto& terrain : terrainTypes)
+                {
+                    writer.writeString(terrain.first);
+                    writer.writeInt32(terrain.second.travelDelay);
+                    write(writer, terrain.second.randomMaps);
+                }
+                writer.writeCount(encounterTypes.size());
+                for (auto& enc : encounterTypes)
+                {
+                    writer.writeString(enc.first);
+                    write(writer, enc.second);
+                }
+                writer.writeCount(encounterTables.size());
+                for (auto& table : encounterTables)
+                {
+                    writer.writeString(table.first);
+                    write(writer, table.second);
+                }
+                writer.writeCount(tiles.size());
+                for (auto& tile : tiles)
+                {
+                    write(writer, tile);
+                }
+            }
+
+            void WorldmapFile::_parseText(const Dat::Stream& stream)
             {
                 Ini::Parser parser(stream);
                 auto file = parser.parse();
@@ -430,8 +697,7 @@ namespace Falltergeist
 
             WorldmapFile::WorldmapFile(Dat::Stream&& stream)
             {
-                std::istream istr(&stream);
-                _parseText(istr);
+                _parseText(stream);
             }
         }
     }
@@ -10,6 +10,12 @@ namespace Falltergeist
 {
     namespace Format
     {
+        namespace Cache
+        {
+            class Reader;
+            class Writer;
+        }
+
         namespace Dat
         {
             class Stream;
@@ -220,8 +226,12 @@ namespace Falltergeist
             {
                 public:
                     WorldmapFile(Dat::Stream&& stream);
+                    // Restores parsed file from the binary cache
+                    WorldmapFile(Cache::Reader& reader);
+
+                    void save(Cache::Writer& writer) const;
 
-                    int numHorizontalTiles;
+                    int numHorizontalTiles = 0;
 
                     std::map<std::string, unsigned char> chanceNames;
                     std::map<std::string, TerrainType> terrainTypes;
@@ -231,7 +241,7 @@ namespace Falltergeist
 
                 protected:
 
-                    void _parseText(std::istream& istr);
+                    void _parseText(const Dat::Stream& stream);
 
                     EncounterObject _parseEncounterObject(const Ini::Value&);
                     InventoryItem _parseInventoryItem(const std::string&);
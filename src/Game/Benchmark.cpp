@@ -0,0 +1,323 @@
+#include <functional>
+#include <list>
+#include <map>
+#include <unordered_map>
+#include <SDL.h>
+#include "../Event/Event.h"
+#include "../Exception.h"
+#include "../Format/Aaf/File.h"
+#include "../Format/Acm/File.h"
+#include "../Format/Bio/File.h"
+#include "../Format/Dat/BinaryReader.h"
+#include "../Format/Dat/Stream.h"
+#include "../Format/Fon/File.h"
+#include "../Format/Frm/File.h"
+#include "../Format/Gam/File.h"
+#include "../Format/Gcd/File.h"
+#include "../Format/Int/File.h"
+#include "../Format/Lip/File.h"
+#include "../Format/Lst/File.h"
+#include "../Format/Map/File.h"
+#include "../Format/Mve/Chunk.h"
+#include "../Format/Mve/Decoder.h"
+#include "../Format/Mve/File.h"
+#include "../Format/Msg/File.h"
+#include "../Format/Pal/File.h"
+#include "../Format/Pro/File.h"
+#include "../Format/Rix/File.h"
+#include "../Format/Sve/File.h"
+#include "../Format/Txt/CityFile.h"
+#include "../Format/Txt/CSVBasedFile.h"
+#include "../Format/Txt/MapsFile.h"
+#include "../Format/Txt/WorldmapFile.h"
+#include "../Game/Benchmark.h"
+#include "../Game/Timer.h"
+#include "../Game/TimerWheel.h"
+#include "../Logger.h"
+#include "../ResourceManager.h"
+
+namespace Falltergeist
+{
+    namespace Game
+    {
+        namespace
+        {
+            using Parser = std::function<void(Format::Dat::Stream&& stream)>;
+
+            template <class T>
+            Parser parser()
+            {
+                return [](Format::Dat::Stream&& stream) {
+                    T file(std::move(stream));
+                };
+            }
+
+            Format::Pro::File* fetchProFileType(unsigned int PID)
+            {
+                return ResourceManager::getInstance()->proFileType(PID);
+            }
+
+            // MB per second
+            uint32_t throughput(uint64_t bytes, uint64_t ticks)
+            {
+                double seconds = static_cast<double>(ticks) / static_cast<double>(SDL_GetPerformanceFrequency());
+                return static_cast<uint32_t>(seconds > 0 ? bytes / seconds / (1024 * 1024) : 0);
+            }
+        }
+
+        void Benchmark::run(const std::string& name)
+        {
+            Logger::info("BENCHMARK") << "Running " << name << " benchmark" << std::endl;
+            if (name == "timers") {
+                _timers();
+                return;
+            }
+            if (name == "parse") {
+                _parsing();
+                return;
+            }
+            if (name == "mve") {
+                _movies();
+                return;
+            }
+            throw Exception("Benchmark::run() - unknown benchmark: " + name);
+        }
+
+        void Benchmark::_timers()
+        {
+            // 10000 live timers, each one is scheduled again when it fires, like scripts usually do
+            const unsigned int TIMERS = 10000;
+            const unsigned int FRAMES = 3600; // one minute at 60 fps
+            const float frameTime = 1000.0f / 60.0f;
+            const double frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+
+            // same pseudo-random delays for both runs, 1..600 game ticks
+            uint32_t seed = 1;
+            auto nextDelay = [&seed]() -> uint32_t {
+                seed = seed * 1103515245u + 12345u;
+                return 1 + (seed >> 16) % 600;
+            };
+
+            uint64_t fired = 0;
+            TimerWheel wheel;
+            wheel.setCallback([&wheel, &fired, &nextDelay](Object* object, int fixedParam) {
+                fired++;
+                wheel.add(object, nextDelay(), fixedParam);
+            });
+            for (unsigned int i = 0; i != TIMERS; ++i) {
+                wheel.add(nullptr, nextDelay(), static_cast<int>(i));
+            }
+            uint64_t start = SDL_GetPerformanceCounter();
+            for (unsigned int frame = 0; frame != FRAMES; ++frame) {
+                wheel.think(frameTime);
+            }
+            double wheelSeconds = static_cast<double>(SDL_GetPerformanceCounter() - start) / frequency;
+            Logger::info("BENCHMARK") << "Timing wheel: " << fired << " timers fired, "
+                                      << static_cast<uint32_t>(wheelSeconds * 1000000.0 / FRAMES) << " us per frame" << std::endl;
+
+            // the list of separate timers which was used before the wheel, each one checked every frame
+            seed = 1;
+            fired = 0;
+            std::list<Timer> timers;
+            for (unsigned int i = 0; i != TIMERS; ++i) {
+                timers.emplace_back(static_cast<float>(nextDelay()) * TimerWheel::TICK_DURATION);
+                Timer* timer = &timers.back();
+                timer->tickHandler().add([timer, &fired, &nextDelay](Event::Event*) {
+                    fired++;
+                    timer->start(static_cast<float>(nextDelay()) * TimerWheel::TICK_DURATION);
+                });
+                timer->start();
+            }
+            start = SDL_GetPerformanceCounter();
+            for (unsigned int frame = 0; frame != FRAMES; ++frame) {
+                for (auto& timer : timers) {
+                    timer.think(frameTime);
+                }
+            }
+            double listSeconds = static_cast<double>(SDL_GetPerformanceCounter() - start) / frequency;
+            Logger::info("BENCHMARK") << "Timer list: " << fired << " timers fired, "
+                                      << static_cast<uint32_t>(listSeconds * 1000000.0 / FRAMES) << " us per frame" << std::endl;
+        }
+
+        void Benchmark::_movies()
+        {
+            auto lst = ResourceManager::getInstance()->lstFileType("data/movies.lst");
+            if (!lst) {
+                throw Exception("Benchmark::_movies() - can't open data/movies.lst");
+            }
+
+            const double frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+            uint64_t totalFrames = 0;
+            uint64_t totalTicks = 0;
+            Format::Mve::Chunk chunk;
+
+            for (auto& name : *lst->strings()) {
+                auto mve = ResourceManager::getInstance()->mveFileType("art/cuts/" + name);
+                if (!mve) {
+                    continue;
+                }
+
+                // only video decoding is timed, reading chunks from archives is not
+                Format::Mve::Decoder decoder;
+                uint64_t frames = 0;
+                uint64_t ticks = 0;
+                try {
+                    while (mve->readChunk(chunk)) {
+                        uint64_t start = SDL_GetPerformanceCounter();
+                        for (auto& opcode : chunk.opcodes()) {
+                            if (decoder.decode(opcode)) {
+                                frames++;
+                            }
+                        }
+                        ticks += SDL_GetPerformanceCounter() - start;
+                    }
+                } catch (const Exception& e) {
+                    Logger::error("BENCHMARK") << name << ": " << e.what() << std::endl;
+                }
+
+                double seconds = static_cast<double>(ticks) / frequency;
+                Logger::info("BENCHMARK") << name << ": " << frames << " frames decoded in "
+                                          << static_cast<uint32_t>(seconds * 1000.0) << " ms, "
+                                          << static_cast<uint32_t>(seconds > 0 ? frames / seconds : 0) << " fps" << std::endl;
+                totalFrames += frames;
+                totalTicks += ticks;
+            }
+
+            double seconds = static_cast<double>(totalTicks) / frequency;
+            Logger::info("BENCHMARK") << "Movies: " << totalFrames << " frames decoded in "
+                                      << static_cast<uint32_t>(seconds * 1000.0) << " ms, "
+                                      << static_cast<uint32_t>(seconds > 0 ? totalFrames / seconds : 0) << " fps" << std::endl;
+        }
+
+        void Benchmark::_parsing()
+        {
+            // parsers by extension, text files by name as each one has a format of its own
+            const std::unordered_map<std::string, Parser> formats = {
+                {"aaf", parser<Format::Aaf::File>()},
+                {"acm", parser<Format::Acm::File>()},
+                {"bio", parser<Format::Bio::File>()},
+                {"fon", parser<Format::Fon::File>()},
+                {"frm", parser<Format::Frm::File>()},
+                {"fr0", parser<Format::Frm::File>()},
+                {"fr1", parser<Format::Frm::File>()},
+                {"fr2", parser<Format::Frm::File>()},
+                {"fr3", parser<Format::Frm::File>()},
+                {"fr4", parser<Format::Frm::File>()},
+                {"fr5", parser<Format::Frm::File>()},
+                {"gam", parser<Format::Gam::File>()},
+                {"gcd", parser<Format::Gcd::File>()},
+                {"int", parser<Format::Int::File>()},
+                {"lip", parser<Format::Lip::File>()},
+                {"lst", parser<Format::Lst::File>()},
+                // objects are parsed with their prototypes, which are loaded once and cached by the resource manager
+                {"map", [](Format::Dat::Stream&& stream) {
+                    Format::Map::File map(std::move(stream));
+                    map.init(&fetchProFileType);
+                }},
+                {"msg", parser<Format::Msg::File>()},
+                {"pal", parser<Format::Pal::File>()},
+                {"pro", parser<Format::Pro::File>()},
+                {"rix", parser<Format::Rix::File>()},
+                {"sve", parser<Format::Sve::File>()},
+            };
+            const std::unordered_map<std::string, Parser> texts = {
+                {"data/city.txt", parser<Format::Txt::CityFile>()},
+                {"data/enddeath.txt", parser<Format::Txt::EndDeathFile>()},
+                {"data/endgame.txt", parser<Format::Txt::EndGameFile>()},
+                {"data/genrep.txt", parser<Format::Txt::GenRepFile>()},
+                {"data/holodisk.txt", parser<Format::Txt::HolodiskFile>()},
+                {"data/karmavar.txt", parser<Format::Txt::KarmaVarFile>()},
+                {"data/maps.txt", parser<Format::Txt::MapsFile>()},
+                {"data/quests.txt", parser<Format::Txt::QuestsFile>()},
+                {"data/worldmap.txt", parser<Format::Txt::WorldmapFile>()},
+            };
+
+            struct Totals
+            {
+                uint64_t files = 0;
+                uint64_t bytes = 0;
+                uint64_t streamTicks = 0;
+                uint64_t readerTicks = 0;
+                uint64_t parseTicks = 0;
+                uint64_t errors = 0;
+            };
+            std::map<std::string, Totals> totals;
+            uint64_t skipped = 0;
+            // keeps reads from being optimized out
+            uint32_t checksum = 0;
+
+            // every file of DAT archives is read three times from memory: word by word through Dat::Stream,
+            // through BinaryReader, and parsed
+            auto resources = ResourceManager::getInstance();
+            for (auto& name : resources->datFilenames()) {
+                const Parser* parse = nullptr;
+                std::string format = name.substr(name.find_last_of('.') + 1);
+                auto text = texts.find(name);
+                auto known = formats.find(format);
+                if (text != texts.end()) {
+                    parse = &text->second;
+                } else if (known != formats.end()) {
+                    parse = &known->second;
+                    if (format.compare(0, 2, "fr") == 0) {
+                        format = "frm";
+                    }
+                } else {
+                    skipped++;
+                    continue;
+                }
+
+                Totals& total = totals[format];
+                resources->loadStream(name, [&](Format::Dat::Stream&& stream) {
+                    const size_t words = stream.size() / 2;
+
+                    stream.setEndianness(ENDIANNESS::BIG);
+                    stream.setPosition(0);
+                    uint64_t start = SDL_GetPerformanceCounter();
+                    for (size_t i = 0; i != words; ++i) {
+                        checksum += stream.uint16();
+                    }
+                    total.streamTicks += SDL_GetPerformanceCounter() - start;
+
+                    start = SDL_GetPerformanceCounter();
+                    Format::Dat::BigEndianReader reader(stream.data(), stream.size());
+                    for (size_t i = 0; i != words; ++i) {
+                        checksum += reader.uint16();
+                    }
+                    total.readerTicks += SDL_GetPerformanceCounter() - start;
+
+                    total.bytes += stream.size();
+                    total.files++;
+                    stream.setPosition(0);
+                    start = SDL_GetPerformanceCounter();
+                    try {
+                        (*parse)(std::move(stream));
+                    } catch (const Exception& e) {
+                        total.errors++;
+                        Logger::error("BENCHMARK") << name << ": " << e.what() << std::endl;
+                    }
+                    total.parseTicks += SDL_GetPerformanceCounter() - start;
+                });
+            }
+
+            Totals all;
+            for (auto& it : totals) {
+                const Totals& total = it.second;
+                Logger::info("BENCHMARK") << it.first << ": " << total.files << " files (" << total.errors << " failed), "
+                                          << total.bytes << " bytes; Dat::Stream::uint16 " << throughput(total.bytes, total.streamTicks)
+                                          << " MB/s, BinaryReader::uint16 " << throughput(total.bytes, total.readerTicks)
+                                          << " MB/s, parsing " << throughput(total.bytes, total.parseTicks) << " MB/s" << std::endl;
+                all.files += total.files;
+                all.errors += total.errors;
+                all.bytes += total.bytes;
+                all.streamTicks += total.streamTicks;
+                all.readerTicks += total.readerTicks;
+                all.parseTicks += total.parseTicks;
+            }
+            Logger::info("BENCHMARK") << "All formats: " << all.files << " files (" << all.errors << " failed), "
+                                      << all.bytes << " bytes; Dat::Stream::uint16 " << throughput(all.bytes, all.streamTicks)
+                                      << " MB/s, BinaryReader::uint16 " << throughput(all.bytes, all.readerTicks)
+                                      << " MB/s, parsing " << throughput(all.bytes, all.parseTicks) << " MB/s" << std::endl;
+            Logger::info("BENCHMARK") << skipped << " files of other formats skipped, checksum " << checksum << std::endl;
+        }
+    }
+}
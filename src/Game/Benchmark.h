@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+
+namespace Falltergeist
+{
+    namespace Game
+    {
+        /**
+         * Measurements run instead of the game, selected by name with the "benchmark" setting.
+         * Each one logs its results and returns, then the game quits.
+         */
+        class Benchmark final
+        {
+            public:
+                // Throws Exception if there is no benchmark with given name
+                void run(const std::string& name);
+
+            private:
+                // 10000 script timers through the timing wheel and through a plain timer list, time per frame
+                void _timers();
+                // decodes all movies as fast as possible, frames per second
+                void _movies();
+                // every file of known format in DAT archives, read throughput of Dat::Stream and BinaryReader and parsing speed
+                void _parsing();
+        };
+    }
+}
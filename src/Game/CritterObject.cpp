@@ -8,6 +8,7 @@
 #include "../Game/DudeObject.h"
 #include "../Game/ExitMiscObject.h"
 #include "../Game/Game.h"
+#include "../Game/ObjectRegistry.h"
 #include "../Game/WeaponItemObject.h"
 #include "../Helpers/CritterHelper.h"
 #include "../Graphics/CritterAnimationFactory.h"
@@ -23,7 +24,17 @@ namespace Falltergeist
     {
         using namespace Base;
 
-        CritterObject::CritterObject() : Object()
+        namespace
+        {
+            // all zeroes, shared by critters not created from a prototype (like the player)
+            const std::shared_ptr<const CritterStats>& emptyStats()
+            {
+                static const std::shared_ptr<const CritterStats> stats = std::make_shared<CritterStats>();
+                return stats;
+            }
+        }
+
+        CritterObject::CritterObject() : Object(), _stats(emptyStats().get()), _sharedStats(emptyStats())
         {
             _type = Type::CRITTER;
             _setupNextIdleAnim();
@@ -39,6 +50,26 @@ namespace Falltergeist
             Object::setOrientation(value);
         }
 
+        void CritterObject::setPrototype(const std::shared_ptr<const Prototype>& prototype)
+        {
+            Object::setPrototype(prototype);
+            if (prototype && prototype->critterStats()) {
+                _sharedStats = prototype->critterStats();
+                _stats = _sharedStats.get();
+                _ownStats.reset();
+            }
+        }
+
+        CritterStats& CritterObject::_mutableStats()
+        {
+            if (!_ownStats) {
+                _ownStats = std::make_unique<CritterStats>(*_stats);
+                _stats = _ownStats.get();
+                _sharedStats.reset();
+            }
+            return *_ownStats;
+        }
+
         const std::shared_ptr<ArmorItemObject> &CritterObject::armorSlot() const
         {
             return _armorSlot;
@@ -92,7 +123,7 @@ namespace Falltergeist
             if (num > STAT::LUCK) {
                 throw Exception("CritterObject::stat(num) - num out of range:" + std::to_string((unsigned)num));
             }
-            return _stats.at((unsigned)num);
+            return _stats->stats.at((unsigned)num);
         }
 
         void CritterObject::setStat(STAT num, int value)
@@ -100,7 +131,7 @@ namespace Falltergeist
             if (num > STAT::LUCK) {
                 throw Exception("CritterObject::setStat(num, value) - num out of range:" + std::to_string((unsigned)num));
             }
-            _stats.at((unsigned)num) = value;
+            _mutableStats().stats.at((unsigned)num) = value;
         }
 
         int CritterObject::statTotal(STAT num) const
@@ -131,7 +162,7 @@ namespace Falltergeist
                 default:
                     break;
             }
-            return _statsBonus.at((unsigned)num) + bonus;
+            return _stats->statsBonus.at((unsigned)num) + bonus;
         }
 
         void CritterObject::setStatBonus(STAT num, int value)
@@ -139,7 +170,7 @@ namespace Falltergeist
             if (num > STAT::LUCK) {
                 throw Exception("CritterObject::setStatBonus(num, value) - num out of range:" + std::to_string((unsigned)num));
             }
-            _statsBonus.at((unsigned)num) = value;
+            _mutableStats().statsBonus.at((unsigned)num) = value;
         }
 
         int CritterObject::skillTagged(SKILL num) const
@@ -147,7 +178,7 @@ namespace Falltergeist
             if (num > SKILL::OUTDOORSMAN) {
                 throw Exception("CritterObject::skillTagged(num) - num out of range:" + std::to_string((unsigned)num));
             }
-            return _skillsTagged.at((unsigned)num);
+            return _stats->skillsTagged.at((unsigned)num);
         }
 
         void CritterObject::setSkillTagged(SKILL num, int value)
@@ -155,7 +186,7 @@ namespace Falltergeist
             if (num > SKILL::OUTDOORSMAN) {
                 throw Exception("CritterObject::setSkillTagged(num, value) - num out of range:" + std::to_string((unsigned)num));
             }
-            _skillsTagged.at((unsigned)num) = value;
+            _mutableStats().skillsTagged.at((unsigned)num) = value;
         }
 
         int CritterObject::skillBaseValue(SKILL skill) const
@@ -403,7 +434,7 @@ namespace Falltergeist
             if (type > DAMAGE::POISON) {
                 throw Exception("CritterObject::damageResist(type) - type out of range: " + std::to_string((unsigned)type));
             }
-            return _damageResist.at((unsigned)type);
+            return _stats->damageResist.at((unsigned)type);
         }
 
         void CritterObject::setDamageResist(DAMAGE type, int value)
@@ -411,7 +442,7 @@ namespace Falltergeist
             if (type > DAMAGE::POISON) {
                 throw Exception("CritterObject::setDamageResist(type, value) - type out of range: " + std::to_string((unsigned)type));
             }
-            _damageResist.at((unsigned)type) = value;
+            _mutableStats().damageResist.at((unsigned)type) = value;
         }
 
         int CritterObject::damageThreshold(DAMAGE type) const
@@ -419,7 +450,7 @@ namespace Falltergeist
             if ( type > DAMAGE::POISON) {
                 throw Exception("CritterObject::damageThreshold(type) - type out of range: " + std::to_string((unsigned)type));
             }
-            return _damageThreshold.at((unsigned)type);
+            return _stats->damageThreshold.at((unsigned)type);
         }
 
         void CritterObject::setDamageThreshold(DAMAGE type, int value)
@@ -427,7 +458,7 @@ namespace Falltergeist
             if ( type > DAMAGE::POISON) {
                 throw Exception("CritterObject::setDamageThreshold(type, value) - type out of range: " + std::to_string((unsigned)type));
             }
-            _damageThreshold.at((unsigned)type) = value;
+            _mutableStats().damageThreshold.at((unsigned)type) = value;
         }
 
         HAND CritterObject::currentHand() const
@@ -450,10 +481,10 @@ namespace Falltergeist
 
         void CritterObject::talk_p_proc()
         {
-            if (_script && _script->hasFunction("talk_p_proc")) {
+            if (_script && _script->hasFunction(STANDARD_PROCEDURE::TALK)) {
                 _script
                     ->setSourceObject(Game::getInstance()->player())
-                    ->call("talk_p_proc")
+                    ->call(STANDARD_PROCEDURE::TALK)
                 ;
             }
         }
@@ -468,8 +499,8 @@ namespace Falltergeist
 
         void CritterObject::critter_p_proc()
         {
-            if (_script && _script->hasFunction("critter_p_proc")) {
-                _script->call("critter_p_proc");
+            if (_script && _script->hasFunction(STANDARD_PROCEDURE::CRITTER)) {
+                _script->call(STANDARD_PROCEDURE::CRITTER);
             }
         }
 
@@ -503,7 +534,7 @@ namespace Falltergeist
             } else {
                 auto anim = (UI::Animation*)ui();
                 if (!_moving && (!anim || !anim->playing())) {
-                    if (SDL_GetTicks() > _nextIdleAnim) {
+                    if (Game::getInstance()->simulationTime() > _nextIdleAnim) {
                         setActionAnimation("aa");
                         _setupNextIdleAnim();
                     }
@@ -544,8 +575,8 @@ namespace Falltergeist
 
                     // This hack is needed for prevent game crash when player goes to the
                     // exit tile and location is changed but movement is not finished
-                    for (auto object : *hexagon->objects()) {
-                        if (std::dynamic_pointer_cast<ExitMiscObject>(object)) {
+                    for (ObjectHandle handle : *hexagon->objects()) {
+                        if (dynamic_cast<ExitMiscObject*>(ObjectRegistry::getInstance()->get(handle))) {
                             moveQueue->clear();
                             break;
                         }
@@ -822,7 +853,7 @@ namespace Falltergeist
 
         void CritterObject::_setupNextIdleAnim()
         {
-            _nextIdleAnim = SDL_GetTicks() + 10000 + (rand() % 7000);
+            _nextIdleAnim = Game::getInstance()->simulationTime() + Game::getInstance()->random().next(10000, 16999);
         }
 
         unsigned CritterObject::age() const
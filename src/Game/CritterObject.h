@@ -1,8 +1,10 @@
 #pragma once
 
+#include <array>
 #include <vector>
 #include "../Format/Enums.h"
 #include "../Game/Object.h"
+#include "../Game/Prototype.h"
 
 namespace Falltergeist
 {
@@ -19,7 +21,7 @@ namespace Falltergeist
         /**
          * Critter refers to player, all NPCs, creatures, robots, etc - all movable and shootable objects.
          */
-        class CritterObject : public Object, public std::enable_shared_from_this<CritterObject>
+        class CritterObject : public Object
         {
             public:
 
@@ -28,6 +30,7 @@ namespace Falltergeist
 
                 std::vector<std::shared_ptr<ItemObject>>* inventory(); // critter's own inventory
                 void setOrientation(Orientation value) override;
+                void setPrototype(const std::shared_ptr<const Prototype>& prototype) override;
 
                 std::vector<std::shared_ptr<Hexagon>>* movementQueue();
 
@@ -205,13 +208,13 @@ namespace Falltergeist
                 HAND _currentHand = HAND::RIGHT;
                 unsigned int _carryWeightMax = 0;
 
-                std::vector<int> _stats = {0, 0, 0, 0, 0, 0, 0};
-                std::vector<int> _statsBonus = {0, 0, 0, 0, 0, 0, 0};
-                std::vector<int> _skillsTagged = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-                std::vector<int> _skillsGainedValue = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-                std::vector<int> _traitsTagged = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-                std::vector<int> _damageResist = {0, 0, 0, 0, 0, 0, 0, 0, 0};
-                std::vector<int> _damageThreshold = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+                // stats, tagged skills and damage protection are read through _stats, which points to the record
+                // shared with the prototype until the first change copies it into _ownStats
+                const CritterStats* _stats;
+                std::shared_ptr<const CritterStats> _sharedStats;
+                std::unique_ptr<CritterStats> _ownStats;
+                std::array<int, 18> _skillsGainedValue{};
+                std::array<int, 16> _traitsTagged{};
                 std::vector<std::shared_ptr<ItemObject>> _inventory;
                 std::vector<std::shared_ptr<Hexagon>> _movementQueue;
 
@@ -221,6 +224,8 @@ namespace Falltergeist
 
                 virtual std::unique_ptr<UI::Animation> _generateMovementAnimation();
                 void _setupNextIdleAnim();
+                // own copy of the stats record, made on first change
+                CritterStats& _mutableStats();
                 void _generateUi() override;
         };
     }
@@ -3,6 +3,7 @@
 #include "../Event/Event.h"
 #include "../Game/Game.h"
 #include "../Logger.h"
+#include "../PathFinding/HexagonGrid.h"
 #include "../State/Location.h"
 #include "../UI/Animation.h"
 #include "../UI/AnimationQueue.h"
@@ -29,6 +30,12 @@ namespace Falltergeist
                 _opened = value;
                 setCanLightThru(_opened);
 
+                // open doors are walked through, closed ones are walked around
+                auto location = Game::getInstance()->locationState();
+                if (location && hexagon()) {
+                    location->hexagonGrid()->invalidate(hexagon().get());
+                }
+
                 if (auto queue = dynamic_cast<UI::AnimationQueue*>(this->ui())) {
                     queue->currentAnimation()->setReverse(value);
                 }
@@ -9,19 +9,25 @@
 #include "../Event/State.h"
 #include "../Exception.h"
 #include "../Format/Gam/File.h"
+#include "../Game/Benchmark.h"
 #include "../Game/DudeObject.h"
 #include "../Game/Game.h"
+#include "../Game/ObjectRegistry.h"
 #include "../Game/Time.h"
 #include "../Graphics/AnimatedPalette.h"
 #include "../Graphics/Renderer.h"
 #include "../Graphics/RendererConfig.h"
 #include "../Input/Mouse.h"
+#include "../Input/Recorder.h"
+#include "../Input/Replayer.h"
 #include "../Logger.h"
+#include "../Profiler.h"
 #include "../ResourceManager.h"
 #include "../Settings.h"
 #include "../State/State.h"
 #include "../State/Location.h"
 #include "../UI/FpsCounter.h"
+#include "../UI/ProfilerGraph.h"
 #include "../UI/TextArea.h"
 
 namespace Falltergeist
@@ -54,6 +60,8 @@ namespace Falltergeist
 
             _settings = std::move(settings);
 
+            _initInputLog();
+
             _eventDispatcher = std::make_unique<Event::Dispatcher>();
 
             _renderer = std::make_shared<Graphics::Renderer>(createRendererConfigFromSettings());
@@ -77,6 +85,8 @@ namespace Falltergeist
             _fpsCounter = std::make_unique<UI::FpsCounter>(Point(renderer()->width() - 42, 2));
             _fpsCounter->setWidth(42);
             _fpsCounter->setHorizontalAlign(UI::TextArea::HorizontalAlign::RIGHT);
+            _profilerGraph = std::make_unique<UI::ProfilerGraph>(Point(3, 3));
+            Profiler::setEnabled(_settings->profiler());
 
             version += " " + to_string(renderer()->size());
 
@@ -92,11 +102,34 @@ namespace Falltergeist
 
             IMG_Init(IMG_INIT_JPG | IMG_INIT_PNG);
 
-            srand(static_cast<unsigned>(time(nullptr))); /// randomization
-
             atexit(SDL_Quit);
         }
 
+        void Game::_initInputLog()
+        {
+            if (!_settings->replayInput().empty()) {
+                _inputReplayer = std::make_unique<Input::Replayer>(_settings->replayInput());
+                if (_inputReplayer->stepsPerSecond() != FPS) {
+                    Logger::warning("GAME") << "Input log was recorded at " << _inputReplayer->stepsPerSecond()
+                                            << " steps per second, replay may diverge" << std::endl;
+                }
+                _random.setSeed(_inputReplayer->seed());
+            } else {
+                _random.setSeed(static_cast<uint32_t>(time(nullptr)));
+                if (!_settings->recordInput().empty()) {
+                    _inputRecorder = std::make_unique<Input::Recorder>(_settings->recordInput(), _random.seed(), FPS);
+                }
+            }
+
+            if (!_settings->frameTimingLog().empty()) {
+                _frameTimingLog = std::make_unique<std::ofstream>(_settings->frameTimingLog(), std::ios_base::out | std::ios_base::trunc);
+                if (!_frameTimingLog->is_open()) {
+                    throw Exception("Game::init() - can't open frame timing log: " + _settings->frameTimingLog());
+                }
+                *_frameTimingLog << "frame,steps,handle_us,think_us,render_us,frame_us" << std::endl;
+            }
+        }
+
         Game::~Game()
         {
             shutdown();
@@ -104,6 +137,14 @@ namespace Falltergeist
 
         void Game::shutdown()
         {
+            if (_settings && !_settings->profilerTrace().empty()) {
+                Profiler::exportTrace(_settings->profilerTrace());
+            }
+            if (_inputRecorder) {
+                _inputRecorder->finish(_steps);
+                _inputRecorder.reset();
+            }
+            _frameTimingLog.reset();
             _mixer.reset();
             _mouse.reset();
             while (!_states.empty()) {
@@ -166,32 +207,142 @@ namespace Falltergeist
 
         void Game::run()
         {
+            if (!_settings->benchmark().empty()) {
+                Benchmark().run(_settings->benchmark());
+                return;
+            }
+
             Logger::info("GAME") << "Starting main loop" << std::endl;
             _frame = 0;
 
-            uint32_t FPS = 60;
-            uint32_t frameDelay = 1000 / FPS;
+            if (_inputReplayer) {
+                _runReplay();
+                Logger::info("GAME") << "Stopping main loop" << std::endl;
+                return;
+            }
 
-            uint32_t frameStart = 0;
-            uint32_t frameTime = 0;
+            if (_settings->headless()) {
+                _runHeadless();
+                if (_inputRecorder) {
+                    _inputRecorder->finish(_steps);
+                }
+                Logger::info("GAME") << "Stopping main loop" << std::endl;
+                return;
+            }
+
+            const uint32_t frameDelay = 1000 / FPS;
+            const float timeStep = 1000.0f / static_cast<float>(FPS);
+
+            // simulation runs in fixed steps independent of how long rendering takes
+            float accumulator = 0;
+            uint32_t lastTicks = SDL_GetTicks();
             while (!_quit) {
-                frameStart = SDL_GetTicks();
+                uint32_t frameStart = SDL_GetTicks();
+                accumulator += static_cast<float>(frameStart - lastTicks);
+                lastTicks = frameStart;
+                // don't try to catch up after a long stall (loading a map, dragging the window, etc.)
+                if (accumulator > timeStep * MAX_STEPS_PER_FRAME) {
+                    accumulator = timeStep * MAX_STEPS_PER_FRAME;
+                }
 
+                uint64_t handleStart = SDL_GetPerformanceCounter();
                 handle();
-                think(frameTime);
+                uint64_t thinkStart = SDL_GetPerformanceCounter();
+                uint32_t steps = 0;
+                while (accumulator >= timeStep) {
+                    think(timeStep);
+                    accumulator -= timeStep;
+                    steps++;
+                }
+                uint64_t renderStart = SDL_GetPerformanceCounter();
                 render();
+                if (_frameTimingLog) {
+                    _logFrameTiming(steps, handleStart, thinkStart, renderStart, SDL_GetPerformanceCounter());
+                }
                 _statesForDelete.clear();
                 _frame++;
+                Profiler::endFrame();
 
-                frameTime = SDL_GetTicks() - frameStart;
+                uint32_t frameTime = SDL_GetTicks() - frameStart;
                 if (frameDelay > frameTime) {
                     SDL_Delay(frameDelay - frameTime);
-                    frameTime += (frameDelay - frameTime);
                 }
             }
+            if (_inputRecorder) {
+                _inputRecorder->finish(_steps);
+            }
             Logger::info("GAME") << "Stopping main loop" << std::endl;
         }
 
+        void Game::_runHeadless()
+        {
+            const float timeStep = 1000.0f / static_cast<float>(FPS);
+            const unsigned int frames = _settings->headlessFrames();
+
+            Logger::info("GAME") << "Running headless, "
+                                 << (frames ? std::to_string(frames) : std::string("unlimited")) << " frames" << std::endl;
+
+            // no rendering and no throttling: simulate as fast as the logic allows
+            uint32_t started = SDL_GetTicks();
+            while (!_quit && (frames == 0 || _frame < frames)) {
+                uint64_t handleStart = SDL_GetPerformanceCounter();
+                handle();
+                uint64_t thinkStart = SDL_GetPerformanceCounter();
+                think(timeStep);
+                if (_frameTimingLog) {
+                    uint64_t thinkEnd = SDL_GetPerformanceCounter();
+                    _logFrameTiming(1, handleStart, thinkStart, thinkEnd, thinkEnd);
+                }
+                _statesForDelete.clear();
+                _frame++;
+                Profiler::endFrame();
+            }
+            uint32_t elapsed = SDL_GetTicks() - started;
+
+            Logger::info("GAME") << "Simulated " << _frame << " frames ("
+                                 << static_cast<uint32_t>(_frame * timeStep) << " ms of game time) in "
+                                 << elapsed << " ms" << std::endl;
+        }
+
+        void Game::_runReplay()
+        {
+            const float timeStep = 1000.0f / static_cast<float>(FPS);
+            const bool headless = _settings->headless();
+
+            // exactly one simulation step per frame, as fast as possible: input is fed by step number, not by wall clock
+            uint32_t started = SDL_GetTicks();
+            while (!_quit && !_inputReplayer->finished(_steps)) {
+                uint64_t handleStart = SDL_GetPerformanceCounter();
+                handle();
+                uint64_t thinkStart = SDL_GetPerformanceCounter();
+                think(timeStep);
+                uint64_t renderStart = SDL_GetPerformanceCounter();
+                if (!headless) {
+                    render();
+                }
+                if (_frameTimingLog) {
+                    _logFrameTiming(1, handleStart, thinkStart, renderStart, SDL_GetPerformanceCounter());
+                }
+                _statesForDelete.clear();
+                _frame++;
+                Profiler::endFrame();
+            }
+            uint32_t elapsed = SDL_GetTicks() - started;
+
+            Logger::info("GAME") << "Replayed " << _steps << " steps (" << simulationTime() << " ms of game time) in "
+                                 << elapsed << " ms" << std::endl;
+        }
+
+        void Game::_logFrameTiming(uint32_t steps, uint64_t handleStart, uint64_t thinkStart, uint64_t renderStart, uint64_t frameEnd)
+        {
+            const double toMicroseconds = 1000000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+            *_frameTimingLog << _frame << "," << steps << ","
+                             << static_cast<uint64_t>((thinkStart - handleStart) * toMicroseconds) << ","
+                             << static_cast<uint64_t>((renderStart - thinkStart) * toMicroseconds) << ","
+                             << static_cast<uint64_t>((frameEnd - renderStart) * toMicroseconds) << ","
+                             << static_cast<uint64_t>((frameEnd - handleStart) * toMicroseconds) << "\n";
+        }
+
         void Game::quit()
         {
             _quit = true;
@@ -200,6 +351,7 @@ namespace Falltergeist
         void Game::setPlayer(std::shared_ptr<DudeObject> player)
         {
             _player = std::move(player);
+            ObjectRegistry::getInstance()->setOwner(_player);
         }
 
         std::shared_ptr<DudeObject> Game::player() const
@@ -374,6 +526,10 @@ namespace Falltergeist
                     {
                         renderer()->screenshot();
                     }
+                    if (keyboardEvent->keyCode() == SDLK_F11)
+                    {
+                        Profiler::setEnabled(!Profiler::enabled());
+                    }
                     return std::move(keyboardEvent);
                 }
             }
@@ -382,6 +538,8 @@ namespace Falltergeist
 
         void Game::handle()
         {
+            ProfilerZone zone("Game::handle");
+
             if (_renderer->fading()) {
                 return;
             }
@@ -390,20 +548,47 @@ namespace Falltergeist
             {
                 if (_event.type == SDL_QUIT) {
                     _quit = true;
-                } else {
+                } else if (!_inputReplayer) {
                     auto event = _createEventFromSDL(_event);
                     if (event) {
-                        for (auto state : _getActiveStates()) state->handle(event.get());
+                        if (_inputRecorder) {
+                            _inputRecorder->record(_steps, event.get());
+                        }
+                        _dispatchEvent(event.get());
                     }
                 }
                 // process events generate during handle()
                 _eventDispatcher->processScheduledEvents();
             }
+
+            // while replaying, OS input is ignored and recorded events are fed at the steps they were captured at
+            if (_inputReplayer) {
+                while (auto event = _inputReplayer->next(_steps)) {
+                    _dispatchEvent(event.get());
+                    _eventDispatcher->processScheduledEvents();
+                }
+            }
+        }
+
+        void Game::_dispatchEvent(Event::Event* event)
+        {
+            // cursor follows the event stream rather than polled OS state, so it is the same in a replay
+            if (auto mouseEvent = dynamic_cast<Event::Mouse*>(event)) {
+                _mouse->updatePosition(mouseEvent->position());
+            }
+            for (auto state : _getActiveStates()) {
+                state->handle(event);
+            }
         }
 
         void Game::think(const float &deltaTime)
         {
+            ProfilerZone zone("Game::think");
+
+            _steps++;
+
             _fpsCounter->think(deltaTime);
+            _profilerGraph->think(deltaTime);
             _mouse->think(deltaTime);
 
             _animatedPalette->think(deltaTime);
@@ -431,7 +616,11 @@ namespace Falltergeist
 
         void Game::render()
         {
+            ProfilerZone zone("Game::render");
+
             renderer()->beginFrame();
+            // palette texture must not be rebound in the middle of binding textures for a draw call
+            _animatedPalette->update();
 
             for (auto state : _getVisibleStates()) {
                 state->render();
@@ -448,6 +637,7 @@ namespace Falltergeist
             }
 
             _currentTime->render();
+            _profilerGraph->render();
             // hexagon is rendered in location after floor
             if (_mouse->state() != Input::Mouse::Cursor::HEXAGON_RED) {
                 _mouse->render();
@@ -480,6 +670,16 @@ namespace Falltergeist
             return _frame;
         }
 
+        Random& Game::random()
+        {
+            return _random;
+        }
+
+        uint32_t Game::simulationTime() const
+        {
+            return static_cast<uint32_t>(static_cast<uint64_t>(_steps) * 1000 / FPS);
+        }
+
         void Game::setUIResourceManager(std::shared_ptr<UI::IResourceManager> uiResourceManager)
         {
             this->uiResourceManager = uiResourceManager;
@@ -503,7 +703,8 @@ namespace Falltergeist
                 x,
                 y,
                 _settings->fullscreen(),
-                _settings->alwaysOnTop()
+                _settings->alwaysOnTop(),
+                _settings->headless()
             );
         }
     }
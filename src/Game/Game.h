@@ -1,9 +1,11 @@
 #pragma once
 
+#include <fstream>
 #include <memory>
 #include <string>
 #include <vector>
 #include <SDL.h>
+#include "../Game/Random.h"
 #include "../Game/Time.h"
 #include "../Graphics/IRendererConfig.h"
 #include "../UI/IResourceManager.h"
@@ -28,6 +30,8 @@ namespace Falltergeist
     namespace Input
     {
         class Mouse;
+        class Recorder;
+        class Replayer;
     }
     namespace Lua
     {
@@ -41,6 +45,7 @@ namespace Falltergeist
     namespace UI
     {
         class FpsCounter;
+        class ProfilerGraph;
         class TextArea;
     }
 
@@ -76,7 +81,7 @@ namespace Falltergeist
                  */
                 void handle();
                 /**
-                 * @brief Process real-time logic.
+                 * @brief Process real-time logic. Called with a fixed time step from run().
                  */
                 void think(const float &deltaTime);
                 /**
@@ -102,8 +107,25 @@ namespace Falltergeist
 
                 unsigned int frame() const;
 
+                /**
+                 * Random number generator for all game logic. Seeded once at startup (or from an input log
+                 * being replayed), so a replayed session rolls exactly the same numbers.
+                 */
+                Random& random();
+
+                /**
+                 * Milliseconds of simulated time since start. Game logic must use it instead of SDL_GetTicks()
+                 * to stay independent of real time, which is what makes headless runs and input replays deterministic.
+                 */
+                uint32_t simulationTime() const;
+
                 void setUIResourceManager(std::shared_ptr<UI::IResourceManager> uiResourceManager);
             protected:
+                // simulation steps per second, also the frame rate cap
+                static const uint32_t FPS = 60;
+                // simulation steps allowed per rendered frame when catching up
+                static const uint32_t MAX_STEPS_PER_FRAME = 5;
+
                 std::vector<int> _GVARS;
                 std::vector<std::shared_ptr<State::State>> _states;
                 std::vector<std::shared_ptr<State::State>> _statesForDelete;
@@ -112,6 +134,10 @@ namespace Falltergeist
                 std::shared_ptr<Time> _gameTime;
 
                 unsigned int _frame = 0;
+                // number of fixed simulation steps done so far
+                uint32_t _steps = 0;
+
+                Random _random;
 
                 std::shared_ptr<Graphics::Renderer> _renderer;
                 std::shared_ptr<Audio::Mixer> _mixer;
@@ -119,8 +145,12 @@ namespace Falltergeist
                 std::shared_ptr<Settings> _settings;
                 std::unique_ptr<Graphics::AnimatedPalette> _animatedPalette;
                 std::unique_ptr<Event::Dispatcher> _eventDispatcher;
+                std::unique_ptr<Input::Recorder> _inputRecorder;
+                std::unique_ptr<Input::Replayer> _inputReplayer;
+                std::unique_ptr<std::ofstream> _frameTimingLog;
 
                 std::unique_ptr<UI::FpsCounter> _fpsCounter;
+                std::unique_ptr<UI::ProfilerGraph> _profilerGraph;
                 std::unique_ptr<UI::TextArea> _mousePosition, _currentTime, _falltergeistVersion;
 
                 std::shared_ptr<DudeObject> _player;
@@ -136,6 +166,11 @@ namespace Falltergeist
             private:
                 std::shared_ptr<UI::IResourceManager> uiResourceManager;
                 void _initGVARS();
+                void _runHeadless();
+                void _runReplay();
+                void _initInputLog();
+                void _dispatchEvent(Event::Event* event);
+                void _logFrameTiming(uint32_t steps, uint64_t handleStart, uint64_t thinkStart, uint64_t renderStart, uint64_t frameEnd);
                 std::unique_ptr<Event::Event> _createEventFromSDL(const SDL_Event& sdlEvent);
                 std::unique_ptr<Graphics::IRendererConfig> createRendererConfigFromSettings();
 
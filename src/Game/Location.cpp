@@ -17,7 +17,7 @@ namespace Falltergeist
 
     namespace Game
     {
-        Location::Location()
+        Location::Location() : _arena(std::make_unique<Base::Arena>(256 * 1024))
         {
         }
 
@@ -49,10 +49,10 @@ namespace Falltergeist
                 );
             }
 
-            GameObjectHelper gameObjectHelper;
+            GameObjectHelper gameObjectHelper(_arena.get());
 
             for (auto &mapElevation : mapFile->elevations()) {
-                auto elevation = std::make_unique<LocationElevation>();
+                auto elevation = std::make_unique<LocationElevation>(_arena.get());
 
                 // load objects
                 for (auto &mapObject : mapElevation.objects()) {
@@ -75,12 +75,12 @@ namespace Falltergeist
 
                     unsigned int tileNum = mapElevation.floorTiles().at(i);
                     if (tileNum > 1) {
-                        elevation->floor()->tiles()[i] = std::make_unique<UI::Tile>(tileNum, Point(x, y));
+                        elevation->floor()->addTile(i, tileNum, Point(x, y));
                     }
 
                     tileNum = mapElevation.roofTiles().at(i);
                     if (tileNum > 1) {
-                        elevation->roof()->tiles()[i] = std::make_unique<UI::Tile>(tileNum, Point(x, y - 96));
+                        elevation->roof()->addTile(i, tileNum, Point(x, y - 96));
                     }
                 }
 
@@ -294,6 +294,16 @@ namespace Falltergeist
             return &_elevations;
         }
 
+        /**
+         * @brief Returns arena which holds tiles and game objects loaded with this location
+         * It is released with the location, objects placed in it must not outlive the location
+         * @return Arena
+         */
+        Base::Arena* Location::arena() const
+        {
+            return _arena.get();
+        }
+
         std::shared_ptr<VM::Script> Location::script() const
         {
             return _script;
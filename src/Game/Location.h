@@ -4,6 +4,7 @@
 #include <map>
 #include <string>
 #include <vector>
+#include "../Base/Arena.h"
 
 namespace Falltergeist
 {
@@ -72,6 +73,8 @@ namespace Falltergeist
 
                 std::vector<std::unique_ptr<LocationElevation>>* elevations();
 
+                Base::Arena* arena() const;
+
                 std::shared_ptr<VM::Script> script() const;
 
             protected:
@@ -149,6 +152,12 @@ namespace Falltergeist
                  */
                 std::vector<int32_t> _MVARS;
 
+                /**
+                 * @brief Memory for tiles and game objects of this location
+                 * Declared before elevations and the script so it is released after them
+                 */
+                std::unique_ptr<Base::Arena> _arena;
+
                 /**
                  * @brief Map elevations
                  */
@@ -5,10 +5,10 @@ namespace Falltergeist
 {
     namespace Game
     {
-        LocationElevation::LocationElevation()
+        LocationElevation::LocationElevation(Base::Arena* arena)
         {
-            _roof = std::make_shared<UI::TileMap>();
-            _floor = std::make_shared<UI::TileMap>();
+            _roof = std::make_shared<UI::TileMap>(arena);
+            _floor = std::make_shared<UI::TileMap>(arena);
         }
 
         LocationElevation::~LocationElevation()
@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <vector>
+#include "../Base/Arena.h"
 
 namespace Falltergeist
 {
@@ -22,7 +23,8 @@ namespace Falltergeist
         class LocationElevation final
         {
             public:
-                LocationElevation();
+                // Tiles are placed in the given arena, see Game::Location::arena()
+                explicit LocationElevation(Base::Arena* arena = nullptr);
                 ~LocationElevation();
 
                 bool canRestHere() const;
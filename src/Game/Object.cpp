@@ -14,6 +14,8 @@
 #include "../Game/Game.h"
 #include "../Game/Helper/EggHelper.h"
 #include "../Game/Object.h"
+#include "../Game/ObjectRegistry.h"
+#include "../Game/Prototype.h"
 #include "../Graphics/ObjectUIFactory.h"
 #include "../PathFinding/HexagonGrid.h"
 #include "../LocationCamera.h"
@@ -33,6 +35,12 @@ namespace Falltergeist
     {
         Object::Object() : Event::EventTarget(Game::getInstance()->eventDispatcher())
         {
+            _handle = ObjectRegistry::getInstance()->add(this);
+        }
+
+        ObjectHandle Object::handle() const
+        {
+            return _handle;
         }
 
         Object::Type Object::type() const
@@ -101,14 +109,28 @@ namespace Falltergeist
             _generateUi();
         }
 
-        std::string Object::name() const
+        const std::shared_ptr<const Prototype>& Object::prototype() const
+        {
+            return _prototype;
+        }
+
+        void Object::setPrototype(const std::shared_ptr<const Prototype>& prototype)
         {
+            _prototype = prototype;
+        }
+
+        const std::string& Object::name() const
+        {
+            if (_prototype && !_hasOwnName) {
+                return _prototype->name();
+            }
             return _name;
         }
 
         void Object::setName(const std::string &value)
         {
             _name = value;
+            _hasOwnName = true;
         }
 
         std::string Object::scrName() const
@@ -121,14 +143,18 @@ namespace Falltergeist
             _scrName = value;
         }
 
-        std::string Object::description() const
+        const std::string& Object::description() const
         {
+            if (_prototype && !_hasOwnDescription) {
+                return _prototype->description();
+            }
             return _description;
         }
 
         void Object::setDescription(const std::string &value)
         {
             _description = value;
+            _hasOwnDescription = true;
         }
 
         VM::Script *Object::script() const
@@ -232,7 +258,7 @@ namespace Falltergeist
             if (!message) {
                 return;
             }
-            if (SDL_GetTicks() - message->timestampCreated() >= 7000) {
+            if (Game::getInstance()->simulationTime() - message->timestampCreated() >= 7000) {
                 setFloatMessage(nullptr);
             } else {
                 message->setPosition(_ui->position() + Point(
@@ -299,10 +325,10 @@ namespace Falltergeist
             Logger::info("SCRIPT") << "description_p_proc() - 0x" << std::hex << PID() << " " << name() << " "
                                    << (script() ? script()->filename() : "") << std::endl;
             bool useDefault = true;
-            if (script() && script()->hasFunction("description_p_proc")) {
+            if (script() && script()->hasFunction(STANDARD_PROCEDURE::DESCRIPTION)) {
                 script()
                         ->setSourceObject(Game::getInstance()->player())
-                        ->call("description_p_proc");
+                        ->call(STANDARD_PROCEDURE::DESCRIPTION);
                 if (script()->overrides()) {
                     useDefault = false;
                 }
@@ -318,29 +344,29 @@ namespace Falltergeist
 
         void Object::use_p_proc(const std::shared_ptr<CritterObject> &usedBy)
         {
-            if (script() && script()->hasFunction("use_p_proc")) {
+            if (script() && script()->hasFunction(STANDARD_PROCEDURE::USE)) {
                 script()
                         ->setSourceObject(usedBy)
-                        ->call("use_p_proc");
+                        ->call(STANDARD_PROCEDURE::USE);
             }
         }
 
         void Object::destroy_p_proc()
         {
-            if (script() && script()->hasFunction("destroy_p_proc")) {
+            if (script() && script()->hasFunction(STANDARD_PROCEDURE::DESTROY)) {
                 script()
                         ->setSourceObject(Game::getInstance()->player())
-                        ->call("destroy_p_proc");
+                        ->call(STANDARD_PROCEDURE::DESTROY);
             }
         }
 
         void Object::look_at_p_proc()
         {
             bool useDefault = true;
-            if (script() && script()->hasFunction("look_at_p_proc")) {
+            if (script() && script()->hasFunction(STANDARD_PROCEDURE::LOOK_AT)) {
                 script()
                         ->setSourceObject(Game::getInstance()->player())
-                        ->call("look_at_p_proc");
+                        ->call(STANDARD_PROCEDURE::LOOK_AT);
                 if (script()->overrides()) {
                     useDefault = false;
                 }
@@ -356,53 +382,53 @@ namespace Falltergeist
         void Object::map_enter_p_proc()
         {
             if (script()) {
-                script()->call("map_enter_p_proc");
+                script()->call(STANDARD_PROCEDURE::MAP_ENTER);
             }
         }
 
         void Object::map_exit_p_proc()
         {
             if (script()) {
-                script()->call("map_exit_p_proc");
+                script()->call(STANDARD_PROCEDURE::MAP_EXIT);
             }
         }
 
         void Object::map_update_p_proc()
         {
             if (script()) {
-                script()->call("map_update_p_proc");
+                script()->call(STANDARD_PROCEDURE::MAP_UPDATE);
             }
         }
 
         void Object::pickup_p_proc(const std::shared_ptr<CritterObject> &pickedUpBy)
         {
-            if (script() && script()->hasFunction("pickup_p_proc")) {
+            if (script() && script()->hasFunction(STANDARD_PROCEDURE::PICKUP)) {
                 script()
                         ->setSourceObject(pickedUpBy)
-                        ->call("pickup_p_proc");
+                        ->call(STANDARD_PROCEDURE::PICKUP);
             }
             // @TODO: standard handler
         }
 
         void Object::use_obj_on_p_proc(const std::shared_ptr<Object> &objectUsed, const std::shared_ptr<CritterObject> &usedBy)
         {
-            if (script() && script()->hasFunction("use_obj_on_p_proc")) {
+            if (script() && script()->hasFunction(STANDARD_PROCEDURE::USE_OBJ_ON)) {
                 script()
                         ->setSourceObject(usedBy)
                         ->setTargetObject(objectUsed)
-                        ->call("use_obj_on_p_proc");
+                        ->call(STANDARD_PROCEDURE::USE_OBJ_ON);
             }
             // @TODO: standard handlers for drugs, etc.
         }
 
         void Object::use_skill_on_p_proc(SKILL skill, const std::shared_ptr<Object> &objectUsed, const std::shared_ptr<CritterObject> &usedBy)
         {
-            if (script() && script()->hasFunction("use_skill_on_p_proc")) {
+            if (script() && script()->hasFunction(STANDARD_PROCEDURE::USE_SKILL_ON)) {
                 script()
                         ->setSourceObject(usedBy)
                         ->setTargetObject(objectUsed)
                         ->setUsedSkill(skill)
-                        ->call("use_skill_on_p_proc");
+                        ->call(STANDARD_PROCEDURE::USE_SKILL_ON);
             }
             // @TODO: standard handlers
         }
@@ -561,6 +587,7 @@ namespace Falltergeist
         // need out-of-line declaration for std::unique_ptr to be happy with other forward declarations
         Falltergeist::Game::Object::~Object()
         {
+            ObjectRegistry::getInstance()->remove(_handle);
         }
 
     }
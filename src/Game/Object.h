@@ -4,6 +4,7 @@
 #include <string>
 #include "../Event/EventTarget.h"
 #include "../Format/Enums.h"
+#include "../Game/ObjectHandle.h"
 #include "../Game/Orientation.h"
 #include "../Graphics/TransFlags.h"
 #include "../UI/Base.h"
@@ -36,8 +37,9 @@ namespace Falltergeist
     namespace Game
     {
         class CritterObject;
+        class Prototype;
 
-        class Object : public Event::EventTarget
+        class Object : public Event::EventTarget, public std::enable_shared_from_this<Object>
         {
             public:
                 // Object type as defined in prototype
@@ -55,6 +57,11 @@ namespace Falltergeist
 
                 Object();
                 virtual ~Object();
+                Object(const Object&) = delete;
+                Object& operator=(const Object&) = delete;
+
+                // handle for references which must not own the object, see ObjectRegistry
+                ObjectHandle handle() const;
 
                 // whether this object is transparent in terms of walking through it by a critter
                 virtual bool canWalkThru() const;
@@ -95,12 +102,16 @@ namespace Falltergeist
                 // changes object facing direction (0 - 5)
                 virtual void setOrientation(Orientation value);
 
-                // object name, as defined in proto msg file
-                std::string name() const;
+                // immutable data shared by all objects with the same PID, nullptr for objects not created from a PRO file
+                const std::shared_ptr<const Prototype>& prototype() const;
+                virtual void setPrototype(const std::shared_ptr<const Prototype>& prototype);
+
+                // object name, as defined in proto msg file unless changed for this object
+                const std::string& name() const;
                 void setName(const std::string& value);
 
-                // object description, as defined in proto msg file
-                std::string description() const;
+                // object description, as defined in proto msg file unless changed for this object
+                const std::string& description() const;
                 void setDescription(const std::string& value);
 
                 // object name from scrname.msg
@@ -219,9 +230,14 @@ namespace Falltergeist
                 int _elevation = 0;
                 Orientation _orientation;
                 int _position = -1;
+                ObjectHandle _handle;
+                std::shared_ptr<const Prototype> _prototype;
+                // own name and description, used instead of the prototype ones once set
                 std::string _name;
                 std::string _scrName;
                 std::string _description;
+                bool _hasOwnName = false;
+                bool _hasOwnDescription = false;
                 std::unique_ptr<VM::Script> _script;
                 std::unique_ptr<UI::Base> _ui;
                 virtual void _generateUi();
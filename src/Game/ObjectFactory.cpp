@@ -14,6 +14,7 @@
 #include "../Game/KeyItemObject.h"
 #include "../Game/LadderSceneryObject.h"
 #include "../Game/MiscItemObject.h"
+#include "../Game/Prototype.h"
 #include "../Game/StairsSceneryObject.h"
 #include "../Game/WallObject.h"
 #include "../Game/WeaponItemObject.h"
@@ -31,7 +32,7 @@ namespace Falltergeist
             return &factory;
         }
 
-        std::shared_ptr<Object> ObjectFactory::createObject(unsigned int PID)
+        std::shared_ptr<Object> ObjectFactory::createObject(unsigned int PID, Base::Arena* arena)
         {
             auto proto = ResourceManager::getInstance()->proFileType(PID);
             std::shared_ptr<Object> object;
@@ -43,12 +44,12 @@ namespace Falltergeist
                     {
                         case ITEM_TYPE::AMMO:
                         {
-                            object = std::make_shared<AmmoItemObject>();
+                            object = _make<AmmoItemObject>(arena);
                             break;
                         }
                         case ITEM_TYPE::ARMOR:
                         {
-                            std::shared_ptr<ArmorItemObject> armorObject = std::make_shared<ArmorItemObject>();
+                            std::shared_ptr<ArmorItemObject> armorObject = _make<ArmorItemObject>(arena);
                             object = armorObject;
                             for (unsigned i = (unsigned)DAMAGE::NORMAL; i != (unsigned)DAMAGE::POISON; ++i)
                             {
@@ -63,27 +64,27 @@ namespace Falltergeist
                         }
                         case ITEM_TYPE::CONTAINER:
                         {
-                            object = std::make_shared<ContainerItemObject>();
+                            object = _make<ContainerItemObject>(arena);
                             break;
                         }
                         case ITEM_TYPE::DRUG:
                         {
-                            object = std::make_shared<DrugItemObject>();
+                            object = _make<DrugItemObject>(arena);
                             break;
                         }
                         case ITEM_TYPE::KEY:
                         {
-                            object = std::make_shared<KeyItemObject>();
+                            object = _make<KeyItemObject>(arena);
                             break;
                         }
                         case ITEM_TYPE::MISC:
                         {
-                            object = std::make_shared<MiscItemObject>();
+                            object = _make<MiscItemObject>(arena);
                             break;
                         }
                         case ITEM_TYPE::WEAPON:
                         {
-                            std::shared_ptr<WeaponItemObject> weaponObject = std::make_shared<WeaponItemObject>();
+                            std::shared_ptr<WeaponItemObject> weaponObject = _make<WeaponItemObject>(arena);
                             object = weaponObject;
 
                             weaponObject->setPerk(proto->perk());
@@ -108,36 +109,12 @@ namespace Falltergeist
                     // @TODO: ((GameItemObject*)object)->setVolume(proto->containerSize());
                     itemObject->setInventoryFID(proto->inventoryFID());
                     itemObject->setPrice(proto->basePrice());
-                    auto msg = ResourceManager::getInstance()->msgFileType("text/english/game/pro_item.msg");
-                    try
-                    {
-                        object->setName(msg->message(proto->messageId())->text());
-                        object->setDescription(msg->message(proto->messageId() + 1)->text());
-                    }
-                    catch (const Exception&) {}
                     break;
                 }
                 case OBJECT_TYPE::CRITTER:
                 {
-                    std::shared_ptr<CritterObject> critterObject = std::make_shared<CritterObject>();
+                    std::shared_ptr<CritterObject> critterObject = _make<CritterObject>(arena);
                     object = critterObject;
-                    auto msg = ResourceManager::getInstance()->msgFileType("text/english/game/pro_crit.msg");
-                    try
-                    {
-                        object->setName(msg->message(proto->messageId())->text());
-                        object->setDescription(msg->message(proto->messageId() + 1)->text());
-                    }
-                    catch (const Exception&) {}
-
-                    for (unsigned i = (unsigned)STAT::STRENGTH; i <= (unsigned)STAT::LUCK; i++)
-                    {
-                        critterObject->setStat((STAT)i, proto->critterStats()->at(i));
-                        critterObject->setStatBonus((STAT)i, proto->critterStatsBonus()->at(i));
-                    }
-                    for (unsigned i = (unsigned)SKILL::SMALL_GUNS; i <= (unsigned)SKILL::OUTDOORSMAN; i++)
-                    {
-                        critterObject->setSkillTagged((SKILL)i, proto->critterSkills()->at(i));
-                    }
                     critterObject->setActionPoints(proto->critterActionPoints());
                     critterObject->setActionPointsMax(proto->critterActionPoints());
                     critterObject->setCritterFlags(proto->critterFlags());
@@ -148,11 +125,6 @@ namespace Falltergeist
                     critterObject->setSequence(proto->critterSequence());
                     critterObject->setCriticalChance(proto->critterCriticalChance());
                     critterObject->setHealingRate(proto->critterHealingRate());
-                    for (unsigned i = (unsigned)DAMAGE::NORMAL; i <= (unsigned)DAMAGE::POISON; i++)
-                    {
-                        critterObject->setDamageResist((DAMAGE)i, proto->damageResist()->at(i));
-                        critterObject->setDamageThreshold((DAMAGE)i, proto->damageThreshold()->at(i));
-                    }
                     critterObject->setGender(proto->critterGender() ? GENDER::FEMALE : GENDER::MALE);
                     critterObject->setAge(proto->critterAge());
                     break;
@@ -163,39 +135,31 @@ namespace Falltergeist
                     {
                         case SCENERY_TYPE::DOOR:
                         {
-                            object = std::make_shared<DoorSceneryObject>();
+                            object = _make<DoorSceneryObject>(arena);
                             break;
                         }
                         case SCENERY_TYPE::ELEVATOR:
                         {
-                            object = std::make_shared<ElevatorSceneryObject>();
+                            object = _make<ElevatorSceneryObject>(arena);
                             break;
                         }
                         case SCENERY_TYPE::GENERIC:
                         {
-                            object = std::make_shared<GenericSceneryObject>();
+                            object = _make<GenericSceneryObject>(arena);
                             break;
                         }
                         case SCENERY_TYPE::LADDER_TOP:
                         case SCENERY_TYPE::LADDER_BOTTOM:
                         {
-                            object = std::make_shared<LadderSceneryObject>();
+                            object = _make<LadderSceneryObject>(arena);
                             break;
                         }
                         case SCENERY_TYPE::STAIRS:
                         {
-                            object = std::make_shared<StairsSceneryObject>();
+                            object = _make<StairsSceneryObject>(arena);
                             break;
                         }
                     }
-                    auto msg = ResourceManager::getInstance()->msgFileType("text/english/game/pro_scen.msg");
-                    try
-                    {
-                        object->setName(msg->message(proto->messageId())->text());
-                        object->setDescription(msg->message(proto->messageId() + 1)->text());
-                    }
-                    catch (const Exception&) {}
-
                     std::dynamic_pointer_cast<SceneryObject>(object)->setSoundId((char)proto->soundId());
 
                     //first two bytes are orientation. second two - unknown
@@ -225,14 +189,7 @@ namespace Falltergeist
                 }
                 case OBJECT_TYPE::WALL:
                 {
-                    object = std::make_shared<WallObject>();
-                    auto msg = ResourceManager::getInstance()->msgFileType("text/english/game/pro_wall.msg");
-                    try
-                    {
-                        object->setName(msg->message(proto->messageId())->text());
-                        object->setDescription(msg->message(proto->messageId() + 1)->text());
-                    }
-                    catch (const Exception&) {}
+                    object = _make<WallObject>(arena);
 
                     //first two bytes are orientation. second two - unknown
                     unsigned short orientation = proto->flagsExt() >> 16;
@@ -276,24 +233,18 @@ namespace Falltergeist
                         case 21:
                         case 22:
                         case 23:
-                            object = std::make_shared<ExitMiscObject>();
+                            object = _make<ExitMiscObject>(arena);
                             break;
                         default:
-                            object = std::make_shared<MiscObject>();
+                            object = _make<MiscObject>(arena);
                             break;
                     }
-
-                    auto msg = ResourceManager::getInstance()->msgFileType("text/english/game/pro_misc.msg");
-                    try
-                    {
-                        object->setName(msg->message(proto->messageId())->text());
-                        object->setDescription(msg->message(proto->messageId() + 1)->text());
-                    }
-                    catch (const Exception&) {}
                     break;
                 }
             }
             object->setPID(PID);
+            // name, description and critter stats come from the shared prototype, see Prototype
+            object->setPrototype(_prototype(PID, proto));
             object->setFID(proto->FID());
             object->setFlags(proto->flags());
 
@@ -305,5 +256,48 @@ namespace Falltergeist
 
             return object;
         }
+
+        std::shared_ptr<const Prototype> ObjectFactory::_prototype(unsigned int PID, Format::Pro::File* proto)
+        {
+            auto it = _prototypes.find(PID);
+            if (it != _prototypes.end())
+            {
+                return it->second;
+            }
+
+            std::string msgFilename;
+            switch ((OBJECT_TYPE)proto->typeId())
+            {
+                case OBJECT_TYPE::ITEM:
+                    msgFilename = "text/english/game/pro_item.msg";
+                    break;
+                case OBJECT_TYPE::CRITTER:
+                    msgFilename = "text/english/game/pro_crit.msg";
+                    break;
+                case OBJECT_TYPE::SCENERY:
+                    msgFilename = "text/english/game/pro_scen.msg";
+                    break;
+                case OBJECT_TYPE::WALL:
+                    msgFilename = "text/english/game/pro_wall.msg";
+                    break;
+                default:
+                    msgFilename = "text/english/game/pro_misc.msg";
+                    break;
+            }
+
+            std::string name;
+            std::string description;
+            auto msg = ResourceManager::getInstance()->msgFileType(msgFilename);
+            try
+            {
+                name = msg->message(proto->messageId())->text();
+                description = msg->message(proto->messageId() + 1)->text();
+            }
+            catch (const Exception&) {}
+
+            auto prototype = std::make_shared<const Prototype>(PID, proto, name, description);
+            _prototypes.emplace(PID, prototype);
+            return prototype;
+        }
     }
 }
@@ -3,26 +3,58 @@
 // C++ standard includes
 
 #include <memory>
+#include <type_traits>
+#include <unordered_map>
 
 // Falltergeist includes
+#include "../Base/Arena.h"
+#include "../Game/ObjectRegistry.h"
 
 namespace Falltergeist
 {
+    namespace Format
+    {
+        namespace Pro
+        {
+            class File;
+        }
+    }
     namespace Game
     {
+        class ItemObject;
         class Object;
+        class Prototype;
 
         class ObjectFactory
         {
             public:
                 static ObjectFactory* getInstance();
-                std::shared_ptr<Object> createObject(unsigned int PID);
+                // Objects are placed in the given arena if there is one, see Game::Location::arena().
+                // Items never are: they can be picked up and carried to other locations.
+                std::shared_ptr<Object> createObject(unsigned int PID, Base::Arena* arena = nullptr);
 
             private:
                 ObjectFactory() = default;
                 ~ObjectFactory() = default;
                 ObjectFactory(ObjectFactory const&) = delete;
                 void operator=(ObjectFactory const&) = delete;
+
+                template <typename T>
+                static std::shared_ptr<T> _make(Base::Arena* arena)
+                {
+                    std::shared_ptr<T> object;
+                    if (arena && !std::is_base_of<ItemObject, T>::value) {
+                        object = std::allocate_shared<T>(Base::ArenaAllocator<T>(arena));
+                    } else {
+                        object = std::make_shared<T>();
+                    }
+                    ObjectRegistry::getInstance()->setOwner(object);
+                    return object;
+                }
+
+                // Built once per PID and shared by every object created from it
+                std::shared_ptr<const Prototype> _prototype(unsigned int PID, Format::Pro::File* proto);
+                std::unordered_map<unsigned int, std::shared_ptr<const Prototype>> _prototypes;
         };
     }
 }
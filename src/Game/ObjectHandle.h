@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Falltergeist
+{
+    namespace Game
+    {
+        /**
+         * @brief Reference to a game object through Game::ObjectRegistry
+         *
+         * 32 bits: index of registry slot and generation of that slot. Generation changes every time
+         * slot is reused, so handle of a deleted object never resolves to another one.
+         * Default constructed handle is null.
+         */
+        class ObjectHandle
+        {
+            public:
+                static const unsigned int INDEX_BITS = 20;
+                static const uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+                static const uint32_t GENERATION_MAX = (1u << (32 - INDEX_BITS)) - 1;
+
+                ObjectHandle() = default;
+
+                ObjectHandle(uint32_t index, uint32_t generation) : _value((generation << INDEX_BITS) | (index & INDEX_MASK))
+                {
+                }
+
+                uint32_t index() const
+                {
+                    return _value & INDEX_MASK;
+                }
+
+                uint32_t generation() const
+                {
+                    return _value >> INDEX_BITS;
+                }
+
+                uint32_t value() const
+                {
+                    return _value;
+                }
+
+                explicit operator bool() const
+                {
+                    return _value != 0;
+                }
+
+                bool operator== (ObjectHandle other) const
+                {
+                    return _value == other._value;
+                }
+
+                bool operator!= (ObjectHandle other) const
+                {
+                    return _value != other._value;
+                }
+
+            private:
+                uint32_t _value = 0;
+        };
+    }
+}
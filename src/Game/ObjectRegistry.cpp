@@ -0,0 +1,83 @@
+// C++ standard includes
+#include <memory>
+
+// Falltergeist includes
+#include "../Exception.h"
+#include "../Game/Object.h"
+#include "../Game/ObjectRegistry.h"
+
+namespace Falltergeist
+{
+    namespace Game
+    {
+        ObjectRegistry* ObjectRegistry::getInstance()
+        {
+            // never destroyed: objects held by other statics (like the Game instance) unregister during static destruction
+            static ObjectRegistry* registry = new ObjectRegistry();
+            return registry;
+        }
+
+        ObjectHandle ObjectRegistry::add(Object* object)
+        {
+            uint32_t index;
+            if (!_freeSlots.empty()) {
+                index = _freeSlots.back();
+                _freeSlots.pop_back();
+            } else {
+                if (_slots.size() > ObjectHandle::INDEX_MASK) {
+                    throw Exception("ObjectRegistry::add() - too many objects");
+                }
+                index = static_cast<uint32_t>(_slots.size());
+                _slots.emplace_back();
+            }
+            auto& slot = _slots[index];
+            slot.object = object;
+            ++_size;
+            return ObjectHandle(index, slot.generation);
+        }
+
+        void ObjectRegistry::remove(ObjectHandle handle)
+        {
+            if (!get(handle)) {
+                return;
+            }
+            auto& slot = _slots[handle.index()];
+            slot.object = nullptr;
+            slot.owner.reset();
+            // generation 0 is reserved, so null handle never matches a slot
+            slot.generation = slot.generation == ObjectHandle::GENERATION_MAX ? 1 : slot.generation + 1;
+            _freeSlots.push_back(handle.index());
+            --_size;
+        }
+
+        void ObjectRegistry::setOwner(const std::shared_ptr<Object>& object)
+        {
+            if (!object || get(object->handle()) != object.get()) {
+                return;
+            }
+            _slots[object->handle().index()].owner = object;
+        }
+
+        Object* ObjectRegistry::get(ObjectHandle handle) const
+        {
+            if (handle.index() >= _slots.size()) {
+                return nullptr;
+            }
+            const auto& slot = _slots[handle.index()];
+            return slot.generation == handle.generation() ? slot.object : nullptr;
+        }
+
+        std::shared_ptr<Object> ObjectRegistry::lock(ObjectHandle handle) const
+        {
+            if (!get(handle)) {
+                return nullptr;
+            }
+            return _slots[handle.index()].owner.lock();
+        }
+
+        size_t ObjectRegistry::size() const
+        {
+            return _size;
+        }
+    }
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+// C++ standard includes
+#include <memory>
+#include <vector>
+
+// Falltergeist includes
+#include "../Game/ObjectHandle.h"
+
+namespace Falltergeist
+{
+    namespace Game
+    {
+        class Object;
+
+        /**
+         * @brief Table of all living game objects, indexed by Game::ObjectHandle
+         *
+         * Objects add themselves on construction and remove on destruction, so holders of a handle
+         * never see a deleted object: it resolves to nullptr instead. Lookup is a single array access.
+         * Ownership stays with shared_ptr's of location and inventories; handles are for references which must not own.
+         */
+        class ObjectRegistry
+        {
+            public:
+                static ObjectRegistry* getInstance();
+
+                ObjectHandle add(Object* object);
+                void remove(ObjectHandle handle);
+                // Remembers shared pointer owning an object, for lock(). Called wherever objects are put into shared_ptr.
+                void setOwner(const std::shared_ptr<Object>& object);
+
+                // Returns object or nullptr if handle is null or object was deleted
+                Object* get(ObjectHandle handle) const;
+                // Same as get(), as shared pointer; nullptr if owner of the object wasn't set or is being destroyed
+                std::shared_ptr<Object> lock(ObjectHandle handle) const;
+
+                // Shares ownership of an object known by pointer, keeping its type
+                template <class T>
+                std::shared_ptr<T> lock(T* object) const
+                {
+                    return object ? std::static_pointer_cast<T>(lock(object->handle())) : nullptr;
+                }
+
+                size_t size() const;
+
+            private:
+                struct Slot
+                {
+                    Object* object = nullptr;
+                    std::weak_ptr<Object> owner;
+                    uint32_t generation = 1;
+                };
+
+                std::vector<Slot> _slots;
+                std::vector<uint32_t> _freeSlots;
+                size_t _size = 0;
+
+                ObjectRegistry() = default;
+                ~ObjectRegistry() = default;
+                ObjectRegistry(ObjectRegistry const&) = delete;
+                void operator=(ObjectRegistry const&) = delete;
+        };
+    }
+}
@@ -0,0 +1,60 @@
+#include "../Format/Enums.h"
+#include "../Format/Pro/File.h"
+#include "../Game/Prototype.h"
+
+namespace Falltergeist
+{
+    namespace Game
+    {
+        Prototype::Prototype(unsigned int PID, Format::Pro::File* proto, const std::string& name, const std::string& description)
+            : _PID(PID), _proto(proto), _name(name), _description(description)
+        {
+            if ((OBJECT_TYPE)proto->typeId() != OBJECT_TYPE::CRITTER)
+            {
+                return;
+            }
+
+            auto stats = std::make_shared<CritterStats>();
+            for (unsigned i = (unsigned)STAT::STRENGTH; i <= (unsigned)STAT::LUCK; i++)
+            {
+                stats->stats[i] = proto->critterStats()->at(i);
+                stats->statsBonus[i] = proto->critterStatsBonus()->at(i);
+            }
+            for (unsigned i = (unsigned)SKILL::SMALL_GUNS; i <= (unsigned)SKILL::OUTDOORSMAN; i++)
+            {
+                stats->skillsTagged[i] = proto->critterSkills()->at(i);
+            }
+            for (unsigned i = (unsigned)DAMAGE::NORMAL; i <= (unsigned)DAMAGE::POISON; i++)
+            {
+                stats->damageResist[i] = proto->damageResist()->at(i);
+                stats->damageThreshold[i] = proto->damageThreshold()->at(i);
+            }
+            _critterStats = std::move(stats);
+        }
+
+        unsigned int Prototype::PID() const
+        {
+            return _PID;
+        }
+
+        Format::Pro::File* Prototype::proto() const
+        {
+            return _proto;
+        }
+
+        const std::string& Prototype::name() const
+        {
+            return _name;
+        }
+
+        const std::string& Prototype::description() const
+        {
+            return _description;
+        }
+
+        const std::shared_ptr<const CritterStats>& Prototype::critterStats() const
+        {
+            return _critterStats;
+        }
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <string>
+
+namespace Falltergeist
+{
+    namespace Format
+    {
+        namespace Pro
+        {
+            class File;
+        }
+    }
+
+    namespace Game
+    {
+        // Base stats, tagged skills and damage protection of a critter, as defined in its PRO file
+        struct CritterStats
+        {
+            std::array<int, 7> stats{};
+            std::array<int, 7> statsBonus{};
+            std::array<int, 18> skillsTagged{};
+            std::array<int, 9> damageResist{};
+            std::array<int, 9> damageThreshold{};
+        };
+
+        /**
+         * Immutable data shared by all objects created from the same PRO file: name and description from the proto msg file
+         * and static critter stats. Created once per PID by ObjectFactory; objects refer to it and store only values changed on them.
+         */
+        class Prototype final
+        {
+            public:
+                Prototype(unsigned int PID, Format::Pro::File* proto, const std::string& name, const std::string& description);
+
+                unsigned int PID() const;
+                Format::Pro::File* proto() const;
+
+                const std::string& name() const;
+                const std::string& description() const;
+
+                // nullptr for prototypes other than critters
+                const std::shared_ptr<const CritterStats>& critterStats() const;
+
+            private:
+                unsigned int _PID;
+                Format::Pro::File* _proto;
+                std::string _name;
+                std::string _description;
+                std::shared_ptr<const CritterStats> _critterStats;
+        };
+    }
+}
@@ -0,0 +1,41 @@
+#include "../Game/Random.h"
+
+namespace Falltergeist
+{
+    namespace Game
+    {
+        Random::Random(uint32_t seed)
+        {
+            setSeed(seed);
+        }
+
+        void Random::setSeed(uint32_t seed)
+        {
+            _seed = seed;
+            _engine.seed(seed);
+        }
+
+        uint32_t Random::seed() const
+        {
+            return _seed;
+        }
+
+        uint32_t Random::next()
+        {
+            return static_cast<uint32_t>(_engine());
+        }
+
+        int Random::next(int min, int max)
+        {
+            if (max <= min) {
+                return min;
+            }
+            // std::uniform_int_distribution is not guaranteed to give the same sequence across standard libraries
+            uint32_t range = static_cast<uint32_t>(max) - static_cast<uint32_t>(min) + 1;
+            if (range == 0) {
+                return static_cast<int>(next());
+            }
+            return static_cast<int>(static_cast<uint32_t>(min) + next() % range);
+        }
+    }
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+
+namespace Falltergeist
+{
+    namespace Game
+    {
+        /**
+         * Seedable pseudo-random number generator for game logic.
+         * All gameplay randomness goes through it, so a recorded session replays exactly with the same seed.
+         */
+        class Random final
+        {
+            public:
+                explicit Random(uint32_t seed = 0);
+
+                void setSeed(uint32_t seed);
+                uint32_t seed() const;
+
+                uint32_t next();
+                /**
+                 * Returns random integer in range [min, max]
+                 */
+                int next(int min, int max);
+
+            private:
+                std::mt19937 _engine;
+                uint32_t _seed = 0;
+        };
+    }
+}
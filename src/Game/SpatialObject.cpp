@@ -13,10 +13,10 @@ namespace Falltergeist
 
         void SpatialObject::spatial_p_proc(const std::shared_ptr<Object> &source)
         {
-            if (_script && _script->hasFunction("spatial_p_proc")) {
+            if (_script && _script->hasFunction(STANDARD_PROCEDURE::SPATIAL)) {
                 _script
                     ->setSourceObject(source)
-                    ->call("spatial_p_proc")
+                    ->call(STANDARD_PROCEDURE::SPATIAL)
                 ;
             }
         }
@@ -25,11 +25,11 @@ namespace Falltergeist
             if (_timeTracked >= _interval) {
                 _timeTracked = _interval;
                 // Invoke directly without Event Dispatcher, for now.
-                Event::Event event("tick");
+                _tickEvent.setHandled(false);
                 if (!_repeat) {
                     _enabled = false;
                 }
-                _tickHandler.invoke(&event);
+                _tickHandler.invoke(&_tickEvent);
                 _timeTracked = 0;
             }
         }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../Event/Event.h"
 #include "../Event/Handler.h"
 
 namespace Falltergeist
@@ -27,6 +28,8 @@ namespace Falltergeist
 
             private:
                 Event::Handler _tickHandler;
+                // reused on every tick to avoid constructing an event each time
+                Event::Event _tickEvent = Event::Event("tick");
 
                 bool _enabled = false;
                 bool _repeat = false;
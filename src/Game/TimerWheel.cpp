@@ -0,0 +1,256 @@
+#include "../Game/TimerWheel.h"
+
+namespace Falltergeist
+{
+    namespace Game
+    {
+        const float TimerWheel::TICK_DURATION = 100.0f;
+
+        TimerWheel::TimerWheel()
+        {
+            clear();
+        }
+
+        void TimerWheel::setCallback(Callback callback)
+        {
+            _callback = std::move(callback);
+        }
+
+        TimerWheel::Handle TimerWheel::add(Object* object, uint32_t ticks, int fixedParam)
+        {
+            int32_t index;
+            if (!_freeNodes.empty()) {
+                index = _freeNodes.back();
+                _freeNodes.pop_back();
+            } else {
+                index = static_cast<int32_t>(_nodes.size());
+                _nodes.emplace_back();
+            }
+
+            Node& node = _nodes[index];
+            node.object = object;
+            node.fixedParam = fixedParam;
+            // _ticks is the next tick to run, so one tick delay expires right on it
+            node.expires = _ticks + (ticks > 0 ? ticks - 1 : 0);
+            node.objectPrev = NONE;
+
+            auto it = _objectTimers.find(object);
+            if (it != _objectTimers.end()) {
+                node.objectNext = it->second;
+                _nodes[it->second].objectPrev = index;
+                it->second = index;
+            } else {
+                node.objectNext = NONE;
+                _objectTimers.emplace(object, index);
+            }
+
+            _schedule(index);
+            _size++;
+
+            return Handle{static_cast<uint32_t>(index), node.generation};
+        }
+
+        void TimerWheel::remove(const Handle& handle)
+        {
+            if (handle.index >= _nodes.size()) {
+                return;
+            }
+            const Node& node = _nodes[handle.index];
+            if (node.generation != handle.generation || node.slot == NONE) {
+                return;
+            }
+            _unlinkSlot(static_cast<int32_t>(handle.index));
+            _release(static_cast<int32_t>(handle.index));
+        }
+
+        void TimerWheel::remove(Object* object)
+        {
+            auto it = _objectTimers.find(object);
+            if (it == _objectTimers.end()) {
+                return;
+            }
+            int32_t index = it->second;
+            while (index != NONE) {
+                int32_t next = _nodes[index].objectNext;
+                _unlinkSlot(index);
+                _release(index);
+                index = next;
+            }
+        }
+
+        void TimerWheel::remove(Object* object, int fixedParam)
+        {
+            auto it = _objectTimers.find(object);
+            if (it == _objectTimers.end()) {
+                return;
+            }
+            int32_t index = it->second;
+            while (index != NONE) {
+                int32_t next = _nodes[index].objectNext;
+                if (_nodes[index].fixedParam == fixedParam) {
+                    _unlinkSlot(index);
+                    _release(index);
+                }
+                index = next;
+            }
+        }
+
+        void TimerWheel::clear()
+        {
+            // keep nodes allocated, but invalidate all handles given out so far
+            _freeNodes.clear();
+            for (size_t i = _nodes.size(); i > 0; i--) {
+                uint32_t generation = _nodes[i - 1].generation;
+                _nodes[i - 1] = Node{};
+                _nodes[i - 1].generation = generation + 1;
+                _freeNodes.push_back(static_cast<int32_t>(i - 1));
+            }
+            _objectTimers.clear();
+            for (auto& slot : _slots) {
+                slot = NONE;
+            }
+            _size = 0;
+            _timeTracked = 0;
+        }
+
+        void TimerWheel::think(const float &deltaTime)
+        {
+            _timeTracked += deltaTime;
+            while (_timeTracked >= TICK_DURATION) {
+                _timeTracked -= TICK_DURATION;
+                tick();
+            }
+        }
+
+        void TimerWheel::tick()
+        {
+            uint32_t index = _ticks & (ROOT_SIZE - 1);
+            // when the root wheel wraps around, pull the next batch of timers down from upper levels
+            if (index == 0) {
+                for (uint32_t level = 0; level < LEVELS; level++) {
+                    if (_cascade(level) != 0) {
+                        break;
+                    }
+                }
+            }
+            _ticks++;
+
+            // move expired timers aside first: callbacks may schedule new ones into the very same slot
+            _slots[RUNNING] = _slots[index];
+            _slots[index] = NONE;
+            for (int32_t node = _slots[RUNNING]; node != NONE; node = _nodes[node].next) {
+                _nodes[node].slot = RUNNING;
+            }
+
+            // timers are detached one by one, so callbacks are free to add or cancel other timers
+            while (_slots[RUNNING] != NONE) {
+                int32_t node = _slots[RUNNING];
+                Object* object = _nodes[node].object;
+                int fixedParam = _nodes[node].fixedParam;
+                _unlinkSlot(node);
+                _release(node);
+                if (_callback) {
+                    _callback(object, fixedParam);
+                }
+            }
+        }
+
+        size_t TimerWheel::size() const
+        {
+            return _size;
+        }
+
+        uint32_t TimerWheel::ticks() const
+        {
+            return _ticks;
+        }
+
+        void TimerWheel::_schedule(int32_t index)
+        {
+            Node& node = _nodes[index];
+            uint32_t delta = node.expires - _ticks;
+            uint32_t slot;
+
+            if (static_cast<int32_t>(delta) < 0) {
+                // already expired, run on the next tick
+                slot = _ticks & (ROOT_SIZE - 1);
+            } else if (delta < ROOT_SIZE) {
+                slot = node.expires & (ROOT_SIZE - 1);
+            } else {
+                const uint32_t maxDelta = (1u << (ROOT_BITS + LEVEL_BITS * LEVELS)) - 1;
+                if (delta > maxDelta) {
+                    node.expires = _ticks + maxDelta;
+                    delta = maxDelta;
+                }
+                uint32_t level = 0;
+                while (delta >= (1u << (ROOT_BITS + LEVEL_BITS * (level + 1)))) {
+                    level++;
+                }
+                uint32_t shift = ROOT_BITS + LEVEL_BITS * level;
+                slot = ROOT_SIZE + LEVEL_SIZE * level + ((node.expires >> shift) & (LEVEL_SIZE - 1));
+            }
+
+            node.slot = static_cast<int32_t>(slot);
+            node.prev = NONE;
+            node.next = _slots[slot];
+            if (node.next != NONE) {
+                _nodes[node.next].prev = index;
+            }
+            _slots[slot] = index;
+        }
+
+        void TimerWheel::_unlinkSlot(int32_t index)
+        {
+            Node& node = _nodes[index];
+            if (node.prev != NONE) {
+                _nodes[node.prev].next = node.next;
+            } else {
+                _slots[node.slot] = node.next;
+            }
+            if (node.next != NONE) {
+                _nodes[node.next].prev = node.prev;
+            }
+            node.slot = NONE;
+            node.prev = NONE;
+            node.next = NONE;
+        }
+
+        void TimerWheel::_release(int32_t index)
+        {
+            Node& node = _nodes[index];
+            if (node.objectPrev != NONE) {
+                _nodes[node.objectPrev].objectNext = node.objectNext;
+            } else if (node.objectNext != NONE) {
+                _objectTimers[node.object] = node.objectNext;
+            } else {
+                _objectTimers.erase(node.object);
+            }
+            if (node.objectNext != NONE) {
+                _nodes[node.objectNext].objectPrev = node.objectPrev;
+            }
+
+            node.object = nullptr;
+            node.objectPrev = NONE;
+            node.objectNext = NONE;
+            node.generation++;
+            _freeNodes.push_back(index);
+            _size--;
+        }
+
+        uint32_t TimerWheel::_cascade(uint32_t level)
+        {
+            uint32_t shift = ROOT_BITS + LEVEL_BITS * level;
+            uint32_t index = (_ticks >> shift) & (LEVEL_SIZE - 1);
+            uint32_t slot = ROOT_SIZE + LEVEL_SIZE * level + index;
+
+            int32_t node = _slots[slot];
+            _slots[slot] = NONE;
+            while (node != NONE) {
+                int32_t next = _nodes[node].next;
+                _schedule(node);
+                node = next;
+            }
+            return index;
+        }
+    }
+}
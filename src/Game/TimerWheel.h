@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace Falltergeist
+{
+    namespace Game
+    {
+        class Object;
+
+        /**
+         * Hierarchical timing wheel for script timer events (add_timer_event and friends).
+         * Time is measured in game ticks (1/10 of a second). Insertion and cancellation by handle are O(1),
+         * advancing by one tick is amortized O(1) and nodes are recycled, so steady-state ticking never allocates.
+         */
+        class TimerWheel final
+        {
+            public:
+                struct Handle
+                {
+                    uint32_t index = UINT32_MAX;
+                    uint32_t generation = 0;
+                };
+
+                using Callback = std::function<void(Object* object, int fixedParam)>;
+
+                // Duration of one game tick in milliseconds
+                static const float TICK_DURATION;
+
+                TimerWheel();
+
+                void setCallback(Callback callback);
+
+                /**
+                 * Schedules callback for object to be called after given number of game ticks.
+                 * Timers with zero delay are fired on the next tick.
+                 */
+                Handle add(Object* object, uint32_t ticks, int fixedParam = 0);
+
+                // Cancels single timer. Stale handles are ignored.
+                void remove(const Handle& handle);
+                // Cancels all timers of given object
+                void remove(Object* object);
+                // Cancels all timers of given object with matching fixedParam
+                void remove(Object* object, int fixedParam);
+
+                void clear();
+
+                // Accumulates real time and runs all game ticks that passed
+                void think(const float &deltaTime);
+
+                // Runs exactly one game tick
+                void tick();
+
+                size_t size() const;
+                uint32_t ticks() const;
+
+            private:
+                static const uint32_t ROOT_BITS = 8;
+                static const uint32_t LEVEL_BITS = 6;
+                static const uint32_t ROOT_SIZE = 1 << ROOT_BITS;
+                static const uint32_t LEVEL_SIZE = 1 << LEVEL_BITS;
+                static const uint32_t LEVELS = 3;
+                static const uint32_t SLOTS = ROOT_SIZE + LEVEL_SIZE * LEVELS;
+                // extra slot holding timers which are being fired right now
+                static const uint32_t RUNNING = SLOTS;
+                static const int32_t NONE = -1;
+
+                struct Node
+                {
+                    Object* object = nullptr;
+                    int fixedParam = 0;
+                    uint32_t expires = 0;
+                    uint32_t generation = 0;
+                    int32_t slot = NONE;
+                    // slot list links
+                    int32_t prev = NONE;
+                    int32_t next = NONE;
+                    // per-object list links
+                    int32_t objectPrev = NONE;
+                    int32_t objectNext = NONE;
+                };
+
+                Callback _callback;
+
+                std::vector<Node> _nodes;
+                std::vector<int32_t> _freeNodes;
+                int32_t _slots[SLOTS + 1];
+                std::unordered_map<Object*, int32_t> _objectTimers;
+
+                // next tick to be processed
+                uint32_t _ticks = 0;
+                float _timeTracked = 0;
+                size_t _size = 0;
+
+                void _schedule(int32_t index);
+                void _unlinkSlot(int32_t index);
+                void _release(int32_t index);
+                uint32_t _cascade(uint32_t level);
+        };
+    }
+}
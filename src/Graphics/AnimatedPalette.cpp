@@ -1,9 +1,48 @@
+#include <algorithm>
+#include "../Format/Pal/Color.h"
+#include "../Format/Pal/File.h"
 #include "../Graphics/AnimatedPalette.h"
+#include "../Graphics/Texture.h"
+#include "../ResourceManager.h"
 
 namespace Falltergeist
 {
     namespace Graphics
     {
+        namespace
+        {
+            const uint8_t SLIME[4][3] = {
+                {0, 108, 0}, {11, 115, 7}, {27, 123, 15}, {43, 131, 27}
+            };
+            const uint8_t MONITORS[5][3] = {
+                {107, 107, 111}, {99, 103, 127}, {87, 107, 143}, {0, 147, 163}, {107, 187, 255}
+            };
+            const uint8_t FIRE_SLOW[5][3] = {
+                {255, 0, 0}, {215, 0, 0}, {147, 43, 11}, {255, 119, 0}, {255, 59, 0}
+            };
+            const uint8_t FIRE_FAST[5][3] = {
+                {71, 0, 0}, {123, 0, 0}, {179, 0, 0}, {123, 0, 0}, {71, 0, 0}
+            };
+            const uint8_t SHORE[6][3] = {
+                {83, 63, 43}, {75, 59, 43}, {67, 55, 39}, {63, 51, 39}, {55, 47, 35}, {51, 43, 35}
+            };
+
+            uint32_t rgba(const uint8_t* color)
+            {
+                return (color[0] << 24) | (color[1] << 16) | (color[2] << 8) | 0xFF;
+            }
+
+            // Fills count palette entries starting at first, shifted by counter
+            template <size_t N>
+            void cycle(std::array<uint32_t, 256>& colors, unsigned int first, const uint8_t (&table)[N][3], unsigned int counter)
+            {
+                for (unsigned int i = 0; i != N; ++i)
+                {
+                    colors[first + i] = rgba(table[(i + counter) % N]);
+                }
+            }
+        }
+
         AnimatedPalette::AnimatedPalette()
         {
         }
@@ -18,6 +57,7 @@ namespace Falltergeist
             if (_monitorsMillisecondsTracked >= 100.0f) {
                 _monitorsMillisecondsTracked -= 100.0f;
                 _monitorsCounter++;
+                _invalidate(233, 5);
                 if (_monitorsCounter >= 5) {
                     _monitorsCounter = 0;
                 }
@@ -27,6 +67,7 @@ namespace Falltergeist
             if (_slimeMillisecondsTracked >= 200.0f) {
                 _slimeMillisecondsTracked -= 200.0f;
                 _slimeCounter++;
+                _invalidate(229, 4);
                 if (_slimeCounter >= 4) {
                     _slimeCounter = 0;
                 }
@@ -36,6 +77,7 @@ namespace Falltergeist
             if (_shoreMillisecondsTracked >= 200.0f) {
                 _shoreMillisecondsTracked -= 200.0f;
                 _shoreCounter++;
+                _invalidate(248, 6);
                 if (_shoreCounter >= 6) {
                     _shoreCounter = 0;
                 }
@@ -45,6 +87,7 @@ namespace Falltergeist
             if (_fireSlowMillisecondsTracked >= 200.0f) {
                 _fireSlowMillisecondsTracked -= 200.0f;
                 _fireSlowCounter++;
+                _invalidate(238, 5);
                 if (_fireSlowCounter >= 5) {
                     _fireSlowCounter = 0;
                 }
@@ -54,6 +97,7 @@ namespace Falltergeist
             if (_fireFastMillisecondsTracked >= 142.0f) {
                 _fireFastMillisecondsTracked -= 142.0f;
                 _fireFastCounter++;
+                _invalidate(243, 5);
                 if (_fireFastCounter >= 5) {
                     _fireFastCounter = 0;
                 }
@@ -67,20 +111,55 @@ namespace Falltergeist
                 }
 
                 _blinkingRedCounter = _blinkingRed + _blinkingRedCounter;
+                _invalidate(254, 1);
             }
         }
 
-        std::vector<GLuint> AnimatedPalette::counters()
+        void AnimatedPalette::update()
+        {
+            if (!_texture)
+            {
+                auto pal = ResourceManager::getInstance()->palFileType("color.pal");
+                for (unsigned int i = 0; i != 256; ++i)
+                {
+                    _colors[i] = *pal->color(i);
+                }
+                _updateAnimatedColors();
+                _texture = std::make_unique<Texture>(256, 1);
+                _texture->loadFromRGBA(_colors.data());
+                _dirtyFirst = 256;
+                _dirtyLast = 0;
+            }
+
+            if (_dirtyFirst <= _dirtyLast)
+            {
+                _updateAnimatedColors();
+                _texture->loadFromRGBA(_colors.data() + _dirtyFirst, Point(_dirtyFirst, 0), Size(_dirtyLast - _dirtyFirst + 1, 1));
+                _dirtyFirst = 256;
+                _dirtyLast = 0;
+            }
+        }
+
+        Texture* AnimatedPalette::texture()
+        {
+            return _texture.get();
+        }
+
+        void AnimatedPalette::_invalidate(unsigned int first, unsigned int count)
+        {
+            _dirtyFirst = std::min(_dirtyFirst, first);
+            _dirtyLast = std::max(_dirtyLast, first + count - 1);
+        }
+
+        void AnimatedPalette::_updateAnimatedColors()
         {
-            std::vector<GLuint> cnt;
-            cnt.reserve(6);
-            cnt.push_back(_slimeCounter);
-            cnt.push_back(_monitorsCounter);
-            cnt.push_back(_fireSlowCounter);
-            cnt.push_back(_fireFastCounter);
-            cnt.push_back(_shoreCounter);
-            cnt.push_back(_blinkingRedCounter);
-            return cnt;
+            cycle(_colors, 229, SLIME, _slimeCounter);
+            cycle(_colors, 233, MONITORS, _monitorsCounter);
+            cycle(_colors, 238, FIRE_SLOW, _fireSlowCounter);
+            cycle(_colors, 243, FIRE_FAST, _fireFastCounter);
+            cycle(_colors, 248, SHORE, _shoreCounter);
+            // alarm
+            _colors[254] = (static_cast<uint32_t>(_blinkingRedCounter * 4) << 24) | 0xFF;
         }
     }
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <memory>
 #include <vector>
 #include <glm/glm.hpp>
 #include "../Format/Enums.h"
@@ -10,16 +11,32 @@ namespace Falltergeist
 {
     namespace Graphics
     {
+        class Texture;
+
+        // Game palette with color cycling (slime, monitors, fire, shore and alarm colors),
+        // kept in a 256x1 texture which shaders use to resolve indexed textures
         class AnimatedPalette
         {
             public:
+                // Indexes from this one up to 254 are cycled
+                static const uint8_t FIRST_ANIMATED_INDEX = 229;
+
                 AnimatedPalette();
                 ~AnimatedPalette();
 
-                std::vector<GLuint> counters();
                 void think(const float &deltaTime);
 
+                // Uploads cycled colors which have changed since last call, called once per frame before anything is drawn
+                void update();
+
+                Texture* texture();
+
             protected:
+                std::array<uint32_t, 256> _colors;
+                std::unique_ptr<Texture> _texture;
+                // range of palette indexes changed since last upload, empty if _dirtyFirst > _dirtyLast
+                unsigned int _dirtyFirst = 0;
+                unsigned int _dirtyLast = 255;
 
                 float _slimeMillisecondsTracked = 0;
                 unsigned int _slimeCounter = 0;
@@ -34,6 +51,9 @@ namespace Falltergeist
                 float _blinkingRedMillisecondsTracked = 0;
                 unsigned char _blinkingRedCounter = 0;
                 short _blinkingRed = -1;
+
+                void _updateAnimatedColors();
+                void _invalidate(unsigned int first, unsigned int count);
         };
     }
 }
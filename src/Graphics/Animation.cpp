@@ -1,4 +1,5 @@
 ﻿#include <SDL_image.h>
+#include "../Exception.h"
 #include "../Format/Frm/File.h"
 #include "../Game/Game.h"
 #include "../Graphics/AnimatedPalette.h"
@@ -12,31 +13,24 @@ namespace Falltergeist
     {
         Animation::Animation(const std::string &filename)
         {
-            // create buffers
-            // generate VAO
-            if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL32)
+            _region = ResourceManager::getInstance()->textureRegion(filename);
+            if (!_region)
             {
-                GL_CHECK(glGenVertexArrays(1, &_vao));
-                GL_CHECK(glBindVertexArray(_vao));
+                throw Exception("Animation::Animation() - can't load image: " + filename);
             }
-
-            // generate VBOs for verts and tex
-            GL_CHECK(glGenBuffers(1, &_coordsVBO));
-            GL_CHECK(glGenBuffers(1, &_texCoordsVBO));
-            GL_CHECK(glGenBuffers(1, &_ebo));
-
-            _texture = ResourceManager::getInstance()->texture(filename);
+            _texture = _region->texture;
 
             Format::Frm::File* frm = ResourceManager::getInstance()->frmFileType(filename);
 
             _stride = frm->framesPerDirection();
 
+            // frames are laid out relative to the image position on the (atlas) texture
             int offsetX = 1;
-            int offsetY = 1;
+            int offsetY = _region->position.y() + 1;
 
             for (auto& direction : frm->directions())
             {
-                offsetX = 1;
+                offsetX = _region->position.x() + 1;
                 for (unsigned int f = 0; f != frm->framesPerDirection(); ++f)
                 {
                     auto& srcFrame = direction.frames().at(f);
@@ -70,6 +64,24 @@ namespace Falltergeist
 
             }
 
+            if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::NONE)
+            {
+                return;
+            }
+
+            // create buffers
+            // generate VAO
+            if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL32)
+            {
+                GL_CHECK(glGenVertexArrays(1, &_vao));
+                GL_CHECK(glBindVertexArray(_vao));
+            }
+
+            // generate VBOs for verts and tex
+            GL_CHECK(glGenBuffers(1, &_coordsVBO));
+            GL_CHECK(glGenBuffers(1, &_texCoordsVBO));
+            GL_CHECK(glGenBuffers(1, &_ebo));
+
             GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, _coordsVBO));
             GL_CHECK(glBufferData(GL_ARRAY_BUFFER, _vertices.size() * sizeof(glm::vec2), &_vertices[0], GL_STATIC_DRAW));
 
@@ -78,28 +90,17 @@ namespace Falltergeist
 
             _shader = ResourceManager::getInstance()->shader("animation");
 
-            _uniformTex = _shader->getUniform("tex");
-            if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL21)
-            {
-                _uniformTexSize = _shader->getUniform("texSize");
-            }
-            _uniformFade = _shader->getUniform("fade");
-            _uniformMVP = _shader->getUniform("MVP");
-            _uniformCnt = _shader->getUniform("cnt");
-            _uniformLight = _shader->getUniform("global_light");
-            _uniformTrans = _shader->getUniform("trans");
-            _uniformOffset = _shader->getUniform("offset");
-            _uniformOutline = _shader->getUniform("outline");
-
-            _uniformTexStart = _shader->getUniform("texStart");
-            _uniformTexHeight = _shader->getUniform("texHeight");
-
             _attribPos = _shader->getAttrib("Position");
             _attribTex = _shader->getAttrib("TexCoord");
         }
 
         Animation::~Animation()
         {
+            if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::NONE)
+            {
+                return;
+            }
+
             GL_CHECK(glDeleteBuffers(1, &_coordsVBO));
             GL_CHECK(glDeleteBuffers(1, &_texCoordsVBO));
             GL_CHECK(glDeleteBuffers(1, &_ebo));
@@ -121,16 +122,12 @@ namespace Falltergeist
             GL_CHECK(_shader->use());
 
             GL_CHECK(_texture->bind(0));
+            GL_CHECK(Game::getInstance()->animatedPalette()->texture()->bind(1));
 
-            GL_CHECK(_shader->setUniform(_uniformTex, 0));
-
-            GL_CHECK(_shader->setUniform(_uniformOffset, glm::vec2((float)x, (float)y)));
+            GL_CHECK(_shader->setUniform(Shader::Uniform::TEX, 0));
+            GL_CHECK(_shader->setUniform(Shader::Uniform::PALETTE, 1));
 
-            GL_CHECK(_shader->setUniform(_uniformMVP, Game::getInstance()->renderer()->getMVP()));
-
-            GL_CHECK(_shader->setUniform(_uniformFade, Game::getInstance()->renderer()->fadeColor()));
-
-            GL_CHECK(_shader->setUniform(_uniformCnt, Game::getInstance()->animatedPalette()->counters()));
+            GL_CHECK(_shader->setUniform(Shader::Uniform::OFFSET, glm::vec2((float)x, (float)y)));
 
             int lightLevel = 100;
             if (light)
@@ -141,19 +138,18 @@ namespace Falltergeist
                     lightLevel = lightValue / ((65536-655)/100);
                 }
             }
-            GL_CHECK(_shader->setUniform(_uniformLight, lightLevel));
+            GL_CHECK(_shader->setUniform(Shader::Uniform::GLOBAL_LIGHT, lightLevel));
 
-            GL_CHECK(_shader->setUniform(_uniformTrans, _trans));
-            GL_CHECK(_shader->setUniform(_uniformOutline, outline));
+            GL_CHECK(_shader->setUniform(Shader::Uniform::TRANS, _trans));
+            GL_CHECK(_shader->setUniform(Shader::Uniform::OUTLINE, outline));
 
-            GL_CHECK(_shader->setUniform(_uniformTexStart, texStart));
-            GL_CHECK(_shader->setUniform(_uniformTexHeight, texHeight));
+            GL_CHECK(_shader->setUniform(Shader::Uniform::TEX_START, texStart));
+            GL_CHECK(_shader->setUniform(Shader::Uniform::TEX_HEIGHT, texHeight));
             if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL21)
             {
-                GL_CHECK(_shader->setUniform(_uniformTexSize, glm::vec2((float)_texture->textureWidth(), (float)_texture->textureHeight() ) ));
+                GL_CHECK(_shader->setUniform(Shader::Uniform::TEX_SIZE, glm::vec2((float)_texture->textureWidth(), (float)_texture->textureHeight() ) ));
             }
 
-
             if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL32)
             {
                 GLint curvao;
@@ -167,7 +163,6 @@ namespace Falltergeist
             GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, _coordsVBO));
             GL_CHECK(glVertexAttribPointer(_attribPos, 2, GL_FLOAT, GL_FALSE, 0, (void*)0 ));
 
-
             GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, _texCoordsVBO));
             GL_CHECK(glVertexAttribPointer(_attribTex, 2, GL_FLOAT, GL_FALSE, 0, (void*)0 ));
 
@@ -175,7 +170,6 @@ namespace Falltergeist
 
             GLushort indexes[6] = {(GLushort) (pos * 4), (GLushort) (pos * 4 + 1), (GLushort) (pos * 4 + 2), (GLushort) (pos * 4 + 3), (GLushort) (pos * 4 + 2), (GLushort) (pos * 4 + 1)};
 
-
             GL_CHECK(glBufferData(GL_ELEMENT_ARRAY_BUFFER, 6*sizeof(GLushort), indexes, GL_STATIC_DRAW));
 
             GL_CHECK(glEnableVertexAttribArray(_attribPos));
@@ -190,7 +184,7 @@ namespace Falltergeist
 
         bool Animation::opaque(unsigned int x, unsigned int y)
         {
-            return _texture->opaque(x, y);
+            return _region->opaque(x, y);
         }
 
         void Animation::trans(Graphics::TransFlags::Trans trans)
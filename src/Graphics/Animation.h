@@ -4,6 +4,7 @@
 #include "../Graphics/Renderer.h"
 #include "../Graphics/Shader.h"
 #include "../Graphics/Texture.h"
+#include "../Graphics/TextureAtlas.h"
 #include "../Graphics/TransFlags.h"
 
 namespace Falltergeist
@@ -25,6 +26,7 @@ namespace Falltergeist
                 GLuint _coordsVBO;
                 GLuint _texCoordsVBO;
                 GLuint _ebo;
+                const TextureRegion* _region;
                 Texture* _texture;
                 int _stride;
                 Graphics::TransFlags::Trans _trans = Graphics::TransFlags::Trans::NONE;
@@ -32,18 +34,6 @@ namespace Falltergeist
                 std::vector<glm::vec2> _vertices;
                 std::vector<glm::vec2> _texCoords;
 
-                GLint _uniformTex;
-                GLint _uniformTexSize;
-                GLint _uniformFade;
-                GLint _uniformMVP;
-                GLint _uniformCnt;
-                GLint _uniformLight;
-                GLint _uniformTrans;
-                GLint _uniformOffset;
-                GLint _uniformOutline;
-                GLint _uniformTexStart;
-                GLint _uniformTexHeight;
-
                 GLint _attribPos;
                 GLint _attribTex;
                 Graphics::Shader*_shader;
@@ -5,6 +5,7 @@
 #include <vector>
 #include "../Graphics/Point.h"
 #include "../Graphics/Texture.h"
+#include "../Graphics/TextureAtlas.h"
 
 namespace Falltergeist
 {
@@ -36,11 +37,17 @@ namespace Falltergeist
 
                 virtual Graphics::Texture *texture()
                 {
-                    return _texture.get();
+                    return _region ? _region->texture : nullptr;
+                }
+
+                // Glyph sheet area on the shared atlas texture
+                virtual const Graphics::TextureRegion* region()
+                {
+                    return _region;
                 }
 
             protected:
-                std::unique_ptr<Graphics::Texture> _texture = nullptr;
+                const Graphics::TextureRegion* _region = nullptr;
                 std::string _filename;
         };
     }
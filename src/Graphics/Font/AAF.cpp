@@ -16,8 +16,7 @@ namespace Falltergeist
             unsigned int width = (_aaf->maximumWidth()+2)*16u;
             unsigned int height = (_aaf->maximumHeight()+2)*16u;
 
-            _texture = std::make_unique<Graphics::Texture>(width, height);
-            _texture->loadFromRGBA(_aaf->rgba());
+            _region = ResourceManager::getInstance()->atlas()->add(filename, Size(width, height), _aaf->alpha());
         }
 
         unsigned short AAF::horizontalGap()
@@ -16,8 +16,7 @@ namespace Falltergeist
             unsigned int height = (_fon->maximumHeight()+2)*16u;
 
 
-            _texture = std::make_unique<Graphics::Texture>(width, height);
-            _texture->loadFromRGBA(_fon->rgba());
+            _region = ResourceManager::getInstance()->atlas()->add(filename, Size(width, height), _fon->alpha());
         }
 
         unsigned short FON::horizontalGap()
@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <vector>
+#include "../Game/Game.h"
+#include "../Graphics/GlyphBuffer.h"
+#include "../Graphics/Renderer.h"
+
+namespace Falltergeist
+{
+    namespace Graphics
+    {
+        GlyphBuffer::GlyphBuffer(size_t capacity)
+        {
+            // indexes are 16 bit
+            _capacity = std::min(capacity, (size_t)65536) / 4 * 4;
+
+            if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL32)
+            {
+                GL_CHECK(glGenVertexArrays(1, &_vao));
+                GL_CHECK(glBindVertexArray(_vao));
+            }
+
+            GL_CHECK(glGenBuffers(1, &_vbo));
+            GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, _vbo));
+            GL_CHECK(glBufferData(GL_ARRAY_BUFFER, _capacity * sizeof(GlyphVertex), NULL, GL_STREAM_DRAW));
+
+            // quads always use the same pattern, relative to the first vertex of the text
+            std::vector<GLushort> indexes;
+            indexes.reserve(_capacity / 4 * 6);
+            for (size_t quad = 0; quad != _capacity / 4; ++quad)
+            {
+                GLushort first = (GLushort)(quad * 4);
+                GLushort pattern[6] = {first, (GLushort)(first + 1), (GLushort)(first + 2), (GLushort)(first + 3), (GLushort)(first + 2), (GLushort)(first + 1)};
+                indexes.insert(indexes.end(), pattern, pattern + 6);
+            }
+            GL_CHECK(glGenBuffers(1, &_ebo));
+            GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo));
+            GL_CHECK(glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexes.size() * sizeof(GLushort), indexes.data(), GL_STATIC_DRAW));
+
+            GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, 0));
+        }
+
+        GlyphBuffer::~GlyphBuffer()
+        {
+            GL_CHECK(glDeleteBuffers(1, &_vbo));
+            GL_CHECK(glDeleteBuffers(1, &_ebo));
+            if (_vao)
+            {
+                GL_CHECK(glDeleteVertexArrays(1, &_vao));
+            }
+        }
+
+        size_t GlyphBuffer::push(const GlyphVertex* vertices, size_t count, Slot& slot)
+        {
+            if (slot.generation == _generation)
+            {
+                return slot.first;
+            }
+
+            count = std::min(count, _capacity);
+
+            GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, _vbo));
+            if (_used + count > _capacity)
+            {
+                // orphan: draws already issued keep reading the old storage
+                GL_CHECK(glBufferData(GL_ARRAY_BUFFER, _capacity * sizeof(GlyphVertex), NULL, GL_STREAM_DRAW));
+                _used = 0;
+                _generation++;
+            }
+            GL_CHECK(glBufferSubData(GL_ARRAY_BUFFER, _used * sizeof(GlyphVertex), count * sizeof(GlyphVertex), vertices));
+
+            slot.generation = _generation;
+            slot.first = _used;
+            _used += count;
+            return slot.first;
+        }
+
+        void GlyphBuffer::bind()
+        {
+            if (_vao)
+            {
+                GLint curvao;
+                glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &curvao);
+                if ((GLuint)curvao != _vao)
+                {
+                    GL_CHECK(glBindVertexArray(_vao));
+                }
+            }
+            GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, _vbo));
+            GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo));
+        }
+
+        size_t GlyphBuffer::capacity() const
+        {
+            return _capacity;
+        }
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <GL/glew.h>
+
+namespace Falltergeist
+{
+    namespace Graphics
+    {
+        struct GlyphVertex
+        {
+            glm::vec2 position;
+            glm::vec2 uv;
+        };
+
+        /**
+         * Single streaming vertex buffer shared by all text on screen, four vertices per glyph quad.
+         * Text is appended once and drawn from the same place every frame for as long as it stays unchanged.
+         * When the buffer is full it is orphaned and starts over, so everyone uploads their quads again.
+         */
+        class GlyphBuffer
+        {
+            public:
+                // Where a piece of text was put, and into which generation of the buffer
+                struct Slot
+                {
+                    uint32_t generation = 0;
+                    size_t first = 0;
+                };
+
+                explicit GlyphBuffer(size_t capacity = 65536);
+                ~GlyphBuffer();
+
+                /**
+                 * Returns the first vertex of given quads in the buffer.
+                 * Quads are uploaded only if slot is not valid for current generation of the buffer.
+                 */
+                size_t push(const GlyphVertex* vertices, size_t count, Slot& slot);
+
+                // Binds vertex array (GL 3.2), vertex buffer and quad index buffer
+                void bind();
+
+                // Maximum number of vertices drawn at once
+                size_t capacity() const;
+
+            private:
+                GLuint _vao = 0;
+                GLuint _vbo = 0;
+                GLuint _ebo = 0;
+                size_t _capacity;
+                size_t _used = 0;
+                uint32_t _generation = 1;
+        };
+    }
+}
@@ -16,6 +16,7 @@ namespace Falltergeist
                 virtual int32_t y() = 0;
                 virtual bool isFullscreen() = 0;
                 virtual bool isAlwaysOnTop() = 0;
+                virtual bool isHeadless() = 0;
         };
     }
 }
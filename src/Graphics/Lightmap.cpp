@@ -9,6 +9,11 @@ namespace Falltergeist
     {
         Lightmap::Lightmap(std::vector<glm::vec2> coords, std::vector<GLuint> indexes)
         {
+            if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::NONE)
+            {
+                return;
+            }
+
             if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL32)
             {
                 GL_CHECK(glGenVertexArrays(1, &_vao));
@@ -26,7 +31,6 @@ namespace Falltergeist
             //update coords
             GL_CHECK(glBufferData(GL_ARRAY_BUFFER, coords.size() * sizeof(glm::vec2), &coords[0], GL_STATIC_DRAW));
 
-
             GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, _lights));
 
             GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo));
@@ -34,19 +38,19 @@ namespace Falltergeist
             GL_CHECK(glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexes.size() * sizeof(GLuint), &indexes[0], GL_DYNAMIC_DRAW));
             _indexes = static_cast<unsigned>(indexes.size());
 
-
             _shader = ResourceManager::getInstance()->shader("lightmap");
 
-            _uniformFade = _shader->getUniform("fade");
-            _uniformMVP = _shader->getUniform("MVP");
-            _uniformOffset = _shader->getUniform("offset");
-
             _attribPos = _shader->getAttrib("Position");
             _attribLights = _shader->getAttrib("lights");
         }
 
         Lightmap::~Lightmap()
         {
+            if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::NONE)
+            {
+                return;
+            }
+
             GL_CHECK(glDeleteBuffers(1, &_coords));
             GL_CHECK(glDeleteBuffers(1, &_lights));
             GL_CHECK(glDeleteBuffers(1, &_ebo));
@@ -65,12 +69,8 @@ namespace Falltergeist
 
             GL_CHECK(_shader->use());
 
-            GL_CHECK(_shader->setUniform(_uniformMVP, Game::getInstance()->renderer()->getMVP()));
-
             // set camera offset
-            GL_CHECK(_shader->setUniform(_uniformOffset, glm::vec2((float)pos.x(), (float)pos.y()) ));
-
-            GL_CHECK(_shader->setUniform(_uniformFade, Game::getInstance()->renderer()->fadeColor()));
+            GL_CHECK(_shader->setUniform(Shader::Uniform::OFFSET, glm::vec2((float)pos.x(), (float)pos.y()) ));
 
             if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL32)
             {
@@ -82,18 +82,15 @@ namespace Falltergeist
                 }
             }
 
-
             GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, _coords));
             GL_CHECK(glVertexAttribPointer(_attribPos, 2, GL_FLOAT, GL_FALSE, 0, (void*)0 ));
 
-
             GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, _lights));
 
             GL_CHECK(glVertexAttribPointer(_attribLights, 1, GL_FLOAT, GL_FALSE, 0, (void*)0 ));
 
             GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo));
 
-
             GL_CHECK(glEnableVertexAttribArray(_attribPos));
 
             GL_CHECK(glEnableVertexAttribArray(_attribLights));
@@ -109,6 +106,11 @@ namespace Falltergeist
 
         void Lightmap::update(std::vector<float> lights)
         {
+            if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::NONE)
+            {
+                return;
+            }
+
             if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL32)
             {
                 GLint curvao;
@@ -22,10 +22,6 @@ namespace Falltergeist
                 GLuint _lights;
                 GLuint _ebo;
 
-                GLint _uniformFade;
-                GLint _uniformMVP;
-                GLint _uniformOffset;
-
                 GLint _attribPos;
                 GLint _attribLights;
                 unsigned int _indexes;
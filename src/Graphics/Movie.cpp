@@ -1,3 +1,4 @@
+#include <cstring>
 #include "../Game/Game.h"
 #include "../Graphics/Movie.h"
 #include "../Graphics/Renderer.h"
@@ -12,6 +13,9 @@ namespace Falltergeist
         {
             // 640x320
             _texture = new Graphics::Texture(640,320);
+            // a new frame is uploaded every tick
+            _texture->setStreaming(true);
+            _palette = new Graphics::Texture(256, 1);
         }
 
         Movie::~Movie()
@@ -20,6 +24,7 @@ namespace Falltergeist
             {
                 delete _texture;
             }
+            delete _palette;
         }
 
         unsigned int Movie::width() const
@@ -32,9 +37,22 @@ namespace Falltergeist
             return _texture->height();
         }
 
-        void Movie::loadFromSurface(SDL_Surface* surface)
+        void Movie::loadFrame(const uint8_t* indexes, unsigned int width, unsigned int height, const uint32_t* palette)
         {
-            _texture->loadFromSurface(surface);
+            if (width != _texture->width() || height != _texture->height())
+            {
+                delete _texture;
+                _texture = new Graphics::Texture(width, height);
+                _texture->setStreaming(true);
+            }
+            _texture->loadFromIndexes(indexes);
+
+            if (!_paletteLoaded || std::memcmp(_colors.data(), palette, sizeof(_colors)) != 0)
+            {
+                std::memcpy(_colors.data(), palette, sizeof(_colors));
+                _palette->loadFromRGBA(_colors.data());
+                _paletteLoaded = true;
+            }
         }
 
         void Movie::render(int x, int y)
@@ -67,15 +85,22 @@ namespace Falltergeist
 
             // TODO: different shader
 
-            GL_CHECK(ResourceManager::getInstance()->shader("sprite")->use());
+            auto shader = ResourceManager::getInstance()->shader("sprite");
 
-            GL_CHECK(_texture->bind(0));
+            GL_CHECK(shader->use());
 
-            GL_CHECK(ResourceManager::getInstance()->shader("sprite")->setUniform("tex",0));
+            GL_CHECK(_texture->bind(0));
+            GL_CHECK(_palette->bind(2));
 
-            GL_CHECK(ResourceManager::getInstance()->shader("sprite")->setUniform("fade",Game::getInstance()->renderer()->fadeColor()));
+            GL_CHECK(shader->setUniform(Shader::Uniform::TEX, 0));
+            GL_CHECK(shader->setUniform(Shader::Uniform::PALETTE, 2));
 
-            GL_CHECK(ResourceManager::getInstance()->shader("sprite")->setUniform("MVP", Game::getInstance()->renderer()->getMVP()));
+            // frame indexes are resolved with the movie palette, as is
+            GL_CHECK(shader->setUniform(Shader::Uniform::INDEXED, 1));
+            GL_CHECK(shader->setUniform(Shader::Uniform::GLOBAL_LIGHT, 100));
+            GL_CHECK(shader->setUniform(Shader::Uniform::TRANS, 0));
+            GL_CHECK(shader->setUniform(Shader::Uniform::OUTLINE, 0));
+            GL_CHECK(shader->setUniform(Shader::Uniform::DO_EGG, false));
 
             if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL32)
             {
@@ -93,26 +118,26 @@ namespace Falltergeist
 
             GL_CHECK(glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(glm::vec2), &vertices[0], GL_DYNAMIC_DRAW));
 
-            GL_CHECK(glVertexAttribPointer(ResourceManager::getInstance()->shader("sprite")->getAttrib("Position"), 2, GL_FLOAT, GL_FALSE, 0, (void*)0 ));
+            GL_CHECK(glVertexAttribPointer(shader->getAttrib("Position"), 2, GL_FLOAT, GL_FALSE, 0, (void*)0 ));
 
 
             GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, Game::getInstance()->renderer()->getTVBO()));
 
             GL_CHECK(glBufferData(GL_ARRAY_BUFFER, UV.size() * sizeof(glm::vec2), &UV[0], GL_DYNAMIC_DRAW));
 
-            GL_CHECK(glVertexAttribPointer(ResourceManager::getInstance()->shader("sprite")->getAttrib("TexCoord"), 2, GL_FLOAT, GL_FALSE, 0, (void*)0 ));
+            GL_CHECK(glVertexAttribPointer(shader->getAttrib("TexCoord"), 2, GL_FLOAT, GL_FALSE, 0, (void*)0 ));
 
             GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, Game::getInstance()->renderer()->getEBO()));
 
-            GL_CHECK(glEnableVertexAttribArray(ResourceManager::getInstance()->shader("sprite")->getAttrib("Position")));
+            GL_CHECK(glEnableVertexAttribArray(shader->getAttrib("Position")));
 
-            GL_CHECK(glEnableVertexAttribArray(ResourceManager::getInstance()->shader("sprite")->getAttrib("TexCoord")));
+            GL_CHECK(glEnableVertexAttribArray(shader->getAttrib("TexCoord")));
 
             GL_CHECK(glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, 0 ));
 
-            GL_CHECK(glDisableVertexAttribArray(ResourceManager::getInstance()->shader("sprite")->getAttrib("Position")));
+            GL_CHECK(glDisableVertexAttribArray(shader->getAttrib("Position")));
 
-            GL_CHECK(glDisableVertexAttribArray(ResourceManager::getInstance()->shader("sprite")->getAttrib("TexCoord")));
+            GL_CHECK(glDisableVertexAttribArray(shader->getAttrib("TexCoord")));
 
         //    GL_CHECK(glBindVertexArray(0));
         }
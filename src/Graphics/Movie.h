@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <string>
 #include "../Graphics/Texture.h"
 
@@ -7,6 +9,7 @@ namespace Falltergeist
 {
     namespace Graphics
     {
+        // Movie frame, kept as palette indexes with a palette texture of its own
         class Movie
         {
             public:
@@ -15,10 +18,14 @@ namespace Falltergeist
                 void render(int x, int y);
                 unsigned int width() const;
                 unsigned int height() const;
-                void loadFromSurface(SDL_Surface* surface);
+                // Uploads frame indexes, palette is uploaded only when it has changed
+                void loadFrame(const uint8_t* indexes, unsigned int width, unsigned int height, const uint32_t* palette);
 
             private:
                 Texture* _texture;
+                Texture* _palette;
+                std::array<uint32_t, 256> _colors;
+                bool _paletteLoaded = false;
         };
     }
 }
@@ -0,0 +1,170 @@
+#include <algorithm>
+#include <vector>
+#include "../Exception.h"
+#include "../Game/Game.h"
+#include "../Graphics/RenderTarget.h"
+#include "../Graphics/Renderer.h"
+#include "../Graphics/Shader.h"
+#include "../Graphics/Texture.h"
+#include "../ResourceManager.h"
+
+namespace Falltergeist
+{
+    namespace Graphics
+    {
+        RenderTarget::RenderTarget(const Size& size) : _size(size)
+        {
+            _texture = std::make_unique<Texture>(size.width(), size.height());
+            _texture->allocateRGBA();
+
+            if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::NONE)
+            {
+                return;
+            }
+
+            GL_CHECK(glGenFramebuffers(1, &_framebuffer));
+            GL_CHECK(glBindFramebuffer(GL_FRAMEBUFFER, _framebuffer));
+            GL_CHECK(glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, _texture->id(), 0));
+            GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+
+            // start with fully transparent contents
+            GL_CHECK(glClearColor(0.0f, 0.0f, 0.0f, 0.0f));
+            GL_CHECK(glClear(GL_COLOR_BUFFER_BIT));
+            GL_CHECK(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+
+            if (status != GL_FRAMEBUFFER_COMPLETE)
+            {
+                GL_CHECK(glDeleteFramebuffers(1, &_framebuffer));
+                _framebuffer = 0;
+                throw Exception("RenderTarget::RenderTarget() - framebuffer is incomplete: " + std::to_string(status));
+            }
+        }
+
+        RenderTarget::~RenderTarget()
+        {
+            if (_framebuffer)
+            {
+                GL_CHECK(glDeleteFramebuffers(1, &_framebuffer));
+            }
+        }
+
+        Size RenderTarget::size() const
+        {
+            return _size;
+        }
+
+        void RenderTarget::begin(const Point& position, const Size& size)
+        {
+            if (!_framebuffer)
+            {
+                return;
+            }
+
+            int left = std::max(position.x(), 0);
+            int top = std::max(position.y(), 0);
+            int right = std::min(position.x() + size.width(), _size.width());
+            int bottom = std::min(position.y() + size.height(), _size.height());
+
+            GL_CHECK(glBindFramebuffer(GL_FRAMEBUFFER, _framebuffer));
+            GL_CHECK(glViewport(0, 0, _size.width(), _size.height()));
+
+            // scissor box is counted from the bottom-left corner, screen coordinates from the top-left one
+            GL_CHECK(glEnable(GL_SCISSOR_TEST));
+            GL_CHECK(glScissor(left, _size.height() - std::max(bottom, top), std::max(right - left, 0), std::max(bottom - top, 0)));
+            GL_CHECK(glClear(GL_COLOR_BUFFER_BIT));
+
+            // colors are premultiplied, alpha accumulates the coverage
+            GL_CHECK(glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA));
+        }
+
+        void RenderTarget::end()
+        {
+            if (!_framebuffer)
+            {
+                return;
+            }
+
+            auto renderer = Game::getInstance()->renderer();
+            GL_CHECK(glDisable(GL_SCISSOR_TEST));
+            GL_CHECK(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+            GL_CHECK(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+            GL_CHECK(glViewport(0, 0, renderer->width(), renderer->height()));
+        }
+
+        void RenderTarget::render()
+        {
+            if (!_framebuffer)
+            {
+                return;
+            }
+
+            auto renderer = Game::getInstance()->renderer();
+
+            float width = static_cast<float>(_size.width());
+            float height = static_cast<float>(_size.height());
+            float u = width / static_cast<float>(_texture->textureWidth());
+            float v = height / static_cast<float>(_texture->textureHeight());
+
+            // texture rows go bottom to top
+            std::vector<glm::vec2> vertices = {
+                glm::vec2(0.0f, 0.0f),
+                glm::vec2(0.0f, height),
+                glm::vec2(width, 0.0f),
+                glm::vec2(width, height)
+            };
+            std::vector<glm::vec2> UV = {
+                glm::vec2(0.0f, v),
+                glm::vec2(0.0f, 0.0f),
+                glm::vec2(u, v),
+                glm::vec2(u, 0.0f)
+            };
+
+            auto shader = ResourceManager::getInstance()->shader("layer");
+
+            GL_CHECK(shader->use());
+
+            GL_CHECK(_texture->bind(0));
+
+            GL_CHECK(shader->setUniform(Shader::Uniform::TEX, 0));
+
+            if (renderer->renderPath() == Renderer::RenderPath::OGL32)
+            {
+                GLint curvao;
+                glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &curvao);
+                GLint vao = renderer->getVAO();
+                if (curvao != vao)
+                {
+                    GL_CHECK(glBindVertexArray(vao));
+                }
+            }
+
+            GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, renderer->getVVBO()));
+
+            GL_CHECK(glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(glm::vec2), &vertices[0], GL_DYNAMIC_DRAW));
+
+            GL_CHECK(glVertexAttribPointer(shader->getAttrib("Position"), 2, GL_FLOAT, GL_FALSE, 0, (void*)0 ));
+
+            GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, renderer->getTVBO()));
+
+            GL_CHECK(glBufferData(GL_ARRAY_BUFFER, UV.size() * sizeof(glm::vec2), &UV[0], GL_DYNAMIC_DRAW));
+
+            GL_CHECK(glVertexAttribPointer(shader->getAttrib("TexCoord"), 2, GL_FLOAT, GL_FALSE, 0, (void*)0 ));
+
+            GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, renderer->getEBO()));
+
+            GL_CHECK(glEnableVertexAttribArray(shader->getAttrib("Position")));
+
+            GL_CHECK(glEnableVertexAttribArray(shader->getAttrib("TexCoord")));
+
+            GL_CHECK(glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA));
+
+            GL_CHECK(glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, 0 ));
+
+            GL_CHECK(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+
+            GL_CHECK(glDisableVertexAttribArray(shader->getAttrib("Position")));
+
+            GL_CHECK(glDisableVertexAttribArray(shader->getAttrib("TexCoord")));
+        }
+    }
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <memory>
+#include <GL/glew.h>
+#include "../Graphics/Point.h"
+#include "../Graphics/Size.h"
+
+namespace Falltergeist
+{
+    namespace Graphics
+    {
+        class Texture;
+
+        /**
+         * Offscreen RGBA image of screen size. Everything drawn between begin() and end() goes into it instead of
+         * the screen, render() then puts the whole image on screen with a single quad.
+         * Colors are stored premultiplied by alpha, so partially transparent contents blend over the screen exactly
+         * as if they were drawn there directly.
+         */
+        class RenderTarget
+        {
+            public:
+                RenderTarget(const Size& size);
+                ~RenderTarget();
+
+                /**
+                 * Redirects drawing into this target. Only the given area (in screen coordinates) is cleared
+                 * and can be drawn into, the rest of the target keeps its contents.
+                 */
+                void begin(const Point& position, const Size& size);
+                void end();
+
+                void render();
+
+                Size size() const;
+
+            private:
+                Size _size;
+                std::unique_ptr<Texture> _texture;
+                GLuint _framebuffer = 0;
+        };
+    }
+}
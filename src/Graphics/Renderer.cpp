@@ -2,12 +2,14 @@
 #include <memory>
 #define GLM_FORCE_RADIANS
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
 #include <SDL_image.h>
 #include "../Base/Buffer.h"
 #include "../CrossPlatform.h"
 #include "../Event/State.h"
 #include "../Exception.h"
 #include "../Game/Game.h"
+#include "../Graphics/GlyphBuffer.h"
 #include "../Graphics/Point.h"
 #include "../Graphics/Renderer.h"
 #include "../Graphics/IRendererConfig.h"
@@ -27,8 +29,11 @@ namespace Falltergeist
         {
             _rendererConfig = std::move(rendererConfig);
 
+            // headless mode still needs the event queue, but not the video subsystem
+            uint32_t subsystem = _rendererConfig->isHeadless() ? SDL_INIT_EVENTS : SDL_INIT_VIDEO;
+
             std::string message = "Renderer initialization - ";
-            if (SDL_InitSubSystem(SDL_INIT_VIDEO) < 0)
+            if (SDL_InitSubSystem(subsystem) < 0)
             {
                 Logger::critical("VIDEO") << message + "[FAIL]" << std::endl;
                 throw Exception(SDL_GetError());
@@ -38,12 +43,18 @@ namespace Falltergeist
 
         Renderer::~Renderer()
         {
+            if (_renderpath == RenderPath::NONE)
+            {
+                return;
+            }
+
             GL_CHECK(glDeleteBuffers(1, &_coord_vbo));
             GL_CHECK(glDeleteBuffers(1, &_texcoord_vbo));
             GL_CHECK(glDeleteBuffers(1, &_ebo));
 
             if (_renderpath == RenderPath::OGL32)
             {
+                GL_CHECK(glDeleteBuffers(1, &_frameConstantsBuffer));
                 GL_CHECK(glDeleteVertexArrays(1, &_vao));
             }
         }
@@ -56,6 +67,21 @@ namespace Falltergeist
             // Game::getInstance()->engineSettings()->setFullscreen(true);
             // Game::getInstance()->engineSettings()->setScale(1); //or 2, if fullhd device
 
+            if (_rendererConfig->isHeadless()) {
+                _renderpath = RenderPath::NONE;
+                Logger::info("RENDERER") << "Render path: none (headless)" << std::endl;
+                _MVP = glm::ortho(
+                    0.0,
+                    static_cast<double>(_rendererConfig->width()),
+                    static_cast<double>(_rendererConfig->height()),
+                    0.0,
+                    -1.0,
+                    1.0
+                );
+                _egg = ResourceManager::getInstance()->texture("data/egg.png");
+                return;
+            }
+
             std::string message =  "SDL_CreateWindow " + std::to_string(_rendererConfig->width()) + "x" + std::to_string(_rendererConfig->height()) + "x" + std::to_string(32) + " - ";
 
             uint32_t flags = SDL_WINDOW_SHOWN | SDL_WINDOW_OPENGL;
@@ -182,6 +208,10 @@ namespace Falltergeist
             Logger::info("RENDERER") << message + "[OK]" << std::endl;
             Logger::info("RENDERER") << "Using GLEW " << glewGetString(GLEW_VERSION) << std::endl;
 
+            // core since 2.1, but the 2.1 path also runs on older drivers exposing only the extension
+            _pixelBufferObjects = (_renderpath == RenderPath::OGL32) || GLEW_ARB_pixel_buffer_object;
+            _framebufferObjects = (_renderpath == RenderPath::OGL32) || GLEW_ARB_framebuffer_object;
+
             Logger::info("RENDERER") << "Extensions: " << std::endl;
 
             if (_renderpath == RenderPath::OGL32) {
@@ -202,6 +232,7 @@ namespace Falltergeist
             ResourceManager::getInstance()->shader("animation");
             ResourceManager::getInstance()->shader("tilemap");
             ResourceManager::getInstance()->shader("lightmap");
+            ResourceManager::getInstance()->shader("layer");
             Logger::info("RENDERER") << "[OK]" << std::endl;
 
             Logger::info("RENDERER") << "Generating buffers" << std::endl;
@@ -221,6 +252,8 @@ namespace Falltergeist
             GLushort indexes[6] = { 0, 1, 2, 3, 2, 1 };
             GL_CHECK(glBufferData(GL_ELEMENT_ARRAY_BUFFER, 6*sizeof(GLushort), indexes, GL_STATIC_DRAW));
 
+            _glyphBuffer = std::make_unique<GlyphBuffer>();
+
             // generate projection matrix
             _MVP = glm::ortho(
                 0.0,
@@ -230,6 +263,18 @@ namespace Falltergeist
                 -1.0,
                 1.0
             );
+            _frameFade = fadeColor();
+
+            if (_renderpath == RenderPath::OGL32)
+            {
+                // std140 layout of FrameConstants block: mat4 MVP, vec4 fade
+                GL_CHECK(glGenBuffers(1, &_frameConstantsBuffer));
+                GL_CHECK(glBindBuffer(GL_UNIFORM_BUFFER, _frameConstantsBuffer));
+                GL_CHECK(glBufferData(GL_UNIFORM_BUFFER, sizeof(glm::mat4) + sizeof(glm::vec4), nullptr, GL_DYNAMIC_DRAW));
+                GL_CHECK(glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(glm::mat4), glm::value_ptr(_MVP)));
+                GL_CHECK(glBufferSubData(GL_UNIFORM_BUFFER, sizeof(glm::mat4), sizeof(glm::vec4), glm::value_ptr(_frameFade)));
+                GL_CHECK(glBindBufferBase(GL_UNIFORM_BUFFER, Shader::FRAME_CONSTANTS_BINDING, _frameConstantsBuffer));
+            }
 
             // load egg
             _egg = ResourceManager::getInstance()->texture("data/egg.png");
@@ -278,6 +323,7 @@ namespace Falltergeist
             _fadeDone = false;
             _fadeDelay = static_cast<unsigned>(round(time / 500));
             _fadeTimer = 0;
+            _updateFrameConstants();
         }
 
         void Renderer::fadeOut(uint8_t r, uint8_t g, uint8_t b, unsigned int time, bool inmovie)
@@ -289,18 +335,50 @@ namespace Falltergeist
             _fadeDone = false;
             _fadeDelay = static_cast<unsigned>(round(time / 500));
             _fadeTimer = 0;
+            _updateFrameConstants();
         }
 
 
         void Renderer::beginFrame()
         {
+            if (_renderpath == RenderPath::NONE) {
+                return;
+            }
             GL_CHECK(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
             GL_CHECK(glEnable(GL_BLEND));
             GL_CHECK(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+            _updateFrameConstants();
+        }
+
+        void Renderer::_updateFrameConstants()
+        {
+            if (_renderpath == RenderPath::NONE) {
+                return;
+            }
+            // MVP never changes after init(), so only fade color has to be compared
+            glm::vec4 fade = fadeColor();
+            if (fade == _frameFade) {
+                return;
+            }
+            _frameFade = fade;
+            _frameConstantsVersion++;
+
+            if (_renderpath == RenderPath::OGL32) {
+                GL_CHECK(glBindBuffer(GL_UNIFORM_BUFFER, _frameConstantsBuffer));
+                GL_CHECK(glBufferSubData(GL_UNIFORM_BUFFER, sizeof(glm::mat4), sizeof(glm::vec4), glm::value_ptr(_frameFade)));
+            }
+        }
+
+        uint32_t Renderer::frameConstantsVersion() const
+        {
+            return _frameConstantsVersion;
         }
 
         void Renderer::endFrame()
         {
+            if (_renderpath == RenderPath::NONE) {
+                return;
+            }
             GL_CHECK(glDisable(GL_BLEND));
             SDL_GL_SwapWindow(_sdlWindow);
         }
@@ -325,6 +403,10 @@ namespace Falltergeist
 
         void Renderer::screenshot()
         {
+            if (_renderpath == RenderPath::NONE) {
+                return;
+            }
+
             std::string filename;
             Uint32 rmask, gmask, bmask, amask;
             SDL_Surface* output;
@@ -391,7 +473,9 @@ namespace Falltergeist
 
         void Renderer::setCaption(const std::string& caption)
         {
-            SDL_SetWindowTitle(_sdlWindow, caption.c_str());
+            if (_sdlWindow) {
+                SDL_SetWindowTitle(_sdlWindow, caption.c_str());
+            }
         }
 
         SDL_Window* Renderer::sdlWindow()
@@ -434,8 +518,17 @@ namespace Falltergeist
             return _ebo;
         }
 
+        GlyphBuffer* Renderer::glyphBuffer()
+        {
+            return _glyphBuffer.get();
+        }
+
         void Renderer::drawRect(int x, int y, int w, int h, SDL_Color color)
         {
+            if (_renderpath == RenderPath::NONE) {
+                return;
+            }
+
             std::vector<glm::vec2> vertices;
 
             glm::vec4 fcolor = glm::vec4((float)color.r/255.0f, (float)color.g/255.0f, (float)color.b/255.0f, (float)color.a/255.0f);
@@ -446,11 +539,11 @@ namespace Falltergeist
             vertices.push_back(glm::vec2((float)x+(float)w, (float)y+(float)h));
 
 
-            GL_CHECK(ResourceManager::getInstance()->shader("default")->use());
+            auto shader = ResourceManager::getInstance()->shader("default");
 
-            GL_CHECK(ResourceManager::getInstance()->shader("default")->setUniform("color", fcolor));
+            GL_CHECK(shader->use());
 
-            GL_CHECK(ResourceManager::getInstance()->shader("default")->setUniform("MVP", getMVP()));
+            GL_CHECK(shader->setUniform(Shader::Uniform::COLOR, fcolor));
 
             if (_renderpath==RenderPath::OGL32)
             {
@@ -467,15 +560,15 @@ namespace Falltergeist
 
             GL_CHECK(glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(glm::vec2), &vertices[0], GL_DYNAMIC_DRAW));
 
-            GL_CHECK(glVertexAttribPointer(ResourceManager::getInstance()->shader("default")->getAttrib("Position"), 2, GL_FLOAT, GL_FALSE, 0, (void*)0 ));
+            GL_CHECK(glVertexAttribPointer(shader->getAttrib("Position"), 2, GL_FLOAT, GL_FALSE, 0, (void*)0 ));
 
             GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, Game::getInstance()->renderer()->getEBO()));
 
-            GL_CHECK(glEnableVertexAttribArray(ResourceManager::getInstance()->shader("default")->getAttrib("Position")));
+            GL_CHECK(glEnableVertexAttribArray(shader->getAttrib("Position")));
 
             GL_CHECK(glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, 0 ));
 
-            GL_CHECK(glDisableVertexAttribArray(ResourceManager::getInstance()->shader("default")->getAttrib("Position")));
+            GL_CHECK(glDisableVertexAttribArray(shader->getAttrib("Position")));
 
         }
 
@@ -484,6 +577,44 @@ namespace Falltergeist
             drawRect(pos.x(), pos.y(), size.width(), size.height(), color);
         }
 
+        void Renderer::drawTriangles(const std::vector<glm::vec2> &vertices, const std::vector<glm::vec4> &colors)
+        {
+            if (_renderpath == RenderPath::NONE || vertices.empty()) {
+                return;
+            }
+
+            auto shader = ResourceManager::getInstance()->shader("colored");
+
+            GL_CHECK(shader->use());
+
+            if (_renderpath==RenderPath::OGL32)
+            {
+                GLint curvao;
+                glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &curvao);
+                GLint vao = getVAO();
+                if (curvao != vao)
+                {
+                    GL_CHECK(glBindVertexArray(vao));
+                }
+            }
+
+            GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, getVVBO()));
+            GL_CHECK(glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(glm::vec2), &vertices[0], GL_DYNAMIC_DRAW));
+            GL_CHECK(glVertexAttribPointer(shader->getAttrib("Position"), 2, GL_FLOAT, GL_FALSE, 0, (void*)0 ));
+
+            GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, getTVBO()));
+            GL_CHECK(glBufferData(GL_ARRAY_BUFFER, colors.size() * sizeof(glm::vec4), &colors[0], GL_DYNAMIC_DRAW));
+            GL_CHECK(glVertexAttribPointer(shader->getAttrib("Color"), 4, GL_FLOAT, GL_FALSE, 0, (void*)0 ));
+
+            GL_CHECK(glEnableVertexAttribArray(shader->getAttrib("Position")));
+            GL_CHECK(glEnableVertexAttribArray(shader->getAttrib("Color")));
+
+            GL_CHECK(glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(vertices.size())));
+
+            GL_CHECK(glDisableVertexAttribArray(shader->getAttrib("Position")));
+            GL_CHECK(glDisableVertexAttribArray(shader->getAttrib("Color")));
+        }
+
         glm::vec4 Renderer::fadeColor()
         {
             return glm::vec4((float)_fadeColor.r/255.0, (float)_fadeColor.g/255.0, (float)_fadeColor.b/255.0, (float)_fadeColor.a/255.0);
@@ -504,5 +635,21 @@ namespace Falltergeist
         {
             return _renderpath;
         }
+
+        bool Renderer::npotTextures()
+        {
+            // GL 2.1 shaders rely on power of two sizes (see egg lookup in sprite shader)
+            return _renderpath == RenderPath::OGL32;
+        }
+
+        bool Renderer::pixelBufferObjects()
+        {
+            return _pixelBufferObjects;
+        }
+
+        bool Renderer::framebufferObjects()
+        {
+            return _framebufferObjects;
+        }
     }
 }
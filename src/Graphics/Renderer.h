@@ -14,6 +14,7 @@ namespace Falltergeist
 {
     namespace Graphics
     {
+        class GlyphBuffer;
         class Texture;
 
         #define GL_CHECK(x) do { \
@@ -33,7 +34,9 @@ namespace Falltergeist
                     OGL21 = 0,
                     OGL32,
                     GLES1,
-                    GLES2
+                    GLES2,
+                    // headless mode: no window, no GL context, nothing is drawn
+                    NONE
                 };
 
                 Renderer(std::unique_ptr<IRendererConfig> rendererConfig);
@@ -64,13 +67,20 @@ namespace Falltergeist
                 GLuint getVVBO();
                 GLuint getTVBO();
                 GLuint getEBO();
+                // Vertex buffer shared by all text
+                GlyphBuffer* glyphBuffer();
                 glm::mat4 getMVP();
 
                 void drawRect(int x, int y, int w, int h, SDL_Color color);
                 void drawRect(const Point &pos, const Size &size, SDL_Color color);
+                // Draws filled triangles with per-vertex colors in a single call, e.g. many rectangles at once
+                void drawTriangles(const std::vector<glm::vec2> &vertices, const std::vector<glm::vec4> &colors);
 
                 glm::vec4 fadeColor();
 
+                // Incremented whenever MVP or fade color changes, so shaders re-send them only when needed
+                uint32_t frameConstantsVersion() const;
+
                 void screenshot();
 
                 int32_t maxTextureSize();
@@ -79,6 +89,13 @@ namespace Falltergeist
 
                 RenderPath renderPath();
 
+                // Textures can be stored with their real size instead of the nearest power of two
+                bool npotTextures();
+                // Texture uploads can be streamed through pixel buffer objects
+                bool pixelBufferObjects();
+                // Drawing can be redirected into textures (see RenderTarget)
+                bool framebufferObjects();
+
             protected:
                 RenderPath _renderpath = RenderPath::OGL21;
 
@@ -94,7 +111,7 @@ namespace Falltergeist
                 float _scaleX = 1.0;
                 float _scaleY = 1.0;
 
-                SDL_Window* _sdlWindow;
+                SDL_Window* _sdlWindow = nullptr;
                 SDL_GLContext _glcontext;
                 GLuint _vao;
                 GLuint _ebo;
@@ -104,8 +121,18 @@ namespace Falltergeist
                 GLint _major;
                 GLint _minor;
                 int32_t _maxTexSize;
+                bool _pixelBufferObjects = false;
+                bool _framebufferObjects = false;
+
+                Texture* _egg = nullptr;
+                std::unique_ptr<GlyphBuffer> _glyphBuffer;
+
+                // MVP and fade color, shared by all programs through a uniform buffer on OpenGL 3.2
+                GLuint _frameConstantsBuffer = 0;
+                uint32_t _frameConstantsVersion = 1;
+                glm::vec4 _frameFade;
 
-                Texture* _egg;
+                void _updateFrameConstants();
 
             private:
                 std::unique_ptr<IRendererConfig> _rendererConfig;
@@ -10,7 +10,8 @@ namespace Falltergeist
             int32_t x,
             int32_t y,
             bool isFullscreen,
-            bool isAlwaysOnTop
+            bool isAlwaysOnTop,
+            bool isHeadless
         ) {
             _width = width;
             _height = height;
@@ -18,6 +19,7 @@ namespace Falltergeist
             _y = y;
             _isFullscreen = isFullscreen;
             _isAlwaysOnTop = isAlwaysOnTop;
+            _isHeadless = isHeadless;
         }
 
         uint32_t RendererConfig::width()
@@ -49,5 +51,10 @@ namespace Falltergeist
         {
             return _isAlwaysOnTop;
         }
+
+        bool RendererConfig::isHeadless()
+        {
+            return _isHeadless;
+        }
     }
 }
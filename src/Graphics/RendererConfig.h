@@ -15,7 +15,8 @@ namespace Falltergeist
                     int32_t x,
                     int32_t y,
                     bool isFullscreen,
-                    bool isAlwaysOnTop
+                    bool isAlwaysOnTop,
+                    bool isHeadless = false
                 );
 
                 uint32_t width() override;
@@ -24,6 +25,7 @@ namespace Falltergeist
                 int32_t y() override;
                 bool isFullscreen() override;
                 bool isAlwaysOnTop() override;
+                bool isHeadless() override;
 
             private:
                 uint32_t _width;
@@ -32,6 +34,7 @@ namespace Falltergeist
                 int32_t _y;
                 bool _isFullscreen;
                 bool _isAlwaysOnTop;
+                bool _isHeadless;
         };
     }
 }
@@ -12,8 +12,36 @@ namespace Falltergeist
 {
     namespace Graphics
     {
+        namespace
+        {
+            // GLSL names of Shader::Uniform values, in the same order
+            const char* const UNIFORM_NAMES[] = {
+                "tex",
+                "texSize",
+                "texStart",
+                "texHeight",
+                "eggTex",
+                "eggpos",
+                "doegg",
+                "palette",
+                "indexed",
+                "global_light",
+                "trans",
+                "outline",
+                "outlineColor",
+                "color",
+                "offset",
+                "MVP",
+                "fade"
+            };
+
+            static_assert(sizeof(UNIFORM_NAMES) / sizeof(UNIFORM_NAMES[0]) == static_cast<unsigned int>(Shader::Uniform::COUNT),
+                "UNIFORM_NAMES must list every Shader::Uniform");
+        }
+
         Shader::Shader(std::string fname)
         {
+            _uniformLocations.fill(-1);
             _load(fname);
         }
 
@@ -62,6 +90,11 @@ namespace Falltergeist
         {
             _progId = 0;
 
+            if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::NONE)
+            {
+                return false;
+            }
+
             std::string rpath = "21/";
             switch (Game::getInstance()->renderer()->renderPath())
             {
@@ -150,9 +183,43 @@ namespace Falltergeist
                     throw Exception("Failed to link shader");
                     return false;
                 }
+
+            _resolveUniforms();
             return true;
         }
 
+        void Shader::_resolveUniforms()
+        {
+            for (unsigned int i = 0; i != _uniformLocations.size(); ++i)
+            {
+                // uniforms missing in this program stay at -1, which GL silently ignores
+                _uniformLocations[i] = glGetUniformLocation(_progId, UNIFORM_NAMES[i]);
+            }
+
+            if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL32)
+            {
+                GLuint block = glGetUniformBlockIndex(_progId, "FrameConstants");
+                if (block != GL_INVALID_INDEX)
+                {
+                    glUniformBlockBinding(_progId, block, FRAME_CONSTANTS_BINDING);
+                }
+            }
+        }
+
+        void Shader::_updateFrameConstants()
+        {
+            // OpenGL 3.2 programs read MVP and fade from the shared uniform buffer,
+            // 2.1 programs get them as plain uniforms, re-sent only when they have changed since this program was last used
+            auto renderer = Game::getInstance()->renderer();
+            if (renderer->renderPath() != Renderer::RenderPath::OGL21 || _frameConstantsVersion == renderer->frameConstantsVersion())
+            {
+                return;
+            }
+            _frameConstantsVersion = renderer->frameConstantsVersion();
+            setUniform(Uniform::MVP, renderer->getMVP());
+            setUniform(Uniform::FADE, renderer->fadeColor());
+        }
+
         void Shader::use()
         {
             GLint cur;
@@ -161,6 +228,7 @@ namespace Falltergeist
             {
                 glUseProgram(_progId);
             }
+            _updateFrameConstants();
         }
 
         void Shader::unuse()
@@ -175,37 +243,49 @@ namespace Falltergeist
 
         GLint Shader::getUniform(const std::string &uniform) const
         {
-            if (!_uniforms.count(uniform))
+            if (!_progId)
             {
-                GLint loc = glGetUniformLocation(_progId, uniform.c_str());
-                if (loc == -1)
-                {
-                    Logger::warning("RENDERER") << "Attention: uniform '" << uniform << "' does not exist in " << _progId << std::endl;
-                }
-
-                _uniforms[uniform] = loc;
-                return loc;
+                return -1;
+            }
+            auto it = _uniforms.find(uniform);
+            if (it != _uniforms.end())
+            {
+                return it->second;
             }
-            else
+
+            GLint loc = glGetUniformLocation(_progId, uniform.c_str());
+            if (loc == -1)
             {
-                return _uniforms.at(uniform);
+                Logger::warning("RENDERER") << "Attention: uniform '" << uniform << "' does not exist in " << _progId << std::endl;
             }
+            _uniforms.emplace(uniform, loc);
+            return loc;
+        }
+
+        GLint Shader::getUniform(Uniform uniform) const
+        {
+            return _uniformLocations[static_cast<unsigned int>(uniform)];
         }
 
         GLint Shader::getAttrib(const std::string &attrib) const
         {
-            if (!_attribs.count(attrib))
+            if (!_progId)
             {
-                GLint loc = glGetAttribLocation(_progId, attrib.c_str());
-                if (loc == -1)
-                {
-                    Logger::warning("RENDERER") << "Attention: attrib '" << attrib << "' does not exist in " << _progId << std::endl;
-                }
+                return -1;
+            }
+            auto it = _attribs.find(attrib);
+            if (it != _attribs.end())
+            {
+                return it->second;
+            }
 
-                _attribs[attrib] = loc;
-                return loc;
+            GLint loc = glGetAttribLocation(_progId, attrib.c_str());
+            if (loc == -1)
+            {
+                Logger::warning("RENDERER") << "Attention: attrib '" << attrib << "' does not exist in " << _progId << std::endl;
             }
-            else return _attribs.at(attrib);
+            _attribs.emplace(attrib, loc);
+            return loc;
         }
 
         void Shader::setUniform(const std::string &uniform, int i)
@@ -243,7 +323,7 @@ namespace Falltergeist
             glUniform3fv(getUniform(uniform), 1, glm::value_ptr(vec));
         }
 
-        void Shader::setUniform(const std::string &uniform, std::vector<GLuint> vec)
+        void Shader::setUniform(const std::string &uniform, const std::vector<GLuint> &vec)
         {
             glUniform1iv(getUniform(uniform), static_cast<GLsizei>(vec.size()), (const int*)&vec[0]);
         }
@@ -293,7 +373,7 @@ namespace Falltergeist
             glUniform3fv((uniform), 1, glm::value_ptr(vec));
         }
 
-        void Shader::setUniform(const GLint &uniform, std::vector<GLuint> vec)
+        void Shader::setUniform(const GLint &uniform, const std::vector<GLuint> &vec)
         {
             glUniform1iv((uniform), static_cast<GLsizei>(vec.size()), (const int*)&vec[0]);
         }
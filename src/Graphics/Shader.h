@@ -1,7 +1,8 @@
 #pragma once
 
-#include <map>
+#include <array>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <glm/glm.hpp>
 #include <GL/glew.h>
@@ -14,6 +15,33 @@ namespace Falltergeist
         class Shader
         {
             public:
+                // Uniforms known to the engine. Their locations are resolved once when program is linked,
+                // so setting them never looks anything up by name.
+                enum class Uniform : unsigned int
+                {
+                    TEX = 0,
+                    TEX_SIZE,
+                    TEX_START,
+                    TEX_HEIGHT,
+                    EGG_TEX,
+                    EGG_POS,
+                    DO_EGG,
+                    PALETTE,
+                    INDEXED,
+                    GLOBAL_LIGHT,
+                    TRANS,
+                    OUTLINE,
+                    OUTLINE_COLOR,
+                    COLOR,
+                    OFFSET,
+                    // per-frame constants, kept in the FrameConstants uniform block on OpenGL 3.2
+                    MVP,
+                    FADE,
+                    COUNT
+                };
+
+                // Binding point of the FrameConstants uniform block
+                static const GLuint FRAME_CONSTANTS_BINDING = 0;
 
                 Shader(std::string fname);
 
@@ -39,7 +67,7 @@ namespace Falltergeist
                 void setUniform(const std::string &uniform, const glm::vec2 &vec);
 
                 void setUniform(const std::string &uniform, const glm::vec3 &vec);
-                void setUniform(const std::string &uniform, std::vector<GLuint> vec);
+                void setUniform(const std::string &uniform, const std::vector<GLuint> &vec);
 
                 void setUniform(const std::string &uniform, const glm::vec4 &vec);
 
@@ -58,16 +86,24 @@ namespace Falltergeist
                 void setUniform(const GLint &uniform, const glm::vec2 &vec);
 
                 void setUniform(const GLint &uniform, const glm::vec3 &vec);
-                void setUniform(const GLint &uniform, std::vector<GLuint> vec);
+                void setUniform(const GLint &uniform, const std::vector<GLuint> &vec);
 
                 void setUniform(const GLint &uniform, const glm::vec4 &vec);
 
                 void setUniform(const GLint &uniform, const glm::mat4 &mat);
 
+                template <typename... Args>
+                void setUniform(Uniform uniform, const Args&... args)
+                {
+                    setUniform(_uniformLocations[static_cast<unsigned int>(uniform)], args...);
+                }
+
                 GLint getAttrib(const std::string &attrib) const;
 
                 GLint getUniform(const std::string &uniform) const;
 
+                GLint getUniform(Uniform uniform) const;
+
             private:
                 GLuint _progId;
                 GLuint _loadShader(const char *, unsigned int);
@@ -75,8 +111,15 @@ namespace Falltergeist
                 std::vector<GLuint> _shaders;
 
                 bool _load(std::string fname);
-                mutable std::map<std::string, GLint> _uniforms;
-                mutable std::map<std::string, GLint> _attribs;
+                void _resolveUniforms();
+                void _updateFrameConstants();
+
+                std::array<GLint, static_cast<unsigned int>(Uniform::COUNT)> _uniformLocations;
+                // version of renderer frame constants last sent to this program (OpenGL 2.1 only)
+                uint32_t _frameConstantsVersion = 0;
+
+                mutable std::unordered_map<std::string, GLint> _uniforms;
+                mutable std::unordered_map<std::string, GLint> _attribs;
         };
     }
 }
@@ -1,3 +1,4 @@
+#include "../Exception.h"
 #include "../Game/DudeObject.h"
 #include "../Game/Game.h"
 #include "../Graphics/AnimatedPalette.h"
@@ -13,23 +14,13 @@ namespace Falltergeist
     {
         Sprite::Sprite(const std::string& fname)
         {
-            _texture = ResourceManager::getInstance()->texture(fname);
-            _shader = ResourceManager::getInstance()->shader("sprite");
-
-            _uniformTex = _shader->getUniform("tex");
-            if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL21)
+            _region = ResourceManager::getInstance()->textureRegion(fname);
+            if (!_region)
             {
-                _uniformTexSize = _shader->getUniform("texSize");
+                throw Exception("Sprite::Sprite() - can't load image: " + fname);
             }
-            _uniformEggTex = _shader->getUniform("eggTex");
-            _uniformFade = _shader->getUniform("fade");
-            _uniformMVP = _shader->getUniform("MVP");
-            _uniformCnt = _shader->getUniform("cnt");
-            _uniformLight = _shader->getUniform("global_light");
-            _uniformTrans = _shader->getUniform("trans");
-            _uniformDoEgg = _shader->getUniform("doegg");
-            _uniformEggPos = _shader->getUniform("eggpos");
-            _uniformOutline = _shader->getUniform("outline");
+            _texture = _region->texture;
+            _shader = ResourceManager::getInstance()->shader("sprite");
 
             _attribPos = _shader->getAttrib("Position");
             _attribTex = _shader->getAttrib("TexCoord");
@@ -41,17 +32,17 @@ namespace Falltergeist
 
         Size Sprite::size() const
         {
-            return _texture->size();
+            return _region->size;
         }
 
         unsigned int Sprite::width() const
         {
-            return _texture->width();
+            return _region->size.width();
         }
 
         unsigned int Sprite::height() const
         {
-            return _texture->height();
+            return _region->size.height();
         }
 
         // render, optionally scaled
@@ -63,11 +54,15 @@ namespace Falltergeist
                 glm::vec2((float)(x + width), (float)y),
                 glm::vec2((float)(x + width), (float)(y + height))
             };
+            float left = (float)_region->position.x() / (float)_texture->textureWidth();
+            float top = (float)_region->position.y() / (float)_texture->textureHeight();
+            float right = (float)(_region->position.x() + _region->size.width()) / (float)_texture->textureWidth();
+            float bottom = (float)(_region->position.y() + _region->size.height()) / (float)_texture->textureHeight();
             glm::vec2 UV[4] = {
-                glm::vec2(0.0, 0.0),
-                glm::vec2(0.0, (float)_texture->height() / (float)_texture->textureHeight()),
-                glm::vec2((float)_texture->width() / (float)_texture->textureWidth(), 0.0),
-                glm::vec2((float)_texture->width() / (float)_texture->textureWidth(), (float)_texture->height() / (float)_texture->textureHeight())
+                glm::vec2(left, top),
+                glm::vec2(left, bottom),
+                glm::vec2(right, top),
+                glm::vec2(right, bottom)
             };
 
             x--;
@@ -85,13 +80,14 @@ namespace Falltergeist
                     Point eggPos = dude->hexagon()->position() - camera->topLeft() + dude->eggOffset();
 
                     SDL_Rect egg_rect = {eggPos.x(), eggPos.y(), 129, 98};
-                    SDL_Rect tex_rect = {x, y, (int) _texture->width(), (int) _texture->height()};
+                    SDL_Rect tex_rect = {x, y, _region->size.width(), _region->size.height()};
 
                     if (!SDL_HasIntersection(&egg_rect, &tex_rect)) {
                         transparency = false;
                     }
                     else {
-                        eggVec = glm::vec2((float) (eggPos.x()-x), (float) (eggPos.y()-y));
+                        // shader compares it with texel coordinates of the whole texture
+                        eggVec = glm::vec2((float) (eggPos.x() - x + _region->position.x()), (float) (eggPos.y() - y + _region->position.y()));
                     }
                 }
             }
@@ -100,22 +96,18 @@ namespace Falltergeist
 
             GL_CHECK(_texture->bind(0));
             GL_CHECK(Game::getInstance()->renderer()->egg()->bind(1));
+            GL_CHECK(Game::getInstance()->animatedPalette()->texture()->bind(2));
 
-            GL_CHECK(_shader->setUniform(_uniformTex, 0));
-            GL_CHECK(_shader->setUniform(_uniformEggTex, 1));
-
-            GL_CHECK(_shader->setUniform(_uniformEggPos, eggVec));
+            GL_CHECK(_shader->setUniform(Shader::Uniform::TEX, 0));
+            GL_CHECK(_shader->setUniform(Shader::Uniform::EGG_TEX, 1));
+            GL_CHECK(_shader->setUniform(Shader::Uniform::PALETTE, 2));
+            GL_CHECK(_shader->setUniform(Shader::Uniform::INDEXED, _texture->indexed()));
 
-            GL_CHECK(_shader->setUniform(_uniformDoEgg, transparency));
+            GL_CHECK(_shader->setUniform(Shader::Uniform::EGG_POS, eggVec));
 
-            GL_CHECK(_shader->setUniform(_uniformOutline, outline));
+            GL_CHECK(_shader->setUniform(Shader::Uniform::DO_EGG, transparency));
 
-
-            GL_CHECK(_shader->setUniform(_uniformFade, Game::getInstance()->renderer()->fadeColor()));
-
-            GL_CHECK(_shader->setUniform(_uniformMVP, Game::getInstance()->renderer()->getMVP()));
-
-            GL_CHECK(_shader->setUniform(_uniformCnt, Game::getInstance()->animatedPalette()->counters()));
+            GL_CHECK(_shader->setUniform(Shader::Uniform::OUTLINE, outline));
 
             int lightLevel = 100;
             if (light)
@@ -126,12 +118,12 @@ namespace Falltergeist
                     lightLevel = lightValue / ((65536-655)/100);
                 }
             }
-            GL_CHECK(_shader->setUniform(_uniformLight, lightLevel));
-            GL_CHECK(_shader->setUniform(_uniformTrans, _trans));
+            GL_CHECK(_shader->setUniform(Shader::Uniform::GLOBAL_LIGHT, lightLevel));
+            GL_CHECK(_shader->setUniform(Shader::Uniform::TRANS, _trans));
 
             if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL21)
             {
-                GL_CHECK(_shader->setUniform(_uniformTexSize, glm::vec2((float)_texture->textureWidth(), (float)_texture->textureHeight() )));
+                GL_CHECK(_shader->setUniform(Shader::Uniform::TEX_SIZE, glm::vec2((float)_texture->textureWidth(), (float)_texture->textureHeight() )));
             }
 
             if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL32)
@@ -145,14 +137,12 @@ namespace Falltergeist
                 }
             }
 
-
             GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, Game::getInstance()->renderer()->getVVBO()));
 
             GL_CHECK(glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), &vertices[0], GL_DYNAMIC_DRAW));
 
             GL_CHECK(glVertexAttribPointer(_attribPos, 2, GL_FLOAT, GL_FALSE, 0, (void*)0 ));
 
-
             GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, Game::getInstance()->renderer()->getTVBO()));
 
             GL_CHECK(glBufferData(GL_ARRAY_BUFFER, sizeof(UV), &UV[0], GL_DYNAMIC_DRAW));
@@ -174,7 +164,7 @@ namespace Falltergeist
 
         void Sprite::render(int x, int y, bool transparency, bool light, int outline, unsigned int lightValue)
         {
-            renderScaled(x, y, _texture->width(), _texture->height(), transparency, light, outline, lightValue);
+            renderScaled(x, y, _region->size.width(), _region->size.height(), transparency, light, outline, lightValue);
         }
 
         // render just a part of texture, unscaled
@@ -187,6 +177,10 @@ namespace Falltergeist
                 glm::vec2((float)(x + width), (float)y),
                 glm::vec2((float)(x + width), (float)(y + height))
             };
+            // crop offset is relative to the image, which may be packed anywhere on the texture
+            dx += _region->position.x();
+            dy += _region->position.y();
+
             glm::vec2 UV[4] = {
                 glm::vec2((float)dx / (float)_texture->textureWidth(), (float)dy / (float)_texture->textureHeight()),
                 glm::vec2((float)dx / (float)_texture->textureWidth(), (float)(dy + height) / (float)_texture->textureHeight()),
@@ -205,7 +199,7 @@ namespace Falltergeist
                     Point eggPos = dude->hexagon()->position() - camera->topLeft() + dude->eggOffset();
 
                     SDL_Rect egg_rect = {eggPos.x(), eggPos.y(), 129, 98};
-                    SDL_Rect tex_rect = {x, y, (int) _texture->width(), (int) _texture->height()};
+                    SDL_Rect tex_rect = {x, y, _region->size.width(), _region->size.height()};
 
                     if (!SDL_HasIntersection(&egg_rect, &tex_rect))
                     {
@@ -213,7 +207,8 @@ namespace Falltergeist
                     }
                     else
                     {
-                        eggVec = glm::vec2((float) (eggPos.x() - x), (float) (eggPos.y() - y));
+                        // shader compares it with texel coordinates of the whole texture
+                        eggVec = glm::vec2((float) (eggPos.x() - x + dx), (float) (eggPos.y() - y + dy));
                     }
                 }
 
@@ -223,15 +218,12 @@ namespace Falltergeist
 
             GL_CHECK(_texture->bind(0));
             GL_CHECK(Game::getInstance()->renderer()->egg()->bind(1));
+            GL_CHECK(Game::getInstance()->animatedPalette()->texture()->bind(2));
 
-            GL_CHECK(_shader->setUniform(_uniformTex, 0));
-            GL_CHECK(_shader->setUniform(_uniformEggTex, 1));
-
-            GL_CHECK(_shader->setUniform(_uniformFade, Game::getInstance()->renderer()->fadeColor()));
-
-            GL_CHECK(_shader->setUniform(_uniformMVP, Game::getInstance()->renderer()->getMVP()));
-
-            GL_CHECK(_shader->setUniform(_uniformCnt, Game::getInstance()->animatedPalette()->counters()));
+            GL_CHECK(_shader->setUniform(Shader::Uniform::TEX, 0));
+            GL_CHECK(_shader->setUniform(Shader::Uniform::EGG_TEX, 1));
+            GL_CHECK(_shader->setUniform(Shader::Uniform::PALETTE, 2));
+            GL_CHECK(_shader->setUniform(Shader::Uniform::INDEXED, _texture->indexed()));
 
             int lightLevel = 100;
             if (light)
@@ -242,18 +234,18 @@ namespace Falltergeist
                     lightLevel = lightValue / ((65536-655)/100);
                 }
             }
-            GL_CHECK(_shader->setUniform(_uniformLight, lightLevel));
+            GL_CHECK(_shader->setUniform(Shader::Uniform::GLOBAL_LIGHT, lightLevel));
 
-            GL_CHECK(_shader->setUniform(_uniformTrans, _trans));
+            GL_CHECK(_shader->setUniform(Shader::Uniform::TRANS, _trans));
 
-            GL_CHECK(_shader->setUniform(_uniformEggPos, eggVec));
+            GL_CHECK(_shader->setUniform(Shader::Uniform::EGG_POS, eggVec));
 
-            GL_CHECK(_shader->setUniform(_uniformDoEgg, transparency));
+            GL_CHECK(_shader->setUniform(Shader::Uniform::DO_EGG, transparency));
 
-            GL_CHECK(_shader->setUniform(_uniformOutline, false));
+            GL_CHECK(_shader->setUniform(Shader::Uniform::OUTLINE, false));
 
             if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL21) {
-                GL_CHECK(_shader->setUniform(_uniformTexSize, glm::vec2((float)_texture->textureWidth(), (float)_texture->textureHeight() )));
+                GL_CHECK(_shader->setUniform(Shader::Uniform::TEX_SIZE, glm::vec2((float)_texture->textureWidth(), (float)_texture->textureHeight() )));
             }
 
             if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL32) {
@@ -292,7 +284,12 @@ namespace Falltergeist
 
         bool Sprite::opaque(unsigned int x, unsigned int y)
         {
-            return _texture->opaque(x+1, y+1);
+            return _region->opaque(x+1, y+1);
+        }
+
+        bool Sprite::animatedColors() const
+        {
+            return _region->animatedColors;
         }
 
         void Sprite::trans(Graphics::TransFlags::Trans trans)
@@ -5,6 +5,7 @@
 #include "../Graphics/Point.h"
 #include "../Graphics/Shader.h"
 #include "../Graphics/Texture.h"
+#include "../Graphics/TextureAtlas.h"
 #include "../Graphics/TransFlags.h"
 
 namespace Falltergeist
@@ -26,22 +27,13 @@ namespace Falltergeist
                 unsigned int height() const;
                 bool opaque(unsigned int x, unsigned int y);
                 void trans(Graphics::TransFlags::Trans _trans);
+                // true if image colors are cycled by the animated palette
+                bool animatedColors() const;
 
             private:
-                GLint _uniformTex;
-                GLint _uniformTexSize;
-                GLint _uniformEggTex;
-                GLint _uniformFade;
-                GLint _uniformMVP;
-                GLint _uniformCnt;
-                GLint _uniformLight;
-                GLint _uniformTrans;
-                GLint _uniformDoEgg;
-                GLint _uniformEggPos;
-                GLint _uniformOutline;
-
                 GLint _attribPos;
                 GLint _attribTex;
+                const TextureRegion* _region;
                 Texture* _texture;
                 Graphics::TransFlags::Trans _trans = Graphics::TransFlags::Trans::NONE;
                 Graphics::Shader*_shader;
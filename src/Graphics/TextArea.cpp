@@ -12,51 +12,34 @@ namespace Falltergeist
     {
         TextArea::TextArea()
         {
-            if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL32)
+            if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::NONE)
             {
-                GL_CHECK(glGenVertexArrays(1, &_vao));
-                GL_CHECK(glBindVertexArray(_vao));
+                return;
             }
 
-            // generate VBOs for verts and tex
-            GL_CHECK(glGenBuffers(1, &_coords));
-            GL_CHECK(glGenBuffers(1, &_texCoords));
-            GL_CHECK(glGenBuffers(1, &_ebo));
-            GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo));
-        //    GL_CHECK(glBindVertexArray(0));
-
             _shader = ResourceManager::getInstance()->shader("font");
 
-            _uniformTex = _shader->getUniform("tex");
-            if (Game::getInstance()->renderer()->renderPath() == Graphics::Renderer::RenderPath::OGL21)
-            {
-                _uniformTexSize = _shader->getUniform("texSize");
-            }
-            _uniformFade = _shader->getUniform("fade");
-            _uniformMVP = _shader->getUniform("MVP");
-            _uniformOffset = _shader->getUniform("offset");
-            _uniformColor = _shader->getUniform("color");
-            _uniformOutline = _shader->getUniform("outlineColor");
-
             _attribPos = _shader->getAttrib("Position");
             _attribTex = _shader->getAttrib("TexCoord");
         }
 
         TextArea::~TextArea()
         {
-            GL_CHECK(glDeleteBuffers(1, &_coords));
-            GL_CHECK(glDeleteBuffers(1, &_texCoords));
-            GL_CHECK(glDeleteBuffers(1, &_ebo));
-            if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL32)
+        }
+
+        void TextArea::setLayout(std::shared_ptr<const TextLayout> layout)
+        {
+            if (layout == _layout)
             {
-                GL_CHECK(glDeleteVertexArrays(1, &_vao));
+                return;
             }
+            _layout = std::move(layout);
+            _slot = GlyphBuffer::Slot();
         }
 
-
         void TextArea::render(Point& pos, Graphics::Font* font, SDL_Color _color, SDL_Color _outlineColor)
         {
-            if (!_cnt)
+            if (!_layout || _layout->vertices.empty())
             {
                 return;
             }
@@ -65,77 +48,31 @@ namespace Falltergeist
 
             GL_CHECK(font->texture()->bind(0));
 
-            GL_CHECK(_shader->setUniform(_uniformTex, 0));
+            GL_CHECK(_shader->setUniform(Shader::Uniform::TEX, 0));
 
-            GL_CHECK(_shader->setUniform(_uniformMVP, Game::getInstance()->renderer()->getMVP()));
-            GL_CHECK(_shader->setUniform(_uniformOffset, glm::vec2((float)pos.x(), (float(pos.y())) )));
-            GL_CHECK(_shader->setUniform(_uniformColor, glm::vec4((float)_color.r / 255.f, (float)_color.g / 255.f, (float)_color.b / 255.f, (float)_color.a / 255.f)));
-            GL_CHECK(_shader->setUniform(_uniformOutline, glm::vec4((float)_outlineColor.r / 255.f, (float)_outlineColor.g / 255.f, (float)_outlineColor.b / 255.f, (float)_outlineColor.a / 255.f)));
-            GL_CHECK(_shader->setUniform(_uniformFade, Game::getInstance()->renderer()->fadeColor()));
+            GL_CHECK(_shader->setUniform(Shader::Uniform::OFFSET, glm::vec2((float)pos.x(), (float(pos.y())) )));
+            GL_CHECK(_shader->setUniform(Shader::Uniform::COLOR, glm::vec4((float)_color.r / 255.f, (float)_color.g / 255.f, (float)_color.b / 255.f, (float)_color.a / 255.f)));
+            GL_CHECK(_shader->setUniform(Shader::Uniform::OUTLINE_COLOR, glm::vec4((float)_outlineColor.r / 255.f, (float)_outlineColor.g / 255.f, (float)_outlineColor.b / 255.f, (float)_outlineColor.a / 255.f)));
             if (Game::getInstance()->renderer()->renderPath() == Graphics::Renderer::RenderPath::OGL21)
             {
-                GL_CHECK(_shader->setUniform(_uniformTexSize, glm::vec2((float)font->texture()->textureWidth(), (float)font->texture()->textureHeight() )));
+                GL_CHECK(_shader->setUniform(Shader::Uniform::TEX_SIZE, glm::vec2((float)font->texture()->textureWidth(), (float)font->texture()->textureHeight() )));
             }
 
-            if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL32)
-            {
-                GLint curvao;
-                glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &curvao);
-                if ((GLuint)curvao != _vao)
-                {
-                    GL_CHECK(glBindVertexArray(_vao));
-                }
-            }
-
-            GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, _coords));
-            GL_CHECK(glVertexAttribPointer(_attribPos, 2, GL_FLOAT, GL_FALSE, 0, (void*)0 ));
-
+            auto glyphBuffer = Game::getInstance()->renderer()->glyphBuffer();
+            size_t count = std::min(_layout->vertices.size(), glyphBuffer->capacity());
+            size_t first = glyphBuffer->push(_layout->vertices.data(), count, _slot);
 
-            GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, _texCoords));
-            GL_CHECK(glVertexAttribPointer(_attribTex, 2, GL_FLOAT, GL_FALSE, 0, (void*)0 ));
-
-            GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo));
+            GL_CHECK(glyphBuffer->bind());
+            GL_CHECK(glVertexAttribPointer(_attribPos, 2, GL_FLOAT, GL_FALSE, sizeof(GlyphVertex), (void*)(first * sizeof(GlyphVertex))));
+            GL_CHECK(glVertexAttribPointer(_attribTex, 2, GL_FLOAT, GL_FALSE, sizeof(GlyphVertex), (void*)(first * sizeof(GlyphVertex) + sizeof(glm::vec2))));
 
             GL_CHECK(glEnableVertexAttribArray(_attribPos));
             GL_CHECK(glEnableVertexAttribArray(_attribTex));
 
-            GL_CHECK(glDrawElements(GL_TRIANGLES, _cnt, GL_UNSIGNED_SHORT, 0 ));
+            GL_CHECK(glDrawElements(GL_TRIANGLES, (GLsizei)(count / 4 * 6), GL_UNSIGNED_SHORT, 0 ));
 
             GL_CHECK(glDisableVertexAttribArray(_attribPos));
             GL_CHECK(glDisableVertexAttribArray(_attribTex));
         }
-
-        void TextArea::updateBuffers(std::vector<glm::vec2> vertices, std::vector<glm::vec2> UV,  std::vector<GLushort> indexes)
-        {
-            if (!vertices.size())
-            {
-                _cnt = 0;
-                return;
-            }
-            _cnt = static_cast<int>(indexes.size());
-
-            if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL32)
-            {
-                GLint curvao;
-                glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &curvao);
-                if ((GLuint)curvao != _vao)
-                {
-                    GL_CHECK(glBindVertexArray(_vao));
-                }
-            }
-
-            GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, _coords));
-            GL_CHECK(glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(glm::vec2), &vertices[0], GL_DYNAMIC_DRAW));
-
-
-            GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, _texCoords));
-            GL_CHECK(glBufferData(GL_ARRAY_BUFFER, UV.size() * sizeof(glm::vec2), &UV[0], GL_DYNAMIC_DRAW));
-
-            GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo));
-            GL_CHECK(glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexes.size() * sizeof(GLushort), &indexes[0], GL_DYNAMIC_DRAW));
-
-            GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
-            GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, 0));
-        }
     }
 }
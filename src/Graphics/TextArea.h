@@ -1,11 +1,14 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 #include "../Graphics/Font.h"
+#include "../Graphics/GlyphBuffer.h"
 #include "../Graphics/Renderer.h"
 #include "../Graphics/Shader.h"
+#include "../Graphics/TextLayout.h"
 
 namespace Falltergeist
 {
@@ -18,22 +21,12 @@ namespace Falltergeist
                 ~TextArea();
 
                 void render(Point& pos, Graphics::Font* font, SDL_Color _color, SDL_Color _outlineColor);
-                void updateBuffers(std::vector<glm::vec2> vertices, std::vector<glm::vec2> UV,  std::vector<GLushort> indexes);
+                // Glyph quads are uploaded to the shared glyph buffer on the next render, unless layout is the same one
+                void setLayout(std::shared_ptr<const TextLayout> layout);
 
             protected:
-                GLuint _vao;
-                GLuint _coords;
-                GLuint _texCoords;
-                GLuint _ebo;
-                int _cnt = 0;
-
-                GLint _uniformTex;
-                GLint _uniformTexSize;
-                GLint _uniformFade;
-                GLint _uniformMVP;
-                GLint _uniformOffset;
-                GLint _uniformColor;
-                GLint _uniformOutline;
+                std::shared_ptr<const TextLayout> _layout;
+                GlyphBuffer::Slot _slot;
 
                 GLint _attribPos;
                 GLint _attribTex;
@@ -0,0 +1,52 @@
+#include "../Graphics/TextLayout.h"
+
+namespace Falltergeist
+{
+    namespace Graphics
+    {
+        TextLayoutCache::TextLayoutCache(size_t capacity) : _capacity(capacity)
+        {
+        }
+
+        std::shared_ptr<const TextLayout> TextLayoutCache::find(const std::string& key)
+        {
+            auto it = _entries.find(key);
+            if (it == _entries.end())
+            {
+                return nullptr;
+            }
+            _order.splice(_order.begin(), _order, it->second.order);
+            return it->second.layout;
+        }
+
+        void TextLayoutCache::insert(const std::string& key, std::shared_ptr<const TextLayout> layout)
+        {
+            auto it = _entries.find(key);
+            if (it != _entries.end())
+            {
+                it->second.layout = std::move(layout);
+                _order.splice(_order.begin(), _order, it->second.order);
+                return;
+            }
+
+            if (_entries.size() >= _capacity && !_order.empty())
+            {
+                _entries.erase(_order.back());
+                _order.pop_back();
+            }
+            _order.push_front(key);
+            _entries.emplace(key, Entry{std::move(layout), _order.begin()});
+        }
+
+        void TextLayoutCache::clear()
+        {
+            _entries.clear();
+            _order.clear();
+        }
+
+        size_t TextLayoutCache::size() const
+        {
+            return _entries.size();
+        }
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../Graphics/GlyphBuffer.h"
+#include "../Graphics/Size.h"
+
+namespace Falltergeist
+{
+    namespace Graphics
+    {
+        // Text laid out for drawing: ready glyph quads (4 vertices each) and size of the visible part
+        struct TextLayout
+        {
+            std::vector<GlyphVertex> vertices;
+            Size size;
+        };
+
+        /**
+         * Least recently used cache of text layouts, keyed by everything that affects the layout
+         * (font, text, wrap width, alignment...). Layouts are immutable and shared between text areas
+         * showing the same text, e.g. floating messages over a crowd.
+         */
+        class TextLayoutCache
+        {
+            public:
+                explicit TextLayoutCache(size_t capacity = 512);
+
+                std::shared_ptr<const TextLayout> find(const std::string& key);
+                void insert(const std::string& key, std::shared_ptr<const TextLayout> layout);
+                void clear();
+
+                size_t size() const;
+
+            private:
+                using Order = std::list<std::string>;
+
+                struct Entry
+                {
+                    std::shared_ptr<const TextLayout> layout;
+                    Order::iterator order;
+                };
+
+                size_t _capacity;
+                // most recently used first
+                Order _order;
+                std::unordered_map<std::string, Entry> _entries;
+        };
+    }
+}
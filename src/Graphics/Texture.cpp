@@ -1,11 +1,16 @@
-﻿#include "../Exception.h"
+﻿#include <algorithm>
+#include <cstring>
+#include "../Exception.h"
 #include "../Game/Game.h"
+#include "../Graphics/Renderer.h"
 #include "../Graphics/Texture.h"
 
 namespace Falltergeist
 {
     namespace Graphics
     {
+        size_t Texture::_totalVideoMemory = 0;
+
         int NearestPowerOf2(int n)
         {
             if (!n) return n; //(0 == 2^0)
@@ -22,24 +27,35 @@ namespace Falltergeist
             _width = width;
             _height = height;
 
-            glGenTextures(1, &_textureID);
+            if (Game::getInstance()->renderer()->renderPath() != Renderer::RenderPath::NONE)
+            {
+                glGenTextures(1, &_textureID);
+            }
         }
 
         Texture::Texture(SDL_Surface* surface): _size(surface->w, surface->h)
         {
             _width = surface->w;
             _height = surface->h;
-            glGenTextures(1, &_textureID);
+            if (Game::getInstance()->renderer()->renderPath() != Renderer::RenderPath::NONE)
+            {
+                glGenTextures(1, &_textureID);
+            }
             loadFromSurface(surface);
         }
 
         Texture::~Texture()
         {
+            if (_pixelBuffers[0] > 0)
+            {
+                glDeleteBuffers(2, _pixelBuffers);
+            }
             if (_textureID > 0)
             {
                 glDeleteTextures(1, &_textureID);
                 _textureID = 0;
             }
+            _setVideoMemory(0);
         }
 
         unsigned int Texture::width() const
@@ -69,78 +85,320 @@ namespace Falltergeist
 
         void Texture::loadFromSurface(SDL_Surface* surface)
         {
-            SDL_Surface* resizedSurface = NULL;
-            SDL_Rect area;
-
             if (surface == NULL)
             {
                 return;
             }
 
-            int newWidth = NearestPowerOf2(_width);
-            int newHeight = NearestPowerOf2(_height);
+            // packed GL types read each pixel as one 32-bit word, exactly like SDL describes its formats
+            GLint internalFormat;
+            GLenum format;
+            GLenum type;
+            switch (surface->format->format)
+            {
+                case SDL_PIXELFORMAT_RGBA8888:
+                    internalFormat = GL_RGBA8;
+                    format = GL_RGBA;
+                    type = GL_UNSIGNED_INT_8_8_8_8;
+                    break;
+                case SDL_PIXELFORMAT_ABGR8888:
+                    internalFormat = GL_RGBA8;
+                    format = GL_RGBA;
+                    type = GL_UNSIGNED_INT_8_8_8_8_REV;
+                    break;
+                case SDL_PIXELFORMAT_ARGB8888:
+                    internalFormat = GL_RGBA8;
+                    format = GL_BGRA;
+                    type = GL_UNSIGNED_INT_8_8_8_8_REV;
+                    break;
+                // formats with an unused byte: RGB storage makes GL ignore it and read alpha as opaque
+                case SDL_PIXELFORMAT_BGR888:
+                    internalFormat = GL_RGB8;
+                    format = GL_RGBA;
+                    type = GL_UNSIGNED_INT_8_8_8_8_REV;
+                    break;
+                case SDL_PIXELFORMAT_RGB888:
+                    internalFormat = GL_RGB8;
+                    format = GL_BGRA;
+                    type = GL_UNSIGNED_INT_8_8_8_8_REV;
+                    break;
+                default:
+                {
+                    // anything else (palettized, 24 and 16 bit) is converted once on the CPU
+                    SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ABGR8888, 0);
+                    if (converted == NULL)
+                    {
+                        throw Exception(std::string("Texture::loadFromSurface() - can't convert surface: ") + SDL_GetError());
+                    }
+                    loadFromSurface(converted);
+                    SDL_FreeSurface(converted);
+                    return;
+                }
+            }
+
+            _allocate(internalFormat, 4);
+
+            if (_textureID == 0)
+            {
+                return;
+            }
 
-            int bpp;
-            Uint32 Rmask, Gmask, Bmask, Amask;
+            if (SDL_MUSTLOCK(surface))
+            {
+                SDL_LockSurface(surface);
+            }
+            _upload(surface->pixels, 0, 0,
+                    std::min(_width, (unsigned int)surface->w),
+                    std::min(_height, (unsigned int)surface->h),
+                    surface->pitch / 4, 4, format, type);
+            if (SDL_MUSTLOCK(surface))
+            {
+                SDL_UnlockSurface(surface);
+            }
+        }
+
+        void Texture::loadFromRGB(unsigned int* data)
+        {
+            // tightly packed 3 bytes per pixel, blue first (0xRRGGBB words)
+            _allocate(GL_RGB8, 3);
+
+            if (_textureID == 0)
+            {
+                return;
+            }
+
+            _upload(data, 0, 0, _width, _height, _width, 3, GL_BGR, GL_UNSIGNED_BYTE);
+        }
+
+        void Texture::loadFromRGBA(unsigned int* data)
+        {
+            // one 0xRRGGBBAA word per pixel
+            _allocate(GL_RGBA8, 4);
 
-            SDL_PixelFormatEnumToMasks(
-                SDL_PIXELFORMAT_ABGR8888, &bpp,
-                &Rmask, &Gmask, &Bmask, &Amask
-            );
+            if (_textureID == 0)
+            {
+                return;
+            }
 
-            resizedSurface = SDL_CreateRGBSurface(0, newWidth, newHeight, bpp,
-                Rmask, Gmask, Bmask, Amask
-            );
+            _upload(data, 0, 0, _width, _height, _width, 4, GL_RGBA, GL_UNSIGNED_INT_8_8_8_8);
+        }
 
-            area.x = 0;
-            area.y = 0;
-            area.w = surface->w;
-            area.h = surface->h;
+        void Texture::loadFromRGBA(const unsigned int* data, const Point& position, const Size& size)
+        {
+            if (position.x() < 0 || position.y() < 0
+                || (unsigned int)(position.x() + size.width()) > _width
+                || (unsigned int)(position.y() + size.height()) > _height)
+            {
+                throw Exception("Texture::loadFromRGBA() - area is out of texture bounds");
+            }
 
-            SDL_SetSurfaceAlphaMod( surface, 0xFF );
-            SDL_SetSurfaceBlendMode( surface, SDL_BLENDMODE_NONE );
-            SDL_BlitSurface(surface, &area, resizedSurface, &area);
+            if (_textureID == 0)
+            {
+                return;
+            }
+            if (_internalFormat != GL_RGBA8)
+            {
+                throw Exception("Texture::loadFromRGBA() - texture storage is not RGBA");
+            }
 
+            // may be called while other textures are bound for drawing, so the current binding is kept
+            GLint previous;
+            glGetIntegerv(GL_TEXTURE_BINDING_2D, &previous);
             glBindTexture(GL_TEXTURE_2D, _textureID);
+            _upload(data, position.x(), position.y(), size.width(), size.height(), size.width(), 4, GL_RGBA, GL_UNSIGNED_INT_8_8_8_8);
+            glBindTexture(GL_TEXTURE_2D, previous);
+        }
 
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, resizedSurface->w, resizedSurface->h, 0, GL_RGBA, GL_UNSIGNED_BYTE, resizedSurface->pixels);
+        void Texture::loadFromIndexes(const uint8_t* data)
+        {
+            _indexed = true;
 
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            // GL 2.1 has no single-channel red textures, luminance samples into .r just the same
+            GLint internalFormat = GL_R8;
+            GLenum format = GL_RED;
+            if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL21)
+            {
+                internalFormat = GL_LUMINANCE8;
+                format = GL_LUMINANCE;
+            }
+
+            _allocate(internalFormat, 1);
+
+            if (_textureID == 0)
+            {
+                return;
+            }
 
-            _textureWidth = resizedSurface->w;
-            _textureHeight = resizedSurface->h;
-            SDL_FreeSurface(resizedSurface);
+            _upload(data, 0, 0, _width, _height, _width, 1, format, GL_UNSIGNED_BYTE);
         }
 
-        void Texture::loadFromRGB(unsigned int* data)
+        void Texture::loadFromIndexes(const uint8_t* data, const Point& position, const Size& size)
         {
-            SDL_Surface* tempSurf = NULL;
-            Uint32 rmask, gmask, bmask, amask;
-            rmask = 0xff0000;
-            gmask = 0x00ff00;
-            bmask = 0x0000ff;
-            amask = 0x000000;
-            tempSurf = SDL_CreateRGBSurfaceFrom(data, _width, _height, 24, _width*3, rmask, gmask, bmask, amask);
+            if (!_indexed)
+            {
+                throw Exception("Texture::loadFromIndexes() - texture storage is not indexed");
+            }
+            if (position.x() < 0 || position.y() < 0
+                || (unsigned int)(position.x() + size.width()) > _width
+                || (unsigned int)(position.y() + size.height()) > _height)
+            {
+                throw Exception("Texture::loadFromIndexes() - area is out of texture bounds");
+            }
 
-            loadFromSurface(tempSurf);
+            if (_textureID == 0)
+            {
+                return;
+            }
 
-            SDL_FreeSurface(tempSurf);
+            GLenum format = GL_RED;
+            if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL21)
+            {
+                format = GL_LUMINANCE;
+            }
+
+            GLint previous;
+            glGetIntegerv(GL_TEXTURE_BINDING_2D, &previous);
+            glBindTexture(GL_TEXTURE_2D, _textureID);
+            _upload(data, position.x(), position.y(), size.width(), size.height(), size.width(), 1, format, GL_UNSIGNED_BYTE);
+            glBindTexture(GL_TEXTURE_2D, previous);
         }
 
-        void Texture::loadFromRGBA(unsigned int* data)
+        void Texture::allocateRGBA()
         {
-            Uint32 rmask, gmask, bmask, amask;
-            rmask = 0xff000000;
-            gmask = 0x00ff0000;
-            bmask = 0x0000ff00;
-            amask = 0x000000ff;
+            _indexed = false;
+            _allocate(GL_RGBA8, 4);
+        }
 
-            SDL_Surface* tempSurf = SDL_CreateRGBSurfaceFrom(data, _width, _height, 32, _width*4, rmask, gmask, bmask, amask);
+        GLuint Texture::id() const
+        {
+            return _textureID;
+        }
 
-            loadFromSurface(tempSurf);
+        bool Texture::indexed() const
+        {
+            return _indexed;
+        }
 
-            SDL_FreeSurface(tempSurf);
+        void Texture::setStreaming(bool value)
+        {
+            _streaming = value;
+        }
+
+        bool Texture::streaming() const
+        {
+            return _streaming;
+        }
+
+        size_t Texture::videoMemory() const
+        {
+            return _videoMemory;
+        }
+
+        size_t Texture::totalVideoMemory()
+        {
+            return _totalVideoMemory;
+        }
+
+        void Texture::_allocate(GLint internalFormat, unsigned int bytesPerTexel)
+        {
+            unsigned int textureWidth = _width;
+            unsigned int textureHeight = _height;
+            if (!Game::getInstance()->renderer()->npotTextures())
+            {
+                textureWidth = NearestPowerOf2(_width);
+                textureHeight = NearestPowerOf2(_height);
+            }
+
+            bool resized = textureWidth != _textureWidth || textureHeight != _textureHeight;
+            _textureWidth = textureWidth;
+            _textureHeight = textureHeight;
+
+            // headless: keep the geometry, there is nothing to upload to
+            if (_textureID == 0)
+            {
+                return;
+            }
+
+            glBindTexture(GL_TEXTURE_2D, _textureID);
+
+            // storage is reused by later uploads of the same format, only the texels are replaced
+            if (!resized && internalFormat == _internalFormat)
+            {
+                return;
+            }
+            _internalFormat = internalFormat;
+
+            // padding (if any) stays undefined, it is never sampled: UVs are clamped to width/textureWidth
+            glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, _textureWidth, _textureHeight, 0,
+                         internalFormat == GL_R8 ? GL_RED : (internalFormat == GL_LUMINANCE8 ? GL_LUMINANCE : GL_RGBA),
+                         GL_UNSIGNED_BYTE, nullptr);
+
+            // nothing is ever filtered: frames are pixel art and indexed texels must not be interpolated
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+            _setVideoMemory((size_t)_textureWidth * _textureHeight * bytesPerTexel + _pixelBufferSize * 2);
+        }
+
+        void Texture::_upload(const void* pixels, unsigned int x, unsigned int y, unsigned int width, unsigned int height,
+                              unsigned int rowLength, unsigned int bytesPerPixel, GLenum format, GLenum type)
+        {
+            // rows are read straight from the source memory, whatever its pitch is
+            glPixelStorei(GL_UNPACK_ROW_LENGTH, rowLength);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, bytesPerPixel == 4 ? 4 : 1);
+
+            const void* source = pixels;
+            bool buffered = false;
+
+            if (_streaming && Game::getInstance()->renderer()->pixelBufferObjects())
+            {
+                size_t bytes = (size_t)rowLength * height * bytesPerPixel;
+                if (_pixelBuffers[0] == 0)
+                {
+                    glGenBuffers(2, _pixelBuffers);
+                }
+                if (bytes > _pixelBufferSize)
+                {
+                    _setVideoMemory(_videoMemory - _pixelBufferSize * 2 + bytes * 2);
+                    _pixelBufferSize = bytes;
+                }
+
+                // alternate between two buffers, so we never wait for the transfer of the previous frame
+                _pixelBufferIndex = (_pixelBufferIndex + 1) % 2;
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _pixelBuffers[_pixelBufferIndex]);
+                // orphan the old contents, driver hands out fresh memory if GPU still reads them
+                glBufferData(GL_PIXEL_UNPACK_BUFFER, _pixelBufferSize, NULL, GL_STREAM_DRAW);
+                void* mapped = glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY);
+                if (mapped)
+                {
+                    std::memcpy(mapped, pixels, bytes);
+                    if (glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_TRUE)
+                    {
+                        // offset into the bound buffer
+                        source = nullptr;
+                        buffered = true;
+                    }
+                }
+                if (!buffered)
+                {
+                    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+                }
+            }
+
+            glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, format, type, source);
+
+            if (buffered)
+            {
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            }
+            glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        }
+
+        void Texture::_setVideoMemory(size_t bytes)
+        {
+            _totalVideoMemory = _totalVideoMemory - _videoMemory + bytes;
+            _videoMemory = bytes;
         }
 
         void Texture::bind(uint8_t unit)
@@ -187,16 +445,12 @@ namespace Falltergeist
 
         bool Texture::opaque(unsigned int x, unsigned int y)
         {
-            if (x >= width() || y >= height() || y*width() + x >= _mask.size()) {
-                return false;
-            }
-
-            return _mask.at(y * width() + x);
+            return _mask && _mask->opaque(x, y);
         }
 
-        void Texture::setMask(std::vector<bool> mask)
+        void Texture::setMask(std::shared_ptr<const Format::Frm::Mask> mask)
         {
-            _mask = mask;
+            _mask = std::move(mask);
         }
     }
 }
@@ -5,6 +5,7 @@
 #include <GL/glew.h>
 #include <SDL.h>
 #include <SDL_opengl.h>
+#include "../Format/Frm/Mask.h"
 #include "../Graphics/Point.h"
 #include "../Graphics/Size.h"
 
@@ -28,24 +29,63 @@ namespace Falltergeist
                 void loadFromSurface(SDL_Surface* surface);
                 void loadFromRGB(unsigned int* data);
                 void loadFromRGBA(unsigned int* data);
+                // Replaces an area of an RGBA texture, storage must already be allocated by loadFromRGBA()
+                void loadFromRGBA(const unsigned int* data, const Point& position, const Size& size);
+                // Uploads 8 bits per pixel into a single-channel texture: palette indexes or font coverage
+                void loadFromIndexes(const uint8_t* data);
+                // Replaces an area of an indexed texture, storage must already be allocated by loadFromIndexes()
+                void loadFromIndexes(const uint8_t* data, const Point& position, const Size& size);
+                // Allocates RGBA storage without uploading anything, for textures which are rendered into
+                void allocateRGBA();
+
+                GLuint id() const;
+
+                // true if texture was loaded with loadFromIndexes(), shaders have to resolve its texels themselves
+                bool indexed() const;
+
+                // Streaming textures are updated every frame (movies), their uploads go through pixel buffer objects
+                void setStreaming(bool value);
+                bool streaming() const;
 
                 void bind(uint8_t unit=0);
                 void unbind(uint8_t unit=0);
 
                 bool opaque(unsigned int x, unsigned int y);
-                void setMask(std::vector<bool> mask);
+                void setMask(std::shared_ptr<const Format::Frm::Mask> mask);
 
                 Size size() const;
 
+                // Video memory taken by this texture storage and its pixel buffers, in bytes
+                size_t videoMemory() const;
+                // Video memory taken by all textures, in bytes
+                static size_t totalVideoMemory();
+
             protected:
-                GLuint _textureID;
+                GLuint _textureID = 0;
                 unsigned int _width = 0;
                 unsigned int _height = 0;
                 Size _size;
 
                 unsigned int _textureWidth = 0;
                 unsigned int _textureHeight = 0;
-                std::vector<bool> _mask;
+                bool _indexed = false;
+                std::shared_ptr<const Format::Frm::Mask> _mask;
+
+                // format of allocated storage, 0 until the first upload
+                GLint _internalFormat = 0;
+                size_t _videoMemory = 0;
+
+                bool _streaming = false;
+                GLuint _pixelBuffers[2] = {0, 0};
+                size_t _pixelBufferSize = 0;
+                unsigned int _pixelBufferIndex = 0;
+
+                static size_t _totalVideoMemory;
+
+                void _allocate(GLint internalFormat, unsigned int bytesPerTexel);
+                void _upload(const void* pixels, unsigned int x, unsigned int y, unsigned int width, unsigned int height,
+                             unsigned int rowLength, unsigned int bytesPerPixel, GLenum format, GLenum type);
+                void _setVideoMemory(size_t bytes);
         };
     }
 }
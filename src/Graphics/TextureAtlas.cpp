@@ -0,0 +1,215 @@
+#include <algorithm>
+#include <cstring>
+#include "../Exception.h"
+#include "../Game/Game.h"
+#include "../Graphics/Renderer.h"
+#include "../Graphics/TextureAtlas.h"
+
+namespace Falltergeist
+{
+    namespace Graphics
+    {
+        bool TextureRegion::opaque(unsigned int x, unsigned int y) const
+        {
+            return mask && mask->opaque(x, y);
+        }
+
+        TextureAtlas::TextureAtlas(unsigned int pageWidth, unsigned int pageHeight)
+        {
+            auto renderer = Game::getInstance()->renderer();
+            if (renderer->renderPath() != Renderer::RenderPath::NONE)
+            {
+                pageWidth = std::min(pageWidth, static_cast<unsigned int>(renderer->maxTextureSize()));
+                pageHeight = std::min(pageHeight, static_cast<unsigned int>(renderer->maxTextureSize()));
+            }
+            _pageWidth = pageWidth;
+            _pageHeight = pageHeight;
+        }
+
+        TextureAtlas::~TextureAtlas()
+        {
+        }
+
+        TextureRegion* TextureAtlas::add(const std::string& name, const Size& size, const uint8_t* data)
+        {
+            auto it = _entries.find(name);
+            if (it != _entries.end())
+            {
+                return &it->second.region;
+            }
+
+            // every image is surrounded by a transparent 1px border, so outline shaders never sample the neighbours
+            unsigned int width = static_cast<unsigned int>(size.width()) + 2;
+            unsigned int height = static_cast<unsigned int>(size.height()) + 2;
+
+            Area area;
+            Page* page = nullptr;
+
+            if (width <= _pageWidth && height <= _pageHeight)
+            {
+                for (auto& candidate : _pages)
+                {
+                    if (!candidate->dedicated && _allocate(*candidate, width, height, area))
+                    {
+                        page = candidate.get();
+                        break;
+                    }
+                }
+                if (!page)
+                {
+                    page = _createPage(_pageWidth, _pageHeight, false);
+                    _allocate(*page, width, height, area);
+                }
+            }
+            else
+            {
+                auto renderer = Game::getInstance()->renderer();
+                if (renderer->renderPath() != Renderer::RenderPath::NONE
+                    && std::max(width, height) > static_cast<unsigned int>(renderer->maxTextureSize()))
+                {
+                    throw Exception("TextureAtlas::add() - image is too large: " + name);
+                }
+                page = _createPage(width, height, true);
+                area.width = width;
+                area.height = height;
+            }
+
+            std::vector<uint8_t> padded(width * height, 0);
+            for (unsigned int y = 0; y != height - 2; ++y)
+            {
+                std::memcpy(padded.data() + (y + 1) * width + 1, data + y * (width - 2), width - 2);
+            }
+            page->texture->loadFromIndexes(padded.data(), Point(area.x, area.y), Size(width, height));
+
+            Entry entry;
+            entry.region.texture = page->texture.get();
+            entry.region.position = Point(area.x + 1, area.y + 1);
+            entry.region.size = size;
+            return &_entries.emplace(name, std::move(entry)).first->second.region;
+        }
+
+        const TextureRegion* TextureAtlas::region(const std::string& name) const
+        {
+            auto it = _entries.find(name);
+            if (it == _entries.end())
+            {
+                return nullptr;
+            }
+            return &it->second.region;
+        }
+
+        size_t TextureAtlas::pages() const
+        {
+            return _pages.size();
+        }
+
+        Size TextureAtlas::pageSize() const
+        {
+            return Size(_pageWidth, _pageHeight);
+        }
+
+        TextureAtlas::Page* TextureAtlas::_createPage(unsigned int width, unsigned int height, bool dedicated)
+        {
+            auto page = std::make_unique<Page>();
+            page->texture = std::make_unique<Texture>(width, height);
+            // allocates indexed storage, filled with the transparent index
+            std::vector<uint8_t> empty(width * height, 0);
+            page->texture->loadFromIndexes(empty.data());
+            page->dedicated = dedicated;
+            page->skyline.push_back(SkylineNode{0, 0, page->texture->width()});
+
+            _pages.push_back(std::move(page));
+            return _pages.back().get();
+        }
+
+        bool TextureAtlas::_allocate(Page& page, unsigned int width, unsigned int height, Area& area)
+        {
+            auto& skyline = page.skyline;
+            size_t bestIndex = skyline.size();
+            unsigned int bestBottom = UINT32_MAX;
+            unsigned int bestWidth = UINT32_MAX;
+            unsigned int bestY = 0;
+
+            // bottom-left rule: place image as low as possible, prefer narrower segments on ties
+            for (size_t i = 0; i != skyline.size(); ++i)
+            {
+                if (skyline[i].x + width > page.texture->width())
+                {
+                    break;
+                }
+
+                unsigned int y = skyline[i].y;
+                unsigned int remaining = width;
+                bool fits = true;
+                for (size_t j = i; remaining > 0; ++j)
+                {
+                    y = std::max(y, skyline[j].y);
+                    if (y + height > page.texture->height())
+                    {
+                        fits = false;
+                        break;
+                    }
+                    if (skyline[j].width >= remaining)
+                    {
+                        break;
+                    }
+                    remaining -= skyline[j].width;
+                }
+
+                if (fits && (y + height < bestBottom || (y + height == bestBottom && skyline[i].width < bestWidth)))
+                {
+                    bestIndex = i;
+                    bestBottom = y + height;
+                    bestWidth = skyline[i].width;
+                    bestY = y;
+                }
+            }
+
+            if (bestIndex == skyline.size())
+            {
+                return false;
+            }
+
+            area.x = skyline[bestIndex].x;
+            area.y = bestY;
+            area.width = width;
+            area.height = height;
+
+            skyline.insert(skyline.begin() + bestIndex, SkylineNode{area.x, area.y + height, width});
+
+            // cut away segments now covered by the new one
+            for (size_t i = bestIndex + 1; i < skyline.size();)
+            {
+                unsigned int right = skyline[i - 1].x + skyline[i - 1].width;
+                if (skyline[i].x >= right)
+                {
+                    break;
+                }
+                unsigned int shrink = right - skyline[i].x;
+                if (skyline[i].width <= shrink)
+                {
+                    skyline.erase(skyline.begin() + i);
+                    continue;
+                }
+                skyline[i].x += shrink;
+                skyline[i].width -= shrink;
+                break;
+            }
+
+            // merge neighbours of equal height
+            for (size_t i = 0; i + 1 < skyline.size();)
+            {
+                if (skyline[i].y == skyline[i + 1].y)
+                {
+                    skyline[i].width += skyline[i + 1].width;
+                    skyline.erase(skyline.begin() + i + 1);
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+            return true;
+        }
+    }
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../Format/Frm/Mask.h"
+#include "../Graphics/Point.h"
+#include "../Graphics/Size.h"
+#include "../Graphics/Texture.h"
+
+namespace Falltergeist
+{
+    namespace Graphics
+    {
+        // Area of a texture holding one image
+        struct TextureRegion
+        {
+            Texture* texture = nullptr;
+            Point position;
+            Size size;
+            // pixel opacity for hit testing, shared with the source image
+            std::shared_ptr<const Format::Frm::Mask> mask;
+            // image uses palette indexes cycled by AnimatedPalette, so its colors change over time
+            bool animatedColors = false;
+
+            bool opaque(unsigned int x, unsigned int y) const;
+        };
+
+        /**
+         * Packs 8-bit images (FRM palette indexes, font coverage) into a few large indexed textures,
+         * so sprites, animations and text drawn one after another share the same texture binding.
+         * Pages are filled with a skyline bottom-left packer. Images are never removed: sprites, animations and fonts
+         * keep pointers to their regions, so regions live as long as the atlas.
+         */
+        class TextureAtlas
+        {
+            public:
+                TextureAtlas(unsigned int pageWidth = 2048, unsigned int pageHeight = 2048);
+                ~TextureAtlas();
+
+                /**
+                 * Copies image into the atlas and returns its region, which stays valid as long as the atlas.
+                 * Image which is already in the atlas is not added again.
+                 * Images larger than a page get a page of their own.
+                 */
+                TextureRegion* add(const std::string& name, const Size& size, const uint8_t* data);
+                const TextureRegion* region(const std::string& name) const;
+
+                size_t pages() const;
+                Size pageSize() const;
+
+            private:
+                struct Area
+                {
+                    unsigned int x = 0;
+                    unsigned int y = 0;
+                    unsigned int width = 0;
+                    unsigned int height = 0;
+                };
+
+                struct SkylineNode
+                {
+                    unsigned int x;
+                    unsigned int y;
+                    unsigned int width;
+                };
+
+                struct Page
+                {
+                    std::unique_ptr<Texture> texture;
+                    std::vector<SkylineNode> skyline;
+                    // holds single oversized image
+                    bool dedicated = false;
+                };
+
+                struct Entry
+                {
+                    TextureRegion region;
+                };
+
+                unsigned int _pageWidth;
+                unsigned int _pageHeight;
+                std::vector<std::unique_ptr<Page>> _pages;
+                std::unordered_map<std::string, Entry> _entries;
+
+                Page* _createPage(unsigned int width, unsigned int height, bool dedicated);
+                bool _allocate(Page& page, unsigned int width, unsigned int height, Area& area);
+        };
+    }
+}
@@ -13,6 +13,11 @@ namespace Falltergeist
     {
         Tilemap::Tilemap(std::vector<glm::vec2> coords, std::vector<glm::vec2> textureCoords)
         {
+            if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::NONE)
+            {
+                return;
+            }
+
             if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL32)
             {
                 GL_CHECK(glGenVertexArrays(1, &_vao));
@@ -30,7 +35,6 @@ namespace Falltergeist
             //update coords
             GL_CHECK(glBufferData(GL_ARRAY_BUFFER, coords.size() * sizeof(glm::vec2), &coords[0], GL_STATIC_DRAW));
 
-
             GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, _texCoords));
             //update texcoords
             GL_CHECK(glBufferData(GL_ARRAY_BUFFER, textureCoords.size() * sizeof(glm::vec2), &textureCoords[0], GL_STATIC_DRAW));
@@ -40,13 +44,6 @@ namespace Falltergeist
 
             _shader = ResourceManager::getInstance()->shader("tilemap");
 
-            _uniformTex = _shader->getUniform("tex");
-            _uniformFade = _shader->getUniform("fade");
-            _uniformMVP = _shader->getUniform("MVP");
-            _uniformCnt = _shader->getUniform("cnt");
-            _uniformLight = _shader->getUniform("global_light");
-            _uniformOffset = _shader->getUniform("offset");
-
             _attribPos = _shader->getAttrib("Position");
             _attribTex = _shader->getAttrib("TexCoord");
 
@@ -54,6 +51,11 @@ namespace Falltergeist
 
         Tilemap::~Tilemap()
         {
+            if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::NONE)
+            {
+                return;
+            }
+
             GL_CHECK(glDeleteBuffers(1, &_coords));
             GL_CHECK(glDeleteBuffers(1, &_texCoords));
             GL_CHECK(glDeleteBuffers(1, &_ebo));
@@ -64,24 +66,20 @@ namespace Falltergeist
             }
         }
 
-        void Tilemap::render(const Point &pos, std::vector<GLuint> indexes, uint32_t atlas)
+        void Tilemap::render(const Point &pos, const std::vector<GLuint> &indexes, uint32_t atlas)
         {
             if (indexes.size()<=0) return;
 
             GL_CHECK(_shader->use());
 
             GL_CHECK(_textures.at(atlas).get()->bind(0));
+            GL_CHECK(Game::getInstance()->animatedPalette()->texture()->bind(1));
 
-            GL_CHECK(_shader->setUniform(_uniformTex, 0));
-
-            GL_CHECK(_shader->setUniform(_uniformMVP, Game::getInstance()->renderer()->getMVP()));
+            GL_CHECK(_shader->setUniform(Shader::Uniform::TEX, 0));
+            GL_CHECK(_shader->setUniform(Shader::Uniform::PALETTE, 1));
 
             // set camera offset
-            GL_CHECK(_shader->setUniform(_uniformOffset, glm::vec2((float)pos.x()+1.0, (float)pos.y()+2.0) ));
-
-            GL_CHECK(_shader->setUniform(_uniformFade, Game::getInstance()->renderer()->fadeColor()));
-
-            GL_CHECK(_shader->setUniform(_uniformCnt, Game::getInstance()->animatedPalette()->counters()));
+            GL_CHECK(_shader->setUniform(Shader::Uniform::OFFSET, glm::vec2((float)pos.x()+1.0, (float)pos.y()+2.0) ));
 
             int lightLevel = 100;
             if (auto state = Game::getInstance()->locationState())
@@ -100,7 +98,7 @@ namespace Falltergeist
                     lightLevel = (state->lightLevel() - 0xA000) * 100 / 0x6000;
                 }
             }
-            GL_CHECK(_shader->setUniform(_uniformLight, lightLevel));
+            GL_CHECK(_shader->setUniform(Shader::Uniform::GLOBAL_LIGHT, lightLevel));
 
             if (Game::getInstance()->renderer()->renderPath() == Renderer::RenderPath::OGL32)
             {
@@ -115,7 +113,6 @@ namespace Falltergeist
             GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, _coords));
             GL_CHECK(glVertexAttribPointer(_attribPos, 2, GL_FLOAT, GL_FALSE, 0, (void*)0 ));
 
-
             GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, _texCoords));
 
             GL_CHECK(glVertexAttribPointer(_attribTex, 2, GL_FLOAT, GL_FALSE, 0, (void*)0 ));
@@ -136,10 +133,9 @@ namespace Falltergeist
             GL_CHECK(glDisableVertexAttribArray(_attribTex));
         }
 
-        void Tilemap::addTexture(SDL_Surface *surface)
+        void Tilemap::addTexture(std::unique_ptr<Texture> texture)
         {
-            _textures.push_back(std::make_unique<Texture>(surface->w, surface->h));
-            _textures.back().get()->loadFromSurface(surface);
+            _textures.push_back(std::move(texture));
         }
     }
 }
@@ -14,8 +14,8 @@ namespace Falltergeist
             public:
                 Tilemap(std::vector<glm::vec2> coords, std::vector<glm::vec2> textureCoords);
                 ~Tilemap();
-                void render(const Point &pos, std::vector<GLuint> indexes, uint32_t atlas);
-                void addTexture(SDL_Surface* surface);
+                void render(const Point &pos, const std::vector<GLuint> &indexes, uint32_t atlas);
+                void addTexture(std::unique_ptr<Texture> texture);
 
             private:
                 GLuint _vao;
@@ -24,13 +24,6 @@ namespace Falltergeist
                 GLuint _ebo;
                 std::vector<std::unique_ptr<Texture>> _textures;
 
-                GLint _uniformTex;
-                GLint _uniformFade;
-                GLint _uniformMVP;
-                GLint _uniformCnt;
-                GLint _uniformLight;
-                GLint _uniformOffset;
-
                 GLint _attribPos;
                 GLint _attribTex;
                 Graphics::Shader*_shader;
@@ -1,5 +1,6 @@
 // C++ standard includes
 #include <memory>
+#include <utility>
 
 // Falltergeist includes
 #include "../Exception.h"
@@ -11,6 +12,7 @@
 #include "../Game/DoorSceneryObject.h"
 #include "../Game/ExitMiscObject.h"
 #include "../Game/ObjectFactory.h"
+#include "../Game/ObjectRegistry.h"
 #include "../Game/SpatialObject.h"
 #include "../Helpers/GameObjectHelper.h"
 #include "../Logger.h"
@@ -21,6 +23,10 @@ namespace Falltergeist
 {
     namespace Helpers
     {
+        GameObjectHelper::GameObjectHelper(Base::Arena* arena) : _arena(arena)
+        {
+        }
+
         std::shared_ptr<Game::Object> GameObjectHelper::createFromMapSpatialScript(const Format::Map::Script& mapScript) const
         {
             auto tile = mapScript.spatialTile();
@@ -28,6 +34,7 @@ namespace Falltergeist
             auto elev = ((tile >> 28) & 0xf) >> 1;
 
             auto object = std::make_shared<Game::SpatialObject>(mapScript.spatialRadius());
+            Game::ObjectRegistry::getInstance()->setOwner(object);
             object->setElevation(elev);
             object->setPosition(hex);
 
@@ -40,7 +47,7 @@ namespace Falltergeist
 
         std::shared_ptr<Game::Object> GameObjectHelper::createFromMapObject(const std::unique_ptr<Format::Map::Object> &mapObject) const
         {
-            std::shared_ptr<Game::Object> object = Game::ObjectFactory::getInstance()->createObject(mapObject->PID());
+            std::shared_ptr<Game::Object> object = Game::ObjectFactory::getInstance()->createObject(mapObject->PID(), _arena);
             if (!object) {
                 Logger::error() << "Location::setLocation() - can't create object with PID: " << mapObject->PID() << std::endl;
                 return nullptr;
@@ -68,7 +75,7 @@ namespace Falltergeist
 
             if (auto container = std::dynamic_pointer_cast<Game::ContainerItemObject>(object)) {
                 for (auto &child : mapObject->children()) {
-                    auto item = std::dynamic_pointer_cast<Game::ItemObject>(Game::ObjectFactory::getInstance()->createObject(child->PID()));
+                    auto item = std::dynamic_pointer_cast<Game::ItemObject>(Game::ObjectFactory::getInstance()->createObject(child->PID(), _arena));
                     if (!item) {
                         Logger::error() << "Location::setLocation() - can't create object with PID: " << child->PID() << std::endl;
                         return nullptr;
@@ -82,7 +89,7 @@ namespace Falltergeist
             if (auto critter = std::dynamic_pointer_cast<Game::CritterObject>(object)) {
                 for (auto &child : mapObject->children()) {
                     auto item = std::dynamic_pointer_cast<Game::ItemObject>(Game::ObjectFactory::getInstance()->createObject(
-                            child->PID()));
+                            child->PID(), _arena));
                     if (!item) {
                         Logger::error() << "Location::setLocation() - can't create object with PID: "
                                         << child->PID() << std::endl;
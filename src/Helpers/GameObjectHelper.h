@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include "../Base/Arena.h"
 
 namespace Falltergeist
 {
@@ -21,9 +22,13 @@ namespace Falltergeist
         class GameObjectHelper
         {
             public:
-                GameObjectHelper() = default;
+                // Objects are placed in the given arena if there is one
+                explicit GameObjectHelper(Base::Arena* arena = nullptr);
                 std::shared_ptr<Game::Object> createFromMapObject(const std::unique_ptr<Falltergeist::Format::Map::Object> &mapObject) const;
                 std::shared_ptr<Game::Object> createFromMapSpatialScript(const Format::Map::Script& mapScript) const;
+
+            private:
+                Base::Arena* _arena;
         };
     }
 }
@@ -59,6 +59,15 @@ namespace Falltergeist
             SDL_WarpMouseInWindow(renderer->sdlWindow(), (int)(pos.x() * scaleX), (int)(pos.y() * scaleY));
         }
 
+        void Mouse::updatePosition(const Point& windowPos)
+        {
+            auto renderer = Game::getInstance()->renderer();
+            _position = Point(
+                static_cast<int>(windowPos.x() / renderer->scaleX()),
+                static_cast<int>(windowPos.y() / renderer->scaleY())
+            );
+        }
+
         void Mouse::setState(Cursor state)
         {
             _states.clear();
@@ -220,11 +229,6 @@ namespace Falltergeist
 
         void Mouse::think(const float &deltaTime)
         {
-            SDL_GetMouseState(&_position.rx(), &_position.ry());
-            _position = Point(
-                static_cast<int>(_position.x() / Game::getInstance()->renderer()->scaleX()),
-                static_cast<int>(_position.y() / Game::getInstance()->renderer()->scaleY())
-            );
             if (_ui) {
                 _ui->think(deltaTime);
             }
@@ -73,6 +73,10 @@ namespace Falltergeist
 
                 const Point& position() const;
                 void setPosition(const Point& pos);
+                /**
+                 * Updates cursor position from an input event (window coordinates) without warping the OS cursor.
+                 */
+                void updatePosition(const Point& windowPos);
 
                 void pushState(Cursor state);
                 void popState();
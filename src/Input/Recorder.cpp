@@ -0,0 +1,119 @@
+#include "../Event/Keyboard.h"
+#include "../Event/Mouse.h"
+#include "../Exception.h"
+#include "../Input/Recorder.h"
+#include "../Logger.h"
+
+namespace Falltergeist
+{
+    namespace Input
+    {
+        const char Recorder::MAGIC[4] = {'F', 'G', 'I', 'R'};
+        const uint8_t Recorder::VERSION = 1;
+
+        Recorder::Recorder(const std::string& filename, uint32_t seed, uint32_t stepsPerSecond)
+        {
+            _stream.open(filename, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+            if (!_stream.is_open()) {
+                throw Exception("Recorder::Recorder() - can't open input log for writing: " + filename);
+            }
+            Logger::info("INPUT") << "Recording input to " << filename << std::endl;
+            _writeHeader(seed, stepsPerSecond);
+        }
+
+        Recorder::~Recorder()
+        {
+            if (!_finished) {
+                finish(_lastStep);
+            }
+        }
+
+        void Recorder::record(uint32_t step, Event::Event* event)
+        {
+            if (auto mouse = dynamic_cast<Event::Mouse*>(event)) {
+                uint8_t modifiers = (mouse->shiftPressed() ? 1 : 0)
+                                  | (mouse->controlPressed() ? 2 : 0)
+                                  | (mouse->altPressed() ? 4 : 0);
+                switch (mouse->originalType()) {
+                    case Event::Mouse::Type::BUTTON_DOWN:
+                    case Event::Mouse::Type::BUTTON_UP:
+                        _writeRecord(mouse->originalType() == Event::Mouse::Type::BUTTON_DOWN ? Record::MOUSE_DOWN : Record::MOUSE_UP, step);
+                        _writeUint16(static_cast<uint16_t>(mouse->position().x()));
+                        _writeUint16(static_cast<uint16_t>(mouse->position().y()));
+                        _writeUint8(static_cast<uint8_t>(mouse->button()));
+                        _writeUint8(modifiers);
+                        break;
+                    case Event::Mouse::Type::MOVE:
+                        _writeRecord(Record::MOUSE_MOVE, step);
+                        _writeUint16(static_cast<uint16_t>(mouse->position().x()));
+                        _writeUint16(static_cast<uint16_t>(mouse->position().y()));
+                        _writeUint16(static_cast<uint16_t>(mouse->offset().x()));
+                        _writeUint16(static_cast<uint16_t>(mouse->offset().y()));
+                        break;
+                }
+                return;
+            }
+
+            if (auto keyboard = dynamic_cast<Event::Keyboard*>(event)) {
+                uint8_t modifiers = (keyboard->shiftPressed() ? 1 : 0)
+                                  | (keyboard->controlPressed() ? 2 : 0)
+                                  | (keyboard->altPressed() ? 4 : 0);
+                _writeRecord(keyboard->originalType() == Event::Keyboard::Type::KEY_DOWN ? Record::KEY_DOWN : Record::KEY_UP, step);
+                _writeUint32(static_cast<uint32_t>(keyboard->keyCode()));
+                _writeUint8(modifiers);
+            }
+        }
+
+        void Recorder::finish(uint32_t steps)
+        {
+            if (_finished) {
+                return;
+            }
+            _writeRecord(Record::END, steps);
+            _stream.flush();
+            _finished = true;
+        }
+
+        void Recorder::_writeHeader(uint32_t seed, uint32_t stepsPerSecond)
+        {
+            _stream.write(MAGIC, sizeof(MAGIC));
+            _writeUint8(VERSION);
+            _writeUint32(seed);
+            _writeUint16(static_cast<uint16_t>(stepsPerSecond));
+        }
+
+        void Recorder::_writeRecord(Record type, uint32_t step)
+        {
+            _writeUint8(static_cast<uint8_t>(type));
+            _writeVarint(step - _lastStep);
+            _lastStep = step;
+        }
+
+        void Recorder::_writeVarint(uint32_t value)
+        {
+            while (value >= 0x80) {
+                _writeUint8(static_cast<uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            _writeUint8(static_cast<uint8_t>(value));
+        }
+
+        void Recorder::_writeUint8(uint8_t value)
+        {
+            _stream.put(static_cast<char>(value));
+        }
+
+        // log is always little-endian
+        void Recorder::_writeUint16(uint16_t value)
+        {
+            _writeUint8(static_cast<uint8_t>(value & 0xFF));
+            _writeUint8(static_cast<uint8_t>(value >> 8));
+        }
+
+        void Recorder::_writeUint32(uint32_t value)
+        {
+            _writeUint16(static_cast<uint16_t>(value & 0xFFFF));
+            _writeUint16(static_cast<uint16_t>(value >> 16));
+        }
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+namespace Falltergeist
+{
+    namespace Event
+    {
+        class Event;
+    }
+    namespace Input
+    {
+        /**
+         * Writes translated input events (Event::Mouse / Event::Keyboard) to a compact binary log.
+         *
+         * Layout: header ("FGIR", version, RNG seed, simulation rate) followed by records. Each record is
+         * a type byte, the simulation step it happened at (varint delta from the previous record) and the
+         * event payload. The log is terminated with an END record holding the total number of steps.
+         */
+        class Recorder final
+        {
+            public:
+                enum class Record : uint8_t
+                {
+                    MOUSE_DOWN = 1,
+                    MOUSE_UP,
+                    MOUSE_MOVE,
+                    KEY_DOWN,
+                    KEY_UP,
+                    END = 0xFF
+                };
+
+                static const char MAGIC[4];
+                static const uint8_t VERSION;
+
+                Recorder(const std::string& filename, uint32_t seed, uint32_t stepsPerSecond);
+                ~Recorder();
+
+                void record(uint32_t step, Event::Event* event);
+                void finish(uint32_t steps);
+
+            private:
+                std::ofstream _stream;
+                uint32_t _lastStep = 0;
+                bool _finished = false;
+
+                void _writeHeader(uint32_t seed, uint32_t stepsPerSecond);
+                void _writeRecord(Record type, uint32_t step);
+                void _writeVarint(uint32_t value);
+                void _writeUint8(uint8_t value);
+                void _writeUint16(uint16_t value);
+                void _writeUint32(uint32_t value);
+        };
+    }
+}
@@ -0,0 +1,164 @@
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include "../Event/Keyboard.h"
+#include "../Event/Mouse.h"
+#include "../Exception.h"
+#include "../Input/Recorder.h"
+#include "../Input/Replayer.h"
+#include "../Logger.h"
+
+namespace Falltergeist
+{
+    namespace Input
+    {
+        using Record = Recorder::Record;
+
+        Replayer::Replayer(const std::string& filename)
+        {
+            std::ifstream stream(filename, std::ios_base::in | std::ios_base::binary);
+            if (!stream.is_open()) {
+                throw Exception("Replayer::Replayer() - can't open input log: " + filename);
+            }
+            _data.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+
+            if (_data.size() < sizeof(Recorder::MAGIC) + 1 || std::memcmp(_data.data(), Recorder::MAGIC, sizeof(Recorder::MAGIC)) != 0) {
+                throw Exception("Replayer::Replayer() - not an input log: " + filename);
+            }
+            _position = sizeof(Recorder::MAGIC);
+            uint8_t version = _readUint8();
+            if (version != Recorder::VERSION) {
+                throw Exception("Replayer::Replayer() - unsupported input log version: " + std::to_string(version));
+            }
+            _seed = _readUint32();
+            _stepsPerSecond = _readUint16();
+
+            Logger::info("INPUT") << "Replaying input from " << filename << ", seed " << _seed << std::endl;
+            _readRecordStep();
+        }
+
+        uint32_t Replayer::seed() const
+        {
+            return _seed;
+        }
+
+        uint32_t Replayer::stepsPerSecond() const
+        {
+            return _stepsPerSecond;
+        }
+
+        std::unique_ptr<Event::Event> Replayer::next(uint32_t step)
+        {
+            using Mouse = Event::Mouse;
+            using Keyboard = Event::Keyboard;
+
+            if (_ended || _nextStep > step) {
+                return nullptr;
+            }
+
+            std::unique_ptr<Event::Event> event;
+            auto type = static_cast<Record>(_nextType);
+            switch (type) {
+                case Record::MOUSE_DOWN:
+                case Record::MOUSE_UP:
+                {
+                    auto mouseEvent = std::make_unique<Mouse>(type == Record::MOUSE_DOWN ? Mouse::Type::BUTTON_DOWN : Mouse::Type::BUTTON_UP);
+                    int x = static_cast<int16_t>(_readUint16());
+                    int y = static_cast<int16_t>(_readUint16());
+                    mouseEvent->setPosition({x, y});
+                    mouseEvent->setButton(static_cast<Mouse::Button>(_readUint8()));
+                    uint8_t modifiers = _readUint8();
+                    mouseEvent->setShiftPressed(modifiers & 1);
+                    mouseEvent->setControlPressed(modifiers & 2);
+                    mouseEvent->setAltPressed(modifiers & 4);
+                    event = std::move(mouseEvent);
+                    break;
+                }
+                case Record::MOUSE_MOVE:
+                {
+                    auto mouseEvent = std::make_unique<Mouse>(Mouse::Type::MOVE);
+                    int x = static_cast<int16_t>(_readUint16());
+                    int y = static_cast<int16_t>(_readUint16());
+                    int xrel = static_cast<int16_t>(_readUint16());
+                    int yrel = static_cast<int16_t>(_readUint16());
+                    mouseEvent->setPosition({x, y});
+                    mouseEvent->setOffset({xrel, yrel});
+                    event = std::move(mouseEvent);
+                    break;
+                }
+                case Record::KEY_DOWN:
+                case Record::KEY_UP:
+                {
+                    auto keyboardEvent = std::make_unique<Keyboard>(type == Record::KEY_DOWN ? Keyboard::Type::KEY_DOWN : Keyboard::Type::KEY_UP);
+                    keyboardEvent->setKeyCode(static_cast<int32_t>(_readUint32()));
+                    uint8_t modifiers = _readUint8();
+                    keyboardEvent->setShiftPressed(modifiers & 1);
+                    keyboardEvent->setControlPressed(modifiers & 2);
+                    keyboardEvent->setAltPressed(modifiers & 4);
+                    event = std::move(keyboardEvent);
+                    break;
+                }
+                default:
+                    throw Exception("Replayer::next() - unknown record type: " + std::to_string(static_cast<int>(type)));
+            }
+
+            _readRecordStep();
+            return event;
+        }
+
+        bool Replayer::finished(uint32_t step) const
+        {
+            return _ended && step >= _nextStep;
+        }
+
+        // reads header of the next record, payload is read by next() once its step comes
+        void Replayer::_readRecordStep()
+        {
+            if (_position >= _data.size()) {
+                // truncated log (e.g. game crashed while recording), treat as the end
+                _ended = true;
+                return;
+            }
+            _nextType = _readUint8();
+            _nextStep += _readVarint();
+            if (static_cast<Record>(_nextType) == Record::END) {
+                _ended = true;
+            }
+        }
+
+        uint8_t Replayer::_readUint8()
+        {
+            if (_position >= _data.size()) {
+                throw Exception("Replayer - unexpected end of input log");
+            }
+            return _data[_position++];
+        }
+
+        uint16_t Replayer::_readUint16()
+        {
+            uint16_t low = _readUint8();
+            uint16_t high = _readUint8();
+            return static_cast<uint16_t>(low | (high << 8));
+        }
+
+        uint32_t Replayer::_readUint32()
+        {
+            uint32_t low = _readUint16();
+            uint32_t high = _readUint16();
+            return low | (high << 16);
+        }
+
+        uint32_t Replayer::_readVarint()
+        {
+            uint32_t value = 0;
+            for (uint32_t shift = 0; shift < 32; shift += 7) {
+                uint8_t byte = _readUint8();
+                value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) {
+                    break;
+                }
+            }
+            return value;
+        }
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Falltergeist
+{
+    namespace Event
+    {
+        class Event;
+    }
+    namespace Input
+    {
+        /**
+         * Reads an input log written by Input::Recorder and hands recorded events back
+         * at the same simulation steps they were originally captured at.
+         */
+        class Replayer final
+        {
+            public:
+                explicit Replayer(const std::string& filename);
+
+                uint32_t seed() const;
+                uint32_t stepsPerSecond() const;
+
+                /**
+                 * Returns next recorded event scheduled at or before given simulation step, or nullptr if there is none.
+                 */
+                std::unique_ptr<Event::Event> next(uint32_t step);
+
+                /**
+                 * Whether all recorded events were replayed and the recording is over at given step.
+                 */
+                bool finished(uint32_t step) const;
+
+            private:
+                std::vector<uint8_t> _data;
+                size_t _position = 0;
+                uint32_t _seed = 0;
+                uint32_t _stepsPerSecond = 0;
+                // header of the record whose payload starts at _position
+                uint8_t _nextType = 0;
+                uint32_t _nextStep = 0;
+                bool _ended = false;
+
+                void _readRecordStep();
+                uint8_t _readUint8();
+                uint16_t _readUint16();
+                uint32_t _readUint32();
+                uint32_t _readVarint();
+        };
+    }
+}
@@ -0,0 +1,334 @@
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include "../PathFinding/ClusterGraph.h"
+#include "../PathFinding/Hexagon.h"
+
+namespace Falltergeist
+{
+    const unsigned int ClusterGraph::CLUSTER_SIZE;
+    const unsigned int ClusterGraph::CLUSTERS_X;
+    const unsigned int ClusterGraph::CLUSTERS_Y;
+    const unsigned int ClusterGraph::CLUSTER_HEXAGONS;
+    const unsigned int ClusterGraph::UNREACHABLE;
+
+    ClusterGraph::ClusterGraph(HexagonGrid* grid) : _grid(grid)
+    {
+    }
+
+    void ClusterGraph::invalidate(Hexagon* hexagon)
+    {
+        if (!hexagon) {
+            return;
+        }
+        _clusters[_clusterOf(hexagon->number())].dirty = true;
+        _dirty = true;
+    }
+
+    void ClusterGraph::update()
+    {
+        if (!_dirty) {
+            return;
+        }
+
+        // entrances on the border with a changed cluster may have changed too
+        std::vector<bool> affected(_clusters.size(), false);
+        for (unsigned int cluster = 0; cluster != _clusters.size(); ++cluster) {
+            if (!_clusters[cluster].dirty) {
+                continue;
+            }
+            affected[cluster] = true;
+            for (unsigned int neighbor : _neighborClusters(cluster)) {
+                affected[neighbor] = true;
+            }
+        }
+
+        for (unsigned int cluster = 0; cluster != _clusters.size(); ++cluster) {
+            if (affected[cluster]) {
+                _rebuild(cluster);
+            }
+        }
+        _dirty = false;
+    }
+
+    std::vector<Hexagon*> ClusterGraph::route(Hexagon* from, Hexagon* to)
+    {
+        update();
+
+        const unsigned int START = GRID_WIDTH * GRID_HEIGHT;
+        const unsigned int GOAL = START + 1;
+        const unsigned int start = from->number();
+        const unsigned int goal = to->number();
+        const unsigned int startCluster = _clusterOf(start);
+        const unsigned int goalCluster = _clusterOf(goal);
+
+        // walking is symmetric, so distances from the goal are distances to it
+        const Distances fromStart = _distancesInCluster(start, _walkable(startCluster));
+        const Distances toGoal = _distancesInCluster(goal, _walkable(goalCluster));
+
+        std::unordered_map<unsigned int, unsigned int> costSoFar;
+        std::unordered_map<unsigned int, unsigned int> cameFrom;
+        // (estimated route cost, node)
+        using Entry = std::pair<unsigned int, unsigned int>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> unvisited;
+        unsigned int goalCost = UNREACHABLE;
+        unsigned int goalCameFrom = START;
+
+        auto heuristic = [this, to](unsigned int node) {
+            return _grid->distance(_grid->at(node).get(), to);
+        };
+        auto reach = [&](unsigned int node, unsigned int cost, unsigned int previous) {
+            auto it = costSoFar.find(node);
+            if (it == costSoFar.end() || cost < it->second) {
+                costSoFar[node] = cost;
+                cameFrom[node] = previous;
+                unvisited.emplace(cost + heuristic(node), node);
+            }
+        };
+        auto reachGoal = [&](unsigned int cost, unsigned int previous) {
+            if (cost < goalCost) {
+                goalCost = cost;
+                goalCameFrom = previous;
+                unvisited.emplace(cost, GOAL);
+            }
+        };
+
+        // start hexagon is usually taken by whoever is walking, so it is connected separately from the graph
+        if (startCluster == goalCluster && fromStart[_localIndex(goal)] != UNREACHABLE) {
+            reachGoal(fromStart[_localIndex(goal)], START);
+        }
+        for (unsigned int node : _clusters[startCluster].nodes) {
+            if (fromStart[_localIndex(node)] != UNREACHABLE) {
+                reach(node, fromStart[_localIndex(node)], START);
+            }
+        }
+        for (Hexagon* neighbor : from->neighbors()) {
+            if (!neighbor || _clusterOf(neighbor->number()) == startCluster) {
+                continue;
+            }
+            if (neighbor == to) {
+                reachGoal(1, START);
+            } else if (_edges(neighbor->number())) {
+                reach(neighbor->number(), 1, START);
+            }
+        }
+
+        while (!unvisited.empty()) {
+            Entry entry = unvisited.top();
+            unvisited.pop();
+            unsigned int node = entry.second;
+            if (node == GOAL) {
+                break;
+            }
+
+            unsigned int cost = costSoFar[node];
+            // outdated entry, the node was reached cheaper later
+            if (entry.first > cost + heuristic(node)) {
+                continue;
+            }
+
+            if (_clusterOf(node) == goalCluster && toGoal[_localIndex(node)] != UNREACHABLE) {
+                reachGoal(cost + toGoal[_localIndex(node)], node);
+            }
+            for (Hexagon* neighbor : _grid->at(node)->neighbors()) {
+                if (neighbor == to) {
+                    reachGoal(cost + 1, node);
+                }
+            }
+            if (auto edges = _edges(node)) {
+                for (const Edge& edge : *edges) {
+                    reach(edge.to, cost + edge.cost, node);
+                }
+            }
+        }
+
+        std::vector<Hexagon*> result;
+        if (goalCost == UNREACHABLE) {
+            return result;
+        }
+
+        result.push_back(to);
+        for (unsigned int node = goalCameFrom; node != START; node = cameFrom[node]) {
+            if (node != result.back()->number()) {
+                result.push_back(_grid->at(node).get());
+            }
+        }
+        if (result.back() != from) {
+            result.push_back(from);
+        }
+        std::reverse(result.begin(), result.end());
+        return result;
+    }
+
+    unsigned int ClusterGraph::_clusterOf(unsigned int hexagon)
+    {
+        return (hexagon / GRID_WIDTH / CLUSTER_SIZE) * CLUSTERS_X + (hexagon % GRID_WIDTH) / CLUSTER_SIZE;
+    }
+
+    unsigned int ClusterGraph::_localIndex(unsigned int hexagon)
+    {
+        return (hexagon / GRID_WIDTH % CLUSTER_SIZE) * CLUSTER_SIZE + hexagon % GRID_WIDTH % CLUSTER_SIZE;
+    }
+
+    unsigned int ClusterGraph::_hexagonAt(unsigned int cluster, unsigned int localIndex)
+    {
+        unsigned int y = (cluster / CLUSTERS_X) * CLUSTER_SIZE + localIndex / CLUSTER_SIZE;
+        unsigned int x = (cluster % CLUSTERS_X) * CLUSTER_SIZE + localIndex % CLUSTER_SIZE;
+        return y * GRID_WIDTH + x;
+    }
+
+    std::vector<unsigned int> ClusterGraph::_neighborClusters(unsigned int cluster) const
+    {
+        // hexagons at the corners have neighbors in diagonal clusters too
+        std::vector<unsigned int> result;
+        int x = cluster % CLUSTERS_X;
+        int y = cluster / CLUSTERS_X;
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                if ((dx || dy)
+                    && x + dx >= 0 && x + dx < static_cast<int>(CLUSTERS_X)
+                    && y + dy >= 0 && y + dy < static_cast<int>(CLUSTERS_Y)
+                ) {
+                    result.push_back((y + dy) * CLUSTERS_X + x + dx);
+                }
+            }
+        }
+        return result;
+    }
+
+    std::vector<std::pair<unsigned int, unsigned int>> ClusterGraph::_entrances(unsigned int first, unsigned int second) const
+    {
+        std::vector<std::pair<unsigned int, unsigned int>> result;
+        // crossings of the current run of adjacent border hexagons
+        std::vector<std::pair<unsigned int, unsigned int>> run;
+        Hexagon* last = nullptr;
+
+        auto closeRun = [&result, &run]() {
+            if (!run.empty()) {
+                result.push_back(run[run.size() / 2]);
+                run.clear();
+            }
+        };
+
+        for (unsigned int i = 0; i != CLUSTER_HEXAGONS; ++i) {
+            Hexagon* hexagon = _grid->at(_hexagonAt(first, i)).get();
+            bool border = false;
+            Hexagon* crossing = nullptr;
+            for (Hexagon* neighbor : hexagon->neighbors()) {
+                if (neighbor && _clusterOf(neighbor->number()) == second) {
+                    border = true;
+                    if (!crossing && neighbor->canWalkThru()) {
+                        crossing = neighbor;
+                    }
+                }
+            }
+            if (!border) {
+                continue;
+            }
+            if (!crossing || !hexagon->canWalkThru()) {
+                // blocked hexagon splits the run
+                closeRun();
+                last = nullptr;
+                continue;
+            }
+            if (last && std::find(last->neighbors().begin(), last->neighbors().end(), hexagon) == last->neighbors().end()) {
+                closeRun();
+            }
+            run.emplace_back(hexagon->number(), crossing->number());
+            last = hexagon;
+        }
+        closeRun();
+        return result;
+    }
+
+    void ClusterGraph::_rebuild(unsigned int cluster)
+    {
+        // (hexagon inside of the cluster, hexagon of the neighbor cluster)
+        std::vector<std::pair<unsigned int, unsigned int>> crossings;
+        for (unsigned int neighbor : _neighborClusters(cluster)) {
+            // both sides of the border must agree on the entrances, so they are always found in the same direction
+            if (cluster < neighbor) {
+                for (const auto& entrance : _entrances(cluster, neighbor)) {
+                    crossings.emplace_back(entrance.first, entrance.second);
+                }
+            } else {
+                for (const auto& entrance : _entrances(neighbor, cluster)) {
+                    crossings.emplace_back(entrance.second, entrance.first);
+                }
+            }
+        }
+
+        Cluster& data = _clusters[cluster];
+        data.nodes.clear();
+        for (const auto& crossing : crossings) {
+            data.nodes.push_back(crossing.first);
+        }
+        std::sort(data.nodes.begin(), data.nodes.end());
+        data.nodes.erase(std::unique(data.nodes.begin(), data.nodes.end()), data.nodes.end());
+
+        data.edges.assign(data.nodes.size(), std::vector<Edge>());
+        for (const auto& crossing : crossings) {
+            auto index = std::lower_bound(data.nodes.begin(), data.nodes.end(), crossing.first) - data.nodes.begin();
+            data.edges[index].push_back({crossing.second, 1});
+        }
+
+        const Walkable walkable = _walkable(cluster);
+        for (size_t i = 0; i != data.nodes.size(); ++i) {
+            const Distances distances = _distancesInCluster(data.nodes[i], walkable);
+            for (size_t j = 0; j != data.nodes.size(); ++j) {
+                unsigned int distance = distances[_localIndex(data.nodes[j])];
+                if (i != j && distance != UNREACHABLE) {
+                    data.edges[i].push_back({data.nodes[j], distance});
+                }
+            }
+        }
+        data.dirty = false;
+    }
+
+    ClusterGraph::Walkable ClusterGraph::_walkable(unsigned int cluster) const
+    {
+        Walkable result;
+        for (unsigned int i = 0; i != CLUSTER_HEXAGONS; ++i) {
+            result[i] = _grid->at(_hexagonAt(cluster, i))->canWalkThru();
+        }
+        return result;
+    }
+
+    ClusterGraph::Distances ClusterGraph::_distancesInCluster(unsigned int from, const Walkable& walkable) const
+    {
+        const unsigned int cluster = _clusterOf(from);
+        Distances result;
+        result.fill(UNREACHABLE);
+
+        // breadth-first search, every step costs the same
+        std::array<unsigned int, CLUSTER_HEXAGONS> queue;
+        size_t head = 0, tail = 0;
+        result[_localIndex(from)] = 0;
+        queue[tail++] = from;
+        while (head != tail) {
+            unsigned int current = queue[head++];
+            for (Hexagon* neighbor : _grid->at(current)->neighbors()) {
+                if (!neighbor || _clusterOf(neighbor->number()) != cluster) {
+                    continue;
+                }
+                unsigned int local = _localIndex(neighbor->number());
+                if (walkable[local] && result[local] == UNREACHABLE) {
+                    result[local] = result[_localIndex(current)] + 1;
+                    queue[tail++] = neighbor->number();
+                }
+            }
+        }
+        return result;
+    }
+
+    const std::vector<ClusterGraph::Edge>* ClusterGraph::_edges(unsigned int node) const
+    {
+        const Cluster& cluster = _clusters[_clusterOf(node)];
+        auto it = std::lower_bound(cluster.nodes.begin(), cluster.nodes.end(), node);
+        if (it == cluster.nodes.end() || *it != node) {
+            return nullptr;
+        }
+        return &cluster.edges[it - cluster.nodes.begin()];
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <array>
+#include <utility>
+#include <vector>
+#include "../PathFinding/HexagonGrid.h"
+
+namespace Falltergeist
+{
+    class Hexagon;
+
+    /**
+     * Abstract graph over the hexagonal grid, used to plan long routes (hierarchical pathfinding, HPA*).
+     * The grid is split into square clusters. Each run of walkable hexagons along the border of two clusters
+     * gets one entrance: a pair of hexagons, one on each side. Entrances of a cluster are connected with
+     * their walking distance inside of it.
+     * A route is planned over entrances first, then HexagonGrid refines it hexagon by hexagon.
+     */
+    class ClusterGraph
+    {
+        public:
+            static const unsigned int CLUSTER_SIZE = 10;
+            static const unsigned int CLUSTERS_X = GRID_WIDTH / CLUSTER_SIZE;
+            static const unsigned int CLUSTERS_Y = GRID_HEIGHT / CLUSTER_SIZE;
+
+            explicit ClusterGraph(HexagonGrid* grid);
+
+            // Marks cluster of given hexagon to be rebuilt, as something blocking appeared or disappeared there.
+            void invalidate(Hexagon* hexagon);
+
+            // Rebuilds invalidated clusters and their neighbors.
+            void update();
+
+            /**
+             * Plans route over cluster entrances.
+             * @return hexagons to pass through, starting with from and ending with to; empty if there is no route
+             */
+            std::vector<Hexagon*> route(Hexagon* from, Hexagon* to);
+
+        private:
+            struct Edge
+            {
+                unsigned int to; // hexagon number
+                unsigned int cost;
+            };
+
+            struct Cluster
+            {
+                std::vector<unsigned int> nodes; // hexagon numbers of entrances, sorted
+                std::vector<std::vector<Edge>> edges; // for each node
+                bool dirty = true;
+            };
+
+            static const unsigned int CLUSTER_HEXAGONS = CLUSTER_SIZE * CLUSTER_SIZE;
+            static const unsigned int UNREACHABLE = static_cast<unsigned int>(-1);
+
+            // indexed by _localIndex()
+            using Walkable = std::array<bool, CLUSTER_HEXAGONS>;
+            using Distances = std::array<unsigned int, CLUSTER_HEXAGONS>;
+
+            HexagonGrid* _grid;
+            std::array<Cluster, CLUSTERS_X * CLUSTERS_Y> _clusters;
+            bool _dirty = true;
+
+            static unsigned int _clusterOf(unsigned int hexagon);
+            static unsigned int _localIndex(unsigned int hexagon);
+            static unsigned int _hexagonAt(unsigned int cluster, unsigned int localIndex);
+            std::vector<unsigned int> _neighborClusters(unsigned int cluster) const;
+
+            // entrances between two clusters, each as a pair of hexagons on the first and on the second cluster's side
+            std::vector<std::pair<unsigned int, unsigned int>> _entrances(unsigned int first, unsigned int second) const;
+            void _rebuild(unsigned int cluster);
+
+            Walkable _walkable(unsigned int cluster) const;
+
+            // distances from a hexagon to other hexagons of its cluster, walking inside of it
+            Distances _distancesInCluster(unsigned int from, const Walkable& walkable) const;
+            const std::vector<Edge>* _edges(unsigned int node) const;
+    };
+}
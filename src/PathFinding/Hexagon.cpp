@@ -1,5 +1,6 @@
 #include <cmath>
 #include "../Game/DoorSceneryObject.h"
+#include "../Game/ObjectRegistry.h"
 #include "../PathFinding/Hexagon.h"
 
 namespace Falltergeist
@@ -15,7 +16,7 @@ namespace Falltergeist
         return _neighbors;
     }
 
-    std::list<std::shared_ptr<Game::Object>>* Hexagon::objects()
+    std::vector<Game::ObjectHandle>* Hexagon::objects()
     {
         return &_objects;
     }
@@ -33,8 +34,10 @@ namespace Falltergeist
     bool Hexagon::canWalkThru()
     {
         // Search hex for any blocking objects...
-        for (const std::shared_ptr<Game::Object> &object : _objects) {
-            if (!object->canWalkThru()) {
+        auto registry = Game::ObjectRegistry::getInstance();
+        for (Game::ObjectHandle handle : _objects) {
+            auto object = registry->get(handle);
+            if (object && !object->canWalkThru()) {
                 return false;
             }
         }
@@ -1,8 +1,9 @@
 #pragma once
 
 #include <array>
-#include <list>
+#include <vector>
 #include "../Game/Object.h"
+#include "../Game/ObjectHandle.h"
 #include "../Graphics/Point.h"
 
 #define HEX_SIDES 6
@@ -86,13 +87,14 @@ namespace Falltergeist
 
             std::array<Hexagon*, HEX_SIDES>& neighbors();
 
-            std::list<std::shared_ptr<Game::Object>>* objects();
+            // objects at this hexagon, owned by the location; resolve with Game::ObjectRegistry
+            std::vector<Game::ObjectHandle>* objects();
 
             Game::Orientation orientationTo(const std::shared_ptr<Hexagon> &hexagon);
 
         protected:
             std::array<Hexagon*, HEX_SIDES> _neighbors = {};
-            std::list<std::shared_ptr<Game::Object>> _objects;
+            std::vector<Game::ObjectHandle> _objects;
             unsigned int _number = 0; // position in hexagonal grid
 
             Point _position;
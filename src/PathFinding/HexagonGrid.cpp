@@ -1,9 +1,11 @@
+#include <algorithm>
 #include <array>
 #include <cstdlib>
 #include <functional>
-#include <queue>
 #include <memory>
+#include "../Game/ObjectRegistry.h"
 #include "../Game/WallObject.h"
+#include "../PathFinding/ClusterGraph.h"
 #include "../PathFinding/Hexagon.h"
 #include "../PathFinding/HexagonGrid.h"
 
@@ -25,12 +27,18 @@ namespace Falltergeist
         const unsigned int xMod = HEX_WIDTH / 2;  // x offset
         const unsigned int yMod = HEX_HEIGHT / 2; // y offset
 
+        // One allocation for the whole grid instead of one per hexagon
+        _storage = std::shared_ptr<Hexagon>(new Hexagon[GRID_WIDTH * GRID_HEIGHT], std::default_delete<Hexagon[]>());
+        _hexagons.reserve(GRID_WIDTH * GRID_HEIGHT);
+        _searchNodes.resize(GRID_WIDTH * GRID_HEIGHT);
+
         for (unsigned int hy = 0; hy != GRID_HEIGHT; ++hy) // rows
         {
             for (unsigned int hx = 0; hx != GRID_WIDTH; ++hx, ++index) // columns
             {
-                _hexagons.emplace_back(std::make_shared<Hexagon>(index));
+                _hexagons.emplace_back(_storage, _storage.get() + index);
                 auto& hexagon = _hexagons.back();
+                hexagon->setNumber(index);
                 // Calculate hex's actual position
                 const bool oddCol = hx & 1;
                 const int  oddMod = hy + 1;
@@ -93,6 +101,8 @@ namespace Falltergeist
             if (indexTopRight < gridSize)
                 neighbor[5] = _hexagons.at(indexTopRight).get();
         }
+
+        _clusters = std::make_unique<ClusterGraph>(this);
     }
 
     HexagonGrid::~HexagonGrid() {}
@@ -125,28 +135,82 @@ namespace Falltergeist
 
     HexagonGrid::HexagonVector HexagonGrid::findPath(Hexagon* from, Hexagon* to)
     {
-        Hexagon* current = nullptr;
         HexagonVector result;
-        std::priority_queue<Hexagon*, std::vector<Hexagon*>, HeuristicComparison> unvisited;
-        unsigned int cameFrom[GRID_HEIGHT * GRID_WIDTH]  = {};
-        unsigned int costSoFar[GRID_HEIGHT * GRID_WIDTH] = {};
 
         // if we can't go to the location
-        // @todo remove when path will have length restriction
         if (!to->canWalkThru()) return result;
 
-        unvisited.push(from);
+        // short walks are searched right away, long ones are planned over clusters first
+        if (distance(from, to) <= ClusterGraph::CLUSTER_SIZE)
+        {
+            result = _findPath(from, to, SEARCH_LIMIT);
+            if (!result.empty()) return result;
+        }
+
+        std::vector<Hexagon*> waypoints = _clusters->route(from, to);
+        if (waypoints.empty()) return result;
+
+        // path goes backwards, so legs between waypoints are added starting from the last one
+        for (size_t i = waypoints.size() - 1; i != 0; --i)
+        {
+            Hexagon* legFrom = waypoints[i - 1];
+            Hexagon* legTo = waypoints[i];
+            auto& neighbors = legFrom->neighbors();
+            if (std::find(neighbors.begin(), neighbors.end(), legTo) != neighbors.end())
+            {
+                result.push_back(_hexagons.at(legTo->number()));
+                continue;
+            }
+
+            // waypoints inside of one cluster are never farther apart than the search limit
+            HexagonVector leg = _findPath(legFrom, legTo, SEARCH_LIMIT);
+            if (leg.empty()) return HexagonVector();
+            result.insert(result.end(), leg.begin(), leg.end());
+        }
+        return result;
+    }
+
+    void HexagonGrid::invalidate(Hexagon* hexagon)
+    {
+        _clusters->invalidate(hexagon);
+    }
+
+    void HexagonGrid::updateClusters()
+    {
+        _clusters->update();
+    }
+
+    HexagonGrid::HexagonVector HexagonGrid::_findPath(Hexagon* from, Hexagon* to, unsigned int costLimit)
+    {
+        Hexagon* current = nullptr;
+        HexagonVector result;
+        HeuristicComparison comparison;
 
-        cameFrom[from->number()]  = 0;
-        costSoFar[from->number()] = 0;
+        // nodes of previous searches become stale all at once
+        if (++_searchGeneration == 0)
+        {
+            for (auto& node : _searchNodes)
+            {
+                node.generation = 0;
+            }
+            _searchGeneration = 1;
+        }
 
+        _unvisited.clear();
+        _unvisited.push_back(from);
+        _searchNodes[from->number()].cameFrom = from->number();
+        _searchNodes[from->number()].cost = 0;
+        _searchNodes[from->number()].generation = _searchGeneration;
 
-        while (!unvisited.empty())
+        while (!_unvisited.empty())
         {
-            current = unvisited.top(); unvisited.pop();
+            std::pop_heap(_unvisited.begin(), _unvisited.end(), comparison);
+            current = _unvisited.back();
+            _unvisited.pop_back();
             if (current == to) break;
+            const unsigned int currentCost = _searchNodes[current->number()].cost;
             // search limit
-            if (costSoFar[current->number()] >= 100) break;
+            if (currentCost >= costLimit) break;
 
             std::array<Hexagon*, HEX_SIDES>& neighbor = current->neighbors();
             // look to each adjacent hex...
@@ -158,20 +222,23 @@ namespace Falltergeist
                 if (!neighbor[i]->canWalkThru()) continue;
 
                 // This hex is a viable path. But is it the shortest?
-                auto &neighborCost   = costSoFar[neighbor[i]->number()];
-                unsigned int newCost = costSoFar[current->number()] + 1;
+                SearchNode& node = _searchNodes[neighbor[i]->number()];
+                unsigned int newCost = currentCost + 1;
 
-                if (neighborCost == 0 || newCost < neighborCost)
+                if (node.generation != _searchGeneration)
                 {
                     // add hexagon to unvisited queue only once and don't change heuristic
-                    if (neighborCost == 0)
-                    {
-                        neighbor[i]->setHeuristic(distance(neighbor[i], to) + newCost);
-                        unvisited.push(neighbor[i]);
-                    }
-                    neighborCost = newCost;
-                    cameFrom[neighbor[i]->number()] = current->number();
+                    neighbor[i]->setHeuristic(distance(neighbor[i], to) + newCost);
+                    _unvisited.push_back(neighbor[i]);
+                    std::push_heap(_unvisited.begin(), _unvisited.end(), comparison);
+                    node.generation = _searchGeneration;
+                }
+                else if (newCost >= node.cost)
+                {
+                    continue;
                 }
+                node.cost = newCost;
+                node.cameFrom = current->number();
             }
         }
 
@@ -181,8 +248,8 @@ namespace Falltergeist
 
         while (current->number() != from->number())
         {
-            result.push_back(std::make_shared<Hexagon>(*current));
-            current = _hexagons.at(cameFrom[current->number()]).get();
+            result.push_back(_hexagons.at(current->number()));
+            current = _hexagons.at(_searchNodes[current->number()].cameFrom).get();
         }
 
         return result;
@@ -274,10 +341,11 @@ namespace Falltergeist
 
     void HexagonGrid::initLight(Hexagon *hex, bool add) const
     {
-//        for (auto it = objectsAtHex->begin(); it != objectsAtHex->end(); ++it)
-        for (const std::shared_ptr<Game::Object> &object : *hex->objects())
+        auto registry = Game::ObjectRegistry::getInstance();
+        for (Game::ObjectHandle handle : *hex->objects())
         {
-            if (object->lightIntensity()>0 && object->lightRadius()>0)
+            auto object = registry->get(handle);
+            if (object && object->lightIntensity()>0 && object->lightRadius()>0)
             {
                 // 36 hexes per direction
                 std::array<bool, 36*6> blocked;
@@ -575,9 +643,10 @@ namespace Falltergeist
                         {
                             // find objs/walls
                             bool lightHex = true;
-                            for (auto it2 = ringhex->objects()->begin(); it2 != ringhex->objects()->end(); ++it2)
+                            for (Game::ObjectHandle curHandle : *ringhex->objects())
                             {
-                                auto curObject = *it2;
+                                auto curObject = registry->get(curHandle);
+                                if (!curObject) continue;
                                 // dead objects block nothing
                                 //if (curObject->dead()) continue;
                                 // flat objects block nothing
@@ -587,7 +656,7 @@ namespace Falltergeist
                                 if (!curObject->canLightThru())
                                 {
                                     // if wall -> check light orientation
-                                    if (auto wall = std::dynamic_pointer_cast<Game::WallObject>(curObject))
+                                    if (auto wall = dynamic_cast<Game::WallObject*>(curObject))
                                     {
                                         if (wall->lightOrientation() == Game::Orientation::EW || wall->lightOrientation() == Game::Orientation::EC)
                                         {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <memory>
 #include <vector>
 #include "../Base/Iterators.h"
 #include "../Graphics/Point.h"
@@ -10,6 +11,7 @@
 
 namespace Falltergeist
 {
+    class ClusterGraph;
     class Hexagon;
 
     class HexagonGrid
@@ -24,12 +26,36 @@ namespace Falltergeist
             unsigned int distance(Hexagon *from, Hexagon *to);
             std::shared_ptr<Hexagon> hexagonAt(const Graphics::Point& pos);
             const std::shared_ptr<Falltergeist::Hexagon> &at(size_t index) const;
+            // Returns path from the destination back to the first step, excluding the starting hexagon. Empty if there is none.
             HexagonVector findPath(Hexagon* from, Hexagon* to);
+            // Marks hexagon whose objects changed their blocking, so long routes are planned around it.
+            void invalidate(Hexagon* hexagon);
+            // Rebuilds route planning data for invalidated hexagons. Done by findPath() anyway; called once the map is loaded.
+            void updateClusters();
             Hexagon *hexInDirection(Falltergeist::Hexagon *from, unsigned short rotation, unsigned int distance) const;
             std::vector<Hexagon*> ring(Hexagon *from, unsigned int radius) const;
             void initLight(Falltergeist::Hexagon *hex, bool add = true) const;
 
         protected:
-            HexagonVector _hexagons; // The 200x200 grid
+            // routes to hexagons no farther than this are searched hexagon by hexagon right away
+            static const unsigned int SEARCH_LIMIT = 100;
+
+            HexagonVector _hexagons; // The 200x200 grid, pointers into _storage
+            std::shared_ptr<Hexagon> _storage; // all hexagons in one block, shared by the pointers above
+            std::unique_ptr<ClusterGraph> _clusters;
+
+            // Scratch data of _findPath(), reused by every search. A node belongs to the current search only if its
+            // generation matches _searchGeneration, so nothing has to be cleared between searches.
+            struct SearchNode
+            {
+                unsigned int cameFrom = 0;
+                unsigned int cost = 0;
+                unsigned int generation = 0;
+            };
+            std::vector<SearchNode> _searchNodes; // by hexagon number
+            unsigned int _searchGeneration = 0;
+            std::vector<Hexagon*> _unvisited; // heap ordered by heuristic
+
+            HexagonVector _findPath(Hexagon* from, Hexagon* to, unsigned int costLimit);
     };
 }
@@ -0,0 +1,195 @@
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <SDL.h>
+#include "Logger.h"
+#include "Profiler.h"
+
+namespace Falltergeist
+{
+    struct Profiler::ThreadBuffer
+    {
+        uint32_t threadId = 0;
+        uint32_t depth = 0;
+        // total number of samples ever written; the writer is the owning thread only
+        std::atomic<uint64_t> written{0};
+        Sample samples[BUFFER_SIZE];
+    };
+
+    namespace
+    {
+        std::mutex buffersMutex;
+        // buffers are never freed so samples of finished threads can still be exported
+        std::vector<std::unique_ptr<Profiler::ThreadBuffer>> buffers;
+        Profiler::ThreadBuffer* mainBuffer = nullptr;
+
+        std::vector<Profiler::FrameStats> frameHistory(Profiler::HISTORY_SIZE);
+        // read by all threads to tag samples
+        std::atomic<uint32_t> frameIndex{0};
+        uint64_t frameStart = 0;
+        // position in main thread buffer where current frame started
+        uint64_t frameFirstSample = 0;
+
+        void escapeJson(std::ostream& stream, const char* text)
+        {
+            for (; *text; ++text) {
+                if (*text == '"' || *text == '\\') {
+                    stream << '\\';
+                }
+                stream << *text;
+            }
+        }
+    }
+
+    std::atomic<bool> Profiler::_enabled{false};
+
+    bool Profiler::enabled()
+    {
+        return _enabled.load(std::memory_order_relaxed);
+    }
+
+    void Profiler::setEnabled(bool enabled)
+    {
+        _enabled.store(enabled, std::memory_order_relaxed);
+        if (enabled) {
+            frameStart = now();
+            frameFirstSample = threadBuffer()->written.load(std::memory_order_relaxed);
+        }
+    }
+
+    Profiler::ThreadBuffer* Profiler::threadBuffer()
+    {
+        thread_local ThreadBuffer* buffer = nullptr;
+        if (!buffer) {
+            std::lock_guard<std::mutex> lock(buffersMutex);
+            buffers.push_back(std::make_unique<ThreadBuffer>());
+            buffer = buffers.back().get();
+            buffer->threadId = static_cast<uint32_t>(buffers.size());
+        }
+        return buffer;
+    }
+
+    uint64_t Profiler::now()
+    {
+        return SDL_GetPerformanceCounter();
+    }
+
+    double Profiler::toMilliseconds(uint64_t ticks)
+    {
+        static const double frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+        return static_cast<double>(ticks) * 1000.0 / frequency;
+    }
+
+    void Profiler::submit(ThreadBuffer* buffer, const char* name, uint64_t start, uint32_t depth)
+    {
+        uint64_t index = buffer->written.load(std::memory_order_relaxed);
+        Sample& sample = buffer->samples[index & (BUFFER_SIZE - 1)];
+        sample.name = name;
+        sample.start = start;
+        sample.end = now();
+        sample.depth = depth;
+        sample.frame = frameIndex.load(std::memory_order_relaxed);
+        buffer->written.store(index + 1, std::memory_order_release);
+    }
+
+    uint32_t& Profiler::depth(ThreadBuffer* buffer)
+    {
+        return buffer->depth;
+    }
+
+    void Profiler::endFrame()
+    {
+        if (!enabled()) {
+            return;
+        }
+
+        ThreadBuffer* buffer = threadBuffer();
+        if (!mainBuffer) {
+            mainBuffer = buffer;
+        }
+
+        uint32_t frame = frameIndex.load(std::memory_order_relaxed) + 1;
+        frameIndex.store(frame, std::memory_order_relaxed);
+        FrameStats& stats = frameHistory[frame % HISTORY_SIZE];
+        stats = FrameStats();
+        stats.start = frameStart;
+        stats.end = now();
+
+        uint64_t written = buffer->written.load(std::memory_order_relaxed);
+        uint64_t first = std::max(frameFirstSample, written > BUFFER_SIZE ? written - BUFFER_SIZE : 0);
+        for (uint64_t i = first; i < written; i++) {
+            const Sample& sample = buffer->samples[i & (BUFFER_SIZE - 1)];
+            if (sample.depth != 0) {
+                continue;
+            }
+            unsigned zone = 0;
+            while (zone < stats.zonesCount && stats.zoneNames[zone] != sample.name) {
+                zone++;
+            }
+            if (zone == stats.zonesCount) {
+                if (zone == FrameStats::MAX_ZONES) {
+                    continue;
+                }
+                stats.zoneNames[zone] = sample.name;
+                stats.zonesCount++;
+            }
+            stats.zoneTimes[zone] += sample.end - sample.start;
+        }
+
+        frameStart = stats.end;
+        frameFirstSample = written;
+    }
+
+    const std::vector<Profiler::FrameStats>& Profiler::history()
+    {
+        return frameHistory;
+    }
+
+    uint32_t Profiler::lastFrame()
+    {
+        return frameIndex.load(std::memory_order_relaxed) % HISTORY_SIZE;
+    }
+
+    bool Profiler::exportTrace(const std::string& filename)
+    {
+        std::ofstream stream(filename, std::ios_base::out | std::ios_base::trunc);
+        if (!stream.is_open()) {
+            Logger::error("PROFILER") << "Can't write trace to " << filename << std::endl;
+            return false;
+        }
+
+        const double toMicroseconds = 1000000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+        uint64_t origin = UINT64_MAX;
+
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        for (auto& buffer : buffers) {
+            uint64_t written = buffer->written.load(std::memory_order_acquire);
+            uint64_t first = written > BUFFER_SIZE ? written - BUFFER_SIZE : 0;
+            for (uint64_t i = first; i < written; i++) {
+                origin = std::min(origin, buffer->samples[i & (BUFFER_SIZE - 1)].start);
+            }
+        }
+
+        stream << "{\"traceEvents\":[";
+        bool firstEvent = true;
+        for (auto& buffer : buffers) {
+            uint64_t written = buffer->written.load(std::memory_order_acquire);
+            uint64_t first = written > BUFFER_SIZE ? written - BUFFER_SIZE : 0;
+            for (uint64_t i = first; i < written; i++) {
+                const Sample& sample = buffer->samples[i & (BUFFER_SIZE - 1)];
+                stream << (firstEvent ? "\n" : ",\n") << "{\"name\":\"";
+                escapeJson(stream, sample.name);
+                stream << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId
+                       << ",\"ts\":" << static_cast<double>(sample.start - origin) * toMicroseconds
+                       << ",\"dur\":" << static_cast<double>(sample.end - sample.start) * toMicroseconds
+                       << ",\"args\":{\"frame\":" << sample.frame << "}}";
+                firstEvent = false;
+            }
+        }
+        stream << "\n]}\n";
+
+        Logger::info("PROFILER") << "Trace written to " << filename << std::endl;
+        return true;
+    }
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Falltergeist
+{
+    /**
+     * Lightweight frame profiler.
+     *
+     * Code is instrumented with scoped ProfilerZone objects. Each thread writes finished zones into its own
+     * fixed-size ring buffer without locking, so instrumentation is cheap enough to leave in release builds.
+     * When the profiler is disabled a zone costs one relaxed atomic load.
+     */
+    class Profiler
+    {
+        public:
+            struct Sample
+            {
+                // zone names are string literals, only the pointer is stored
+                const char* name = nullptr;
+                uint64_t start = 0;
+                uint64_t end = 0;
+                uint32_t depth = 0;
+                uint32_t frame = 0;
+            };
+
+            // top-level zones of a single frame on the main thread
+            struct FrameStats
+            {
+                static const unsigned MAX_ZONES = 8;
+
+                uint64_t start = 0;
+                uint64_t end = 0;
+                unsigned zonesCount = 0;
+                const char* zoneNames[MAX_ZONES] = {};
+                uint64_t zoneTimes[MAX_ZONES] = {};
+            };
+
+            // samples kept per thread
+            static const uint32_t BUFFER_SIZE = 1 << 16;
+            // frames kept for the overlay graph
+            static const uint32_t HISTORY_SIZE = 128;
+
+            static bool enabled();
+            static void setEnabled(bool enabled);
+
+            /**
+             * Marks the end of a frame. Must be called from the main thread.
+             */
+            static void endFrame();
+
+            static const std::vector<FrameStats>& history();
+            // index of the most recent frame in history()
+            static uint32_t lastFrame();
+
+            static double toMilliseconds(uint64_t ticks);
+
+            /**
+             * Writes all buffered samples of all threads to a file in Chrome trace event format
+             * (chrome://tracing, Perfetto, Speedscope). Buffers are not locked against their writers,
+             * so the oldest samples of a thread which is still running may come out torn.
+             */
+            static bool exportTrace(const std::string& filename);
+
+            // internal, used by ProfilerZone
+            struct ThreadBuffer;
+            static ThreadBuffer* threadBuffer();
+            static uint64_t now();
+            static void submit(ThreadBuffer* buffer, const char* name, uint64_t start, uint32_t depth);
+            static uint32_t& depth(ThreadBuffer* buffer);
+
+        private:
+            static std::atomic<bool> _enabled;
+    };
+
+    /**
+     * Measures time from construction to the end of the enclosing scope.
+     * @param name must be a string literal (or otherwise outlive the profiler)
+     */
+    class ProfilerZone final
+    {
+        public:
+            explicit ProfilerZone(const char* name)
+            {
+                if (!Profiler::enabled()) {
+                    return;
+                }
+                _buffer = Profiler::threadBuffer();
+                _name = name;
+                _depth = Profiler::depth(_buffer)++;
+                _start = Profiler::now();
+            }
+
+            ~ProfilerZone()
+            {
+                if (_buffer) {
+                    Profiler::submit(_buffer, _name, _start, _depth);
+                    Profiler::depth(_buffer)--;
+                }
+            }
+
+            ProfilerZone(const ProfilerZone&) = delete;
+            void operator=(const ProfilerZone&) = delete;
+
+        private:
+            Profiler::ThreadBuffer* _buffer = nullptr;
+            const char* _name = nullptr;
+            uint64_t _start = 0;
+            uint32_t _depth = 0;
+    };
+}
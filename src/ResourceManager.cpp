@@ -1,4 +1,6 @@
-﻿#include <fstream>
+﻿#include <algorithm>
+#include <chrono>
+#include <fstream>
 #include <sstream>
 #include <iomanip>
 #include <locale>
@@ -9,9 +11,12 @@
 #include "Exception.h"
 #include "Format/Acm/File.h"
 #include "Format/Bio/File.h"
+#include "Format/Cache/File.h"
+#include "Format/Cache/Writer.h"
 #include "Format/Dat/Stream.h"
 #include "Format/Dat/File.h"
 #include "Format/Dat/MiscFile.h"
+#include "Format/Dat/SequentialStream.h"
 #include "Format/Dat/Item.h"
 #include "Format/Fon/File.h"
 #include "Format/Frm/File.h"
@@ -32,12 +37,15 @@
 #include "Format/Txt/MapsFile.h"
 #include "Format/Txt/WorldmapFile.h"
 #include "Game/Location.h"
+#include "Graphics/AnimatedPalette.h"
 #include "Graphics/Font.h"
 #include "Graphics/Font/AAF.h"
 #include "Graphics/Font/FON.h"
 #include "Graphics/Texture.h"
+#include "Graphics/TextureAtlas.h"
 #include "Graphics/Shader.h"
 #include "Logger.h"
+#include "Profiler.h"
 #include "ResourceManager.h"
 #include "Ini/File.h"
 
@@ -70,7 +78,9 @@ ResourceManager* ResourceManager::getInstance()
     return &manager;
 }
 
-void ResourceManager::_loadStreamForFile(string filename, std::function<void(Dat::Stream&&)> callback) {
+void ResourceManager::_loadStreamForFile(string filename, std::function<void(const StreamOpener&, const Cache::Key&)> callback) {
+    ProfilerZone zone("ResourceManager::load");
+
     // Searching file in Fallout data directory
     {
         string path = CrossPlatform::findFalloutDataPath() + "/" + filename;
@@ -88,7 +98,12 @@ void ResourceManager::_loadStreamForFile(string filename, std::function<void(Dat
         }
 
         if (stream.is_open()) {
-            callback(Dat::Stream(stream));
+            Cache::Key key;
+            key.filename = filename;
+            key.source = path;
+            CrossPlatform::fileInfo(path, key.sourceSize, key.sourceModified);
+            key.size = static_cast<uint32_t>(key.sourceSize);
+            callback([&stream]() { return Dat::Stream(stream); }, key);
             stream.close();
             return;
         }
@@ -99,13 +114,63 @@ void ResourceManager::_loadStreamForFile(string filename, std::function<void(Dat
         auto entry = datfile->entry(filename);
         if (entry != nullptr) {
             Logger::debug("RESOURCE MANAGER") << "Loading file: " << filename << " [FROM " << datfile->filename() << "]" << endl;
-            callback(Dat::Stream(*entry));
+            Cache::Key key;
+            key.filename = filename;
+            key.source = datfile->filename();
+            key.offset = entry->dataOffset();
+            key.size = entry->packedSize();
+            CrossPlatform::fileInfo(datfile->filename(), key.sourceSize, key.sourceModified);
+            callback([entry]() { return Dat::Stream(*entry); }, key);
             return;
         }
     }
     Logger::error("RESOURCE MANAGER") << "Loading file: " << filename << " [ NOT FOUND]" << endl;
 }
 
+void ResourceManager::loadStream(const string& filename, std::function<void(Dat::Stream&&)> callback)
+{
+    string name = filename;
+    std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+    _loadStreamForFile(name, [&callback](const StreamOpener& open, const Cache::Key&) {
+        callback(open());
+    });
+}
+
+std::vector<std::string> ResourceManager::datFilenames() const
+{
+    std::vector<std::string> result;
+    for (auto& datfile : _datFiles) {
+        auto filenames = datfile->filenames();
+        result.insert(result.end(), filenames.begin(), filenames.end());
+    }
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+std::unique_ptr<Dat::SequentialStream> ResourceManager::_openSequentialStream(string filename)
+{
+    std::transform(filename.begin(), filename.end(), filename.begin(), ::tolower);
+
+    for (auto& path : {CrossPlatform::findFalloutDataPath(), CrossPlatform::findFalltergeistDataPath()}) {
+        auto stream = std::make_unique<Dat::SequentialStream>(path + "/" + filename);
+        if (stream->isOpen()) {
+            Logger::debug("RESOURCE MANAGER") << "Streaming file: " << filename << " [FROM " << path << "]" << endl;
+            return stream;
+        }
+    }
+
+    for (auto& datfile : _datFiles) {
+        auto entry = datfile->entry(filename);
+        if (entry != nullptr) {
+            Logger::debug("RESOURCE MANAGER") << "Streaming file: " << filename << " [FROM " << datfile->filename() << "]" << endl;
+            return std::make_unique<Dat::SequentialStream>(*entry);
+        }
+    }
+    Logger::error("RESOURCE MANAGER") << "Streaming file: " << filename << " [ NOT FOUND]" << endl;
+    return nullptr;
+}
+
 template <class T>
 T* ResourceManager::_datFileItem(string filename)
 {
@@ -124,9 +189,9 @@ T* ResourceManager::_datFileItem(string filename)
     }
 
     T* itemPtr = nullptr;
-    _loadStreamForFile(filename, [this, &filename, &itemPtr](Dat::Stream&& stream)
+    _loadStreamForFile(filename, [this, &filename, &itemPtr](const StreamOpener& open, const Cache::Key& key)
     {
-        auto item = std::make_unique<T>(std::move(stream));
+        auto item = _createItem<T>(open, key, std::is_constructible<T, Cache::Reader&>());
         itemPtr = item.get();
         item->setFilename(filename);
         _datItems.emplace(filename, std::move(item));
@@ -135,6 +200,41 @@ T* ResourceManager::_datFileItem(string filename)
     return itemPtr;
 }
 
+template <class T>
+std::unique_ptr<T> ResourceManager::_createItem(const StreamOpener& open, const Cache::Key&, std::false_type)
+{
+    return std::make_unique<T>(open());
+}
+
+template <class T>
+std::unique_ptr<T> ResourceManager::_createItem(const StreamOpener& open, const Cache::Key& key, std::true_type)
+{
+    ProfilerZone zone("ResourceManager::cache");
+    auto start = std::chrono::steady_clock::now();
+    auto elapsed = [&start]() {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    Cache::File cache(CrossPlatform::getConfigPath() + "/cache/" + key.filename + ".cache", key);
+    if (cache.load()) {
+        try {
+            auto reader = cache.reader();
+            auto item = std::make_unique<T>(reader);
+            Logger::info("CACHE") << key.filename << ": loaded from cache in " << elapsed() << " us" << endl;
+            return item;
+        } catch (const Exception& e) {
+            Logger::warning("CACHE") << key.filename << ": can't read cache: " << e.what() << endl;
+        }
+    }
+
+    auto item = std::make_unique<T>(open());
+    Logger::info("CACHE") << key.filename << ": parsed in " << elapsed() << " us" << endl;
+    Cache::Writer writer;
+    item->save(writer);
+    cache.save(writer);
+    return item;
+}
+
 Frm::File* ResourceManager::frmFileType(const string& filename)
 {
     // TODO: Maybe get rid of all wrappers like this and call template function directly from outside.
@@ -191,9 +291,13 @@ Msg::File* ResourceManager::msgFileType(const string& filename)
     return _datFileItem<Msg::File>(filename);
 }
 
-Mve::File* ResourceManager::mveFileType(const string& filename)
+std::unique_ptr<Mve::File> ResourceManager::mveFileType(const string& filename)
 {
-    return _datFileItem<Mve::File>(filename);
+    auto stream = _openSequentialStream(filename);
+    if (!stream) {
+        return nullptr;
+    }
+    return std::make_unique<Mve::File>(std::move(stream));
 }
 
 Bio::File* ResourceManager::bioFileType(const string& filename)
@@ -282,6 +386,8 @@ Graphics::Texture* ResourceManager::texture(const string& filename)
         return _textures.at(filename).get();
     }
 
+    ProfilerZone zone("ResourceManager::texture");
+
     string ext = filename.substr(filename.length() - 4);
 
     Graphics::Texture* texture = nullptr;
@@ -311,14 +417,6 @@ Graphics::Texture* ResourceManager::texture(const string& filename)
         texture = new Graphics::Texture(rix->width(), rix->height());
         texture->loadFromRGBA(rix->rgba());
     }
-    else if (ext == ".frm")
-    {
-        auto frm = frmFileType(filename);
-        if (!frm) return nullptr;
-        texture = new Graphics::Texture(frm->width(), frm->height());
-        texture->loadFromRGBA(frm->rgba(palFileType("color.pal")));
-        texture->setMask(frm->mask(palFileType("color.pal")));
-    }
     else
     {
         throw Exception("ResourceManager::surface() - unknown image type:" + filename);
@@ -328,6 +426,53 @@ Graphics::Texture* ResourceManager::texture(const string& filename)
     return texture;
 }
 
+const Graphics::TextureRegion* ResourceManager::textureRegion(const string& filename)
+{
+    if (auto region = atlas()->region(filename))
+    {
+        return region;
+    }
+    if (_textureRegions.count(filename))
+    {
+        return _textureRegions.at(filename).get();
+    }
+
+    if (filename.substr(filename.length() - 4) == ".frm")
+    {
+        auto frm = frmFileType(filename);
+        if (!frm) return nullptr;
+
+        ProfilerZone zone("ResourceManager::textureRegion");
+        auto region = atlas()->add(filename, Graphics::Size(frm->width(), frm->height()), frm->indexes());
+        region->mask = frm->mask(palFileType("color.pal"));
+        auto indexes = frm->indexes();
+        region->animatedColors = std::any_of(indexes, indexes + frm->width() * frm->height(), [](uint8_t index) {
+            return index >= Graphics::AnimatedPalette::FIRST_ANIMATED_INDEX && index != 255;
+        });
+        return region;
+    }
+
+    // true color images can't share indexed atlas pages
+    auto tex = texture(filename);
+    if (!tex) return nullptr;
+
+    auto region = std::make_unique<Graphics::TextureRegion>();
+    region->texture = tex;
+    region->size = tex->size();
+    _textureRegions.insert(make_pair(filename, std::move(region)));
+    return _textureRegions.at(filename).get();
+}
+
+Graphics::TextureAtlas* ResourceManager::atlas()
+{
+    // created on demand: renderer has to be initialized first
+    if (!_atlas)
+    {
+        _atlas = std::make_unique<Graphics::TextureAtlas>();
+    }
+    return _atlas.get();
+}
+
 Graphics::Font* ResourceManager::font(const string& filename)
 {
 
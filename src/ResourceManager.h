@@ -5,6 +5,7 @@
 #include <string>
 #include <map>
 #include <memory>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
@@ -16,11 +17,17 @@ namespace Falltergeist
         namespace Fon { class File; }
         namespace Acm { class File; }
         namespace Bio { class File; }
+        namespace Cache
+        {
+            struct Key;
+            class Reader;
+        }
         namespace Dat
         {
             class File;
             class Item;
             class MiscFile;
+            class SequentialStream;
             class Stream;
         }
         namespace Frm { class File; }
@@ -70,6 +77,8 @@ namespace Falltergeist
     namespace Graphics
     {
         class Texture;
+        class TextureAtlas;
+        struct TextureRegion;
         class Font;
         class Shader;
     }
@@ -93,9 +102,14 @@ namespace Falltergeist
             Format::Int::File* intFileType(unsigned int SID);
             Format::Lip::File* lipFileType(const std::string& filename);
             Format::Lst::File* lstFileType(const std::string& filename);
+            // Names of all files packed in DAT files, sorted, each one listed once
+            std::vector<std::string> datFilenames() const;
+            // Calls the callback with the raw stream of a file, without parsing or caching it. Does nothing if the file is not found.
+            void loadStream(const std::string& filename, std::function<void(Format::Dat::Stream&&)> callback);
             Format::Map::File* mapFileType(const std::string& filename);
             Format::Msg::File* msgFileType(const std::string& filename);
-            Format::Mve::File* mveFileType(const std::string& filename);
+            // Movies are not cached: each call opens a new stream which reads the file incrementally
+            std::unique_ptr<Format::Mve::File> mveFileType(const std::string& filename);
             Format::Pro::File* proFileType(const std::string& filename);
             Format::Pro::File* proFileType(unsigned int PID);
             Format::Rix::File* rixFileType(const std::string& filename);
@@ -112,7 +126,11 @@ namespace Falltergeist
             Format::Txt::KarmaVarFile* karmaVarTxt();
             Format::Txt::QuestsFile* questsTxt();
 
+            // true color images (PNG, RIX) only, FRM images are in the atlas
             Graphics::Texture* texture(const std::string& filename);
+            // FRM images are packed into the shared atlas, other images get a region spanning their own texture
+            const Graphics::TextureRegion* textureRegion(const std::string& filename);
+            Graphics::TextureAtlas* atlas();
             Graphics::Font* font(const std::string& filename = "font1.aaf");
             Graphics::Shader* shader(const std::string& filename);
             void unloadResources();
@@ -125,6 +143,8 @@ namespace Falltergeist
             std::vector<std::unique_ptr<Format::Dat::File>> _datFiles;
             std::unordered_map<std::string, std::unique_ptr<Format::Dat::Item>> _datItems;
             std::unordered_map<std::string, std::unique_ptr<Graphics::Texture>> _textures;
+            std::unordered_map<std::string, std::unique_ptr<Graphics::TextureRegion>> _textureRegions;
+            std::unique_ptr<Graphics::TextureAtlas> _atlas;
             std::unordered_map<std::string, std::unique_ptr<Graphics::Font>> _fonts;
             std::unordered_map<std::string, std::unique_ptr<Graphics::Shader>> _shaders;
 
@@ -137,7 +157,23 @@ namespace Falltergeist
             template <class T>
             T* _datFileItem(std::string filename);
 
-            // Searches for a given file within virtual "file system" and calls the given callback with Dat::Stream created from that file.
-            void _loadStreamForFile(std::string filename, std::function<void(Format::Dat::Stream&&)> callback);
+            // Reads (and unpacks) a found file into Dat::Stream
+            using StreamOpener = std::function<Format::Dat::Stream()>;
+
+            // Searches for a given file within virtual "file system" and calls the given callback with the location it was found at
+            // and a function reading it. Nothing is read until that function is called.
+            void _loadStreamForFile(std::string filename, std::function<void(const StreamOpener&, const Format::Cache::Key&)> callback);
+
+            // Parses item from the stream
+            template <class T>
+            std::unique_ptr<T> _createItem(const StreamOpener& open, const Format::Cache::Key& key, std::false_type);
+
+            // Items which can be restored from Cache::Reader are loaded from the binary cache while their source data is unchanged,
+            // otherwise read, parsed and cached for the next time
+            template <class T>
+            std::unique_ptr<T> _createItem(const StreamOpener& open, const Format::Cache::Key& key, std::true_type);
+
+            // Same lookup as _loadStreamForFile, but nothing is read in advance. Returns nullptr if the file is not found.
+            std::unique_ptr<Format::Dat::SequentialStream> _openSequentialStream(std::string filename);
     };
 }
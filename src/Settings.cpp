@@ -42,6 +42,8 @@ namespace Falltergeist
         video->setPropertyInt("scale", _scale);
         video->setPropertyBool("fullscreen", _fullscreen);
         video->setPropertyBool("always_on_top", _alwaysOnTop);
+        video->setPropertyBool("headless", _headless);
+        video->setPropertyInt("headless_frames", _headlessFrames);
 
         auto audio = file.section("audio");
         audio->setPropertyBool("enabled", _audioEnabled);
@@ -62,6 +64,12 @@ namespace Falltergeist
         game->setPropertyBool("display_fps", _displayFps);
         game->setPropertyBool("worldmap_fullscreen", _worldMapFullscreen);
         game->setPropertyBool("display_mouse_position", _displayMousePosition);
+        game->setPropertyString("record_input", _recordInput);
+        game->setPropertyString("replay_input", _replayInput);
+        game->setPropertyString("frame_timing_log", _frameTimingLog);
+        game->setPropertyBool("profiler", _profiler);
+        game->setPropertyString("profiler_trace", _profilerTrace);
+        game->setPropertyString("benchmark", _benchmark);
 
         auto preferences = file.section("preferences");
         preferences->setPropertyDouble("brightness", _brightness);
@@ -148,6 +156,8 @@ namespace Falltergeist
             _scale = video->propertyInt("scale", _scale);
             _fullscreen = video->propertyBool("fullscreen", _fullscreen);
             _alwaysOnTop = video->propertyBool("always_on_top", _alwaysOnTop);
+            _headless = video->propertyBool("headless", _headless);
+            _headlessFrames = video->propertyInt("headless_frames", _headlessFrames);
         }
 
         auto audio = file->section("audio");
@@ -178,6 +188,12 @@ namespace Falltergeist
             _displayFps = game->propertyBool("display_fps", _displayFps);
             _worldMapFullscreen = game->propertyBool("worldmap_fullscreen", _worldMapFullscreen);
             _displayMousePosition = game->propertyBool("display_mouse_position", _displayMousePosition);
+            _recordInput = game->propertyString("record_input", _recordInput);
+            _replayInput = game->propertyString("replay_input", _replayInput);
+            _frameTimingLog = game->propertyString("frame_timing_log", _frameTimingLog);
+            _profiler = game->propertyBool("profiler", _profiler);
+            _profilerTrace = game->propertyString("profiler_trace", _profilerTrace);
+            _benchmark = game->propertyString("benchmark", _benchmark);
         }
 
         auto preferences = file->section("preferences");
@@ -449,6 +465,46 @@ namespace Falltergeist
         return _alwaysOnTop;
     }
 
+    bool Settings::headless() const
+    {
+        return _headless;
+    }
+
+    unsigned int Settings::headlessFrames() const
+    {
+        return _headlessFrames;
+    }
+
+    const std::string& Settings::recordInput() const
+    {
+        return _recordInput;
+    }
+
+    const std::string& Settings::replayInput() const
+    {
+        return _replayInput;
+    }
+
+    const std::string& Settings::frameTimingLog() const
+    {
+        return _frameTimingLog;
+    }
+
+    bool Settings::profiler() const
+    {
+        return _profiler;
+    }
+
+    const std::string& Settings::profilerTrace() const
+    {
+        return _profilerTrace;
+    }
+
+    const std::string& Settings::benchmark() const
+    {
+        return _benchmark;
+    }
+
     void Settings::setAudioBufferSize(int _audioBufferSize)
     {
         this->_audioBufferSize = _audioBufferSize;
@@ -88,6 +88,14 @@ namespace Falltergeist
             void setFullscreen(bool _fullscreen);
             bool fullscreen() const;
             bool alwaysOnTop() const;
+            bool headless() const;
+            unsigned int headlessFrames() const;
+            const std::string& recordInput() const;
+            const std::string& replayInput() const;
+            const std::string& frameTimingLog() const;
+            bool profiler() const;
+            const std::string& profilerTrace() const;
+            const std::string& benchmark() const;
             void setAudioBufferSize(int _audioBufferSize);
             int audioBufferSize() const;
 
@@ -102,10 +110,26 @@ namespace Falltergeist
             bool _displayFps = true;
             bool _worldMapFullscreen = false;
             bool _displayMousePosition = true;
+            // file to record input log to, empty means no recording
+            std::string _recordInput;
+            // input log to replay instead of reading input from OS
+            std::string _replayInput;
+            // CSV file for per-frame handle/think/render timings
+            std::string _frameTimingLog;
+            // collect profiler zones from start (can be toggled in game with F11)
+            bool _profiler = false;
+            // file to write Chrome trace of profiler zones to on exit
+            std::string _profilerTrace;
+            // name of Game::Benchmark to run instead of the game (timers, parse, mve), the game quits when it's done
+            std::string _benchmark;
             std::string _loggerLevel = "info";
             bool _loggerColors = true;
             unsigned int _scale = 0;
             bool _fullscreen = false;
+            // run without window, GL context and audio; simulation is not throttled
+            bool _headless = false;
+            // number of frames to simulate before quitting in headless mode, 0 means no limit
+            unsigned int _headlessFrames = 0;
 
             double _brightness = 1.0;
             unsigned int _gameDifficulty = 1;
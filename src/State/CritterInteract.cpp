@@ -103,7 +103,7 @@ namespace Falltergeist
                 _headName = headImage;
 
                 _fidgetTimer.tickHandler().add([this](Event::Event* evt){
-                    uint8_t fidget = rand() % 3 + 1;
+                    uint8_t fidget = Game::getInstance()->random().next(1, 3);
                     auto headImage = _headName;
                     switch (_mood)
                     {
@@ -123,7 +123,7 @@ namespace Falltergeist
                     head->animations().push_back(std::make_unique<UI::Animation>("art/heads/" + headImage));
 
                     head->start();
-                    _fidgetTimer.start(std::rand() % 5000 + 5000);
+                    _fidgetTimer.start(Game::getInstance()->random().next(5000, 9999));
 
                 });
                 headImage+="gf1.frm";
@@ -220,7 +220,7 @@ namespace Falltergeist
             _fidgetTimer.stop();
             Game::getInstance()->mixer()->playACMSpeech(_headName+"/"+speech+".acm");
             // start timer
-            _startTime = SDL_GetTicks();
+            _startTime = Game::getInstance()->simulationTime();
             _nextIndex = 0;
             _phase = Phase::TALK;
 
@@ -269,14 +269,14 @@ namespace Falltergeist
                     // if playing speech - set phoneme frame
 
 
-                    if (_nextIndex < _lips->phonemes().size() && SDL_GetTicks()-_startTime>=_lips->timestamps().at(_nextIndex))
+                    if (_nextIndex < _lips->phonemes().size() && Game::getInstance()->simulationTime()-_startTime>=_lips->timestamps().at(_nextIndex))
                     {
                         //set frame
                         auto head = dynamic_cast<UI::AnimationQueue*>(getUI("head"));
                         head->currentAnimation()->setCurrentFrame(_phonemeToFrame(_lips->phonemes().at(_nextIndex)));
                         _nextIndex++;
                     }
-                    if (SDL_GetTicks()-_startTime>= (_lips->acmSize()*1000 / 22050 /2))
+                    if (Game::getInstance()->simulationTime()-_startTime>= (_lips->acmSize()*1000 / 22050 /2))
                     {
                         _phase = Phase::FIDGET;
                         _fidgetTimer.start(0);
@@ -8,6 +8,7 @@
 #include "../Format/Msg/File.h"
 #include "../Format/Txt/MapsFile.h"
 #include "../Format/Gam/File.h"
+#include "../Format/Int/File.h"
 #include "../functions.h"
 #include "../Game/ContainerItemObject.h"
 #include "../Game/Defines.h"
@@ -17,12 +18,14 @@
 #include "../Game/Location.h"
 #include "../Game/LocationElevation.h"
 #include "../Game/ObjectFactory.h"
+#include "../Game/ObjectRegistry.h"
 #include "../Game/SpatialObject.h"
 #include "../Game/WeaponItemObject.h"
 #include "../Helpers/GameLocationHelper.h"
 #include "../Helpers/GameObjectHelper.h"
 #include "../LocationCamera.h"
 #include "../Logger.h"
+#include "../Profiler.h"
 #include "../PathFinding/Hexagon.h"
 #include "../PathFinding/HexagonGrid.h"
 #include "../ResourceManager.h"
@@ -49,6 +52,7 @@ namespace Falltergeist
 
         const int Location::DROPDOWN_DELAY = 350;
         const int Location::KEYBOARD_SCROLL_STEP = 35;
+        const int Location::SCRIPT_OVERRUN_REPORT_INTERVAL = 10;
 
         Location::Location(std::shared_ptr<Game::DudeObject> player,
             std::shared_ptr<Input::Mouse> mouse,
@@ -66,9 +70,28 @@ namespace Falltergeist
             gameTime(std::move(gameTime))
         {
             this->resourceManager = resourceManager;
+
+            _timerEvents.setCallback([this](Game::Object* object, int fixedParam) {
+                if (object) {
+                    if (auto vm = object->script()) {
+                        vm->setFixedParam(fixedParam);
+                        _callBudgeted(object->handle(), vm, STANDARD_PROCEDURE::TIMED_EVENT);
+                    }
+                }
+            });
         }
 
-        Location::~Location() {  }
+        Location::~Location()
+        {
+            // objects are allocated in the arena of _location, so they must be gone before it is
+            _objectUnderCursor = nullptr;
+            _actionCursorLastObject = nullptr;
+            _suspendedScripts.clear();
+            _procedureSubscribers.clear();
+            _flatObjects.clear();
+            _objects.clear();
+            _location.reset();
+        }
 
         void Location::init()
         {
@@ -91,6 +114,7 @@ namespace Falltergeist
             _objects.clear();
             _flatObjects.clear();
             _spatials.clear();
+            _procedureSubscribers.clear();
 
             _hexagonGrid = std::make_unique<HexagonGrid>();
 
@@ -108,13 +132,13 @@ namespace Falltergeist
 
 
                 if (object->ui()) {
-                    std::weak_ptr<Game::Object> weakObject = object;
+                    Game::ObjectHandle handle = object->handle();
                     object->ui()->mouseDownHandler().add(
                         std::bind(
                             &Location::onObjectMouseEvent,
                             this,
                             std::placeholders::_1,
-                            weakObject
+                            handle
                         )
                     );
                     object->ui()->mouseClickHandler().add(
@@ -122,7 +146,7 @@ namespace Falltergeist
                             &Location::onObjectMouseEvent,
                             this,
                             std::placeholders::_1,
-                            weakObject
+                            handle
                         )
                     );
                     object->ui()->mouseInHandler().add(
@@ -130,7 +154,7 @@ namespace Falltergeist
                             &Location::onObjectHover,
                             this,
                             std::placeholders::_1,
-                            weakObject
+                            handle
                         )
                     );
                     // TODO: get rid of mousemove handler?
@@ -139,7 +163,7 @@ namespace Falltergeist
                             &Location::onObjectHover,
                             this,
                             std::placeholders::_1,
-                            weakObject
+                            handle
                         )
                     );
                     object->ui()->mouseOutHandler().add(
@@ -147,7 +171,7 @@ namespace Falltergeist
                             &Location::onObjectHover,
                             this,
                             std::placeholders::_1,
-                            weakObject
+                            handle
                         )
                     );
                 }
@@ -164,6 +188,7 @@ namespace Falltergeist
                 }
 
                 _objects.emplace_back(object);
+                _subscribe(object.get());
             }
 
             std::shared_ptr<Game::DudeObject> dude = player.lock();
@@ -180,7 +205,9 @@ namespace Falltergeist
 
             std::shared_ptr<Hexagon> hexagon = hexagonGrid()->at(_location->defaultPosition());
             _objects.emplace_back(player);
+            _subscribe(dude.get());
             moveObjectToHexagon(dude, hexagon);
+            _hexagonGrid->updateClusters();
 
             elevation->floor()->init();
             elevation->roof()->init();
@@ -224,11 +251,9 @@ namespace Falltergeist
             _locationScriptTimer.start(10000.0f, true);
             _locationScriptTimer.tickHandler().add([this, dude](Event::Event*) {
                 if (_location->script()) {
-                    _location->script()->call("map_update_p_proc");
-                }
-                for (const std::shared_ptr<Game::Object> &object : _objects) {
-                    object->map_update_p_proc();
+                    _callBudgeted(Game::ObjectHandle(), _location->script().get(), STANDARD_PROCEDURE::MAP_UPDATE);
                 }
+                _broadcast(STANDARD_PROCEDURE::MAP_UPDATE);
                 dude->map_update_p_proc();
             });
         }
@@ -273,7 +298,7 @@ namespace Falltergeist
                 _ambientSfx = it->ambientSfx;
                 if (!_ambientSfx.empty()) {
                     _ambientSfxTimer.tickHandler().add([this, mapShortName](Event::Event *evt) {
-                        unsigned char rnd = rand() % 100, sum = 0;
+                        unsigned char rnd = Game::getInstance()->random().next(0, 99), sum = 0;
                         auto it = _ambientSfx.cbegin();
                         while (it != _ambientSfx.cend() && (sum + it->second) < rnd) {
                             sum += it->second;
@@ -286,7 +311,7 @@ namespace Falltergeist
                             Logger::error("Location") << "Could not match ambient sfx for map " << mapShortName
                                                       << " with " << rnd << std::endl;
                         }
-                        _ambientSfxTimer.start(rand() % 10000 + 20000);
+                        _ambientSfxTimer.start(Game::getInstance()->random().next(20000, 29999));
                     });
                     _ambientSfxTimer.start(10000);
                 } else {
@@ -373,7 +398,7 @@ namespace Falltergeist
         std::vector<Input::Mouse::Icon> Location::getCursorIconsForObject(Game::Object *object)
         {
             std::vector<Input::Mouse::Icon> icons;
-            if (object->script() && object->script()->hasFunction("use_p_proc")) {
+            if (object->script() && object->script()->hasFunction(STANDARD_PROCEDURE::USE)) {
                 icons.push_back(Input::Mouse::Icon::USE);
             } else if (dynamic_cast<Game::DoorSceneryObject*>(object)) {
                 icons.push_back(Input::Mouse::Icon::USE);
@@ -396,9 +421,9 @@ namespace Falltergeist
         }
 
 
-        void Location::onObjectMouseEvent(Event::Mouse *event, const std::weak_ptr<Game::Object> &weakObject)
+        void Location::onObjectMouseEvent(Event::Mouse *event, Game::ObjectHandle handle)
         {
-            std::shared_ptr<Game::Object> object = weakObject.lock();
+            std::shared_ptr<Game::Object> object = Game::ObjectRegistry::getInstance()->lock(handle);
             if (!object) {
                 return;
             }
@@ -420,9 +445,9 @@ namespace Falltergeist
             }
         }
 
-        void Location::onObjectHover(Event::Mouse *event, const std::weak_ptr<Game::Object> &object)
+        void Location::onObjectHover(Event::Mouse *event, Game::ObjectHandle handle)
         {
-            std::shared_ptr<Game::Object> hoveredObject = object.lock();
+            std::shared_ptr<Game::Object> hoveredObject = Game::ObjectRegistry::getInstance()->lock(handle);
             if (event->name() == "mouseout") {
                 if (!hoveredObject || _objectUnderCursor == hoveredObject) {
                     _objectUnderCursor = nullptr;
@@ -443,6 +468,7 @@ namespace Falltergeist
 
         void Location::render()
         {
+            ProfilerZone zone("Location::render");
             const std::unique_ptr<Game::LocationElevation> &elevation = _location->elevations()->at(_elevation);
             elevation->floor()->render();
             _lightmap->render(_camera->topLeft());
@@ -483,6 +509,7 @@ namespace Falltergeist
         //render only flat objects first
         void Location::renderObjects() const
         {
+            ProfilerZone zone("Location::renderObjects");
             for (const auto &object: _flatObjects) {
                 object->render();
             }
@@ -509,6 +536,9 @@ namespace Falltergeist
 
         void Location::think(const float &deltaTime)
         {
+            ProfilerZone zone("Location::think");
+            _scriptBudget.startFrame();
+            _resumeScripts();
             gameTime->think(deltaTime);
             thinkObjects(deltaTime);
             std::shared_ptr<Game::DudeObject> dude = player.lock();
@@ -529,19 +559,14 @@ namespace Falltergeist
         // timers processing
         void Location::processTimers(const float &deltaTime)
         {
+            ProfilerZone zone("Location::processTimers");
             _locationScriptTimer.think(deltaTime);
             _actionCursorTimer.think(deltaTime);
             _ambientSfxTimer.think(deltaTime);
-
-            for (auto it = _timerEvents.begin(); it != _timerEvents.end();) {
-                it->timer.think(deltaTime);
-                if (!it->timer.enabled()) {
-                    it = _timerEvents.erase(it);
-                } else ++it;
-            }
+            _timerEvents.think(deltaTime);
         }
 
-        void Location::firstLocationEnter(const float &deltaTime) const
+        void Location::firstLocationEnter(const float &deltaTime)
         {
             if (_location->script()) {
                 _location->script()->initialize();
@@ -567,16 +592,14 @@ namespace Falltergeist
             }
 
             if (_location->script()) {
-                _location->script()->call("map_enter_p_proc");
+                _callBudgeted(Game::ObjectHandle(), _location->script().get(), STANDARD_PROCEDURE::MAP_ENTER);
             }
 
             // By some reason we need to use reverse iterator to prevent scripts problems
             // If we use normal iterators, some exported variables are not initialized on the moment
             // when script is called
             dude->map_enter_p_proc();
-            for (auto it = _objects.rbegin(); it != _objects.rend(); ++it) {
-                (*it)->map_enter_p_proc();
-            }
+            _broadcast(STANDARD_PROCEDURE::MAP_ENTER, true);
         }
 
         void Location::performScrolling(const float &deltaTime)
@@ -632,6 +655,7 @@ namespace Falltergeist
 
         void Location::thinkObjects(const float &deltaTime) const
         {
+            ProfilerZone zone("Location::thinkObjects");
             for (const auto &object : _objects) {
                 object->think(deltaTime);
             }
@@ -966,17 +990,17 @@ namespace Falltergeist
                     //_hexagonGrid->initLight(oldHexagon, false);
                 }
 
-                for (auto it = oldHexagon->objects()->begin(); it != oldHexagon->objects()->end(); ++it) {
-                    if (*it == object) {
-                        oldHexagon->objects()->erase(it);
-                        break;
-                    }
+                auto objectsAtHex = oldHexagon->objects();
+                auto it = std::find(objectsAtHex->begin(), objectsAtHex->end(), object->handle());
+                if (it != objectsAtHex->end()) {
+                    objectsAtHex->erase(it);
+                    _hexagonGrid->invalidate(oldHexagon.get());
                 }
 
                 /* JUST FOR EXIT GRIDS TESTING*/
                 if (object->type() == Game::Object::Type::DUDE) {
-                    for (auto obj : *hexagon->objects()) {
-                        if (auto exitGrid = std::dynamic_pointer_cast<Game::ExitMiscObject>(obj)) {
+                    for (Game::ObjectHandle handle : *hexagon->objects()) {
+                        if (auto exitGrid = dynamic_cast<Game::ExitMiscObject*>(Game::ObjectRegistry::getInstance()->get(handle))) {
                             auto &debug = Logger::critical("LOCATION");
                             debug << " PID: 0x" << std::hex << exitGrid->PID() << std::dec << std::endl;
                             debug << " name: " << exitGrid->name() << std::endl;
@@ -1018,7 +1042,8 @@ namespace Falltergeist
 
             object->setHexagon(hexagon);
             if (hexagon) {
-                hexagon->objects()->push_back(object);
+                hexagon->objects()->push_back(object->handle());
+                _hexagonGrid->invalidate(hexagon.get());
             } else {
                 Logger::warning("LOCATION") << "Set null hexagon" << std::endl;
             }
@@ -1069,11 +1094,11 @@ namespace Falltergeist
                 y /= 2;
                 int tilenum = y * 100 + x;
 
-                if (!elevation->roof()->inside() && elevation->roof()->tiles().count(tilenum)) {
+                if (!elevation->roof()->inside() && elevation->roof()->tileAt(tilenum)) {
                     // we was outside, now are inside
                     elevation->roof()->disable(tilenum);
                     elevation->roof()->setInside(true);
-                } else if (elevation->roof()->inside() && !elevation->roof()->tiles().count(tilenum)) {
+                } else if (elevation->roof()->inside() && !elevation->roof()->tileAt(tilenum)) {
                     // we was inside, now are outside
                     elevation->roof()->enableAll();
                     elevation->roof()->setInside(false);
@@ -1084,12 +1109,10 @@ namespace Falltergeist
         void Location::removeObjectFromMap(const std::shared_ptr<Game::Object> &object)
         {
             auto objectsAtHex = object->hexagon()->objects();
-
-            for (auto it = objectsAtHex->begin(); it != objectsAtHex->end(); ++it) {
-                if (*it == object) {
-                    objectsAtHex->erase(it);
-                    break;
-                }
+            auto handleIt = std::find(objectsAtHex->begin(), objectsAtHex->end(), object->handle());
+            if (handleIt != objectsAtHex->end()) {
+                objectsAtHex->erase(handleIt);
+                _hexagonGrid->invalidate(object->hexagon().get());
             }
             if (_objectUnderCursor == object) {
                 _objectUnderCursor = nullptr;
@@ -1098,6 +1121,7 @@ namespace Falltergeist
             auto it = std::find(_objects.begin(), _objects.end(), object);
             if (it != _objects.end()) {
                 _objects.erase(it);
+                _unsubscribe(object->handle());
             }
         }
 
@@ -1198,31 +1222,17 @@ namespace Falltergeist
 
         void Location::addTimerEvent(Game::Object *obj, int ticks, int fixedParam)
         {
-            Game::Timer timer(static_cast<float>(ticks) * 100.0f);
-            timer.start();
-            timer.tickHandler().add([obj, fixedParam](Event::Event *) {
-                if (obj) {
-                    if (auto vm = obj->script()) {
-                        vm->setFixedParam(fixedParam);
-                        vm->call("timed_event_p_proc");
-                    }
-                }
-            });
-            _timerEvents.emplace_back(TimerEvent {obj, std::move(timer), fixedParam});
+            _timerEvents.add(obj, static_cast<uint32_t>(std::max(ticks, 0)), fixedParam);
         }
 
         void Location::removeTimerEvent(Game::Object *obj)
         {
-            _timerEvents.remove_if([=](Location::TimerEvent &item) { return item.object == obj; });
+            _timerEvents.remove(obj);
         }
 
         void Location::removeTimerEvent(Game::Object *obj, int fixedParam)
         {
-            _timerEvents.remove_if(
-                [=](Location::TimerEvent &item) {
-                    return item.object == obj && item.fixedParam == fixedParam;
-                }
-            );
+            _timerEvents.remove(obj, fixedParam);
         }
 
         unsigned int Location::lightLevel()
@@ -1245,6 +1255,7 @@ namespace Falltergeist
 
         void Location::initLight()
         {
+            ProfilerZone zone("Location::initLight");
             for (Hexagon *hex: _hexagonGrid->hexagons()) {
                 hex->setLight(655);
             }
@@ -1274,12 +1285,113 @@ namespace Falltergeist
         std::shared_ptr<Game::Object> Location::addObject(unsigned int PID, unsigned int position, unsigned int elevation)
         {
             std::shared_ptr<Game::Object> object = Game::ObjectFactory::getInstance()->createObject(PID);
-            _objects.push_back(std::move(object));
+            _objects.push_back(object);
+            _subscribe(object.get());
             moveObjectToHexagon(object, hexagonGrid()->at(position));
             object->setElevation(elevation);
             return object;
         }
 
+        void Location::updateSubscriptions(Game::Object *object)
+        {
+            _unsubscribe(object->handle());
+            _subscribe(object);
+        }
+
+        void Location::_subscribe(Game::Object *object)
+        {
+            if (!object->script()) {
+                return;
+            }
+            for (auto procedure : {STANDARD_PROCEDURE::MAP_ENTER, STANDARD_PROCEDURE::MAP_UPDATE}) {
+                if (object->script()->hasFunction(procedure)) {
+                    _procedureSubscribers[procedure].push_back(object->handle());
+                }
+            }
+        }
+
+        void Location::_unsubscribe(Game::ObjectHandle handle)
+        {
+            for (auto &subscribers : _procedureSubscribers) {
+                auto it = std::find(subscribers.second.begin(), subscribers.second.end(), handle);
+                if (it == subscribers.second.end()) {
+                    continue;
+                }
+                if (_broadcasts) {
+                    *it = Game::ObjectHandle();
+                    _unsubscribed = true;
+                } else {
+                    subscribers.second.erase(it);
+                }
+            }
+        }
+
+        void Location::_broadcast(STANDARD_PROCEDURE procedure, bool reverse)
+        {
+            auto &subscribers = _procedureSubscribers[procedure];
+            const size_t count = subscribers.size();
+            ++_broadcasts;
+            for (size_t i = 0; i != count; ++i) {
+                // the vector may grow meanwhile, so no references into it are kept over a call
+                Game::ObjectHandle handle = subscribers[reverse ? count - 1 - i : i];
+                if (auto object = Game::ObjectRegistry::getInstance()->get(handle)) {
+                    _callBudgeted(handle, object->script(), procedure);
+                }
+            }
+            --_broadcasts;
+
+            if (!_broadcasts && _unsubscribed) {
+                for (auto &list : _procedureSubscribers) {
+                    list.second.erase(std::remove(list.second.begin(), list.second.end(), Game::ObjectHandle()), list.second.end());
+                }
+                _unsubscribed = false;
+            }
+        }
+
+        void Location::_callBudgeted(Game::ObjectHandle handle, VM::Script *script, STANDARD_PROCEDURE procedure)
+        {
+            if (!script->call(procedure, _scriptBudget)) {
+                _suspendedScripts.push_back(handle);
+                _reportSuspended(script);
+            }
+        }
+
+        void Location::_reportSuspended(VM::Script *script)
+        {
+            auto now = std::chrono::steady_clock::now();
+            if (now - _lastOverrunReport < std::chrono::seconds(SCRIPT_OVERRUN_REPORT_INTERVAL)) {
+                return;
+            }
+            _lastOverrunReport = now;
+
+            const auto &statistics = script->statistics();
+            Logger::warning("SCRIPT") << "Script budget exhausted in " << _scriptBudget.overruns() << " frames, suspended "
+                                      << script->script()->filename() << ": "
+                                      << statistics.calls << " calls, "
+                                      << statistics.suspensions << " suspensions, "
+                                      << statistics.instructions << " instructions, longest call took "
+                                      << statistics.maxFramesPerCall << " frames" << std::endl;
+        }
+
+        void Location::_resumeScripts()
+        {
+            ProfilerZone zone("Location::resumeScripts");
+            while (!_suspendedScripts.empty() && !_scriptBudget.exhausted()) {
+                Game::ObjectHandle handle = _suspendedScripts.front();
+                VM::Script *script = nullptr;
+                if (!handle) {
+                    script = _location->script().get();
+                } else if (auto object = Game::ObjectRegistry::getInstance()->get(handle)) {
+                    script = object->script();
+                }
+                // scripts of removed objects are gone along with them
+                if (script && !script->resume(_scriptBudget)) {
+                    break;
+                }
+                _suspendedScripts.pop_front();
+            }
+        }
+
         unsigned int Location::currentMapIndex()
         {
             return _currentMap;
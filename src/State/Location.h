@@ -1,16 +1,20 @@
 #pragma once
 
+#include <chrono>
+#include <deque>
 #include <list>
 #include <memory>
 #include "../Format/Map/File.h"
 #include "../Game/DudeObject.h"
 #include "../Game/Object.h"
 #include "../Game/Timer.h"
+#include "../Game/TimerWheel.h"
 #include "../Graphics/Lightmap.h"
 #include "../Input/Mouse.h"
 #include "../State/State.h"
 #include "../UI/ImageButton.h"
 #include "../UI/IResourceManager.h"
+#include "../VM/ExecutionBudget.h"
 
 namespace Falltergeist
 {
@@ -112,8 +116,8 @@ namespace Falltergeist
                 void removeTimerEvent(Game::Object* obj, int fixedParam);
 
                 void onBackgroundClick(Event::Mouse* event);
-                void onObjectMouseEvent(Event::Mouse* event, const std::weak_ptr<Game::Object> &weakObject);
-                void onObjectHover(Event::Mouse* event, const std::weak_ptr<Game::Object> &object);
+                void onObjectMouseEvent(Event::Mouse* event, Game::ObjectHandle handle);
+                void onObjectHover(Event::Mouse* event, Game::ObjectHandle handle);
                 void onKeyDown(Event::Keyboard* event) override;
                 void onMouseUp(Event::Mouse* event);
                 void onMouseDown(Event::Mouse* event);
@@ -132,6 +136,8 @@ namespace Falltergeist
                 void initLight();
 
                 std::shared_ptr<Game::Object> addObject(unsigned int PID, unsigned int position, unsigned int elevation);
+                // Call after a script was attached to an object on the map, so it gets broadcast procedures
+                void updateSubscriptions(Game::Object* object);
 
                 SKILL skillInUse() const;
                 void setSkillInUse(SKILL skill);
@@ -146,22 +152,17 @@ namespace Falltergeist
                 std::shared_ptr<UI::IResourceManager> resourceManager;
 
             protected:
-                struct TimerEvent
-                {
-                    Game::Object* object;
-                    Game::Timer timer;
-                    int fixedParam;
-                };
-
                 static const int KEYBOARD_SCROLL_STEP;
                 static const int DROPDOWN_DELAY;
+                // seconds between warnings about suspended scripts
+                static const int SCRIPT_OVERRUN_REPORT_INTERVAL;
 
                 // Timers
                 Game::Timer _locationScriptTimer;
                 Game::Timer _actionCursorTimer;
                 Game::Timer _ambientSfxTimer;
                 // for VM opcode add_timer_event
-                std::list<TimerEvent> _timerEvents;
+                Game::TimerWheel _timerEvents;
                 // TODO: move to Game::Location class?
                 std::map<std::string, unsigned char> _ambientSfx;
 
@@ -169,6 +170,8 @@ namespace Falltergeist
                 std::unique_ptr<LocationCamera> _camera;
                 std::map<std::string, VM::StackValue> _EVARS;
 
+                // Owns the arena most objects of the location are allocated in. Everything holding those objects
+                // (_objects, _flatObjects, _objectUnderCursor...) must be released before it, see ~Location().
                 std::unique_ptr<Falltergeist::Game::Location> _location;
                 unsigned int _elevation = 0;
 
@@ -190,6 +193,28 @@ namespace Falltergeist
                 std::list<std::shared_ptr<Game::Object>> _objects;
                 std::list<std::shared_ptr<Game::Object>> _flatObjects;
 
+                // Objects from _objects whose scripts implement a broadcast procedure, in the order they were added.
+                // Updated as objects are added, removed or get a new script. While a broadcast runs, removed objects
+                // are replaced with null handles, so it can walk the list by index; they are dropped when it ends.
+                std::map<STANDARD_PROCEDURE, std::vector<Game::ObjectHandle>> _procedureSubscribers;
+                unsigned int _broadcasts = 0;
+                bool _unsubscribed = false;
+                void _subscribe(Game::Object* object);
+                void _unsubscribe(Game::ObjectHandle handle);
+                // calls procedure of every subscriber, objects added meanwhile are not called
+                void _broadcast(STANDARD_PROCEDURE procedure, bool reverse = false);
+
+                // Broadcast procedures (map_update, map_enter, timed_event) share this budget every frame.
+                // Scripts which run out of it are suspended and resumed on the next frames, in the order they were called.
+                VM::ExecutionBudget _scriptBudget;
+                // null handle stands for the map script
+                std::deque<Game::ObjectHandle> _suspendedScripts;
+                void _callBudgeted(Game::ObjectHandle handle, VM::Script *script, STANDARD_PROCEDURE procedure);
+                // logs budget overruns and statistics of a suspended script, rate-limited
+                void _reportSuspended(VM::Script *script);
+                std::chrono::steady_clock::time_point _lastOverrunReport;
+                void _resumeScripts();
+
                 std::unique_ptr<UI::TextArea> _hexagonInfo;
 
                 Event::MouseHandler _mouseDownHandler, _mouseUpHandler, _mouseMoveHandler;
@@ -220,7 +245,7 @@ namespace Falltergeist
 
                 void performScrolling(const float &deltaTime);
 
-                void firstLocationEnter(const float &deltaTime) const;
+                void firstLocationEnter(const float &deltaTime);
 
                 void processTimers(const float &deltaTime);
 
@@ -5,6 +5,7 @@
 #include "../Event/Mouse.h"
 #include "../Format/Dat/MiscFile.h"
 #include "../Format/Lst/File.h"
+#include "../Format/Mve/File.h"
 #include "../Format/Sve/File.h"
 #include "../Game/Game.h"
 #include "../Graphics/Renderer.h"
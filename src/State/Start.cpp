@@ -43,7 +43,7 @@ namespace Falltergeist
 
             setPosition((renderer->size() - Point(640, 480)) / 2);
 
-            addUI("splash", resourceManager->getImage("art/splash/" + splashes.at(rand() % splashes.size())));
+            addUI("splash", resourceManager->getImage("art/splash/" + splashes.at(Game::getInstance()->random().next(0, static_cast<int>(splashes.size()) - 1))));
 
             auto game = Game::getInstance();
             _delayTimer = std::make_unique<Game::Timer>(3000);
@@ -6,6 +6,7 @@
 #include "../Graphics/Renderer.h"
 #include "../UI/ImageList.h"
 #include "../UI/SmallCounter.h"
+#include "../UI/StaticLayer.h"
 #include "../UI/TextArea.h"
 
 namespace Falltergeist
@@ -166,9 +167,33 @@ namespace Falltergeist
 
         void State::render()
         {
-            for (auto& ui : _ui) {
-                if (ui->visible()) {
-                    ui->render(false);
+            // a single element is drawn with one quad anyway, there is nothing to save
+            const size_t minStaticUI = 2;
+
+            size_t first = 0;
+            if (UI::StaticLayer::available()) {
+                _staticUI.clear();
+                for (auto& ui : _ui) {
+                    if (!ui->cacheable()) {
+                        break;
+                    }
+                    _staticUI.push_back(ui.get());
+                }
+
+                if (_staticUI.size() >= minStaticUI) {
+                    if (!_staticLayer) {
+                        _staticLayer = std::make_unique<UI::StaticLayer>();
+                    }
+                    _staticLayer->render(_staticUI);
+                    first = _staticUI.size();
+                } else {
+                    _staticLayer.reset();
+                }
+            }
+
+            for (auto it = _ui.begin() + first; it != _ui.end(); ++it) {
+                if ((*it)->visible()) {
+                    (*it)->render(false);
                 }
             }
             _uiToDelete.clear();
@@ -24,6 +24,7 @@ namespace Falltergeist
     {
         class ImageList;
         class SmallCounter;
+        class StaticLayer;
         class TextArea;
         class Base;
     }
@@ -95,6 +96,8 @@ namespace Falltergeist
                 virtual void think(const float &deltaTime);
                 /**
                  * @brief Renders all visible objects of this state on screen.
+                 * Leading cacheable UI elements (background, buttons, labels) are kept in a StaticLayer
+                 * and only redrawn where they change, the rest is drawn every frame.
                  * This method is called last in the main loop (after handle() and think()).
                  */
                 virtual void render();
@@ -134,6 +137,9 @@ namespace Falltergeist
                 std::vector<std::unique_ptr<UI::Base>> _uiToDelete;
                 std::map<std::string, UI::Base*> _labeledUI;
 
+                std::unique_ptr<UI::StaticLayer> _staticLayer;
+                std::vector<UI::Base*> _staticUI;
+
                 Point _position;
 
                 bool _modal = false; // prevents all states before this one to call think() method
@@ -10,6 +10,7 @@
 #include "../UI/Image.h"
 #include "../UI/ImageButton.h"
 #include "../UI/ImageList.h"
+#include "../UI/StaticLayer.h"
 #include "../UI/TextArea.h"
 
 namespace Falltergeist
@@ -118,6 +119,9 @@ namespace Falltergeist
             signed int worldTileMinY; // start Y coordinate of current tile on world map
             // NB: can be unsigned, but it compared with signed deltaX and deltaY, so...
 
+            // map only moves while travelling, so everything is drawn through the static layer
+            _staticUI.clear();
+
             // copy tiles to screen if needed
             for (unsigned int y=0; y<tilesNumberY; y++)
             {
@@ -136,14 +140,14 @@ namespace Falltergeist
                         ((deltaY<=worldTileMinY+(signed int)tileHeight) && (worldTileMinY+(signed int)tileHeight<=deltaY+(signed int)mapHeight))) )
                     {
                         _tiles->images().at(y*tilesNumberX+x)->setPosition(Point(x*tileWidth-deltaX, y*tileHeight-deltaY));
-                        _tiles->images().at(y*tilesNumberX+x)->render();
+                        _staticUI.push_back(_tiles->images().at(y*tilesNumberX+x).get());
                     }
                 }
             }
 
             // hostpot show
             _hotspot->setPosition(Point(mapMinX + worldMapX - deltaX, mapMinY + worldMapY - deltaY));
-            _hotspot->render();
+            _staticUI.push_back(_hotspot);
 
             // panel
             unsigned int panelX;
@@ -160,7 +164,29 @@ namespace Falltergeist
             panelY = (renderHeight - _panel->size().height()) / 2;
 
             _panel->setPosition(Point(panelX, panelY));
-            _panel->render();
+            _staticUI.push_back(_panel);
+
+            bool cacheable = UI::StaticLayer::available();
+            for (auto ui : _staticUI)
+            {
+                cacheable = cacheable && ui->cacheable();
+            }
+
+            if (cacheable)
+            {
+                if (!_staticLayer)
+                {
+                    _staticLayer = std::make_unique<UI::StaticLayer>();
+                }
+                _staticLayer->render(_staticUI);
+            }
+            else
+            {
+                for (auto ui : _staticUI)
+                {
+                    ui->render();
+                }
+            }
 
         }
 
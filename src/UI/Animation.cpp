@@ -97,8 +97,8 @@ namespace Falltergeist
             }
 
             // TODO: handle cases when main loop FPS is lower than animation FPS
-            if (SDL_GetTicks() - _frameTicks >= _animationFrames.at(_currentFrame)->duration()) {
-                _frameTicks = SDL_GetTicks();
+            if (Game::getInstance()->simulationTime() - _frameTicks >= _animationFrames.at(_currentFrame)->duration()) {
+                _frameTicks = Game::getInstance()->simulationTime();
 
                 _progress += 1;
 
@@ -156,7 +156,7 @@ namespace Falltergeist
             if (!_playing) {
                 _playing = true;
                 _ended = false;
-                _frameTicks = SDL_GetTicks();
+                _frameTicks = Game::getInstance()->simulationTime();
             }
         }
 
@@ -16,6 +16,11 @@ namespace Falltergeist
     {
         using namespace Base;
 
+        namespace
+        {
+            uint32_t lastRevision = 0;
+        }
+
         Base::Base(int x, int y) : Base(Point(x, y))
         {
         }
@@ -23,6 +28,7 @@ namespace Falltergeist
         Base::Base(const Point& pos) : Event::EventTarget(Game::getInstance()->eventDispatcher())
         {
             _position = pos;
+            _revision = ++lastRevision;
         }
 
         Base::~Base()
@@ -404,7 +410,9 @@ namespace Falltergeist
 
         void Base::setLight(bool light)
         {
+            if (_light == light) return;
             _light = light;
+            markDirty();
         }
 
         bool Base::light()
@@ -419,17 +427,37 @@ namespace Falltergeist
 
         void Base::setTrans(Graphics::TransFlags::Trans value)
         {
+            if (_trans == value) return;
             _trans = value;
+            markDirty();
         }
 
         void Base::setOutline(int outline)
         {
+            if (_outline == outline) return;
             _outline=outline;
+            markDirty();
         }
 
         void Base::setLightLevel(unsigned int level)
         {
             _lightLevel = level;
+            markDirty();
+        }
+
+        bool Base::cacheable() const
+        {
+            return false;
+        }
+
+        void Base::markDirty()
+        {
+            _revision = ++lastRevision;
+        }
+
+        uint32_t Base::revision() const
+        {
+            return _revision;
         }
     }
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include "../Event/EventTarget.h"
 #include "../Graphics/Point.h"
@@ -98,6 +99,18 @@ namespace Falltergeist
 
                 void setOutline(int outline);
 
+                /**
+                 * @brief Whether this element can be drawn into a cached StaticLayer.
+                 * Cacheable elements change their look only through position, size, visibility and markDirty().
+                 */
+                virtual bool cacheable() const;
+                /**
+                 * @brief Tells cached layers this element has to be drawn again.
+                 */
+                void markDirty();
+                // Changes whenever element is marked dirty, unique across all elements
+                uint32_t revision() const;
+
             protected:
                 Point _position;
                 Point _offset;
@@ -117,6 +130,7 @@ namespace Falltergeist
 
                 int _outline = 0;
                 unsigned int _lightLevel;
+                uint32_t _revision;
         };
     }
 }
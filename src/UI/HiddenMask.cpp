@@ -23,6 +23,11 @@ namespace Falltergeist
         {
         }
 
+        bool HiddenMask::cacheable() const
+        {
+            return true;
+        }
+
         bool HiddenMask::opaque(const Point &pos)
         {
             return Graphics::Rect::inRect(pos, this->size());
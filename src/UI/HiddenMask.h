@@ -21,6 +21,9 @@ namespace Falltergeist
                 virtual bool opaque(const Point &pos) override;
 
                 void think(const float &deltaTime) override;
+
+                // draws nothing
+                bool cacheable() const override;
         };
     }
 }
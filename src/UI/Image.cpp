@@ -20,6 +20,12 @@ namespace Falltergeist
             return sprite->size();
         }
 
+        bool Image::cacheable() const
+        {
+            // palette cycling would freeze in a cached layer
+            return !sprite->animatedColors();
+        }
+
         bool Image::opaque(unsigned int x, unsigned int y)
         {
             return sprite->opaque(x, y);
@@ -27,6 +27,8 @@ namespace Falltergeist
 
                 virtual Size size() const override;
 
+                virtual bool cacheable() const override;
+
             private:
                 std::unique_ptr<Graphics::Sprite> sprite;
         };
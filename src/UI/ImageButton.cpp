@@ -38,6 +38,7 @@ namespace Falltergeist
             auto sender = dynamic_cast<ImageButton*>(event->target());
             if (sender->checkboxMode) {
                 sender->_checked = !sender->_checked;
+                sender->markDirty();
             }
             if (!sender->buttonUpSoundFilename.empty()) {
                 Game::getInstance()->mixer()->playACMSound(sender->buttonUpSoundFilename);
@@ -75,7 +76,9 @@ namespace Falltergeist
 
         void ImageButton::setChecked(bool _checked)
         {
+            if (this->_checked == _checked) return;
             this->_checked = _checked;
+            markDirty();
         }
 
         bool ImageButton::enabled()
@@ -85,7 +88,9 @@ namespace Falltergeist
 
         void ImageButton::setEnabled(bool _enabled)
         {
+            if (this->_enabled == _enabled) return;
             this->_enabled = _enabled;
+            markDirty();
         }
 
         void ImageButton::handle(Event::Mouse* mouseEvent)
@@ -95,7 +100,12 @@ namespace Falltergeist
             }
             // disable right button clicks
             _rightButtonPressed = false;
+            bool pressed = _leftButtonPressed;
             Base::handle(mouseEvent);
+            // pressed buttons are drawn with the other sprite
+            if (pressed != _leftButtonPressed) {
+                markDirty();
+            }
         }
 
         void ImageButton::render(bool eggTransparency)
@@ -111,6 +121,19 @@ namespace Falltergeist
             buttonUpSprite->render(position().x(), position().y());
         }
 
+        Size ImageButton::size() const
+        {
+            if ((checkboxMode && _checked) || _leftButtonPressed) {
+                return buttonDownSprite->size();
+            }
+            return buttonUpSprite->size();
+        }
+
+        bool ImageButton::cacheable() const
+        {
+            return !buttonUpSprite->animatedColors() && !buttonDownSprite->animatedColors();
+        }
+
         bool ImageButton::opaque(const Point &pos)
         {
             return opaque(pos.x(),pos.y());
@@ -39,6 +39,10 @@ namespace Falltergeist
                 bool opaque(unsigned int x, unsigned int y);
                 virtual bool opaque(const Point &pos) override;
 
+                virtual Size size() const override;
+
+                virtual bool cacheable() const override;
+
             protected:
                 bool checkboxMode = false; // remember new state after click
                 bool _checked = false;
@@ -21,7 +21,9 @@ namespace Falltergeist
 
         void ImageList::setCurrentImage(unsigned int number)
         {
+            if (_currentImage == number) return;
             _currentImage = number;
+            markDirty();
         }
 
         void ImageList::addImage(std::unique_ptr<Image> &image)
@@ -45,6 +47,24 @@ namespace Falltergeist
             return _images.at(currentImage())->opaque(pos);
         }
 
+        Size ImageList::size() const
+        {
+            if (_currentImage >= _images.size()) {
+                return Size(0, 0);
+            }
+            return _images.at(_currentImage)->size();
+        }
+
+        bool ImageList::cacheable() const
+        {
+            for (auto& image : _images) {
+                if (!image->cacheable()) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
         void ImageList::setPosition(const Point &pos)
         {
             Base::setPosition(pos);
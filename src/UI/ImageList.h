@@ -21,6 +21,8 @@ namespace Falltergeist
                 const std::vector<std::unique_ptr<Image>>& images() const;
 
                 virtual bool opaque(const Point &pos) override;
+                virtual Size size() const override;
+                virtual bool cacheable() const override;
 
                 virtual void render(bool eggTransparency) override;
                 virtual void setPosition(const Point &pos) override;
@@ -1,8 +1,9 @@
-﻿#include <bitset>
-#include "../Exception.h"
+﻿#include "../Exception.h"
 #include "../Format/Mve/Chunk.h"
 #include "../Format/Mve/File.h"
 #include "../Game/Game.h"
+#include "../Logger.h"
+#include "../Profiler.h"
 #include "../UI/MvePlayer.h"
 
 namespace Falltergeist
@@ -53,25 +54,32 @@ namespace Falltergeist
         }
 
 
-        MvePlayer::MvePlayer(Format::Mve::File* mve) : Falltergeist::UI::Base()
+        MvePlayer::MvePlayer(std::unique_ptr<Format::Mve::File> mve) : Falltergeist::UI::Base(), _mve(std::move(mve))
         {
             _movie = new Graphics::Movie();
-            _mve = mve;
-            _mve->setPosition(26);
-            _chunk = _mve->getNextChunk();
-            while(!_finished && !_timerStarted ) {
-                _processChunk();
+            if (!_mve) {
+                _decodeFinished = true;
+                return;
             }
+            _decoder = std::thread(&MvePlayer::_decode, this);
         }
 
         MvePlayer::~MvePlayer()
         {
-            delete [] _decodingMap;
-            delete [] _audioBuf;
-            delete _movie;
+            {
+                std::lock_guard<std::mutex> lock(_queueMutex);
+                _stopDecoding = true;
+            }
+            _queueCondition.notify_all();
+            if (_decoder.joinable()) {
+                _decoder.join();
+            }
 
-            SDL_FreeSurface(_currentBuf);
-            SDL_FreeSurface(_backBuf);
+            if (_audio && (_audio->underruns() || _audio->overruns()))
+            {
+                Logger::debug("MVE") << "audio underruns: " << _audio->underruns() << ", overruns: " << _audio->overruns() << std::endl;
+            }
+            delete _movie;
         }
 
         void MvePlayer::render(bool eggTransparency)
@@ -83,630 +91,95 @@ namespace Falltergeist
             _movie->render(_position.x(),_position.y());
         }
 
-        SDL_Rect relClose(uint32_t b, int8_t sign, uint32_t _x, uint32_t _y)
-        {
-            SDL_Rect rect;
-            rect.w=8;
-            rect.h=8;
-            if (b < 56) {
-                rect.x = _x+sign*(8 + (b % 7));
-                rect.y = _y+sign*(b / 7);
-            } else {
-                rect.x = _x+sign*(-14 + ((b - 56) % 29));
-                rect.y = _y+sign*( 8 + ((b - 56) / 29));
-            }
-            return rect;
-        }
-
-        SDL_Rect relFar(uint8_t b, uint32_t _x, uint32_t _y)
-        {
-            int32_t ma, mi;
-            SDL_Rect rect;
-            rect.w = 8;
-            rect.h = 8;
-
-            ma = b >> 4;
-            mi = b & 0xf;
-
-            rect.x = _x + mi - 8;
-            rect.y = _y + ma - 8;
-
-            return rect;
-        }
-
-
-        void MvePlayer::_drawRow(uint32_t x, uint32_t y, uint8_t c1, uint8_t c2, uint8_t mask)
-        {
-            std::bitset<8> bitmask(mask);
-            SDL_Rect dstrect;
-            for (uint32_t dx = 0; dx < 8; dx++) {
-                dstrect.w = 1;
-                dstrect.h = 1;
-                dstrect.x = x + dx;
-                dstrect.y = y;
-                SDL_FillRect(_currentBuf, &dstrect, (bitmask.test(dx) ? c2 : c1));
-            }
-        }
-
-        void MvePlayer::_drawRow2x2(uint32_t x, uint32_t y, uint8_t c1, uint8_t c2, uint8_t mask)
-        {
-            std::bitset<8> bitmask(mask);
-            SDL_Rect dstrect;
-            for (uint32_t di = 0; di < 8; di++) {
-                dstrect.w = 2;
-                dstrect.h = 2;
-                dstrect.x = x + (di % 4) * 2;
-                dstrect.y = y + (di / 4) * 2;
-                SDL_FillRect(_currentBuf, &dstrect, (bitmask.test(di) ? c2 : c1));
-            }
-        }
-
-        void MvePlayer::_drawRow4colors(uint32_t x, uint32_t y, uint8_t c1, uint8_t c2, uint8_t c3, uint8_t c4, uint8_t mask1,uint8_t mask2)
-        {
-            std::bitset<8> bitmasks[2] = {mask1, mask2};
-            SDL_Rect dstrect;
-            for (uint32_t dx = 0;dx < 8; dx++) {
-                dstrect.w = 1;
-                dstrect.h = 1;
-                dstrect.x = x + dx;
-                dstrect.y = y;
-                SDL_FillRect(_currentBuf,&dstrect, (bitmasks[dx/4].test((dx%4)*2+1) ? (bitmasks[dx/4].test((dx%4)*2) ? c4 : c3) : (bitmasks[dx/4].test((dx%4)*2) ? c2 : c1) ));
-            }
-        }
-
-        void MvePlayer::_drawRow4colors2x2(uint32_t x, uint32_t y, uint8_t c1, uint8_t c2, uint8_t c3, uint8_t c4, uint8_t mask)
-        {
-            std::bitset<8> bitmask(mask);
-            SDL_Rect dstrect;
-            for (uint32_t dx = 0; dx < 4; dx++) {
-                dstrect.w = 2;
-                dstrect.h = 2;
-                dstrect.x = x + dx*2;
-                dstrect.y = y;
-                SDL_FillRect(_currentBuf,&dstrect, (bitmask.test(dx*2+1) ? (bitmask.test(dx*2) ? c4 : c3) : (bitmask.test(dx*2) ? c2 : c1) ));
-            }
-        }
-
-        void MvePlayer::_drawRow4colors2x1(uint32_t x, uint32_t y, uint8_t c1, uint8_t c2, uint8_t c3, uint8_t c4, uint8_t mask)
-        {
-            std::bitset<8> bitmask(mask);
-            SDL_Rect dstrect;
-            for (uint32_t dx = 0; dx < 4; dx++) {
-                dstrect.w = 2;
-                dstrect.h = 1;
-                dstrect.x = x + dx*2;
-                dstrect.y = y;
-                SDL_FillRect(_currentBuf,&dstrect, (bitmask.test(dx*2+1) ? (bitmask.test(dx*2) ? c4 : c3) : (bitmask.test(dx*2) ? c2 : c1) ));
-            }
-        }
-
-        void MvePlayer::_drawRow4colors1x2(uint32_t x, uint32_t y, uint8_t c1, uint8_t c2, uint8_t c3, uint8_t c4, uint8_t mask1, uint8_t mask2)
-        {
-            std::bitset<8> bitmasks[2]={mask1,mask2};
-            SDL_Rect dstrect;
-            for (uint32_t dx = 0; dx < 8; dx++) {
-                dstrect.w = 1;
-                dstrect.h = 2;
-                dstrect.x = x + dx;
-                dstrect.y = y;
-                SDL_FillRect(_currentBuf,&dstrect, (bitmasks[dx/4].test((dx%4)*2+1) ? (bitmasks[dx/4].test((dx%4)*2) ? c4 : c3) : (bitmasks[dx/4].test((dx%4)*2) ? c2 : c1) ));
-            }
-
-        }
-
-
-        void MvePlayer::_drawQuadrant(uint32_t x, uint32_t y, uint8_t c1, uint8_t c2, uint8_t mask1, uint8_t mask2)
+        void MvePlayer::_storeFrame()
         {
-            std::bitset<8> bitmask1(mask1);
-            std::bitset<8> bitmask2(mask2);
-            SDL_Rect dstrect;
-            for (uint32_t dy = 0; dy < 4; dy++) {
-                for (uint32_t dx = 0; dx < 4; dx++) {
-                    dstrect.w = 1;
-                    dstrect.h = 1;
-                    dstrect.x = x + dx;
-                    dstrect.y = y + dy;
-                    if (dy < 2) {
-                        SDL_FillRect(_currentBuf,&dstrect, (bitmask1.test(4*(dy%2)+dx) ? c2 : c1));
-                    } else {
-                        SDL_FillRect(_currentBuf,&dstrect, (bitmask2.test(4*(dy%2)+dx) ? c2 : c1));
-                    }
-                }
+            // texture can only be updated from the main thread, so keep decoded frame until it's shown
+            if (!_pendingFrame) {
+                _pendingFrame = _acquireFrame();
             }
-
-        }
-
-
-        void MvePlayer::_drawQuadrant4colors(uint32_t x, uint32_t y, uint8_t c1, uint8_t c2, uint8_t c3, uint8_t c4, uint8_t mask1, uint8_t mask2, uint8_t mask3, uint8_t mask4)
-        {
-            std::bitset<8> bitmasks[4];
-            bitmasks[0] = mask1;
-            bitmasks[1] = mask2;
-            bitmasks[2] = mask3;
-            bitmasks[3] = mask4;
-            SDL_Rect dstrect;
-            for (uint32_t dy = 0; dy < 4; dy++) {
-                for (uint32_t dx = 0; dx < 4; dx++) {
-                    dstrect.w = 1;
-                    dstrect.h = 1;
-                    dstrect.x = x + dx;
-                    dstrect.y = y + dy;
-                    SDL_FillRect(_currentBuf,&dstrect, (bitmasks[dy].test(dx*2+1) ? (bitmasks[dy].test(dx*2) ? c4 : c3) : (bitmasks[dy].test(dx*2) ? c2 : c1) ));
-                }
-            }
-        }
-
-        void MvePlayer::_decodeFrame(uint8_t* data, uint32_t len)
-        {
-            uint32_t h = (_currentBuf->h / 8);
-            uint32_t w = (_currentBuf->w / 8);
-            uint32_t curMap;
-            SDL_Rect srcrect;
-            SDL_Rect dstrect;
-            uint8_t color;
-            for (uint32_t y = 0; y < h;y++) {
-                for (uint32_t x = 0; x < w;x++) {
-                    curMap = (y*w + x);
-                    switch (_decodingMap[curMap])
-                    {
-                        case 0x0:
-                            //copy from backbuf
-                            srcrect.w = 8;
-                            srcrect.h = 8;
-                            srcrect.x = x*8;
-                            srcrect.y = y*8;
-                            SDL_BlitSurface(_backBuf, &srcrect, _currentBuf, &srcrect); // Conditional jump or move depends on uninitialised value(s)
-                            break;
-                        case 0x1:
-                            //copy from back-back buff -> copy from current frame -> do nothing
-                            break;
-                        case 0x2:
-                            srcrect = relClose(data[0], 1, x*8, y*8);
-                            dstrect.w = 8;
-                            dstrect.h = 8;
-                            dstrect.x = x*8;
-                            dstrect.y = y*8;
-                            SDL_BlitSurface(_currentBuf, &srcrect, _currentBuf, &dstrect);
-                            data++;
-                            len--;
-                            break;
-                        case 0x3:
-                            srcrect = relClose(data[0], -1, x*8, y*8);
-                            dstrect.w = 8;
-                            dstrect.h = 8;
-                            dstrect.x = x*8;
-                            dstrect.y = y*8;
-                            SDL_BlitSurface(_currentBuf, &srcrect, _currentBuf, &dstrect);
-                            data++;
-                            len--;
-                            break;
-                        case 0x4:
-                            srcrect = relFar(data[0], x*8, y*8);
-                            dstrect.w = 8;
-                            dstrect.h = 8;
-                            dstrect.x = x*8;
-                            dstrect.y = y*8;
-                            SDL_BlitSurface(_backBuf, &srcrect, _currentBuf, &dstrect);
-                            data++;
-                            len--;
-                            break;
-                        case 0x5:
-                            srcrect.w = 8;
-                            srcrect.h = 8;
-                            dstrect.w = 8;
-                            dstrect.h = 8;
-                            dstrect.x = x*8;
-                            dstrect.y = y*8;
-                            srcrect.x = x*8 + (int8_t)data[0];
-                            srcrect.y = y*8 + (int8_t)data[1];
-                            SDL_BlitSurface(_backBuf, &srcrect, _currentBuf, &dstrect);
-                            data += 2;
-                            len -= 2;
-                            break;
-                        case 0x6:
-                            //skip 2 blocks
-                            x++;
-                            if (x >= w) {
-                                x = 0;
-                                y++;
-                            }
-                            x++;
-                            if (x >= w) {
-                                x = 0;
-                                y++;
-                            }
-                            break;
-                        //hell
-                        case 0x7:
-                            if (data[0]<=data[1]) {
-                                _drawRow(x*8, y*8,     data[0], data[1], data[2] );
-                                _drawRow(x*8, y*8 + 1, data[0], data[1], data[3] );
-                                _drawRow(x*8, y*8 + 2, data[0], data[1], data[4] );
-                                _drawRow(x*8, y*8 + 3, data[0], data[1], data[5] );
-                                _drawRow(x*8, y*8 + 4, data[0], data[1], data[6] );
-                                _drawRow(x*8, y*8 + 5, data[0], data[1], data[7] );
-                                _drawRow(x*8, y*8 + 6, data[0], data[1], data[8]);
-                                _drawRow(x*8, y*8 + 7, data[0], data[1], data[9]);
-                                data += 10;
-                                len -= 10;
-                            } else {
-                                _drawRow2x2(x*8, y*8,     data[0], data[1], data[2]);
-                                _drawRow2x2(x*8, y*8 + 4, data[0], data[1], data[3]);
-                                data += 4;
-                                len -= 4;
-                            }
-                            break;
-                        case 0x8:
-                            if (data[0] <= data[1]) {
-                                // cross-split
-                                // 0 | 2
-                                // -----
-                                // 1 | 3
-                                _drawQuadrant(x*8,     y*8,     data[0],  data[1],  data[2],  data[3] );
-                                _drawQuadrant(x*8,     y*8 + 4, data[4],  data[5],  data[6],  data[7] );
-                                _drawQuadrant(x*8 + 4, y*8,     data[8],  data[9],  data[10], data[11]);
-                                _drawQuadrant(x*8 + 4, y*8 + 4, data[12], data[13], data[14], data[15]);
-                                data+=16;
-                                len-=16;
-                            } else {
-                                if (data[6] <= data[7]) {
-                                    //left|right split. same as above, except uses 1 byte per 2 4x4 blocks
-                                    // 0 | 2
-                                    // 1 | 3
-                                    _drawQuadrant(x*8,     y*8,     data[0], data[1], data[2],  data[3] );
-                                    _drawQuadrant(x*8,     y*8 + 4, data[0], data[1], data[4],  data[5] );
-                                    _drawQuadrant(x*8 + 4, y*8,     data[6], data[7], data[8],  data[9] );
-                                    _drawQuadrant(x*8 + 4, y*8 + 4, data[6], data[7], data[10], data[11]);
-                                } else {
-                                    //top|bottom split
-                                    // 0 1
-                                    //-----
-                                    // 2 3
-                                    _drawRow(x*8, y*8,     data[0], data[1], data[2] );
-                                    _drawRow(x*8, y*8 + 1, data[0], data[1], data[3] );
-                                    _drawRow(x*8, y*8 + 2, data[0], data[1], data[4] );
-                                    _drawRow(x*8, y*8 + 3, data[0], data[1], data[5] );
-                                    _drawRow(x*8, y*8 + 4, data[6], data[7], data[8] );
-                                    _drawRow(x*8, y*8 + 5, data[6], data[7], data[9] );
-                                    _drawRow(x*8, y*8 + 6, data[6], data[7], data[10]);
-                                    _drawRow(x*8, y*8 + 7, data[6], data[7], data[11]);
-                                }
-                                data += 12;
-                                len -= 12;
-                            }
-                            break;
-                        case 0x9:
-                            if (data[0] <= data[1] && data[2] <= data[3]) {
-                                _drawRow4colors(x*8, y*8,     data[0], data[1], data[2], data[3], data[4],   data[5] );
-                                _drawRow4colors(x*8, y*8 + 1, data[0], data[1], data[2], data[3], data[6],   data[7] );
-                                _drawRow4colors(x*8, y*8 + 2, data[0], data[1], data[2], data[3], data[8],   data[9] );
-                                _drawRow4colors(x*8, y*8 + 3, data[0], data[1], data[2], data[3], data[10],  data[11]);
-                                _drawRow4colors(x*8, y*8 + 4, data[0], data[1], data[2], data[3], data[12],  data[13]);
-                                _drawRow4colors(x*8, y*8 + 5, data[0], data[1], data[2], data[3], data[14],  data[15]);
-                                _drawRow4colors(x*8, y*8 + 6, data[0], data[1], data[2], data[3], data[16],  data[17]);
-                                _drawRow4colors(x*8, y*8 + 7, data[0], data[1], data[2], data[3], data[18],  data[19]);
-                                data += 20;
-                                len -= 20;
-                            } else if (data[0] <= data[1] && data[2] > data[3]) {
-                                _drawRow4colors2x2(x*8, y*8,     data[0], data[1], data[2], data[3], data[4]);
-                                _drawRow4colors2x2(x*8, y*8 + 2, data[0], data[1], data[2], data[3], data[5]);
-                                _drawRow4colors2x2(x*8, y*8 + 4, data[0], data[1], data[2], data[3], data[6]);
-                                _drawRow4colors2x2(x*8, y*8 + 6, data[0], data[1], data[2], data[3], data[7]);
-                                data += 8;
-                                len -= 8;
-                            } else if (data[0] > data[1] && data[2] <= data[3]) {
-                                _drawRow4colors2x1(x*8, y*8,     data[0], data[1], data[2], data[3], data[4] );
-                                _drawRow4colors2x1(x*8, y*8 + 1, data[0], data[1], data[2], data[3], data[5] );
-                                _drawRow4colors2x1(x*8, y*8 + 2, data[0], data[1], data[2], data[3], data[6] );
-                                _drawRow4colors2x1(x*8, y*8 + 3, data[0], data[1], data[2], data[3], data[7] );
-                                _drawRow4colors2x1(x*8, y*8 + 4, data[0], data[1], data[2], data[3], data[8] );
-                                _drawRow4colors2x1(x*8, y*8 + 5, data[0], data[1], data[2], data[3], data[9] );
-                                _drawRow4colors2x1(x*8, y*8 + 6, data[0], data[1], data[2], data[3], data[10]);
-                                _drawRow4colors2x1(x*8, y*8 + 7, data[0], data[1], data[2], data[3], data[11]);
-                                data += 12;
-                                len -= 12;
-                            } else if (data[0] > data[1] && data[2] > data[3]) {
-                                _drawRow4colors1x2(x*8, y*8,     data[0], data[1], data[2], data[3], data[4],  data[5]);
-                                _drawRow4colors1x2(x*8, y*8 + 2, data[0], data[1], data[2], data[3], data[6],  data[7]);
-                                _drawRow4colors1x2(x*8, y*8 + 4, data[0], data[1], data[2], data[3], data[8],  data[9]);
-                                _drawRow4colors1x2(x*8, y*8 + 6, data[0], data[1], data[2], data[3], data[10], data[11]);
-                                data += 12;
-                                len -= 12;
-                            }
-                            break;
-                        case 0xA:
-                            if (data[0] <= data[1]) {
-                                // quadrant. 4 colors per block, 2 bits of pattern per pixel
-                                // 0 | 2
-                                // -----
-                                // 1 | 3
-                                _drawQuadrant4colors(x*8,     y*8,     data[0],  data[1],  data[2],  data[3],  data[4],  data[5],  data[6],  data[7] );
-                                _drawQuadrant4colors(x*8,     y*8 + 4, data[8],  data[9],  data[10], data[11], data[12], data[13], data[14], data[15]);
-                                _drawQuadrant4colors(x*8 + 4, y*8,     data[16], data[17], data[18], data[19], data[20], data[21], data[22], data[23]);
-                                _drawQuadrant4colors(x*8 + 4, y*8 + 4, data[24], data[25], data[26], data[27], data[28], data[29], data[30], data[31]);
-
-                                data += 32;
-                                len -= 32;
-                            } else {
-                                if (data[12] <= data[13]) {
-                                    //vertical split, 4 colors per half
-                                    // 0 | 2
-                                    // 1 | 3
-                                    _drawQuadrant4colors(x*8,     y*8,     data[0],  data[1],  data[2],  data[3],  data[4],  data[5],  data[6],  data[7] );
-                                    _drawQuadrant4colors(x*8,     y*8 + 4, data[0],  data[1],  data[2],  data[3],  data[8],  data[9],  data[10], data[11]);
-                                    _drawQuadrant4colors(x*8 + 4, y*8,     data[12], data[13], data[14], data[15], data[16], data[17], data[18], data[19]);
-                                    _drawQuadrant4colors(x*8 + 4, y*8 + 4, data[12], data[13], data[14], data[15], data[20], data[21], data[22], data[23]);
-                                } else {
-                                    //horizontal split, 4 colors per half
-                                    // 0  1
-                                    //-----
-                                    // 2  3
-                                    _drawRow4colors(x*8, y*8,     data[0],  data[1],  data[2],  data[3],  data[4],   data[5] );
-                                    _drawRow4colors(x*8, y*8 + 1, data[0],  data[1],  data[2],  data[3],  data[6],   data[7] );
-                                    _drawRow4colors(x*8, y*8 + 2, data[0],  data[1],  data[2],  data[3],  data[8],   data[9] );
-                                    _drawRow4colors(x*8, y*8 + 3, data[0],  data[1],  data[2],  data[3],  data[10],  data[11]);
-                                    _drawRow4colors(x*8, y*8 + 4, data[12], data[13], data[14], data[15], data[16],  data[17]);
-                                    _drawRow4colors(x*8, y*8 + 5, data[12], data[13], data[14], data[15], data[18],  data[19]);
-                                    _drawRow4colors(x*8, y*8 + 6, data[12], data[13], data[14], data[15], data[20],  data[21]);
-                                    _drawRow4colors(x*8, y*8 + 7, data[12], data[13], data[14], data[15], data[22],  data[23]);
-                                }
-                                data += 24;
-                                len -= 24;
-                            }
-                            break;
-                        //raw data
-                        case 0xB:
-                            dstrect.w = 1;
-                            dstrect.h = 1;
-                            for (uint32_t fy = 0; fy < 8; fy++) {
-                                for (uint32_t fx = 0; fx < 8; fx++) {
-                                    color=data[fy*8 + fx];
-                                    dstrect.x = x*8 + fx;
-                                    dstrect.y = y*8 + fy;
-                                    SDL_FillRect(_currentBuf, &dstrect, color);
-                                }
-                            }
-                            data += 64;
-                            len -= 64;
-                            break;
-                        case 0xC:
-                            dstrect.w = 2;
-                            dstrect.h = 2;
-                            for (uint32_t fy = 0; fy < 4; fy++) {
-                                for (uint32_t fx = 0; fx < 4; fx++) {
-                                    color = data[fy*4 + fx];
-                                    dstrect.x = x*8 + fx*2;
-                                    dstrect.y = y*8 + fy*2;
-                                    SDL_FillRect(_currentBuf, &dstrect, color);
-                                }
-                            }
-                            data += 16;
-                            len -= 16;
-                            break;
-                        case 0xD:
-                            dstrect.w = 4;
-                            dstrect.h = 4;
-                            for (uint32_t fy = 0; fy < 2; fy++) {
-                                for (uint32_t fx = 0; fx < 2; fx++) {
-                                    color = data[fy*2 + fx];
-                                    dstrect.x = x*8 + fx*4;
-                                    dstrect.y = y*8 + fy*4;
-                                    SDL_FillRect(_currentBuf, &dstrect, color);
-                                }
-                            }
-                            data += 4;
-                            len -= 4;
-                            break;
-                        case 0xE:
-                            dstrect.w = 8;
-                            dstrect.h = 8;
-                            color = data[0];
-                            dstrect.x = x*8;
-                            dstrect.y = y*8;
-                            SDL_FillRect(_currentBuf, &dstrect, color);
-                            data++;
-                            len--;
-                            break;
-                        //check-board
-                        case 0xF:
-                            dstrect.w = 1;
-                            dstrect.h = 1;
-                            uint32_t even = 0;
-                            for (uint32_t fy = 0; fy < 8; fy++)
-                            {
-                                for (uint32_t fx = 0; fx < 8; fx++)
-                                {
-                                    color = data[even%2];
-                                    dstrect.x = x*8 + fx;
-                                    dstrect.y = y*8 + fy;
-                                    SDL_FillRect(_currentBuf, &dstrect, color);
-                                    even++;
-                                }
-                                even++;
-                            }
-                            data += 2;
-                            len -= 2;
-                            break;
-                    }
-                }
+            if (!_pendingFrame) {
+                std::lock_guard<std::mutex> lock(_queueMutex);
+                _frames.push_back(std::make_unique<Frame>());
+                _pendingFrame = _frames.back().get();
             }
+            _pendingFrame->width = _video.width();
+            _pendingFrame->height = _video.height();
+            _pendingFrame->pixels.assign(_video.pixels(), _video.pixels() + _video.width() * _video.height());
+            _pendingFrame->palette = _video.palette();
         }
 
-        void MvePlayer::_decodeVideo( uint8_t* data, uint32_t len )
+        MvePlayer::Frame* MvePlayer::_acquireFrame()
         {
-        /*
-            int16_t nFrameHot, nFrameCold;
-            int16_t nXoffset, nYoffset;
-            int16_t nXsize, nYsize;
-        */
-            int16_t nFlags;
-
-        /*
-            nFrameHot  = get_short(data);
-            nFrameCold = get_short(data+2);
-            nXoffset   = get_short(data+4);
-            nYoffset   = get_short(data+6);
-            nXsize     = get_short(data+8);
-            nYsize     = get_short(data+10);
-        */
-            nFlags     = get_short(data+12);
-
-            if (nFlags & 1)
-            {
-                SDL_Surface* temp;
-                temp = _currentBuf;
-                _currentBuf = _backBuf;
-                _backBuf = temp;
+            // queue holds at most FRAME_QUEUE_SIZE frames and one more is being decoded, so the pool never grows past that
+            std::lock_guard<std::mutex> lock(_queueMutex);
+            if (_freeFrames.empty()) {
+                return nullptr;
             }
-            _decodeFrame(data + 14, len - 14);
-
-            SDL_PixelFormat* format = SDL_AllocFormat(SDL_PIXELFORMAT_BGR888);
-            SDL_Surface *temp = SDL_ConvertSurface(_currentBuf, format, 0);
-            _movie->loadFromSurface(temp);
-            SDL_FreeSurface(temp);
-            SDL_FreeFormat(format);
+            Frame* frame = _freeFrames.back();
+            _freeFrames.pop_back();
+            return frame;
         }
 
-        void MvePlayer::_setDecodingMap(uint8_t* data)
+        void MvePlayer::_initAudioBuffer(uint8_t version, uint8_t* data)
         {
-            uint32_t w = _currentBuf->w / 8;
-            uint32_t h = _currentBuf->h / 8;
-
-            for (uint32_t i = 0; i < w*h/2; i++)
+        //  uint16_t flags=get_short(data+2);
+        //  std::bitset<16> bit(flags);
+        //  uint16_t sample_rate=get_short(data+4); //always 22050
+            // audio callback may already be reading it, so the buffer is created only once
+            if (_audioReady)
             {
-              _decodingMap[i*2] = data[i] & 0x0F;
-              _decodingMap[i*2 + 1] = (data[i] >> 4) & 0x0F;
+                return;
             }
+            // decoder runs ahead of playback, so there must be room for more than the movie asks for
+            uint32_t buflen = get_int(data + 6) + AUDIO_HEADROOM;
+            _audio = std::make_unique<Audio::RingBuffer<int16_t>>(buflen);
+            _audioReady = true;
         }
 
-        void MvePlayer::_setPalette(uint8_t* data)
+        void MvePlayer::_playAudio()
         {
-            uint16_t start = get_short(data);
-            uint16_t count = get_short(data+2);
-            SDL_Color palette[256];
-            palette[0].r = 0;
-            palette[0].g = 0;
-            palette[0].b = 0;
-            palette[0].a = 0;
-            uint8_t* pal = data;
-            pal+=4;
-
-            for (uint16_t i = start; i <= count; i++)
-            {
-                palette[i].r = *(pal++) << 2;
-                palette[i].g = *(pal++) << 2;
-                palette[i].b = *(pal++) << 2;
-                palette[i].a = 0;
-            }
-            int ret = 1;
-            if (_currentBuf)
-            {
-                ret = SDL_SetPaletteColors(_currentBuf->format->palette, palette, 0, 256);
-            }
-            if (_backBuf)
-            {
-                ret = SDL_SetPaletteColors(_backBuf->format->palette, palette, 0, 256);
-            }
-            if (ret != 0)
-            {
-                throw new Exception(SDL_GetError());
-            }
         }
 
-        void MvePlayer::_sendVideoBuffer(uint8_t* data)
-        {
-            _frame++;
-        }
 
-        void MvePlayer::_initVideoBuffer(uint8_t* data)
+        uint32_t MvePlayer::samplesLeft()
         {
-            uint16_t width  = 0;
-            uint16_t height = 0;
-            // size, apparently in 8x8 pixel blocks
-            width = get_short(data) * 8;
-            height = get_short(data+2) * 8;
-
-            if (_currentBuf != nullptr) return;
-            if (_backBuf != nullptr) return;
-
-            _currentBuf = SDL_CreateRGBSurface(0, width, height, 8, 0, 0, 0, 0);
-            if (!_currentBuf)
+            if (!_audioReady)
             {
-                throw new Exception(SDL_GetError());
-            }
-
-            _backBuf = SDL_CreateRGBSurface(0, width, height, 8, 0, 0, 0, 0);
-            if (!_backBuf)
-            {
-                throw new Exception(SDL_GetError());
+                return 0;
             }
-
-            if (_decodingMap != nullptr) return;
-            // decoding map is 4 bits per 8x8 block
-            _decodingMap = new uint8_t [(width*height / (8*8))];
-
+            return static_cast<uint32_t>(_audio->size());
         }
 
-
-        void MvePlayer::_initAudioBuffer(uint8_t version, uint8_t* data)
+        bool MvePlayer::audioFinished()
         {
-        //  uint16_t flags=get_short(data+2);
-        //  std::bitset<16> bit(flags);
-        //  uint16_t sample_rate=get_short(data+4); //always 22050
-            uint32_t buflen = get_int(data + 6);
-            _audioBuf = new int16_t[buflen];
-            _audioBufHead = 0;
-            _audioBufTail = 0;
-            _audioBufSize = buflen;
-        }
-
-        void MvePlayer::_playAudio()
-        {
-        }
-
-
-        uint32_t MvePlayer::samplesLeft()
-        {
-            return _samplesReady;
+            return _audioFinished;
         }
 
         uint32_t MvePlayer::getAudio(uint8_t* data, uint32_t len)
         {
-            if (!_timerStarted)
+            if (!_timerStarted || !_audioReady)
             {
                 return 0;
             }
-            uint32_t res = 0;
-            int16_t *buf = (int16_t*)data;
-            while (res < len / 2)
-            {
-                if (_samplesReady <= 0) break;
-                *buf = _audioBuf[_audioBufHead];
-                buf++;
-                _audioBufHead++;
-                if (_audioBufHead >= _audioBufSize) _audioBufHead = 0;
-                res++;
-                _samplesReady--;
-            }
-            return res;
+            return static_cast<uint32_t>(_audio->read(reinterpret_cast<int16_t*>(data), len / 2));
         }
 
         void MvePlayer::_decodeAudio(uint8_t* data, uint32_t len)
         {
+            if (!_audioReady)
+            {
+                return;
+            }
+
             uint16_t strlen = get_short(data + 4);
             data += 6;
             int16_t left = get_short(data);
             int16_t right = get_short(data + 2);
             data += 4;
 
-            _audioBuf[_audioBufTail] = left;
-            _audioBufTail++;
-            _samplesReady++;
-            if (_audioBufTail >= _audioBufSize) _audioBufTail = 0;
-            _audioBuf[_audioBufTail] = right;
-            _audioBufTail++;
-            _samplesReady++;
-            if (_audioBufTail >= _audioBufSize) _audioBufTail = 0;
+            _audioSamples.clear();
+            _audioSamples.push_back(left);
+            _audioSamples.push_back(right);
 
             for (int32_t i = 0; i < strlen/2-2; i++)
             {
@@ -714,29 +187,28 @@ namespace Falltergeist
                 {
                     left += audio_exp_table[data[i]];
                     left = clip_int16(left);
-                    _audioBuf[_audioBufTail] = left;
+                    _audioSamples.push_back(left);
                 }
                 else
                 {
                     right += audio_exp_table[data[i]];
                     right = clip_int16(right);
-                    _audioBuf[_audioBufTail] = right;
+                    _audioSamples.push_back(right);
                 }
-                _audioBufTail++;
-                _samplesReady++;
-                if (_audioBufTail >= _audioBufSize) _audioBufTail = 0;
             }
+
+            // nobody drains the buffer if audio is disabled: samples which don't fit are dropped and counted
+            _audio->write(_audioSamples.data(), _audioSamples.size());
         }
 
-        void MvePlayer::_processChunk()
+        bool MvePlayer::_processChunk(Format::Mve::Chunk& chunk)
         {
-            if (static_cast<Chunk>(_chunk->type()) == Chunk::END)
+            if (static_cast<Chunk>(chunk.type()) == Chunk::END)
             {
-                _finished = true;
-                return;
+                return false;
             }
 
-            auto& opcodes = _chunk->opcodes();
+            auto& opcodes = chunk.opcodes();
             for (auto& opcode : opcodes)
             {
                 switch (static_cast<Opcode>(opcode.type()))
@@ -748,9 +220,7 @@ namespace Falltergeist
                         _timerStarted = true;
                         break;
                     case Opcode::END_STREAM:
-                        _finished = true;
-                        return;
-                        break;
+                        return false;
                     case Opcode::INIT_AUDIO_BUF:
                         _initAudioBuffer(opcode.version(), opcode.data());
                         break;
@@ -759,11 +229,10 @@ namespace Falltergeist
                         break;
                     case Opcode::INIT_VIDIO_BUF:
                         //can be called multiple times (intro and tanker)
-                        _initVideoBuffer(opcode.data());
+                        _video.decode(opcode);
                         break;
                     case Opcode::SEND_BUFFER:
-                        _sendVideoBuffer(opcode.data());
-                        //copy buffer to texture (with palette)
+                        // frame was already stored on VIDEO_DATA, it's counted when it's shown
                         break;
                     case Opcode::AUDIO_DATA:
                         _decodeAudio(opcode.data(), opcode.length());
@@ -777,16 +246,16 @@ namespace Falltergeist
                         break;
                     case Opcode::SET_PALETTE:
                         //can be called several times (intro and tanker)
-                        _setPalette(opcode.data());
+                        _video.decode(opcode);
                         break;
                     case Opcode::SET_PALETTE_COMPRESSED:
                         break;
                     case Opcode::SET_DECODING_MAP:
-                        _setDecodingMap(opcode.data());
+                        _video.decode(opcode);
                         break;
                     case Opcode::VIDEO_DATA:
-                        _decodeVideo(opcode.data(), opcode.length());
-                        //set (buffer) texture
+                        _video.decode(opcode);
+                        _storeFrame();
                         break;
                     case Opcode::UNKNOWN_0x06:
                     case Opcode::UNKNOWN_0xe:
@@ -799,19 +268,133 @@ namespace Falltergeist
                         break;
                 }
             }
-            _chunk = _mve->getNextChunk();
+            return true;
+        }
+
+        // decoder thread
+        void MvePlayer::_decode()
+        {
+            Format::Mve::Chunk chunk;
+            try
+            {
+                while (_mve->readChunk(chunk))
+                {
+                    bool timerStarted = _timerStarted;
+                    bool hasMore;
+                    {
+                        ProfilerZone zone("MvePlayer::decodeChunk");
+                        hasMore = _processChunk(chunk);
+                    }
+                    if (!hasMore)
+                    {
+                        break;
+                    }
+
+                    std::unique_lock<std::mutex> lock(_queueMutex);
+                    _queueCondition.wait(lock, [this]() { return _stopDecoding || _queue.size() < FRAME_QUEUE_SIZE; });
+                    if (_stopDecoding)
+                    {
+                        break;
+                    }
+                    QueuedChunk queued;
+                    queued.frame = _pendingFrame;
+                    queued.immediate = !timerStarted;
+                    _queue.push_back(queued);
+                    _pendingFrame = nullptr;
+                }
+            }
+            catch (const std::exception& e)
+            {
+                std::lock_guard<std::mutex> lock(_queueMutex);
+                _decodeError = e.what();
+            }
+
+            std::lock_guard<std::mutex> lock(_queueMutex);
+            if (_pendingFrame)
+            {
+                _freeFrames.push_back(_pendingFrame);
+                _pendingFrame = nullptr;
+            }
+            _decodeFinished = true;
+            _audioFinished = true;
+        }
+
+        bool MvePlayer::_popChunk(QueuedChunk& chunk)
+        {
+            std::lock_guard<std::mutex> lock(_queueMutex);
+            if (_queue.empty())
+            {
+                if (_decodeFinished)
+                {
+                    if (!_decodeError.empty())
+                    {
+                        Logger::error("MVE") << _decodeError << std::endl;
+                    }
+                    _finished = true;
+                }
+                return false;
+            }
+            chunk = _queue.front();
+            _queue.pop_front();
+            _queueCondition.notify_all();
+            return true;
+        }
+
+        void MvePlayer::_showChunk(const QueuedChunk& chunk)
+        {
+            if (!chunk.frame)
+            {
+                return;
+            }
+            auto frame = chunk.frame;
+            _movie->loadFrame(frame->pixels.data(), frame->width, frame->height, frame->palette.data());
+            _frame++;
+
+            std::lock_guard<std::mutex> lock(_queueMutex);
+            _freeFrames.push_back(chunk.frame);
         }
 
         void MvePlayer::think(const float &deltaTime)
         {
-            if (!_timerStarted) {
+            if (_finished)
+            {
                 return;
             }
 
-            if (_millisecondsTracked >= _delay / 1000) // 66.728
+            if (!_timerStarted)
             {
-                _millisecondsTracked -= _delay / 1000;
-                _processChunk();
+                std::lock_guard<std::mutex> lock(_queueMutex);
+                if (_decodeFinished)
+                {
+                    _finished = true;
+                }
+                return;
+            }
+
+            QueuedChunk chunk;
+            {
+                // chunks decoded before the timer was created (movie setup) are not paced
+                std::unique_lock<std::mutex> lock(_queueMutex);
+                while (!_queue.empty() && _queue.front().immediate)
+                {
+                    chunk = _queue.front();
+                    _queue.pop_front();
+                    _queueCondition.notify_all();
+                    lock.unlock();
+                    _showChunk(chunk);
+                    lock.lock();
+                }
+            }
+
+            float delay = static_cast<float>(_delay / 1000); // 66.728
+            if (_millisecondsTracked >= delay)
+            {
+                // if decoder is late, time is not consumed and the chunk is shown as soon as it's ready
+                if (_popChunk(chunk))
+                {
+                    _millisecondsTracked -= delay;
+                    _showChunk(chunk);
+                }
             }
 
             _millisecondsTracked += deltaTime;
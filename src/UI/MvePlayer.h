@@ -1,7 +1,17 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <condition_variable>
 #include <ctime>
-#include <SDL.h>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../Audio/RingBuffer.h"
+#include "../Format/Mve/Decoder.h"
 #include "../Graphics/Movie.h"
 #include "../UI/Base.h"
 
@@ -17,50 +27,94 @@ namespace Falltergeist
     }
     namespace UI
     {
+        /**
+         * Plays Interplay MVE movie. Chunks are read and decoded on a worker thread, which runs a few frames
+         * ahead of playback. The main thread only uploads ready frames to the texture, so decoding never stalls
+         * the game loop, and memory use doesn't depend on movie length.
+         * Frames are kept as palette indexes plus palette and are resolved to colors by the shader.
+         */
         class MvePlayer : public Falltergeist::UI::Base
         {
             public:
-                MvePlayer(Format::Mve::File* mve);
+                MvePlayer(std::unique_ptr<Format::Mve::File> mve);
                 ~MvePlayer() override;
 
                 void think(const float &deltaTime) override;
                 void render(bool eggTransparency = false) override;
                 bool finished();
+                // Called from audio thread, returns number of samples copied
                 uint32_t getAudio(uint8_t* data, uint32_t len);
                 uint32_t samplesLeft();
+                // Decoder has reached the end of the movie, no more audio samples will be added
+                bool audioFinished();
                 // Current frame number
                 uint32_t frame();
 
             private:
-                Format::Mve::File* _mve = nullptr;
-                std::unique_ptr<Format::Mve::Chunk> _chunk;
+                // decoded frames allowed to wait for display
+                static const size_t FRAME_QUEUE_SIZE = 4;
+                // extra audio buffer space for samples decoded ahead, in samples (one second of stereo)
+                static const uint32_t AUDIO_HEADROOM = 22050 * 2;
+
+                // Decoded frame waiting to be uploaded
+                struct Frame
+                {
+                    std::vector<uint8_t> pixels;
+                    unsigned int width = 0;
+                    unsigned int height = 0;
+                    std::array<uint32_t, 256> palette;
+                };
+
+                // One chunk worth of playback time. Chunks without video have no frame, but still take their time slot.
+                struct QueuedChunk
+                {
+                    Frame* frame = nullptr;
+                    // chunk was decoded before the timer started, show it right away
+                    bool immediate = false;
+                };
+
+                std::unique_ptr<Format::Mve::File> _mve;
 
                 Graphics::Movie* _movie;
 
-                bool _timerStarted = false;
+                std::atomic<bool> _timerStarted{false};
+                std::atomic<uint32_t> _delay{0};
+                // main thread only: all chunks were shown
                 bool _finished = false;
 
-                uint8_t* _decodingMap = nullptr;
-                int16_t* _audioBuf = nullptr;
+                std::thread _decoder;
+                std::mutex _queueMutex;
+                std::condition_variable _queueCondition;
+                std::deque<QueuedChunk> _queue;
+                std::vector<Frame*> _freeFrames;
+                std::vector<std::unique_ptr<Frame>> _frames;
+                bool _decodeFinished = false;
+                bool _stopDecoding = false;
+                // frame being filled by the decoder for the current chunk
+                Frame* _pendingFrame = nullptr;
+                std::string _decodeError;
 
-                uint32_t  _frame = 0;
-                uint32_t _delay = 0;
-                uint32_t _audioBufHead = 0;
-                uint32_t _audioBufTail = 0;
-                uint32_t _audioBufSize = 0;
-                uint32_t _samplesReady = 0;
+                // decoder thread only
+                Format::Mve::Decoder _video;
 
+                // audio samples, filled by decoder and drained from audio callback without locking
+                std::unique_ptr<Audio::RingBuffer<int16_t>> _audio;
+                // set once _audio is created, the audio thread doesn't touch it before
+                std::atomic<bool> _audioReady{false};
+                std::atomic<bool> _audioFinished{false};
+                // decoder thread only: samples of the audio opcode being decoded
+                std::vector<int16_t> _audioSamples;
+
+                uint32_t  _frame = 0;
                 float _millisecondsTracked = 0;
-                SDL_Surface* _currentBuf = NULL;
-                SDL_Surface* _backBuf = NULL;
 
-                void _processChunk();
-                void _decodeVideo(uint8_t* data, uint32_t len);
-                void _decodeFrame(uint8_t* data, uint32_t len);
-                void _initVideoBuffer(uint8_t* data);
-                void _sendVideoBuffer(uint8_t* data);
-                void _setPalette(uint8_t* data);
-                void _setDecodingMap(uint8_t* data);
+                void _decode();
+                // returns false if the stream has ended
+                bool _processChunk(Format::Mve::Chunk& chunk);
+                bool _popChunk(QueuedChunk& chunk);
+                void _showChunk(const QueuedChunk& chunk);
+                Frame* _acquireFrame();
+                void _storeFrame();
                 void _initAudioBuffer(uint8_t version, uint8_t* data);
                 void _playAudio();
                 void _decodeAudio(uint8_t* data, uint32_t len);
@@ -98,15 +152,6 @@ namespace Falltergeist
                     UNKNOWN_0x14,
                     UNKNOWN_0x15
                 };
-                //drawing helpers
-                void _drawRow(uint32_t x, uint32_t y, uint8_t c1, uint8_t c2, uint8_t mask);
-                void _drawRow2x2(uint32_t x, uint32_t y, uint8_t c1, uint8_t c2, uint8_t mask);
-                void _drawRow4colors(uint32_t x, uint32_t y, uint8_t c1, uint8_t c2, uint8_t c3, uint8_t c4, uint8_t mask1, uint8_t mask2);
-                void _drawRow4colors2x2(uint32_t x, uint32_t y, uint8_t c1, uint8_t c2, uint8_t c3, uint8_t c4, uint8_t mask);
-                void _drawRow4colors2x1(uint32_t x, uint32_t y, uint8_t c1, uint8_t c2, uint8_t c3, uint8_t c4, uint8_t mask);
-                void _drawRow4colors1x2(uint32_t x, uint32_t y, uint8_t c1, uint8_t c2, uint8_t c3, uint8_t c4, uint8_t mask1, uint8_t mask2);
-                void _drawQuadrant(uint32_t x, uint32_t y, uint8_t c1, uint8_t c2, uint8_t mask1, uint8_t mask2);
-                void _drawQuadrant4colors(uint32_t x, uint32_t y, uint8_t c1, uint8_t c2, uint8_t c3, uint8_t c4, uint8_t mask1, uint8_t mask2, uint8_t mask3, uint8_t mask4);
         };
     }
 }
@@ -155,7 +155,7 @@ namespace Falltergeist
                     if (_scrollingLog != 0)
                     {
                         _messageLog->setLineOffset(_messageLog->lineOffset() + _scrollingLog);
-                        _scrollingLogTimer = SDL_GetTicks();
+                        _scrollingLogTimer = Game::getInstance()->simulationTime();
                     }
                 });
 
@@ -264,12 +264,12 @@ namespace Falltergeist
                 itemUi->think(deltaTime);
             }
 
-            if (_scrollingLogTimer && (SDL_GetTicks() > _scrollingLogTimer + 150)
+            if (_scrollingLogTimer && (Game::getInstance()->simulationTime() > _scrollingLogTimer + 150)
                 && ((_scrollingLog < 0 && _messageLog->lineOffset() > 0)
                     || (_scrollingLog > 0 && _messageLog->lineOffset() < _messageLog->numLines() - 6)))
             {
                 _messageLog->setLineOffset(_messageLog->lineOffset() + _scrollingLog);
-                _scrollingLogTimer = SDL_GetTicks();
+                _scrollingLogTimer = Game::getInstance()->simulationTime();
             }
         }
 
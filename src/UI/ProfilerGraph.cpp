@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <cstdio>
+#include "../Game/Game.h"
+#include "../Graphics/Renderer.h"
+#include "../Profiler.h"
+#include "../UI/ProfilerGraph.h"
+#include "../UI/TextArea.h"
+
+namespace Falltergeist
+{
+    namespace UI
+    {
+        namespace
+        {
+            const SDL_Color backgroundColor = {0, 0, 0, 160};
+            const SDL_Color budgetColor = {255, 255, 255, 200};
+            const SDL_Color otherColor = {96, 96, 96, 255};
+            const SDL_Color zoneColors[] = {
+                {60, 200, 60, 255},
+                {60, 140, 240, 255},
+                {240, 200, 40, 255},
+                {230, 80, 80, 255},
+                {200, 90, 220, 255},
+                {60, 210, 210, 255},
+                {240, 140, 40, 255},
+                {160, 160, 255, 255},
+            };
+            const unsigned zoneColorsCount = sizeof(zoneColors) / sizeof(zoneColors[0]);
+        }
+
+        ProfilerGraph::ProfilerGraph(const Point& pos) : Base(pos)
+        {
+            _legend = std::make_unique<TextArea>(pos + Point(0, GRAPH_HEIGHT + 2));
+        }
+
+        ProfilerGraph::~ProfilerGraph()
+        {
+        }
+
+        void ProfilerGraph::think(const float &deltaTime)
+        {
+            // legend is text, rebuilding it every frame would cost more than the graph itself
+            _millisecondsTracked += deltaTime;
+            if (_millisecondsTracked >= 250.0f) {
+                _millisecondsTracked = 0;
+                _updateLegend();
+            }
+        }
+
+        void ProfilerGraph::render(bool eggTransparency)
+        {
+            if (!visible() || !Profiler::enabled()) {
+                return;
+            }
+
+            auto renderer = Game::getInstance()->renderer();
+            const auto& history = Profiler::history();
+            const uint32_t last = Profiler::lastFrame();
+            const double pixelsPerMillisecond = GRAPH_HEIGHT / GRAPH_MILLISECONDS;
+            const Point pos = position();
+
+            _vertices.clear();
+            _colors.clear();
+            _addRect(pos.x(), pos.y(), size().width(), size().height(), backgroundColor);
+
+            for (uint32_t column = 0; column < Profiler::HISTORY_SIZE; column++) {
+                // oldest frame on the left
+                const auto& frame = history[(last + 1 + column) % Profiler::HISTORY_SIZE];
+                if (frame.end <= frame.start) {
+                    continue;
+                }
+                int x = pos.x() + static_cast<int>(column) * COLUMN_WIDTH;
+                int bottom = pos.y() + GRAPH_HEIGHT;
+                double total = Profiler::toMilliseconds(frame.end - frame.start);
+                double zonesTotal = 0;
+
+                for (unsigned zone = 0; zone < frame.zonesCount && bottom > pos.y(); zone++) {
+                    double milliseconds = Profiler::toMilliseconds(frame.zoneTimes[zone]);
+                    zonesTotal += milliseconds;
+                    int height = std::min(static_cast<int>(milliseconds * pixelsPerMillisecond + 0.5), bottom - pos.y());
+                    if (height > 0) {
+                        bottom -= height;
+                        _addRect(x, bottom, COLUMN_WIDTH, height, zoneColors[_zoneColor(frame.zoneNames[zone])]);
+                    }
+                }
+
+                // time not covered by any zone (frame limiter, swap, etc.)
+                int height = std::min(static_cast<int>((total - zonesTotal) * pixelsPerMillisecond + 0.5), bottom - pos.y());
+                if (height > 0) {
+                    _addRect(x, bottom - height, COLUMN_WIDTH, height, otherColor);
+                }
+            }
+
+            int budget = pos.y() + GRAPH_HEIGHT - static_cast<int>(BUDGET_MILLISECONDS * pixelsPerMillisecond);
+            _addRect(pos.x(), budget, size().width(), 1, budgetColor);
+            renderer->drawTriangles(_vertices, _colors);
+
+            _legend->render();
+        }
+
+        bool ProfilerGraph::opaque(const Point &pos)
+        {
+            return false;
+        }
+
+        Size ProfilerGraph::size() const
+        {
+            return Size(Profiler::HISTORY_SIZE * COLUMN_WIDTH, GRAPH_HEIGHT);
+        }
+
+        void ProfilerGraph::_addRect(int x, int y, int width, int height, const SDL_Color& color)
+        {
+            const float left = static_cast<float>(x);
+            const float top = static_cast<float>(y);
+            const float right = static_cast<float>(x + width);
+            const float bottom = static_cast<float>(y + height);
+            const glm::vec2 corners[6] = {
+                {left, top}, {left, bottom}, {right, top},
+                {right, top}, {left, bottom}, {right, bottom},
+            };
+            const glm::vec4 fcolor(color.r / 255.0f, color.g / 255.0f, color.b / 255.0f, color.a / 255.0f);
+            _vertices.insert(_vertices.end(), corners, corners + 6);
+            _colors.insert(_colors.end(), 6, fcolor);
+        }
+
+        unsigned ProfilerGraph::_zoneColor(const char* name)
+        {
+            auto it = std::find(_zones.begin(), _zones.end(), name);
+            if (it == _zones.end()) {
+                _zones.push_back(name);
+                it = _zones.end() - 1;
+            }
+            return static_cast<unsigned>(it - _zones.begin()) % zoneColorsCount;
+        }
+
+        void ProfilerGraph::_updateLegend()
+        {
+            const auto& frame = Profiler::history()[Profiler::lastFrame()];
+            char line[64];
+
+            std::snprintf(line, sizeof(line), "frame %.2f ms\n", Profiler::toMilliseconds(frame.end - frame.start));
+            std::string text = line;
+            for (unsigned zone = 0; zone < frame.zonesCount; zone++) {
+                std::snprintf(line, sizeof(line), "%s %.2f ms\n", frame.zoneNames[zone], Profiler::toMilliseconds(frame.zoneTimes[zone]));
+                text += line;
+            }
+            _legend->setText(text);
+        }
+    }
+}
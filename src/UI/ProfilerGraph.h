@@ -0,0 +1,50 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+#include "../UI/Base.h"
+
+namespace Falltergeist
+{
+    namespace UI
+    {
+        class TextArea;
+
+        /**
+         * On-screen frame time graph built from Profiler history. Every column is one frame,
+         * split into top-level profiler zones. The horizontal line marks the 60 FPS budget.
+         */
+        class ProfilerGraph final : public Base
+        {
+            public:
+                ProfilerGraph(const Point& pos);
+                ~ProfilerGraph() override;
+
+                void think(const float &deltaTime) override;
+                void render(bool eggTransparency = false) override;
+
+                bool opaque(const Point &pos) override;
+                Size size() const override;
+
+            private:
+                static const int COLUMN_WIDTH = 2;
+                static const int GRAPH_HEIGHT = 64;
+                // frame time which fills the whole graph height
+                static constexpr double GRAPH_MILLISECONDS = 33.3;
+                static constexpr double BUDGET_MILLISECONDS = 1000.0 / 60.0;
+
+                std::unique_ptr<TextArea> _legend;
+                // zone names in order of first appearance, defines zone colors
+                std::vector<const char*> _zones;
+                float _millisecondsTracked = 0;
+                // all bars of the graph, drawn with one call; kept between frames to reuse memory
+                std::vector<glm::vec2> _vertices;
+                std::vector<glm::vec4> _colors;
+
+                unsigned _zoneColor(const char* name);
+                void _addRect(int x, int y, int width, int height, const SDL_Color& color);
+                void _updateLegend();
+        };
+    }
+}
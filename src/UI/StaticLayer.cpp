@@ -0,0 +1,180 @@
+#include <algorithm>
+#include "../Game/Game.h"
+#include "../Graphics/Rect.h"
+#include "../Graphics/Renderer.h"
+#include "../Graphics/RenderTarget.h"
+#include "../UI/Base.h"
+#include "../UI/StaticLayer.h"
+
+namespace Falltergeist
+{
+    namespace UI
+    {
+        StaticLayer::StaticLayer()
+        {
+        }
+
+        StaticLayer::~StaticLayer()
+        {
+        }
+
+        bool StaticLayer::available()
+        {
+            auto renderer = Game::getInstance()->renderer();
+            return renderer->renderPath() != Graphics::Renderer::RenderPath::NONE && renderer->framebufferObjects();
+        }
+
+        void StaticLayer::invalidate()
+        {
+            _valid = false;
+        }
+
+        void StaticLayer::render(const std::vector<Base*>& elements)
+        {
+            auto renderer = Game::getInstance()->renderer();
+
+            if (!_target || _target->size() != renderer->size())
+            {
+                _target = std::make_unique<Graphics::RenderTarget>(renderer->size());
+                _valid = false;
+            }
+
+            if (_frameConstantsVersion != renderer->frameConstantsVersion())
+            {
+                _frameConstantsVersion = renderer->frameConstantsVersion();
+                _valid = false;
+            }
+
+            if (_valid && elements.size() == _snapshots.size())
+            {
+                for (size_t i = 0; i != elements.size(); ++i)
+                {
+                    if (_snapshots[i].element != elements[i])
+                    {
+                        _valid = false;
+                        break;
+                    }
+                }
+            }
+            else
+            {
+                _valid = false;
+            }
+
+            _dirty = false;
+            if (!_valid)
+            {
+                _dirty = true;
+                _dirtyLeft = 0;
+                _dirtyTop = 0;
+                _dirtyRight = renderer->size().width();
+                _dirtyBottom = renderer->size().height();
+                _snapshots.clear();
+                for (auto element : elements)
+                {
+                    _snapshots.push_back(_snapshot(element));
+                }
+            }
+            else
+            {
+                for (size_t i = 0; i != elements.size(); ++i)
+                {
+                    Snapshot current = _snapshot(elements[i]);
+                    Snapshot& previous = _snapshots[i];
+                    if (current.revision != previous.revision || current.visible != previous.visible
+                        || current.position != previous.position || current.size != previous.size)
+                    {
+                        // old area has to be uncovered, new one drawn
+                        _addDirty(previous);
+                        _addDirty(current);
+                        previous = current;
+                    }
+                }
+            }
+
+            if (_dirty)
+            {
+                _redraw(elements);
+
+                // elements like text areas know their size only after they have been drawn,
+                // so one more pass covers anything which has grown out of the drawn area
+                int left = _dirtyLeft;
+                int top = _dirtyTop;
+                int right = _dirtyRight;
+                int bottom = _dirtyBottom;
+                for (size_t i = 0; i != elements.size(); ++i)
+                {
+                    Snapshot current = _snapshot(elements[i]);
+                    if (current.position != _snapshots[i].position || current.size != _snapshots[i].size)
+                    {
+                        _addDirty(current);
+                        _snapshots[i] = current;
+                    }
+                }
+                if (_dirtyLeft != left || _dirtyTop != top || _dirtyRight != right || _dirtyBottom != bottom)
+                {
+                    _redraw(elements);
+                }
+                _valid = true;
+            }
+
+            _target->render();
+        }
+
+        StaticLayer::Snapshot StaticLayer::_snapshot(Base* element) const
+        {
+            Snapshot snapshot;
+            snapshot.element = element;
+            snapshot.revision = element->revision();
+            snapshot.position = element->position();
+            snapshot.size = element->size();
+            snapshot.visible = element->visible();
+            return snapshot;
+        }
+
+        void StaticLayer::_addDirty(const Snapshot& snapshot)
+        {
+            if (!snapshot.visible || snapshot.size.width() <= 0 || snapshot.size.height() <= 0)
+            {
+                return;
+            }
+
+            int left = snapshot.position.x();
+            int top = snapshot.position.y();
+            int right = left + snapshot.size.width();
+            int bottom = top + snapshot.size.height();
+
+            if (!_dirty)
+            {
+                _dirty = true;
+                _dirtyLeft = left;
+                _dirtyTop = top;
+                _dirtyRight = right;
+                _dirtyBottom = bottom;
+                return;
+            }
+
+            _dirtyLeft = std::min(_dirtyLeft, left);
+            _dirtyTop = std::min(_dirtyTop, top);
+            _dirtyRight = std::max(_dirtyRight, right);
+            _dirtyBottom = std::max(_dirtyBottom, bottom);
+        }
+
+        void StaticLayer::_redraw(const std::vector<Base*>& elements)
+        {
+            Point position(_dirtyLeft, _dirtyTop);
+            Size size(_dirtyRight - _dirtyLeft, _dirtyBottom - _dirtyTop);
+
+            _target->begin(position, size);
+            for (auto element : elements)
+            {
+                // everything overlapping the area is drawn again, in the original order
+                if (element->visible() && Graphics::Rect::intersects(element->position(), element->size(), position, size))
+                {
+                    element->render(false);
+                }
+            }
+            _target->end();
+        }
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "../Graphics/Point.h"
+#include "../Graphics/Size.h"
+
+namespace Falltergeist
+{
+    namespace Graphics
+    {
+        class RenderTarget;
+    }
+
+    namespace UI
+    {
+        class Base;
+
+        using Graphics::Point;
+        using Graphics::Size;
+
+        /**
+         * Retained drawing of UI elements which rarely change (backgrounds, buttons, labels).
+         * Elements are drawn into an offscreen render target once. Every frame the layer compares them with
+         * their state from the previous frame (position, size, visibility and revision), draws again only the
+         * area covered by changed elements and puts the whole target on screen with a single quad.
+         * All elements must be cacheable().
+         */
+        class StaticLayer
+        {
+            public:
+                StaticLayer();
+                ~StaticLayer();
+
+                void render(const std::vector<Base*>& elements);
+
+                // Next render() draws everything again
+                void invalidate();
+
+                // false in headless mode and without framebuffer support, elements then have to be drawn directly
+                static bool available();
+
+            private:
+                struct Snapshot
+                {
+                    Base* element = nullptr;
+                    uint32_t revision = 0;
+                    Point position;
+                    Size size;
+                    bool visible = false;
+                };
+
+                std::unique_ptr<Graphics::RenderTarget> _target;
+                std::vector<Snapshot> _snapshots;
+                bool _valid = false;
+                // fade color is baked into the cached image
+                uint32_t _frameConstantsVersion = 0;
+
+                // area to draw again, in screen coordinates
+                bool _dirty = false;
+                int _dirtyLeft = 0;
+                int _dirtyTop = 0;
+                int _dirtyRight = 0;
+                int _dirtyBottom = 0;
+
+                Snapshot _snapshot(Base* element) const;
+                void _addDirty(const Snapshot& snapshot);
+                void _redraw(const std::vector<Base*>& elements);
+        };
+    }
+}
@@ -17,7 +17,7 @@ namespace Falltergeist
 
         TextArea::TextArea(const Point& pos) : Base(pos)
         {
-            _timestampCreated = SDL_GetTicks();
+            _timestampCreated = Game::getInstance()->simulationTime();
 
         }
 
@@ -27,7 +27,7 @@ namespace Falltergeist
 
         TextArea::TextArea(const std::string& text, const Point& pos) : Base(pos)
         {
-            _timestampCreated = SDL_GetTicks();
+            _timestampCreated = Game::getInstance()->simulationTime();
             setText(text);
         }
 
@@ -56,6 +56,7 @@ namespace Falltergeist
         void TextArea::_needUpdate(bool lines)
         {
             _changed = true;
+            markDirty();
             if (lines)
             {
                 _lines.clear();
@@ -94,6 +95,7 @@ namespace Falltergeist
 
         void TextArea::setText(const std::string& text)
         {
+            if (_text == text) return;
             _text = text;
             _needUpdate(true);
         }
@@ -117,13 +119,13 @@ namespace Falltergeist
         void TextArea::setFont(Graphics::Font *font, SDL_Color color)
         {
             setFont(font);
-            _color = color;
+            setColor(color);
         }
 
         void TextArea::setFont(const std::string& fontName, SDL_Color color)
         {
             setFont(ResourceManager::getInstance()->font(fontName));
-            _color = color;
+            setColor(color);
         }
 
         std::string TextArea::fontName()
@@ -146,11 +148,13 @@ namespace Falltergeist
         void TextArea::setColor(SDL_Color color)
         {
             _color = color;
+            markDirty();
         }
 
         void TextArea::setOutline(bool outline)
         {
             _outlineColor.a = outline ? 255 : 0;
+            markDirty();
         }
 
         bool TextArea::outline() const
@@ -161,6 +165,7 @@ namespace Falltergeist
         void TextArea::setOutlineColor(SDL_Color color)
         {
             _outlineColor = color;
+            markDirty();
         }
 
         SDL_Color TextArea::outlineColor() const
@@ -187,6 +192,11 @@ namespace Falltergeist
             );
         }
 
+        bool TextArea::cacheable() const
+        {
+            return true;
+        }
+
         Size TextArea::textSize()
         {
             _updateSymbols();
@@ -212,21 +222,63 @@ namespace Falltergeist
             setSize({width, _size.height()});
         }
 
-        // TODO: anyone is welcome to do this better..
         void TextArea::_updateSymbols()
         {
             if (!_changed) return;
+            _changed = false;
 
-            _symbols.clear();
+            // text which is rewritten every frame with the same content (counters, cursor position) ends up here
+            // with the very same layout, which keeps its quads in the glyph buffer
+            auto key = _layoutKey();
+            auto layout = _layoutCache().find(key);
+            if (!layout)
+            {
+                layout = _createLayout();
+                _layoutCache().insert(key, layout);
+            }
+            _calculatedSize = layout->size;
+            _textArea.setLayout(layout);
+        }
+
+        Graphics::TextLayoutCache& TextArea::_layoutCache()
+        {
+            static Graphics::TextLayoutCache cache;
+            return cache;
+        }
+
+        std::string TextArea::_layoutKey()
+        {
+            std::string key = font()->filename();
+            for (int value : {_size.width(), _size.height(),
+                              _paddingTopLeft.width(), _paddingTopLeft.height(),
+                              _paddingBottomRight.width(), _paddingBottomRight.height(),
+                              _lineOffset, (int)_wordWrap, (int)_horizontalAlign})
+            {
+                key += ',';
+                key += std::to_string(value);
+            }
+            for (int shift : _customLineShifts)
+            {
+                key += ';';
+                key += std::to_string(shift);
+            }
+            key += '\n';
+            key += _text;
+            return key;
+        }
+
+        // TODO: anyone is welcome to do this better..
+        std::shared_ptr<const Graphics::TextLayout> TextArea::_createLayout()
+        {
+            auto layout = std::make_shared<Graphics::TextLayout>();
 
             if (_text.empty())
             {
-                _updateBuffers();
-                _calculatedSize = Size(0, 0);
-                _changed = false;
-                return;
+                return layout;
             }
 
+            std::vector<Graphics::TextSymbol> symbols;
+
             _updateLines();
 
             // at positive offset, skip number of first lines
@@ -261,12 +313,8 @@ namespace Falltergeist
             // Calculating textarea sizes if needed
             if (numVisibleLines > 0)
             {
-                _calculatedSize.setWidth(std::max_element(lineBegin, lineEnd)->width);
-                _calculatedSize.setHeight(numVisibleLines * font()->height() + (numVisibleLines - 1) * font()->verticalGap());
-            }
-            else
-            {
-                _calculatedSize = Size(0, 0);
+                layout->size.setWidth(std::max_element(lineBegin, lineEnd)->width);
+                layout->size.setHeight(numVisibleLines * font()->height() + (numVisibleLines - 1) * font()->verticalGap());
             }
 
             // Alignment
@@ -283,7 +331,7 @@ namespace Falltergeist
                 offset.setX(0);
                 if (_horizontalAlign != HorizontalAlign::LEFT)
                 {
-                    offset.setX((_size.width() ? _size.width() : _calculatedSize.width()) - line.width);
+                    offset.setX((_size.width() ? _size.width() : layout->size.width()) - line.width);
                     if (_horizontalAlign == HorizontalAlign::CENTER)
                     {
                         offset.rx() /= 2;
@@ -298,11 +346,11 @@ namespace Falltergeist
                 {
                     symbol.position += offset;
                     // outline symbols
-                    _symbols.push_back(symbol);
+                    symbols.push_back(symbol);
                 }
             }
-            _updateBuffers();
-            _changed = false;
+            _createQuads(symbols, layout->vertices);
+            return layout;
         }
 
         void TextArea::_updateLines()
@@ -503,20 +551,20 @@ namespace Falltergeist
         void TextArea::setCustomLineShifts(std::vector<int> shifts)
         {
             _customLineShifts = shifts;
+            _needUpdate();
         }
 
-        void TextArea::_updateBuffers()
+        void TextArea::_createQuads(const std::vector<Graphics::TextSymbol>& symbols, std::vector<Graphics::GlyphVertex>& vertices)
         {
-            std::vector<glm::vec2> vertices;
-            std::vector<glm::vec2> UV;
-            std::vector<GLushort> indexes;
+            vertices.reserve(symbols.size() * 4);
 
-            int cnt = 0;
             auto tex = font()->texture();
-            for ( auto symbol: _symbols )
+            // glyph sheet is packed somewhere on the atlas texture
+            auto sheet = font()->region()->position;
+            for ( auto symbol: symbols )
             {
-                auto textureX = static_cast<float>((symbol.chr % 16) * font()->width() + (symbol.chr % 16) * 2 + 1);
-                auto textureY = static_cast<float>((symbol.chr / 16) * font()->height() + (symbol.chr / 16) * 2 + 1);
+                auto textureX = static_cast<float>(sheet.x() + (symbol.chr % 16) * font()->width() + (symbol.chr % 16) * 2 + 1);
+                auto textureY = static_cast<float>(sheet.y() + (symbol.chr / 16) * font()->height() + (symbol.chr / 16) * 2 + 1);
 
                 Point drawPos = symbol.position;
 
@@ -525,30 +573,16 @@ namespace Falltergeist
                 glm::vec2 vertex_down_left  = glm::vec2( (float)drawPos.x()-1.0, (float)drawPos.y()+(float)font()->height()+1.0 );
                 glm::vec2 vertex_down_right = glm::vec2( (float)drawPos.x()+(float)font()->width()+1.0, (float)drawPos.y()+(float)font()->height()+1.0 );
 
-                vertices.push_back(vertex_up_left   );
-                vertices.push_back(vertex_up_right  );
-                vertices.push_back(vertex_down_left );
-                vertices.push_back(vertex_down_right);
-
                 glm::vec2 tex_up_left    = glm::vec2( (textureX-1.0)/(float)tex->textureWidth(), (textureY-1.0)/(float)tex->textureHeight() );
                 glm::vec2 tex_up_right   = glm::vec2( (textureX+(float)font()->width()+1.0)/(float)tex->textureWidth(), (textureY-1.0)/(float)tex->textureHeight() );
                 glm::vec2 tex_down_left  = glm::vec2( (textureX-1.0)/(float)tex->textureWidth(), (textureY+(float)font()->height()+1.0)/(float)tex->textureHeight() );
                 glm::vec2 tex_down_right = glm::vec2( (textureX+(float)font()->width()+1.0)/(float)tex->textureWidth(), (textureY+(float)font()->height()+1.0)/(float)tex->textureHeight() );
 
-                UV.push_back(tex_up_left   );
-                UV.push_back(tex_up_right  );
-                UV.push_back(tex_down_left );
-                UV.push_back(tex_down_right);
-
-                indexes.push_back(cnt*4);
-                indexes.push_back(cnt*4+1);
-                indexes.push_back(cnt*4+2);
-                indexes.push_back(cnt*4+3);
-                indexes.push_back(cnt*4+2);
-                indexes.push_back(cnt*4+1);
-                cnt++;
+                vertices.push_back({vertex_up_left,    tex_up_left   });
+                vertices.push_back({vertex_up_right,   tex_up_right  });
+                vertices.push_back({vertex_down_left,  tex_down_left });
+                vertices.push_back({vertex_down_right, tex_down_right});
             }
-            _textArea.updateBuffers(vertices,UV,indexes);
         }
 
         bool TextArea::opaque(const Point &pos)
@@ -1,10 +1,12 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 #include "../Graphics/Font.h"
 #include "../Graphics/TextArea.h"
+#include "../Graphics/TextLayout.h"
 #include "../UI/Base.h"
 
 namespace Falltergeist
@@ -83,6 +85,8 @@ namespace Falltergeist
              * Size of text area. It's either fixed value given to setSize() or previously calculated size.
              */
             Size size() const override;
+
+            bool cacheable() const override;
             /**
              * Sets fixed size of TextArea. If this is not (0, 0) - calls to size() will always return this value,
              * regardless of actual width/height of TextArea on screen.
@@ -250,11 +254,10 @@ namespace Falltergeist
             };
 
             /**
-             * If true, _symbols will be regenerated on next render().
+             * If true, layout will be looked up or regenerated on next render().
              */
             bool _changed = true;
 
-            std::vector<Graphics::TextSymbol> _symbols;
             std::string _text;
             Graphics::Font* _font = nullptr;
 
@@ -306,7 +309,16 @@ namespace Falltergeist
             void _needUpdate(bool lines = false);
 
             Graphics::TextArea _textArea;
-            void _updateBuffers();
+            /**
+             * Layouts shared by all text areas.
+             */
+            static Graphics::TextLayoutCache& _layoutCache();
+            /**
+             * Everything layout depends on, packed into a string.
+             */
+            std::string _layoutKey();
+            std::shared_ptr<const Graphics::TextLayout> _createLayout();
+            void _createQuads(const std::vector<Graphics::TextSymbol>& symbols, std::vector<Graphics::GlyphVertex>& vertices);
         };
     }
 }
@@ -30,19 +30,14 @@ namespace Falltergeist
             _index = value;
         }
 
-        void Tile::enable()
+        unsigned int Tile::region() const
         {
-            _enabled = true;
+            return _region;
         }
 
-        void Tile::disable()
+        void Tile::setRegion(unsigned int value)
         {
-            _enabled = false;
-        }
-
-        bool Tile::enabled()
-        {
-            return _enabled;
+            _region = value;
         }
     }
 }
@@ -25,15 +25,16 @@ namespace Falltergeist
 
                 unsigned int index() const;
                 void setIndex(unsigned int value);
-                void enable();
-                void disable();
-                bool enabled();
+
+                // Connected group of tiles (a roof) the tile belongs to, 0 until TileMap::init()
+                unsigned int region() const;
+                void setRegion(unsigned int value);
 
             private:
                 unsigned int _index = 0;
                 unsigned int _number = 0;
+                unsigned int _region = 0;
                 Point _position;
-                bool _enabled = true;
         };
     }
 }
@@ -3,6 +3,8 @@
 #include <memory>
 #include <vector>
 #include <SDL_image.h>
+#include "../Format/Frm/File.h"
+#include "../Format/Frm/Mask.h"
 #include "../Format/Lst/File.h"
 #include "../Game/Game.h"
 #include "../Graphics/Point.h"
@@ -10,6 +12,7 @@
 #include "../Graphics/Tilemap.h"
 #include "../LocationCamera.h"
 #include "../Logger.h"
+#include "../Profiler.h"
 #include "../ResourceManager.h"
 #include "../State/Location.h"
 #include "../UI/Tile.h"
@@ -19,8 +22,12 @@ namespace  Falltergeist
 {
     namespace UI
     {
-        TileMap::TileMap()
+        TileMap::TileMap(Falltergeist::Base::Arena* arena) : _arena(arena), _grid(100 * 100, nullptr)
         {
+            if (!_arena) {
+                _ownArena = std::make_unique<Falltergeist::Base::Arena>();
+                _arena = _ownArena.get();
+            }
         }
 
         TileMap::~TileMap()
@@ -40,10 +47,8 @@ namespace  Falltergeist
 
             Logger::info("GAME") << "Tilemap tiles " << _tiles.size() << std::endl;
 
-            for (auto& it : _tiles)
+            for (auto tile : _tiles)
             {
-                auto& tile = it.second;
-
                 auto position = std::find(numbers.begin(), numbers.end(), tile->number());
                 if (position == numbers.end())
                 {
@@ -64,9 +69,8 @@ namespace  Falltergeist
 
             }
 
-            for (auto& it : _tiles)
+            for (auto tile : _tiles)
             {
-                auto& tile = it.second;
                 // push vertices
                 float vx = static_cast<float>(tile->position().x());
                 float vy = static_cast<float>(tile->position().y());
@@ -105,64 +109,167 @@ namespace  Falltergeist
             Logger::info("GAME") << "Tilemap atlases " << _atlases << std::endl;
 
             auto tilesLst = ResourceManager::getInstance()->lstFileType("art/tiles/tiles.lst");
+            auto palette = ResourceManager::getInstance()->palFileType("color.pal");
+            _masks.assign(numbers.size(), nullptr);
 
+            uint32_t atlasSize = Game::getInstance()->renderer()->maxTextureSize();
+            std::vector<uint8_t> atlas;
             for (uint8_t i = 0; i < _atlases; i++)
             {
-                SDL_Surface* tmp = SDL_CreateRGBSurface(0, Game::getInstance()->renderer()->maxTextureSize(), Game::getInstance()->renderer()->maxTextureSize(), 32, 0xff000000, 0x00ff0000, 0x0000ff00, 0x000000ff);
-                SDL_SetSurfaceBlendMode(tmp, SDL_BLENDMODE_NONE);
+                // palette indexes, shaders look colors up in the animated palette
+                atlas.assign(atlasSize * atlasSize, 0);
                 for (unsigned int j = _tilesPerAtlas*i; j < std::min((uint32_t)numbers.size(), (uint32_t)_tilesPerAtlas*(i + 1)); ++j)
                 {
                     auto frm = ResourceManager::getInstance()->frmFileType("art/tiles/" + tilesLst->strings()->at(numbers.at(j)));
-
-                    SDL_Surface* tileSurf = SDL_CreateRGBSurfaceFrom(frm->rgba(ResourceManager::getInstance()->palFileType("color.pal")), 82, 38, 32, 82 * 4, 0xff000000, 0x00ff0000, 0x0000ff00, 0x000000ff);
-                    SDL_SetSurfaceBlendMode(tileSurf, SDL_BLENDMODE_NONE);
-                    int x = (j % maxW) * 80;
-                    int y = (j / maxW) * 36;
-                    SDL_Rect srcrect = { 1,1,80,36 };
-                    SDL_Rect rect = { x,y,80,36 };
-                    SDL_BlitSurface(tileSurf, &srcrect, tmp, &rect);
-                    SDL_FreeSurface(tileSurf);
+                    auto& frame = frm->directions().at(0).frames().at(0);
+                    _masks[j] = frm->mask(palette);
+
+                    uint32_t x = (j % maxW) * 80;
+                    uint32_t y = (j / maxW) * 36;
+                    unsigned int width = std::min<unsigned int>(frame.width(), 80);
+                    unsigned int height = std::min<unsigned int>(frame.height(), 36);
+                    for (unsigned int row = 0; row != height; ++row)
+                    {
+                        const uint8_t* src = frame.data() + row * frame.width();
+                        std::copy(src, src + width, atlas.begin() + (y + row) * atlasSize + x);
+                    }
                 }
                 //push new atlas
-                _tilemap->addTexture(tmp);
-                //IMG_SavePNG(tmp, "text.png");
-                SDL_FreeSurface(tmp);
+                auto texture = std::make_unique<Graphics::Texture>(atlasSize, atlasSize);
+                texture->loadFromIndexes(atlas.data());
+                _tilemap->addTexture(std::move(texture));
             }
+
+            _buildRegions();
+            _buildCells();
         }
 
-        void TileMap::render()
+        void TileMap::_buildRegions()
         {
-            auto camera = Game::getInstance()->locationState()->camera();
-            std::vector<std::vector<GLuint>> indexes;
-            for (uint8_t i = 0; i < _atlases; i++)
+            // 4-way connected components of the 100x100 tile grid, found with an explicit queue
+            unsigned int regions = 0;
+            std::vector<unsigned int> queue;
+            for (unsigned int start = 0; start != _grid.size(); ++start)
             {
-                indexes.push_back(std::vector<GLuint>());
+                if (!_grid[start] || _grid[start]->region())
+                {
+                    continue;
+                }
+                ++regions;
+                _grid[start]->setRegion(regions);
+                queue.assign(1, start);
+                while (!queue.empty())
+                {
+                    unsigned int num = queue.back();
+                    queue.pop_back();
+                    int x = num % 100;
+                    int y = num / 100;
+                    const int neighbors[4][2] = {{x + 1, y}, {x - 1, y}, {x, y + 1}, {x, y - 1}};
+                    for (auto& neighbor : neighbors)
+                    {
+                        if (neighbor[0] < 0 || neighbor[0] >= 100 || neighbor[1] < 0 || neighbor[1] >= 100)
+                        {
+                            continue;
+                        }
+                        unsigned int next = neighbor[1] * 100 + neighbor[0];
+                        if (_grid[next] && !_grid[next]->region())
+                        {
+                            _grid[next]->setRegion(regions);
+                            queue.push_back(next);
+                        }
+                    }
+                }
+            }
+            // region 0 is never used
+            _hiddenRegions.assign(regions + 1, false);
+            _dirty = true;
+        }
+
+        bool TileMap::_visible(const Tile* tile) const
+        {
+            return tile->region() >= _hiddenRegions.size() || !_hiddenRegions[tile->region()];
+        }
+
+        void TileMap::_buildCells()
+        {
+            _cells.clear();
+            _cellsX = _cellsY = 0;
+            if (_tiles.empty())
+            {
+                return;
+            }
+
+            int left = _tiles.front()->position().x();
+            int top = _tiles.front()->position().y();
+            int right = left;
+            int bottom = top;
+            for (auto tile : _tiles)
+            {
+                left = std::min(left, tile->position().x());
+                top = std::min(top, tile->position().y());
+                right = std::max(right, tile->position().x() + 80);
+                bottom = std::max(bottom, tile->position().y() + 36);
+            }
+
+            _cellsOrigin = Point(left, top);
+            _cellsX = (right - left + CELL_WIDTH - 1) / CELL_WIDTH;
+            _cellsY = (bottom - top + CELL_HEIGHT - 1) / CELL_HEIGHT;
+            _cells.resize(_cellsX * _cellsY);
+
+            // tiles keep the drawing order inside of each cell
+            for (auto tile : _tiles)
+            {
+                Point offset = tile->position() - _cellsOrigin;
+                for (int y = offset.y() / CELL_HEIGHT; y <= (offset.y() + 36 - 1) / CELL_HEIGHT; ++y)
+                {
+                    for (int x = offset.x() / CELL_WIDTH; x <= (offset.x() + 80 - 1) / CELL_WIDTH; ++x)
+                    {
+                        _cells[y * _cellsX + x].push_back(tile);
+                    }
+                }
             }
-            int cnt = 0;
+        }
 
+        void TileMap::render()
+        {
+            ProfilerZone zone("TileMap::render");
+            auto camera = Game::getInstance()->locationState()->camera();
             auto topLeft = camera->topLeft();
             auto size = camera->size();
-            for (auto& it : _tiles)
+
+            if (_dirty || topLeft != _renderedTopLeft || size != _renderedSize)
             {
-                auto& tile = it.second;
-                const Size tileSize = Size(80, 36);
-                if (tile->enabled() && Rect::intersects(tile->position(), tileSize, topLeft, size))
+                _indexes.resize(_atlases);
+                for (auto& indexes : _indexes)
                 {
-                    uint32_t aIndex = tile->index() / _tilesPerAtlas;
-                    indexes.at(aIndex).push_back(cnt * 4);
-                    indexes.at(aIndex).push_back(cnt * 4 + 1);
-                    indexes.at(aIndex).push_back(cnt * 4 + 2);
-                    indexes.at(aIndex).push_back(cnt * 4 + 3);
-                    indexes.at(aIndex).push_back(cnt * 4 + 2);
-                    indexes.at(aIndex).push_back(cnt * 4 + 1);
+                    indexes.clear();
                 }
-                cnt++;
+
+                int cnt = 0;
+                for (auto tile : _tiles)
+                {
+                    const Size tileSize = Size(80, 36);
+                    if (_visible(tile) && Rect::intersects(tile->position(), tileSize, topLeft, size))
+                    {
+                        uint32_t aIndex = tile->index() / _tilesPerAtlas;
+                        _indexes.at(aIndex).push_back(cnt * 4);
+                        _indexes.at(aIndex).push_back(cnt * 4 + 1);
+                        _indexes.at(aIndex).push_back(cnt * 4 + 2);
+                        _indexes.at(aIndex).push_back(cnt * 4 + 3);
+                        _indexes.at(aIndex).push_back(cnt * 4 + 2);
+                        _indexes.at(aIndex).push_back(cnt * 4 + 1);
+                    }
+                    cnt++;
+                }
+                _renderedTopLeft = topLeft;
+                _renderedSize = size;
+                _dirty = false;
             }
 
             for (uint32_t i = 0; i < _atlases; i++)
             {
                 //render atlas with indexes->at(atlasIndex)
-                _tilemap.get()->render(topLeft, indexes.at(i), i);
+                _tilemap.get()->render(topLeft, _indexes.at(i), i);
 
             }
 
@@ -180,61 +287,78 @@ namespace  Falltergeist
 
         void TileMap::enableAll()
         {
-            for (auto& tile : _tiles)
+            if (std::find(_hiddenRegions.begin(), _hiddenRegions.end(), true) != _hiddenRegions.end())
             {
-                tile.second->enable();
+                _hiddenRegions.assign(_hiddenRegions.size(), false);
+                _dirty = true;
             }
-
         }
 
-        std::map<unsigned int, std::unique_ptr<Tile>> &TileMap::tiles()
+        const std::vector<Tile*>& TileMap::tiles() const
         {
             return _tiles;
         }
 
-        void TileMap::disable(unsigned int num)
+        Tile* TileMap::tileAt(unsigned int position) const
         {
-            int x = num % 100;
-            int y = num / 100;
-            _floodDisable(x, y);
+            return position < _grid.size() ? _grid[position] : nullptr;
         }
 
-        void TileMap::_floodDisable(int x, int y)
+        void TileMap::addTile(unsigned int position, unsigned int number, const Point& pos)
         {
-            // TODO: this is basic 4-way floodfill
-            // maybe better replace it with scanlines or QuickFill
-            int num = y * 100 + x;
-            if (_tiles.count(num) && _tiles.at(num)->enabled())
+            if (position >= _grid.size())
+            {
+                return;
+            }
+            auto tile = _arena->create<Tile>(number, pos);
+            if (_grid[position])
             {
-                _tiles.at(num)->disable();
-                _floodDisable(x + 1, y);
-                _floodDisable(x - 1, y);
-                _floodDisable(x, y + 1);
-                _floodDisable(x, y - 1);
+                // replaced tile stays in the arena until the location is unloaded
+                *std::find(_tiles.begin(), _tiles.end(), _grid[position]) = tile;
+            }
+            else
+            {
+                _tiles.push_back(tile);
+            }
+            _grid[position] = tile;
+        }
+
+        void TileMap::disable(unsigned int num)
+        {
+            Tile* tile = tileAt(num);
+            if (tile && _visible(tile) && tile->region() < _hiddenRegions.size())
+            {
+                _hiddenRegions[tile->region()] = true;
+                _dirty = true;
             }
         }
 
         bool TileMap::opaque(const Point &pos)
         {
             auto camera = Game::getInstance()->locationState()->camera();
+            Point point = pos + camera->topLeft();
 
-            auto tilesLst = ResourceManager::getInstance()->lstFileType("art/tiles/tiles.lst");
-            for (auto& it : _tiles)
+            Point offset = point - _cellsOrigin;
+            if (offset.x() < 0 || offset.y() < 0)
+            {
+                return false;
+            }
+            int x = offset.x() / CELL_WIDTH;
+            int y = offset.y() / CELL_HEIGHT;
+            if (x >= _cellsX || y >= _cellsY)
+            {
+                return false;
+            }
+
+            for (auto tile : _cells[y * _cellsX + x])
             {
-                auto& tile = it.second;
                 const Size tileSize = Size(80, 36);
-                if (tile->enabled() && Rect::inRect(pos + camera->topLeft(), tile->position(), tileSize))
+                if (_visible(tile) && Rect::inRect(point, tile->position(), tileSize))
                 {
-                    auto frm = ResourceManager::getInstance()->frmFileType("art/tiles/" + tilesLst->strings()->at(tile->number()));
-                    auto& mask = frm->mask(ResourceManager::getInstance()->palFileType("color.pal"));
-                    auto position = pos - tile->position() + camera->topLeft() + Point(1, 1);
-
-                    if ((position.y() * 82 + position.x()) > 0 && ((unsigned)(position.y() * 82 + position.x()) < mask.size()))
+                    auto position = point - tile->position() + Point(1, 1);
+                    if (_masks[tile->index()]->opaque(position.x(), position.y()))
                     {
-                        if (mask.at(position.y() * 82 + position.x()))
-                        {
-                            return true;
-                        }
+                        return true;
                     }
                 }
             }
@@ -1,13 +1,22 @@
 ﻿#pragma once
 
-#include <map>
 #include <memory>
+#include <vector>
+#include "../Base/Arena.h"
 #include "../Graphics/Point.h"
 #include "../Graphics/Rect.h"
 #include "../Graphics/Renderer.h"
+#include "../Graphics/Size.h"
 
 namespace Falltergeist
 {
+    namespace Format
+    {
+        namespace Frm
+        {
+            class Mask;
+        }
+    }
     namespace Graphics
     {
         class Texture;
@@ -17,33 +26,65 @@ namespace Falltergeist
     {
         using Graphics::Point;
         using Graphics::Rect;
+        using Graphics::Size;
 
         class Tile;
 
         class TileMap
         {
             public:
-                TileMap();
+                // Tiles are placed in the given arena, or in an own one if there is none
+                explicit TileMap(Falltergeist::Base::Arena* arena = nullptr);
                 ~TileMap();
 
-                std::map<unsigned int, std::unique_ptr<Tile>>& tiles();
+                // Tiles in order they were added, which is the drawing order
+                const std::vector<Tile*>& tiles() const;
+                // Tile at given position on the grid or nullptr
+                Tile* tileAt(unsigned int position) const;
+                void addTile(unsigned int position, unsigned int number, const Point& pos);
                 void render();
                 void init();
                 void setInside(bool inside);
                 bool inside();
+                // Shows all regions
                 void enableAll();
+                // Hides whole region (roof) containing tile at given grid position
                 void disable(unsigned int num);
 
                 // Tests if there is a non-transparent pixel at the given point.
                 bool opaque(const Point& pos);
 
             private:
-                std::map<unsigned int, std::unique_ptr<Tile>> _tiles;
+                // cells of the screen index, in pixels
+                static const int CELL_WIDTH = 80;
+                static const int CELL_HEIGHT = 36;
+
+                // owned by the location, or _ownArena if none was given
+                Falltergeist::Base::Arena* _arena;
+                std::unique_ptr<Falltergeist::Base::Arena> _ownArena;
+                std::vector<Tile*> _tiles;
+                std::vector<Tile*> _grid;
                 uint32_t _tilesPerAtlas;
                 std::unique_ptr<Graphics::Tilemap> _tilemap;
                 uint32_t _atlases;
                 bool _inside = false;
-                void _floodDisable(int x, int y);
+                // Region of each tile is found once by init(); hiding a roof just flags its region
+                std::vector<bool> _hiddenRegions;
+                // index lists are rebuilt only when regions are toggled or camera moves
+                bool _dirty = true;
+                std::vector<std::vector<GLuint>> _indexes;
+                Point _renderedTopLeft;
+                Size _renderedSize;
+                // Screen index built by init(): the map is split into cells, each lists tiles overlapping it
+                std::vector<std::vector<Tile*>> _cells;
+                Point _cellsOrigin;
+                int _cellsX = 0;
+                int _cellsY = 0;
+                // opacity masks of unique tiles, by Tile::index()
+                std::vector<std::shared_ptr<const Format::Frm::Mask>> _masks;
+                void _buildRegions();
+                void _buildCells();
+                bool _visible(const Tile* tile) const;
         };
     }
 }
@@ -0,0 +1,52 @@
+#include <SDL.h>
+#include "../VM/ExecutionBudget.h"
+
+namespace Falltergeist
+{
+    namespace VM
+    {
+        ExecutionBudget::ExecutionBudget(unsigned int instructions, unsigned int microseconds)
+            : _instructionsLimit(instructions), _ticksLimit(SDL_GetPerformanceFrequency() * microseconds / 1000000)
+        {
+            startFrame();
+        }
+
+        void ExecutionBudget::startFrame()
+        {
+            _frameStart = SDL_GetPerformanceCounter();
+            _instructions = 0;
+            _exhausted = false;
+        }
+
+        bool ExecutionBudget::spend()
+        {
+            if (_exhausted) {
+                return false;
+            }
+            if (_instructions >= _instructionsLimit
+                || (_instructions % CLOCK_INTERVAL == 0 && _instructions != 0 && SDL_GetPerformanceCounter() - _frameStart >= _ticksLimit)
+            ) {
+                _exhausted = true;
+                ++_overruns;
+                return false;
+            }
+            ++_instructions;
+            return true;
+        }
+
+        bool ExecutionBudget::exhausted() const
+        {
+            return _exhausted;
+        }
+
+        unsigned int ExecutionBudget::instructions() const
+        {
+            return _instructions;
+        }
+
+        unsigned int ExecutionBudget::overruns() const
+        {
+            return _overruns;
+        }
+    }
+}
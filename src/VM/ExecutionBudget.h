@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Falltergeist
+{
+    namespace VM
+    {
+        /**
+         * Limits how much script code runs in a single frame, by number of executed instructions and by wall-clock time.
+         * Owner calls startFrame() every frame and passes the budget to Script::call() or Script::resume(),
+         * which suspend the script once the budget is exhausted.
+         */
+        class ExecutionBudget
+        {
+            public:
+                static const unsigned int DEFAULT_INSTRUCTIONS = 20000;
+                static const unsigned int DEFAULT_MICROSECONDS = 4000;
+
+                ExecutionBudget(unsigned int instructions = DEFAULT_INSTRUCTIONS, unsigned int microseconds = DEFAULT_MICROSECONDS);
+
+                void startFrame();
+
+                // Counts one instruction about to be executed. Returns false if the budget is exhausted and it must not be.
+                bool spend();
+
+                bool exhausted() const;
+
+                // instructions executed in the current frame
+                unsigned int instructions() const;
+
+                // frames in which the budget was exhausted
+                unsigned int overruns() const;
+
+            private:
+                // clock is read once per this many instructions
+                static const unsigned int CLOCK_INTERVAL = 256;
+
+                unsigned int _instructionsLimit;
+                uint64_t _ticksLimit;
+                uint64_t _frameStart = 0;
+                unsigned int _instructions = 0;
+                unsigned int _overruns = 0;
+                bool _exhausted = false;
+        };
+    }
+}
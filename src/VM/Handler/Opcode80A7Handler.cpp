@@ -25,6 +25,7 @@
 // Falltergeist includes
 #include "../../Game/Game.h"
 #include "../../Game/Object.h"
+#include "../../Game/ObjectRegistry.h"
 #include "../../Logger.h"
 #include "../../PathFinding/Hexagon.h"
 #include "../../PathFinding/HexagonGrid.h"
@@ -47,9 +48,10 @@ namespace Falltergeist {
                 auto elevation = _script->dataStack()->popInteger();
                 auto position = _script->dataStack()->popInteger();
                 auto game = Game::getInstance();
-                std::shared_ptr<Game::Object> found;
-                for (auto object : *game->locationState()->hexagonGrid()->at(position)->objects()) {
-                    if (object->PID() == PID && object->elevation() == elevation) {
+                Game::Object *found = nullptr;
+                for (Game::ObjectHandle handle : *game->locationState()->hexagonGrid()->at(position)->objects()) {
+                    auto object = Game::ObjectRegistry::getInstance()->get(handle);
+                    if (object && object->PID() == PID && object->elevation() == elevation) {
                         found = object;
                         break;
                     }
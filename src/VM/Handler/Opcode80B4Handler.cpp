@@ -21,10 +21,9 @@
 #include "../../VM/Handler/Opcode80B4Handler.h"
 
 // C++ standard includes
-#include <cstdlib>
-#include <ctime>
 
 // Falltergeist includes
+#include "../../Game/Game.h"
 #include "../../Logger.h"
 #include "../../VM/Script.h"
 
@@ -40,7 +39,7 @@ namespace Falltergeist {
                 Logger::debug("SCRIPT") << "[80B4] [+] int rand(int min, int max)" << std::endl;
                 auto max = _script->dataStack()->popInteger();
                 auto min = _script->dataStack()->popInteger();
-                _script->dataStack()->push(rand() % (max - min + 1) + min);
+                _script->dataStack()->push(Game::getInstance()->random().next(min, max));
             }
         }
     }
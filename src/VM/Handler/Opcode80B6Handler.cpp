@@ -25,6 +25,7 @@
 // Falltergeist includes
 #include "../../Game/Game.h"
 #include "../../Game/DudeObject.h"
+#include "../../Game/ObjectRegistry.h"
 #include "../../Logger.h"
 #include "../../PathFinding/Hexagon.h"
 #include "../../PathFinding/HexagonGrid.h"
@@ -49,9 +50,9 @@ namespace Falltergeist {
                     _error("move_to: object is NULL");
                 }
                 auto hexagon = Game::getInstance()->locationState()->hexagonGrid()->at(position);
-                Game::getInstance()->locationState()->moveObjectToHexagon(object, hexagon);
+                Game::getInstance()->locationState()->moveObjectToHexagon(Game::ObjectRegistry::getInstance()->lock(object), hexagon);
                 object->setElevation(elevation);
-                if (object == Game::getInstance()->player()) {
+                if (object == Game::getInstance()->player().get()) {
                     Game::getInstance()->locationState()->centerCameraAtHexagon(object->hexagon().get());
                 }
                 _script->dataStack()->push(0);
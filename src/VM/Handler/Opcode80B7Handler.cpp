@@ -55,6 +55,7 @@ namespace Falltergeist {
                     auto intFile = ResourceManager::getInstance()->intFileType(SID);
                     if (intFile) {
                         object->setScript(new VM::Script(intFile, object));
+                        Game::getInstance()->locationState()->updateSubscriptions(object.get());
                     }
                 }
                 if (object->script()) {
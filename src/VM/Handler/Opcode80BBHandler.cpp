@@ -25,6 +25,7 @@
 // Falltergeist includes
 #include "../../Game/Game.h"
 #include "../../Game/Object.h"
+#include "../../Game/ObjectRegistry.h"
 #include "../../Game/ObjectFactory.h"
 #include "../../Logger.h"
 #include "../../PathFinding/Hexagon.h"
@@ -49,8 +50,9 @@ namespace Falltergeist {
                 auto position = _script->dataStack()->popInteger();
                 auto game = Game::getInstance();
                 int found = 0;
-                for (auto object : *game->locationState()->hexagonGrid()->at(position)->objects()) {
-                    if (object->PID() == PID && object->elevation() == elevation) {
+                for (Game::ObjectHandle handle : *game->locationState()->hexagonGrid()->at(position)->objects()) {
+                    auto object = Game::ObjectRegistry::getInstance()->get(handle);
+                    if (object && object->PID() == PID && object->elevation() == elevation) {
                         found = 1;
                     }
                 }
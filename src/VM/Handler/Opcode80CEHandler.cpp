@@ -49,7 +49,7 @@ namespace Falltergeist {
                 // ANIMATE_WALK      (0)
                 // ANIMATE_RUN       (1)
                 // ANIMATE_INTERRUPT (16) - flag to interrupt current animation
-                auto critter = std::dynamic_pointer_cast<Game::CritterObject>(object);
+                auto critter = dynamic_cast<Game::CritterObject *>(object);
                 auto state = Game::Game::getInstance()->locationState();
                 if (state) {
                     auto tileObj = state->hexagonGrid()->at(tile);
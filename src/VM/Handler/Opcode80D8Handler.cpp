@@ -26,6 +26,7 @@
 #include "../../Game/ContainerItemObject.h"
 #include "../../Game/CritterObject.h"
 #include "../../Game/Game.h"
+#include "../../Game/ObjectRegistry.h"
 #include "../../Logger.h"
 #include "../../State/Location.h"
 #include "../../VM/Script.h"
@@ -40,7 +41,7 @@ namespace Falltergeist {
 
             void Opcode80D8::_run() {
                 Logger::debug("SCRIPT") << "[80D8] [=] void add_obj_to_inven(void* who, void* item)" << std::endl;
-                auto item = std::dynamic_pointer_cast<Game::ItemObject>(_script->dataStack()->popObject());
+                auto item = dynamic_cast<Game::ItemObject *>(_script->dataStack()->popObject());
                 auto invenObj = _script->dataStack()->popObject();
 
                 if (!item) {
@@ -49,21 +50,21 @@ namespace Falltergeist {
                 }
 
                 std::vector<std::shared_ptr<Game::ItemObject>> *inven;
-                if (auto critterObj = std::dynamic_pointer_cast<Game::CritterObject>(invenObj)) {
+                if (auto critterObj = dynamic_cast<Game::CritterObject *>(invenObj)) {
                     inven = critterObj->inventory();
-                } else if (auto contObj = std::dynamic_pointer_cast<Game::ContainerItemObject>(invenObj)) {
+                } else if (auto contObj = dynamic_cast<Game::ContainerItemObject *>(invenObj)) {
                     inven = contObj->inventory();
                 } else {
                     _error("add_obj_to_inven - wrong WHO parameter");
                     return;
                 }
 
-                inven->push_back(item);
+                inven->push_back(Game::ObjectRegistry::getInstance()->lock(item));
 
                 if (item->hexagon()) {
                     auto location = Game::Game::getInstance()->locationState();
                     if (location) {
-                        location->moveObjectToHexagon(item, nullptr);
+                        location->moveObjectToHexagon(Game::ObjectRegistry::getInstance()->lock(item), nullptr);
                     }
                 }
             }
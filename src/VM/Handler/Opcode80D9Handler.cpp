@@ -39,7 +39,7 @@ namespace Falltergeist {
 
             void Opcode80D9::_run() {
                 Logger::debug("SCRIPT") << "[80D9] [=] void rm_obj_from_inven(void* who, void* obj)" << std::endl;
-                auto item = std::dynamic_pointer_cast<Game::ItemObject>(_script->dataStack()->popObject());
+                auto item = dynamic_cast<Game::ItemObject *>(_script->dataStack()->popObject());
                 auto invenObj = _script->dataStack()->popObject();
 
                 if (!item) {
@@ -48,9 +48,9 @@ namespace Falltergeist {
                 }
 
                 std::vector<std::shared_ptr<Game::ItemObject>> *inven;
-                if (auto critterObj = std::dynamic_pointer_cast<Game::CritterObject>(invenObj)) {
+                if (auto critterObj = dynamic_cast<Game::CritterObject *>(invenObj)) {
                     inven = critterObj->inventory();
-                } else if (auto contObj = std::dynamic_pointer_cast<Game::ContainerItemObject>(invenObj)) {
+                } else if (auto contObj = dynamic_cast<Game::ContainerItemObject *>(invenObj)) {
                     inven = contObj->inventory();
                 } else {
                     _error("rm_obj_from_inven - wrong WHO parameter");
@@ -58,7 +58,7 @@ namespace Falltergeist {
                 }
 
                 for (auto it=inven->begin(); it!=inven->end(); it++) {
-                    if (*it == item) {
+                    if (it->get() == item) {
                         inven->erase(it);
                         break;
                     }
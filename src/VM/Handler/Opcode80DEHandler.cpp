@@ -25,6 +25,7 @@
 // Falltergeist includes
 #include "../../Game/CritterObject.h"
 #include "../../Game/Game.h"
+#include "../../Game/ObjectRegistry.h"
 #include "../../Logger.h"
 #include "../../State/CritterDialog.h"
 #include "../../State/CritterInteract.h"
@@ -47,7 +48,7 @@ namespace Falltergeist {
                 int headID = _script->dataStack()->popInteger();
                 State::CritterInteract::Mood mood = static_cast<State::CritterInteract::Mood>(_script->dataStack()->popInteger());
 
-                auto critter = std::dynamic_pointer_cast<Game::CritterObject>(_script->dataStack()->popObject());
+                auto critter = dynamic_cast<Game::CritterObject *>(_script->dataStack()->popObject());
                 if (!critter) _error("start_gdialog - wrong critter pointer");
 
                 int msgFileID = _script->dataStack()->popInteger();
@@ -66,7 +67,7 @@ namespace Falltergeist {
                 interact->setBackgroundID(backgroundID);
                 interact->setHeadID(headID);
                 interact->setMood(mood);
-                interact->setCritter(critter);
+                interact->setCritter(Game::ObjectRegistry::getInstance()->lock(critter));
                 interact->setMsgFileID(msgFileID);
                 interact->setScript(_script);
                 Game::getInstance()->pushState(std::move(interact));
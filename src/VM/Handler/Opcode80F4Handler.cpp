@@ -24,6 +24,7 @@
 
 // Falltergeist includes
 #include "../../Game/Game.h"
+#include "../../Game/ObjectRegistry.h"
 #include "../../Logger.h"
 #include "../../State/Location.h"
 #include "../../VM/Script.h"
@@ -39,7 +40,7 @@ namespace Falltergeist {
             void Opcode80F4::_run() {
                 Logger::debug("SCRIPT") << "[80F4] [=] int destroy_object(void* obj)" << std::endl;
                 auto object = _script->dataStack()->popObject();
-                Game::Game::getInstance()->locationState()->destroyObject(object);
+                Game::Game::getInstance()->locationState()->destroyObject(Game::ObjectRegistry::getInstance()->lock(object));
                 _script->dataStack()->push(0);
             }
         }
@@ -26,6 +26,7 @@
 #include "../../Game/CritterObject.h"
 #include "../../Game/Game.h"
 #include "../../Game/Object.h"
+#include "../../Game/ObjectRegistry.h"
 #include "../../Logger.h"
 #include "../../PathFinding/Hexagon.h"
 #include "../../PathFinding/HexagonGrid.h"
@@ -47,12 +48,12 @@ namespace Falltergeist {
                         << std::endl;
                 auto elevation = _script->dataStack()->popInteger();
                 auto position = _script->dataStack()->popInteger();
-                auto critter = std::static_pointer_cast<Game::CritterObject>(_script->dataStack()->popObject());
+                auto critter = static_cast<Game::CritterObject *>(_script->dataStack()->popObject());
                 if (!critter) {
                     _error("critter_attempt_placement - invalid critter pointer");
                 }
                 auto hexagon = Game::getInstance()->locationState()->hexagonGrid()->at(position);
-                Game::getInstance()->locationState()->moveObjectToHexagon(critter, hexagon);
+                Game::getInstance()->locationState()->moveObjectToHexagon(Game::ObjectRegistry::getInstance()->lock(critter), hexagon);
                 critter->setElevation(elevation);
                 _script->dataStack()->push(1);
             }
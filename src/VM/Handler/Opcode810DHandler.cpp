@@ -53,9 +53,9 @@ namespace Falltergeist {
                     }
                 };
 
-                if (auto critter = std::dynamic_pointer_cast<Game::CritterObject>(who)) {
+                if (auto critter = dynamic_cast<Game::CritterObject *>(who)) {
                     _script->dataStack()->push(findItem(critter->inventory()));
-                } else if (auto container = std::dynamic_pointer_cast<Game::ContainerItemObject>(who)) {
+                } else if (auto container = dynamic_cast<Game::ContainerItemObject *>(who)) {
                     _script->dataStack()->push(findItem(container->inventory()));
                 } else {
                     _warning(std::string("obj_carrying_pid_obj: 'who' is not valid GameCritterObject, nor ContainerItemObject. It is ") +
@@ -27,6 +27,7 @@
 #include "../../Game/CritterObject.h"
 #include "../../Game/Game.h"
 #include "../../Game/Object.h"
+#include "../../Game/ObjectRegistry.h"
 #include "../../Logger.h"
 #include "../../State/Location.h"
 #include "../../VM/Script.h"
@@ -44,7 +45,7 @@ namespace Falltergeist {
                         << "[8116] [+] void add_mult_objs_to_inven(GameObject* who, GameItemObject* item, int amount)"
                         << std::endl;
                 auto amount = _script->dataStack()->popInteger();
-                auto item = std::dynamic_pointer_cast<Game::ItemObject>(_script->dataStack()->popObject());
+                auto item = dynamic_cast<Game::ItemObject *>(_script->dataStack()->popObject());
                 auto invenObj = _script->dataStack()->popObject();
 
                 if (!item) {
@@ -55,21 +56,21 @@ namespace Falltergeist {
                 item->setAmount(amount);
                 // who can be critter or container
                 std::vector<std::shared_ptr<Game::ItemObject>> *inven;
-                if (auto critterObj = std::dynamic_pointer_cast<Game::CritterObject>(invenObj)) {
+                if (auto critterObj = dynamic_cast<Game::CritterObject *>(invenObj)) {
                     inven = critterObj->inventory();
-                } else if (auto contObj = std::dynamic_pointer_cast<Game::ContainerItemObject>(invenObj)) {
+                } else if (auto contObj = dynamic_cast<Game::ContainerItemObject *>(invenObj)) {
                     inven = contObj->inventory();
                 } else {
                     _error("add_mult_objs_to_inven - wrong WHO parameter");
                     return;
                 }
 
-                inven->push_back(item);
+                inven->push_back(Game::ObjectRegistry::getInstance()->lock(item));
 
                 if (item->hexagon()) {
                     auto location = Game::Game::getInstance()->locationState();
                     if (location) {
-                        location->removeObjectFromMap(item);
+                        location->removeObjectFromMap(Game::ObjectRegistry::getInstance()->lock(item));
                     }
                 }
             }
@@ -40,7 +40,7 @@ namespace Falltergeist {
                 debug << "[8122] [+] void poison(GameCritterObject* who, int amount)" << std::endl;
                 int amount = _script->dataStack()->popInteger();
                 debug << "    amount = " << amount << std::endl;
-                auto critter = std::dynamic_pointer_cast<Game::CritterObject>(_script->dataStack()->popObject());
+                auto critter = dynamic_cast<Game::CritterObject *>(_script->dataStack()->popObject());
                 if (!critter) {
                     _error("poison - WHO is not critter");
                 }
@@ -41,9 +41,9 @@ namespace Falltergeist {
                 auto object = _script->dataStack()->popObject();
                 if (object) {
                     debug << "    PID: 0x" << std::hex << (object ? object->PID() : 0) << std::endl;
-                    if (auto door = std::dynamic_pointer_cast<Game::DoorSceneryObject>(object)) {
+                    if (auto door = dynamic_cast<Game::DoorSceneryObject *>(object)) {
                         door->setLocked(true);
-                    } else if (auto container = std::dynamic_pointer_cast<Game::ContainerItemObject>(object)) {
+                    } else if (auto container = dynamic_cast<Game::ContainerItemObject *>(object)) {
                         container->setLocked(true);
                     } else {
                         _warning("obj_lock: object is not door or container");
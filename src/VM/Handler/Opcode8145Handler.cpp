@@ -24,6 +24,7 @@
 
 // Falltergeist includes
 #include "../../Game/CritterObject.h"
+#include "../../Game/ObjectRegistry.h"
 #include "../../Logger.h"
 #include "../../VM/Script.h"
 
@@ -37,7 +38,7 @@ namespace Falltergeist {
 
             void Opcode8145::_run() {
                 Logger::debug("SCRIPT") << "[8145] [=] void use_obj_on_obj(void* item, void* target)" << std::endl;
-                auto selfCritter = std::dynamic_pointer_cast<Game::CritterObject>(_script->owner());
+                auto selfCritter = dynamic_cast<Game::CritterObject *>(_script->owner());
                 if (!selfCritter) {
                     _error("use_obj_on_obj: owner is not a critter!");
                 }
@@ -51,7 +52,8 @@ namespace Falltergeist {
                 }
                 // @TODO: play animation
                 //selfCritter->setActionAnimation("al");
-                target->use_obj_on_p_proc(item, selfCritter);
+                auto registry = Game::ObjectRegistry::getInstance();
+                target->use_obj_on_p_proc(registry->lock(item), registry->lock(selfCritter));
 
             }
         }
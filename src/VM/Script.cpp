@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <ctime>
 #include <memory>
 #include <sstream>
@@ -9,9 +10,12 @@
 #include "../Format/Msg/Message.h"
 #include "../Game/Game.h"
 #include "../Game/Object.h"
+#include "../Game/ObjectRegistry.h"
 #include "../Logger.h"
+#include "../Profiler.h"
 #include "../ResourceManager.h"
 #include "../VM/ErrorException.h"
+#include "../VM/ExecutionBudget.h"
 #include "../VM/HaltException.h"
 #include "../VM/OpcodeFactory.h"
 #include "../VM/Script.h"
@@ -23,7 +27,9 @@ namespace Falltergeist
     {
         Script::Script(Format::Int::File *script, const std::shared_ptr<Game::Object> &owner)
         {
-            _owner = owner;
+            if (owner) {
+                _owner = owner->handle();
+            }
             _script = script;
             if (!_script) {
                 throw Exception("Script::VM() - script is null");
@@ -32,7 +38,9 @@ namespace Falltergeist
 
         Script::Script(const std::string &filename, const std::shared_ptr<Game::Object> &owner)
         {
-            _owner = owner;
+            if (owner) {
+                _owner = owner->handle();
+            }
             _script = ResourceManager::getInstance()->intFileType(filename);
             if (!_script) {
                 throw Exception("Script::VM() - script is null: " + filename);
@@ -53,28 +61,108 @@ namespace Falltergeist
             return _script->procedure(name) != nullptr;
         }
 
+        bool Script::hasFunction(STANDARD_PROCEDURE procedure) const
+        {
+            return _script->procedure(procedure) != nullptr;
+        }
+
         void Script::call(const std::string &name)
+        {
+            _call(_script->procedure(name), name);
+        }
+
+        void Script::call(STANDARD_PROCEDURE procedure)
+        {
+            _call(_script->procedure(procedure), Format::Int::File::procedureName(procedure));
+        }
+
+        bool Script::call(STANDARD_PROCEDURE procedure, ExecutionBudget &budget)
+        {
+            _completeSuspended();
+            return _start(_script->procedure(procedure), Format::Int::File::procedureName(procedure), &budget);
+        }
+
+        bool Script::resume(ExecutionBudget &budget)
+        {
+            if (!_suspended) {
+                return true;
+            }
+            ++_callFrames;
+            if (!_run(&budget)) {
+                ++_statistics.suspensions;
+                return false;
+            }
+            _suspended = false;
+            _finishCall();
+            return true;
+        }
+
+        bool Script::suspended() const
+        {
+            return _suspended;
+        }
+
+        const Script::Statistics &Script::statistics() const
+        {
+            return _statistics;
+        }
+
+        void Script::_call(const Format::Int::Procedure *procedure, const std::string &name)
+        {
+            _completeSuspended();
+            _start(procedure, name, nullptr);
+        }
+
+        bool Script::_start(const Format::Int::Procedure *procedure, const std::string &name, ExecutionBudget *budget)
         {
             _overrides = false;
-            auto procedure = _script->procedure(name);
             if (!procedure) {
-                return;
+                return true;
             }
 
             _programCounter = procedure->bodyOffset();
             _dataStack.push(0); // arguments counter;
             _returnStack.push(0); // return address
             Logger::debug("SCRIPT") << "CALLED: " << name << " [" << _script->filename() << "]" << std::endl;
-            run();
+            if (budget) {
+                ++_statistics.calls;
+                _callFrames = 1;
+            }
+            if (!_run(budget)) {
+                _suspended = true;
+                ++_statistics.suspensions;
+                Logger::debug("SCRIPT") << "Suspended: " << name << " [" << _script->filename() << "]" << std::endl;
+                return false;
+            }
+            _finishCall();
+            return true;
+        }
+
+        void Script::_finishCall()
+        {
             _dataStack.popInteger(); // remove function result
             Logger::debug("SCRIPT") << "Function ended" << std::endl;
 
+            _statistics.maxFramesPerCall = std::max(_statistics.maxFramesPerCall, _callFrames);
+            _callFrames = 0;
+
             // reset special script arguments
-            _sourceObject.reset();
-            _targetObject.reset();
+            _sourceObject = Game::ObjectHandle();
+            _targetObject = Game::ObjectHandle();
             _actionUsed = _fixedParam = 0;
         }
 
+        // Procedure left suspended has to end before the script is called again or its arguments are changed.
+        void Script::_completeSuspended()
+        {
+            if (!_suspended) {
+                return;
+            }
+            _suspended = false;
+            _run(nullptr);
+            _finishCall();
+        }
+
         void Script::initialize()
         {
             if (_initialized) {
@@ -87,9 +175,21 @@ namespace Falltergeist
 
         void Script::run()
         {
+            _run(nullptr);
+        }
+
+        bool Script::_run(ExecutionBudget *budget)
+        {
+            ProfilerZone zone("Script::run");
             while (_programCounter != _script->size()) {
                 if (_programCounter == 0 && _initialized) {
-                    return;
+                    return true;
+                }
+                if (budget) {
+                    if (!budget->spend()) {
+                        return false;
+                    }
+                    ++_statistics.instructions;
                 }
                 auto offset = _programCounter;
                 _script->setPosition(_programCounter);
@@ -99,15 +199,16 @@ namespace Falltergeist
                 try {
                     opcodeHandler->run();
                 } catch (const HaltException &) {
-                    return;
+                    return true;
                 } catch (const ErrorException &e) {
                     Logger::error("SCRIPT") << e.what() << " in [" << std::hex << opcode << "] at "
                                             << _script->filename() << ":0x" << offset << std::endl;
                     _dataStack.values()->clear();
                     _dataStack.push(0); // to end script properly
-                    return;
+                    return true;
                 }
             }
+            return true;
         }
 
         std::string Script::msgMessage(int msg_file_num, int msg_num)
@@ -175,9 +276,9 @@ namespace Falltergeist
             return &_LVARS;
         }
 
-        std::shared_ptr<Game::Object> Script::owner()
+        Game::Object *Script::owner()
         {
-            return _owner.lock();
+            return Game::ObjectRegistry::getInstance()->get(_owner);
         }
 
         bool Script::initialized()
@@ -202,6 +303,7 @@ namespace Falltergeist
 
         Script *Script::setFixedParam(int fixedParam)
         {
+            _completeSuspended();
             this->_fixedParam = fixedParam;
             return this;
         }
@@ -213,24 +315,26 @@ namespace Falltergeist
 
         Script *Script::setTargetObject(const std::shared_ptr<Game::Object> &targetObject)
         {
-            this->_targetObject = targetObject;
+            _completeSuspended();
+            this->_targetObject = targetObject ? targetObject->handle() : Game::ObjectHandle();
             return this;
         }
 
-        std::shared_ptr<Game::Object> Script::targetObject() const
+        Game::Object *Script::targetObject() const
         {
-            return _targetObject.lock();
+            return Game::ObjectRegistry::getInstance()->get(_targetObject);
         }
 
         Script *Script::setSourceObject(const std::shared_ptr<Game::Object> &sourceObject)
         {
-            this->_sourceObject = sourceObject;
+            _completeSuspended();
+            this->_sourceObject = sourceObject ? sourceObject->handle() : Game::ObjectHandle();
             return this;
         }
 
-        std::shared_ptr<Game::Object> Script::sourceObject() const
+        Game::Object *Script::sourceObject() const
         {
-            return _sourceObject.lock();
+            return Game::ObjectRegistry::getInstance()->get(_sourceObject);
         }
 
         size_t Script::DVARbase()
@@ -260,6 +364,7 @@ namespace Falltergeist
 
         Script *Script::setUsedSkill(SKILL skill)
         {
+            _completeSuspended();
             _usedSkill = skill;
             return this;
         }
@@ -12,6 +12,7 @@ namespace Falltergeist
         namespace Int
         {
             class File;
+            class Procedure;
         }
     }
 
@@ -22,6 +23,8 @@ namespace Falltergeist
 
     namespace VM
     {
+        class ExecutionBudget;
+
         /**
          * Script class represents Virtual Machine for running vanilla Fallout scripts.
          * VM uses 2 stacks (return stack and data stack).
@@ -31,6 +34,18 @@ namespace Falltergeist
         class Script
         {
             public:
+                struct Statistics
+                {
+                    // instructions executed under a budget
+                    unsigned long long instructions = 0;
+                    // budgeted procedure calls
+                    unsigned int calls = 0;
+                    // how many times the script was suspended because of exhausted budget
+                    unsigned int suspensions = 0;
+                    // the longest budgeted call, in frames
+                    unsigned int maxFramesPerCall = 0;
+                };
+
                 Script(Format::Int::File *script, const std::shared_ptr<Game::Object> &owner);
 
                 Script(const std::string &filename, const std::shared_ptr<Game::Object> &owner);
@@ -58,11 +73,29 @@ namespace Falltergeist
 
                 bool hasFunction(const std::string &name);
 
+                bool hasFunction(STANDARD_PROCEDURE procedure) const;
+
                 void call(const std::string &name);
 
+                // same as call(name) for one of standard procedures, without a name lookup
+                void call(STANDARD_PROCEDURE procedure);
+
+                /**
+                 * Calls standard procedure, executing no more instructions than the budget allows.
+                 * @return false if the script was suspended before the procedure ended, resume() continues it then
+                 */
+                bool call(STANDARD_PROCEDURE procedure, ExecutionBudget &budget);
+
+                // Continues suspended procedure. Returns false if it is still not finished.
+                bool resume(ExecutionBudget &budget);
+
+                bool suspended() const;
+
+                const Statistics &statistics() const;
+
                 Format::Int::File *script();
 
-                std::shared_ptr<Falltergeist::Game::Object> owner();
+                Falltergeist::Game::Object *owner();
 
                 unsigned int programCounter();
 
@@ -88,20 +121,20 @@ namespace Falltergeist
 
                 VM::Script *setTargetObject(const std::shared_ptr<Game::Object> &targetObject);
 
-                std::shared_ptr<Falltergeist::Game::Object> targetObject() const;
+                Falltergeist::Game::Object *targetObject() const;
 
                 VM::Script *setSourceObject(const std::shared_ptr<Game::Object> &sourceObject);
 
-                std::shared_ptr<Falltergeist::Game::Object> sourceObject() const;
+                Falltergeist::Game::Object *sourceObject() const;
 
                 SKILL usedSkill() const;
 
                 VM::Script *setUsedSkill(SKILL skill);
 
             protected:
-                std::weak_ptr<Game::Object> _owner;
-                std::weak_ptr<Game::Object> _sourceObject;
-                std::weak_ptr<Game::Object> _targetObject;
+                Game::ObjectHandle _owner;
+                Game::ObjectHandle _sourceObject;
+                Game::ObjectHandle _targetObject;
                 SKILL _usedSkill = SKILL::NONE;
 
                 int _fixedParam = 0;
@@ -115,6 +148,15 @@ namespace Falltergeist
                 unsigned int _programCounter = 0;
                 size_t _DVAR_base = 0;
                 size_t _SVAR_base = 0;
+                bool _suspended = false;
+                unsigned int _callFrames = 0;
+                Statistics _statistics;
+
+                void _call(const Format::Int::Procedure *procedure, const std::string &name);
+                bool _start(const Format::Int::Procedure *procedure, const std::string &name, ExecutionBudget *budget);
+                bool _run(ExecutionBudget *budget);
+                void _finishCall();
+                void _completeSuspended();
         };
     }
 }
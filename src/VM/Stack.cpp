@@ -84,7 +84,7 @@ namespace Falltergeist
             push(StackValue(value));
         }
 
-        std::shared_ptr<Game::Object> Stack::popObject()
+        Game::Object *Stack::popObject()
         {
             return pop().objectValue();
         }
@@ -94,6 +94,11 @@ namespace Falltergeist
             push(StackValue(value));
         }
 
+        void Stack::push(Game::Object *value)
+        {
+            push(StackValue(value));
+        }
+
         std::string Stack::popString()
         {
             return pop().stringValue();
@@ -31,6 +31,8 @@ namespace Falltergeist
 
                 void push(const std::shared_ptr<Game::Object> &value);
 
+                void push(Game::Object *value);
+
                 void push(const std::string &value);
 
                 const StackValue pop();
@@ -41,7 +43,8 @@ namespace Falltergeist
 
                 std::string popString();
 
-                std::shared_ptr<Game::Object> popObject();
+                // doesn't share ownership, see Game::ObjectRegistry::lock() for that
+                Game::Object *popObject();
 
                 bool popLogical();
 
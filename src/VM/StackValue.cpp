@@ -3,6 +3,7 @@
 #include <stdexcept>
 #include <string>
 #include "../Game/Object.h"
+#include "../Game/ObjectRegistry.h"
 #include "../VM/ErrorException.h"
 #include "../VM/StackValue.h"
 
@@ -38,7 +39,17 @@ namespace Falltergeist
         {
             //throw Exception("StackValue::StackValue(Game::GameObject*) - null object value is not allowed, use integer 0");
             _type = Type::OBJECT;
-            _objectValue = value;
+            if (value) {
+                _objectValue = value->handle();
+            }
+        }
+
+        StackValue::StackValue(Game::Object *value)
+        {
+            _type = Type::OBJECT;
+            if (value) {
+                _objectValue = value->handle();
+            }
         }
 
         StackValue::~StackValue()
@@ -82,7 +93,7 @@ namespace Falltergeist
             return _stringValue;
         }
 
-        std::shared_ptr<Game::Object> StackValue::objectValue() const
+        Game::Object *StackValue::objectValue() const
         {
             if (_type == Type::INTEGER && _intValue == 0) {
                 return nullptr;
@@ -91,12 +102,10 @@ namespace Falltergeist
                 throw ErrorException(std::string("StackValue::objectValue() - stack value is not an object, it is ") +
                                      typeName(_type));
             }
-            std::shared_ptr<Game::Object> ret = _objectValue.lock();
+            Game::Object *ret = Game::ObjectRegistry::getInstance()->get(_objectValue);
             if (!ret) {
                 throw ErrorException(std::string("StackValue::objectValue() - object has been deleted"));
             }
-
-
             return ret;
         }
 
@@ -113,7 +122,7 @@ namespace Falltergeist
                 case Type::STRING:
                     return _stringValue;
                 case Type::OBJECT: {
-                    const std::shared_ptr<Game::Object> &object = objectValue();
+                    Game::Object *object = objectValue();
                     return object ? object->name() : std::string(
                             "(null)"); // just in case, we should never create null object value
                 }
@@ -2,6 +2,7 @@
 
 #include <string>
 #include <memory>
+#include "../Game/ObjectHandle.h"
 
 namespace Falltergeist
 {
@@ -32,6 +33,8 @@ namespace Falltergeist
 
                 StackValue(const std::shared_ptr<Game::Object> &value);
 
+                StackValue(Game::Object *value);
+
                 virtual ~StackValue();
 
                 Type type() const;
@@ -47,8 +50,8 @@ namespace Falltergeist
                 // returns string value or throws exception if it's not string
                 std::string stringValue() const;
 
-                // returns object pointer or throws exception if it's not object
-                std::shared_ptr<Falltergeist::Game::Object> objectValue() const;
+                // returns object pointer or throws exception if it's not object, doesn't share ownership
+                Falltergeist::Game::Object *objectValue() const;
 
                 // converts value of any type to string representation
                 std::string toString() const;
@@ -68,7 +71,7 @@ namespace Falltergeist
                     int32_t _intValue;
                     float _floatValue;
                 };
-                std::weak_ptr<Game::Object> _objectValue;
+                Game::ObjectHandle _objectValue;
                 std::string _stringValue;
         };
     }